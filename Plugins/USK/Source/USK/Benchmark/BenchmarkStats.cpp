@@ -0,0 +1,42 @@
+﻿// Created by Henry Jooste
+
+#include "BenchmarkStats.h"
+
+#include "HAL/PlatformTime.h"
+
+bool FBenchmarkStats::bEnabled = false;
+double FBenchmarkStats::SpawnProjectileTime = 0.0;
+int FBenchmarkStats::SpawnProjectileCalls = 0;
+double FBenchmarkStats::ProjectileHitTime = 0.0;
+int FBenchmarkStats::ProjectileHitCalls = 0;
+
+/**
+ * @brief Reset all the measurements
+ */
+void FBenchmarkStats::Reset()
+{
+	SpawnProjectileTime = 0.0;
+	SpawnProjectileCalls = 0;
+	ProjectileHitTime = 0.0;
+	ProjectileHitCalls = 0;
+}
+
+/**
+ * @brief Start measuring the scope
+ * @param InTime The total time of the section
+ * @param InCalls The amount of times the section was measured
+ */
+FBenchmarkStatScope::FBenchmarkStatScope(double& InTime, int& InCalls) : Time(InTime), Calls(InCalls),
+	StartTime(FBenchmarkStats::bEnabled ? FPlatformTime::Seconds() : -1.0) { }
+
+/**
+ * @brief Stop measuring the scope
+ */
+FBenchmarkStatScope::~FBenchmarkStatScope()
+{
+	if (StartTime >= 0.0)
+	{
+		Time += FPlatformTime::Seconds() - StartTime;
+		Calls++;
+	}
+}
@@ -0,0 +1,83 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Measure the time spent in the current scope while a benchmark is running
+ * @param Name The name of the measured section in FBenchmarkStats
+ */
+#define USK_BENCHMARK_SCOPE(Name) \
+	const FBenchmarkStatScope BenchmarkStatScope_##Name(FBenchmarkStats::Name##Time, FBenchmarkStats::Name##Calls)
+
+/**
+ * @brief The time spent in the sections of code measured by the benchmarks
+ */
+struct USK_API FBenchmarkStats
+{
+	/**
+	 * @brief Are the sections currently being measured?
+	 */
+	static bool bEnabled;
+
+	/**
+	 * @brief The amount of seconds spent spawning weapon projectiles
+	 */
+	static double SpawnProjectileTime;
+
+	/**
+	 * @brief The amount of weapon projectiles spawned
+	 */
+	static int SpawnProjectileCalls;
+
+	/**
+	 * @brief The amount of seconds spent processing weapon projectile hits
+	 */
+	static double ProjectileHitTime;
+
+	/**
+	 * @brief The amount of weapon projectile hits processed
+	 */
+	static int ProjectileHitCalls;
+
+	/**
+	 * @brief Reset all the measurements
+	 */
+	static void Reset();
+};
+
+/**
+ * @brief Adds the time spent in a scope to a benchmark section
+ */
+class USK_API FBenchmarkStatScope
+{
+public:
+	/**
+	 * @brief Start measuring the scope
+	 * @param InTime The total time of the section
+	 * @param InCalls The amount of times the section was measured
+	 */
+	FBenchmarkStatScope(double& InTime, int& InCalls);
+
+	/**
+	 * @brief Stop measuring the scope
+	 */
+	~FBenchmarkStatScope();
+
+private:
+	/**
+	 * @brief The total time of the section
+	 */
+	double& Time;
+
+	/**
+	 * @brief The amount of times the section was measured
+	 */
+	int& Calls;
+
+	/**
+	 * @brief The time at which the scope started, or a negative value if the scope is not measured
+	 */
+	double StartTime;
+};
@@ -0,0 +1,232 @@
+﻿// Created by Henry Jooste
+
+#include "InputRecorderComponent.h"
+
+#include "EnhancedPlayerInput.h"
+#include "InputRecordingButton.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "HAL/IConsoleManager.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "USK/Character/USKCharacter.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Get the input recorder of the first local player, adding one if the character doesn't have a recorder
+ * @param World The world containing the player
+ * @return The input recorder or nullptr if the player isn't controlling a USK character
+ */
+static UInputRecorderComponent* GetPlayerInputRecorder(const UWorld* World)
+{
+	AUSKCharacter* Character = Cast<AUSKCharacter>(UGameplayStatics::GetPlayerPawn(World, 0));
+	if (!IsValid(Character))
+	{
+		USK_LOG_ERROR("Unable to record input. The player isn't controlling a USK character");
+		return nullptr;
+	}
+
+	UInputRecorderComponent* Recorder = Character->FindComponentByClass<UInputRecorderComponent>();
+	if (!IsValid(Recorder))
+	{
+		Recorder = NewObject<UInputRecorderComponent>(Character);
+		Recorder->RegisterComponent();
+	}
+
+	return Recorder;
+}
+
+/**
+ * @brief Console command used to start recording the input of the player
+ */
+static FAutoConsoleCommandWithWorldAndArgs StartRecordingInputCommand(
+	TEXT("USK.Benchmark.RecordInput"),
+	TEXT("Start recording the input of the player. Usage: USK.Benchmark.RecordInput [Name]"),
+	FConsoleCommandWithWorldAndArgsDelegate::CreateLambda([](const TArray<FString>& Args, const UWorld* World)
+	{
+		UInputRecorderComponent* Recorder = GetPlayerInputRecorder(World);
+		if (!IsValid(Recorder))
+		{
+			return;
+		}
+
+		if (Args.Num() > 0)
+		{
+			Recorder->RecordingName = Args[0];
+		}
+
+		Recorder->StartRecording();
+	}));
+
+/**
+ * @brief Console command used to stop recording the input of the player
+ */
+static FAutoConsoleCommandWithWorld StopRecordingInputCommand(
+	TEXT("USK.Benchmark.StopRecordingInput"),
+	TEXT("Stop recording the input of the player and write the recording to the Saved/Benchmarks directory"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](const UWorld* World)
+	{
+		UInputRecorderComponent* Recorder = GetPlayerInputRecorder(World);
+		if (IsValid(Recorder))
+		{
+			Recorder->StopRecording();
+		}
+	}));
+
+/**
+ * @brief Create a new instance of the UInputRecorderComponent component
+ */
+UInputRecorderComponent::UInputRecorderComponent()
+{
+	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bStartWithTickEnabled = false;
+	PrimaryComponentTick.TickGroup = TG_PrePhysics;
+}
+
+/**
+ * @brief Capture the input action values of the current frame
+ * @param DeltaTime The time since the last tick
+ * @param TickType The kind of tick this is
+ * @param ThisTickFunction The tick function that is being executed
+ */
+void UInputRecorderComponent::TickComponent(const float DeltaTime, const ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+	if (!bIsRecording || !IsValid(Character) || !IsValid(PlayerInput))
+	{
+		return;
+	}
+
+	EInputRecordingButton Buttons = EInputRecordingButton::None;
+	if (IsPressed(Character->JumpAction))
+	{
+		Buttons |= EInputRecordingButton::Jump;
+	}
+
+	if (IsPressed(Character->SprintAction))
+	{
+		Buttons |= EInputRecordingButton::Sprint;
+	}
+
+	if (IsPressed(Character->CrouchAction))
+	{
+		Buttons |= EInputRecordingButton::Crouch;
+	}
+
+	if (IsPressed(Character->FireWeaponAction))
+	{
+		Buttons |= EInputRecordingButton::FireWeapon;
+	}
+
+	FInputRecordingFrame& Frame = Recording.Frames.AddDefaulted_GetRef();
+	Frame.Move = GetAxis2D(Character->MoveAction);
+	Frame.Look = GetAxis2D(Character->LookAroundAction);
+	Frame.Lean = GetAxis1D(Character->LeanAction);
+	Frame.Buttons = static_cast<uint8>(Buttons);
+}
+
+/**
+ * @brief Start capturing the input action values of the owning character
+ */
+void UInputRecorderComponent::StartRecording()
+{
+	if (bIsRecording)
+	{
+		USK_LOG_WARNING("Input is already being recorded");
+		return;
+	}
+
+	Character = Cast<AUSKCharacter>(GetOwner());
+	const APlayerController* PlayerController = IsValid(Character)
+		? Cast<APlayerController>(Character->GetController())
+		: nullptr;
+	PlayerInput = IsValid(PlayerController) ? Cast<UEnhancedPlayerInput>(PlayerController->PlayerInput) : nullptr;
+	if (!IsValid(PlayerInput))
+	{
+		USK_LOG_ERROR("Unable to record input. The owner isn't a USK character controlled by a player");
+		return;
+	}
+
+	USK_LOG_INFO(*FString::Format(TEXT("Recording input {0}"), { RecordingName }));
+	Recording = FInputRecording();
+	Recording.StartLocation = Character->GetActorLocation();
+	Recording.StartRotation = Character->GetControlRotation();
+	Recording.FixedDeltaTime = 1.0f / ReplayFrameRate;
+	Recording.Frames.Reserve(FMath::CeilToInt(ReplayFrameRate * 60.0f));
+	bIsRecording = true;
+
+	// Capture every frame at the timestep it is replayed at so the replayed movement matches the recording
+	bPreviousUseFixedTimestep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+	FApp::SetUseFixedTimeStep(true);
+	FApp::SetFixedDeltaTime(Recording.FixedDeltaTime);
+	SetComponentTickEnabled(true);
+}
+
+/**
+ * @brief Stop capturing the input action values and write the recording to file
+ */
+void UInputRecorderComponent::StopRecording()
+{
+	if (!bIsRecording)
+	{
+		return;
+	}
+
+	bIsRecording = false;
+	SetComponentTickEnabled(false);
+	FApp::SetUseFixedTimeStep(bPreviousUseFixedTimestep);
+	FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+	Recording.SaveToFile(FInputRecording::GetRecordingPath(RecordingName));
+	Recording = FInputRecording();
+}
+
+/**
+ * @brief Check if the input action values are being captured
+ * @return A boolean value indicating if the input action values are being captured
+ */
+bool UInputRecorderComponent::IsRecording() const
+{
+	return bIsRecording;
+}
+
+/**
+ * @brief Ends gameplay for this component
+ * @param EndPlayReason The reason gameplay is ending
+ */
+void UInputRecorderComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	StopRecording();
+	Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * @brief Get the current value of an input action as a 2D vector
+ * @param Action The input action
+ * @return The current value of the input action
+ */
+FVector2D UInputRecorderComponent::GetAxis2D(const UInputAction* Action) const
+{
+	return IsValid(Action) ? PlayerInput->GetActionValue(Action).Get<FVector2D>() : FVector2D::ZeroVector;
+}
+
+/**
+ * @brief Get the current value of an input action as a float
+ * @param Action The input action
+ * @return The current value of the input action
+ */
+float UInputRecorderComponent::GetAxis1D(const UInputAction* Action) const
+{
+	return IsValid(Action) ? PlayerInput->GetActionValue(Action).Get<float>() : 0.0f;
+}
+
+/**
+ * @brief Check if an input action is currently pressed
+ * @param Action The input action
+ * @return A boolean value indicating if the input action is pressed
+ */
+bool UInputRecorderComponent::IsPressed(const UInputAction* Action) const
+{
+	return IsValid(Action) && PlayerInput->GetActionValue(Action).Get<bool>();
+}
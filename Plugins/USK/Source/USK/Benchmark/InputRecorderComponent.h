@@ -0,0 +1,128 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputRecording.h"
+#include "Components/ActorComponent.h"
+#include "InputRecorderComponent.generated.h"
+
+class AUSKCharacter;
+class UEnhancedPlayerInput;
+class UInputAction;
+
+/**
+ * @brief Actor component that captures the input action values of a character every frame so they can be replayed
+ */
+UCLASS(Blueprintable, meta=(BlueprintSpawnableComponent))
+class USK_API UInputRecorderComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief The name of the recording written to the Saved/Benchmarks/Recordings directory
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark")
+	FString RecordingName = "InputRecording";
+
+	/**
+	 * @brief The fixed frame rate the engine runs at while recording and replaying the input
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark", meta=(ClampMin = "1"))
+	float ReplayFrameRate = 60.0f;
+
+	/**
+	 * @brief Create a new instance of the UInputRecorderComponent component
+	 */
+	UInputRecorderComponent();
+
+	/**
+	 * @brief Capture the input action values of the current frame
+	 * @param DeltaTime The time since the last tick
+	 * @param TickType The kind of tick this is
+	 * @param ThisTickFunction The tick function that is being executed
+	 */
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+		FActorComponentTickFunction* ThisTickFunction) override;
+
+	/**
+	 * @brief Start capturing the input action values of the owning character
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Benchmark")
+	void StartRecording();
+
+	/**
+	 * @brief Stop capturing the input action values and write the recording to file
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Benchmark")
+	void StopRecording();
+
+	/**
+	 * @brief Check if the input action values are being captured
+	 * @return A boolean value indicating if the input action values are being captured
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Benchmark")
+	bool IsRecording() const;
+
+protected:
+	/**
+	 * @brief Ends gameplay for this component
+	 * @param EndPlayReason The reason gameplay is ending
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/**
+	 * @brief The character that owns the component
+	 */
+	UPROPERTY()
+	AUSKCharacter* Character;
+
+	/**
+	 * @brief The player input used to read the current input action values
+	 */
+	UPROPERTY()
+	UEnhancedPlayerInput* PlayerInput;
+
+	/**
+	 * @brief The input action values captured so far
+	 */
+	FInputRecording Recording;
+
+	/**
+	 * @brief Are the input action values being captured?
+	 */
+	bool bIsRecording;
+
+	/**
+	 * @brief Was the engine using a fixed timestep before the recording started?
+	 */
+	bool bPreviousUseFixedTimestep;
+
+	/**
+	 * @brief The fixed timestep used by the engine before the recording started
+	 */
+	double PreviousFixedDeltaTime;
+
+	/**
+	 * @brief Get the current value of an input action as a 2D vector
+	 * @param Action The input action
+	 * @return The current value of the input action
+	 */
+	FVector2D GetAxis2D(const UInputAction* Action) const;
+
+	/**
+	 * @brief Get the current value of an input action as a float
+	 * @param Action The input action
+	 * @return The current value of the input action
+	 */
+	float GetAxis1D(const UInputAction* Action) const;
+
+	/**
+	 * @brief Check if an input action is currently pressed
+	 * @param Action The input action
+	 * @return A boolean value indicating if the input action is pressed
+	 */
+	bool IsPressed(const UInputAction* Action) const;
+};
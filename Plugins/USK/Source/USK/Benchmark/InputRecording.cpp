@@ -0,0 +1,169 @@
+﻿// Created by Henry Jooste
+
+#include "InputRecording.h"
+
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "Serialization/BufferArchive.h"
+#include "Serialization/MemoryReader.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief The value written at the start of each recording file
+ */
+static constexpr uint32 InputRecordingMagic = 0x55534B49;
+
+/**
+ * @brief The version of the recording file format
+ */
+static constexpr uint32 InputRecordingVersion = 1;
+
+/**
+ * @brief Read or write a vector using single precision components to keep the stream compact
+ * @param Archive The archive used to read or write the vector
+ * @param Value The vector to read or write
+ */
+static void SerializeCompact(FArchive& Archive, FVector2D& Value)
+{
+	float X = Value.X;
+	float Y = Value.Y;
+	Archive << X << Y;
+	if (Archive.IsLoading())
+	{
+		Value = FVector2D(X, Y);
+	}
+}
+
+/**
+ * @brief Read or write a vector using single precision components to keep the stream compact
+ * @param Archive The archive used to read or write the vector
+ * @param Value The vector to read or write
+ */
+static void SerializeCompact(FArchive& Archive, FVector& Value)
+{
+	float X = Value.X;
+	float Y = Value.Y;
+	float Z = Value.Z;
+	Archive << X << Y << Z;
+	if (Archive.IsLoading())
+	{
+		Value = FVector(X, Y, Z);
+	}
+}
+
+/**
+ * @brief Read or write a rotator using single precision components to keep the stream compact
+ * @param Archive The archive used to read or write the rotator
+ * @param Value The rotator to read or write
+ */
+static void SerializeCompact(FArchive& Archive, FRotator& Value)
+{
+	float Pitch = Value.Pitch;
+	float Yaw = Value.Yaw;
+	float Roll = Value.Roll;
+	Archive << Pitch << Yaw << Roll;
+	if (Archive.IsLoading())
+	{
+		Value = FRotator(Pitch, Yaw, Roll);
+	}
+}
+
+/**
+ * @brief Get the path of a recording in the Saved/Benchmarks/Recordings directory
+ * @param Name The name of the recording
+ * @return The full path of the recording
+ */
+FString FInputRecording::GetRecordingPath(const FString& Name)
+{
+	return FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), TEXT("Recordings"), Name + TEXT(".uskinput"));
+}
+
+/**
+ * @brief Write the recording to a binary file
+ * @param Path The path of the file
+ * @return A boolean value indicating if the recording was written
+ */
+bool FInputRecording::SaveToFile(const FString& Path) const
+{
+	FBufferArchive Writer;
+	// Serializing into a saving archive never modifies the recording
+	const_cast<FInputRecording*>(this)->Serialize(Writer);
+	if (!FFileHelper::SaveArrayToFile(Writer, *Path))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Failed to write input recording to {0}"), { Path }));
+		return false;
+	}
+
+	USK_LOG_INFO(*FString::Format(TEXT("Input recording with {0} frames written to {1}"), { Frames.Num(), Path }));
+	return true;
+}
+
+/**
+ * @brief Read the recording from a binary file
+ * @param Path The path of the file
+ * @return A boolean value indicating if the recording was read
+ */
+bool FInputRecording::LoadFromFile(const FString& Path)
+{
+	TArray<uint8> Data;
+	if (!FFileHelper::LoadFileToArray(Data, *Path))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Failed to read input recording {0}"), { Path }));
+		return false;
+	}
+
+	FMemoryReader Reader(Data);
+	Serialize(Reader);
+	if (Reader.IsError() || FixedDeltaTime <= 0.0f)
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Input recording {0} is corrupt or has an unsupported format"), { Path }));
+		Frames.Empty();
+		return false;
+	}
+
+	return true;
+}
+
+/**
+ * @brief Read or write the header and frames of the recording
+ * @param Archive The archive used to read or write the recording
+ */
+void FInputRecording::Serialize(FArchive& Archive)
+{
+	uint32 Magic = InputRecordingMagic;
+	uint32 Version = InputRecordingVersion;
+	Archive << Magic << Version;
+	if (Magic != InputRecordingMagic || Version != InputRecordingVersion)
+	{
+		Archive.SetError();
+		return;
+	}
+
+	SerializeCompact(Archive, StartLocation);
+	SerializeCompact(Archive, StartRotation);
+	Archive << FixedDeltaTime;
+
+	int32 FrameCount = Frames.Num();
+	Archive << FrameCount;
+	if (Archive.IsLoading())
+	{
+		if (FrameCount < 0 || FrameCount > Archive.TotalSize())
+		{
+			Archive.SetError();
+			return;
+		}
+
+		Frames.SetNum(FrameCount);
+	}
+
+	for (FInputRecordingFrame& Frame : Frames)
+	{
+		SerializeCompact(Archive, Frame.Move);
+		SerializeCompact(Archive, Frame.Look);
+		Archive << Frame.Lean << Frame.Buttons;
+		if (Archive.IsError())
+		{
+			return;
+		}
+	}
+}
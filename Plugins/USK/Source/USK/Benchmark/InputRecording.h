@@ -0,0 +1,68 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputRecordingFrame.h"
+#include "InputRecording.generated.h"
+
+/**
+ * @brief A stream of input action values that can be replayed to drive a character without player input
+ */
+USTRUCT(BlueprintType)
+struct USK_API FInputRecording
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The location of the character when the recording started
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	FVector StartLocation = FVector::ZeroVector;
+
+	/**
+	 * @brief The control rotation of the character when the recording started
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	FRotator StartRotation = FRotator::ZeroRotator;
+
+	/**
+	 * @brief The amount of seconds between frames when the recording is replayed
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float FixedDeltaTime = 1.0f / 60.0f;
+
+	/**
+	 * @brief The input action values captured during each frame
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	TArray<FInputRecordingFrame> Frames;
+
+	/**
+	 * @brief Get the path of a recording in the Saved/Benchmarks/Recordings directory
+	 * @param Name The name of the recording
+	 * @return The full path of the recording
+	 */
+	static FString GetRecordingPath(const FString& Name);
+
+	/**
+	 * @brief Write the recording to a binary file
+	 * @param Path The path of the file
+	 * @return A boolean value indicating if the recording was written
+	 */
+	bool SaveToFile(const FString& Path) const;
+
+	/**
+	 * @brief Read the recording from a binary file
+	 * @param Path The path of the file
+	 * @return A boolean value indicating if the recording was read
+	 */
+	bool LoadFromFile(const FString& Path);
+
+private:
+	/**
+	 * @brief Read or write the header and frames of the recording
+	 * @param Archive The archive used to read or write the recording
+	 */
+	void Serialize(FArchive& Archive);
+};
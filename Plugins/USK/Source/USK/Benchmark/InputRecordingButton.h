@@ -0,0 +1,39 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputRecordingButton.generated.h"
+
+/**
+ * @brief The buttons captured by an input recording that can be combined into a single bitfield
+ */
+UENUM(BlueprintType, meta=(Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EInputRecordingButton : uint8
+{
+	/**
+	 * @brief No buttons are pressed
+	 */
+	None = 0 UMETA(Hidden),
+
+	/**
+	 * @brief The jump button is pressed
+	 */
+	Jump = 1 << 0,
+
+	/**
+	 * @brief The sprint button is pressed
+	 */
+	Sprint = 1 << 1,
+
+	/**
+	 * @brief The crouch button is pressed
+	 */
+	Crouch = 1 << 2,
+
+	/**
+	 * @brief The fire weapon button is pressed
+	 */
+	FireWeapon = 1 << 3
+};
+ENUM_CLASS_FLAGS(EInputRecordingButton);
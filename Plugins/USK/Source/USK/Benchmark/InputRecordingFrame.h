@@ -0,0 +1,40 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputRecordingFrame.generated.h"
+
+/**
+ * @brief The input action values of a character captured during a single frame
+ */
+USTRUCT(BlueprintType)
+struct USK_API FInputRecordingFrame
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The value of the move input action
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	FVector2D Move = FVector2D::ZeroVector;
+
+	/**
+	 * @brief The value of the look around input action
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	FVector2D Look = FVector2D::ZeroVector;
+
+	/**
+	 * @brief The value of the lean input action
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float Lean = 0.0f;
+
+	/**
+	 * @brief The buttons that are pressed during the frame
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark",
+		meta=(Bitmask, BitmaskEnum = "EInputRecordingButton"))
+	uint8 Buttons = 0;
+};
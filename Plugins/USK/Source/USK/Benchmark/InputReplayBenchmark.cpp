@@ -0,0 +1,396 @@
+﻿// Created by Henry Jooste
+
+#include "InputReplayBenchmark.h"
+
+#include "EngineUtils.h"
+#include "JsonObjectConverter.h"
+#include "RenderCore.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Kismet/GameplayStatics.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Console command used to start all the input replay benchmarks in the current world
+ */
+static FAutoConsoleCommandWithWorld StartInputReplayBenchmarksCommand(
+	TEXT("USK.Benchmark.ReplayInput"),
+	TEXT("Start all the input replay benchmarks in the current world"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](const UWorld* World)
+	{
+		for (TActorIterator<AInputReplayBenchmark> It(World); It; ++It)
+		{
+			It->StartBenchmark();
+		}
+	}));
+
+/**
+ * @brief Get a percentile of a sorted array of timings using the nearest rank
+ * @param SortedValues The timings sorted from fastest to slowest
+ * @param Percentile The percentile between 0 and 100
+ * @return The value of the percentile
+ */
+static float GetPercentile(const TArray<float>& SortedValues, const float Percentile)
+{
+	if (SortedValues.Num() == 0)
+	{
+		return 0.0f;
+	}
+
+	const int Rank = FMath::CeilToInt(Percentile / 100.0f * SortedValues.Num());
+	return SortedValues[FMath::Clamp(Rank - 1, 0, SortedValues.Num() - 1)];
+}
+
+/**
+ * @brief Create a new instance of the AInputReplayBenchmark actor
+ */
+AInputReplayBenchmark::AInputReplayBenchmark()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+	PrimaryActorTick.TickGroup = TG_PrePhysics;
+}
+
+/**
+ * @brief Feed the next frame of the recording to the character and record the measurements
+ * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+ */
+void AInputReplayBenchmark::Tick(const float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+	if (!bIsRunning)
+	{
+		return;
+	}
+
+	if (!IsValid(Character) || FrameIndex >= Recording.Frames.Num())
+	{
+		FinishBenchmark();
+		return;
+	}
+
+	// The fixed timestep hides the real frame time from the engine, so the wall clock is measured instead
+	const double CurrentTime = FPlatformTime::Seconds();
+	if (FrameIndex >= WarmupFrames)
+	{
+		FrameTimes.Add((CurrentTime - PreviousFrameTime) * 1000.0);
+		GameThreadTimes.Add(FPlatformTime::ToMilliseconds(GGameThreadTime));
+	}
+
+	PreviousFrameTime = CurrentTime;
+	const FInputRecordingFrame& PreviousFrame = FrameIndex > 0
+		? Recording.Frames[FrameIndex - 1]
+		: FInputRecordingFrame();
+	Character->ApplyRecordedInput(Recording.Frames[FrameIndex], PreviousFrame);
+	FrameIndex++;
+}
+
+/**
+ * @brief Load the recording and start replaying it
+ */
+void AInputReplayBenchmark::StartBenchmark()
+{
+	if (bIsRunning)
+	{
+		USK_LOG_WARNING("Benchmark is already running");
+		return;
+	}
+
+	if (!Recording.LoadFromFile(FInputRecording::GetRecordingPath(RecordingName)) || !PrepareCharacter())
+	{
+		if (bExitWhenFinished)
+		{
+			FPlatformMisc::RequestExitWithStatus(false, 1);
+		}
+
+		return;
+	}
+
+	USK_LOG_INFO(*FString::Format(TEXT("Starting input replay benchmark {0} with {1} frames"),
+		{ ReportName, Recording.Frames.Num() }));
+	Report = FInputReplayBenchmarkReport();
+	FrameTimes.Empty(Recording.Frames.Num());
+	GameThreadTimes.Empty(Recording.Frames.Num());
+	FrameIndex = 0;
+	PreviousFrameTime = FPlatformTime::Seconds();
+	bIsRunning = true;
+
+	bPreviousUseFixedTimestep = FApp::UseFixedTimeStep();
+	PreviousFixedDeltaTime = FApp::GetFixedDeltaTime();
+	if (bUseFixedTimestep)
+	{
+		FApp::SetUseFixedTimeStep(true);
+		FApp::SetFixedDeltaTime(Recording.FixedDeltaTime);
+	}
+
+	SetActorTickEnabled(true);
+}
+
+/**
+ * @brief Check if the benchmark is running
+ * @return A boolean value indicating if the benchmark is running
+ */
+bool AInputReplayBenchmark::IsRunning() const
+{
+	return bIsRunning;
+}
+
+/**
+ * @brief Get the summary of the last benchmark
+ * @return The summary of the last benchmark
+ */
+FInputReplayBenchmarkReport AInputReplayBenchmark::GetReport() const
+{
+	return Report;
+}
+
+/**
+ * @brief Overridable native event for when play begins for this actor
+ */
+void AInputReplayBenchmark::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (FParse::Value(FCommandLine::Get(), TEXT("USKInputReplay="), RecordingName))
+	{
+		FParse::Value(FCommandLine::Get(), TEXT("USKBenchmarkReport="), ReportName);
+		FParse::Value(FCommandLine::Get(), TEXT("USKBenchmarkBaseline="), BaselineFile);
+		bRunOnBeginPlay = true;
+		bExitWhenFinished = true;
+	}
+
+	if (bRunOnBeginPlay)
+	{
+		StartBenchmark();
+	}
+}
+
+/**
+ * @brief Overridable function called whenever this actor is being removed from a level
+ * @param EndPlayReason The reason this actor is being removed
+ */
+void AInputReplayBenchmark::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bIsRunning)
+	{
+		RestoreTimestep();
+		bIsRunning = false;
+	}
+
+	Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * @brief Find or spawn the character driven by the recording
+ * @return A boolean value indicating if a character is available
+ */
+bool AInputReplayBenchmark::PrepareCharacter()
+{
+	if (bSpawnedCharacter && IsValid(Character))
+	{
+		Character->Destroy();
+	}
+
+	bSpawnedCharacter = false;
+	Character = Cast<AUSKCharacter>(UGameplayStatics::GetPlayerPawn(this, 0));
+	if (!IsValid(Character) && IsValid(CharacterClass))
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+		Character = GetWorld()->SpawnActor<AUSKCharacter>(CharacterClass, Recording.StartLocation,
+			FRotator(0.0f, Recording.StartRotation.Yaw, 0.0f), SpawnParams);
+		if (IsValid(Character))
+		{
+			Character->SpawnDefaultController();
+			bSpawnedCharacter = true;
+		}
+	}
+
+	if (!IsValid(Character))
+	{
+		USK_LOG_ERROR("Unable to replay input. No USK character is available");
+		return false;
+	}
+
+	Character->TeleportTo(Recording.StartLocation, FRotator(0.0f, Recording.StartRotation.Yaw, 0.0f), false, true);
+	if (IsValid(Character->GetController()))
+	{
+		Character->GetController()->SetControlRotation(Recording.StartRotation);
+	}
+
+	// The recorded input must be applied before the movement component consumes it
+	Character->GetCharacterMovement()->AddTickPrerequisiteActor(this);
+	return true;
+}
+
+/**
+ * @brief Stop replaying, write the reports and notify the listeners
+ */
+void AInputReplayBenchmark::FinishBenchmark()
+{
+	RestoreTimestep();
+	bIsRunning = false;
+	SetActorTickEnabled(false);
+
+	if (IsValid(Character))
+	{
+		Character->ApplyRecordedInput(FInputRecordingFrame(), Recording.Frames.Num() > 0
+			? Recording.Frames.Last()
+			: FInputRecordingFrame());
+		Character->GetCharacterMovement()->RemoveTickPrerequisiteActor(this);
+		if (bSpawnedCharacter)
+		{
+			if (IsValid(Character->GetController()))
+			{
+				Character->GetController()->Destroy();
+			}
+
+			Character->Destroy();
+		}
+	}
+
+	Character = nullptr;
+	bSpawnedCharacter = false;
+
+	CreateReport();
+	Report.bPassed = CompareToBaseline();
+	WriteReport();
+
+	USK_LOG_INFO(*FString::Format(TEXT("Input replay benchmark {0} finished: {1}"),
+		{ ReportName, Report.bPassed ? TEXT("passed") : TEXT("failed") }));
+	OnBenchmarkFinished.Broadcast(Report);
+
+	if (bExitWhenFinished)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, Report.bPassed ? 0 : 1);
+	}
+}
+
+/**
+ * @brief Restore the timestep used by the engine before the benchmark started
+ */
+void AInputReplayBenchmark::RestoreTimestep() const
+{
+	if (bUseFixedTimestep)
+	{
+		FApp::SetUseFixedTimeStep(bPreviousUseFixedTimestep);
+		FApp::SetFixedDeltaTime(PreviousFixedDeltaTime);
+	}
+}
+
+/**
+ * @brief Summarize the recorded measurements
+ */
+void AInputReplayBenchmark::CreateReport()
+{
+	Report = FInputReplayBenchmarkReport();
+	Report.RecordingName = RecordingName;
+	Report.FrameCount = FrameTimes.Num();
+	if (FrameTimes.Num() == 0)
+	{
+		return;
+	}
+
+	TArray<float> SortedFrameTimes = FrameTimes;
+	TArray<float> SortedGameThreadTimes = GameThreadTimes;
+	SortedFrameTimes.Sort();
+	SortedGameThreadTimes.Sort();
+
+	for (int Index = 0; Index < FrameTimes.Num(); Index++)
+	{
+		Report.AverageFrameTime += FrameTimes[Index];
+		Report.AverageGameThreadTime += GameThreadTimes[Index];
+	}
+
+	Report.AverageFrameTime /= FrameTimes.Num();
+	Report.AverageGameThreadTime /= GameThreadTimes.Num();
+	Report.MedianFrameTime = GetPercentile(SortedFrameTimes, 50.0f);
+	Report.P90FrameTime = GetPercentile(SortedFrameTimes, 90.0f);
+	Report.P99FrameTime = GetPercentile(SortedFrameTimes, 99.0f);
+	Report.MaxFrameTime = SortedFrameTimes.Last();
+	Report.P99GameThreadTime = GetPercentile(SortedGameThreadTimes, 99.0f);
+}
+
+/**
+ * @brief Write the summary and the frame times to the Saved/Benchmarks directory
+ */
+void AInputReplayBenchmark::WriteReport() const
+{
+	const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"));
+
+	FString Json;
+	FJsonObjectConverter::UStructToJsonObjectString(Report, Json);
+	const FString JsonPath = FPaths::Combine(Directory, ReportName + TEXT(".json"));
+	if (!FFileHelper::SaveStringToFile(Json, *JsonPath))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Failed to write benchmark report to {0}"), { JsonPath }));
+	}
+
+	FString Csv = TEXT("Frame,FrameTime,GameThreadTime\n");
+	for (int Index = 0; Index < FrameTimes.Num(); Index++)
+	{
+		Csv += FString::Printf(TEXT("%d,%.4f,%.4f\n"), Index + WarmupFrames, FrameTimes[Index], GameThreadTimes[Index]);
+	}
+
+	const FString CsvPath = FPaths::Combine(Directory, ReportName + TEXT(".csv"));
+	if (!FFileHelper::SaveStringToFile(Csv, *CsvPath))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Failed to write benchmark samples to {0}"), { CsvPath }));
+		return;
+	}
+
+	USK_LOG_INFO(*FString::Format(TEXT("Benchmark report written to {0}"), { JsonPath }));
+}
+
+/**
+ * @brief Compare the summary against the baseline report
+ * @return A boolean value indicating if all timings are within the allowed regression
+ */
+bool AInputReplayBenchmark::CompareToBaseline() const
+{
+	if (BaselineFile.IsEmpty())
+	{
+		return true;
+	}
+
+	const FString BaselinePath = FPaths::Combine(FPaths::ProjectDir(), BaselineFile);
+	FString Json;
+	FInputReplayBenchmarkReport Baseline;
+	if (!FFileHelper::LoadFileToString(Json, *BaselinePath) ||
+		!FJsonObjectConverter::JsonObjectStringToUStruct(Json, &Baseline, 0, 0))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Failed to read benchmark baseline {0}"), { BaselinePath }));
+		return false;
+	}
+
+	bool bPassed = IsWithinBaseline("AverageFrameTime", Report.AverageFrameTime, Baseline.AverageFrameTime);
+	bPassed &= IsWithinBaseline("P90FrameTime", Report.P90FrameTime, Baseline.P90FrameTime);
+	bPassed &= IsWithinBaseline("P99FrameTime", Report.P99FrameTime, Baseline.P99FrameTime);
+	bPassed &= IsWithinBaseline("AverageGameThreadTime", Report.AverageGameThreadTime,
+		Baseline.AverageGameThreadTime);
+	return bPassed;
+}
+
+/**
+ * @brief Check if a timing is within the allowed regression of the baseline
+ * @param Name The name of the timing
+ * @param Value The measured value
+ * @param BaselineValue The value of the baseline
+ * @return A boolean value indicating if the timing is within the allowed regression
+ */
+bool AInputReplayBenchmark::IsWithinBaseline(const FString& Name, const float Value, const float BaselineValue) const
+{
+	if (BaselineValue <= 0.0f || Value <= BaselineValue * (1.0f + MaxRegressionPercent / 100.0f))
+	{
+		return true;
+	}
+
+	USK_LOG_WARNING(*FString::Format(TEXT("{0} regressed from {1} to {2}"), { Name, BaselineValue, Value }));
+	return false;
+}
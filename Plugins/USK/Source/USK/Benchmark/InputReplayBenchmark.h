@@ -0,0 +1,229 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputRecording.h"
+#include "InputReplayBenchmarkReport.h"
+#include "GameFramework/Actor.h"
+#include "USK/Character/USKCharacter.h"
+#include "InputReplayBenchmark.generated.h"
+
+/**
+ * @brief Actor used to replay an input recording at a fixed timestep and measure the frame times
+ */
+UCLASS()
+class USK_API AInputReplayBenchmark : public AActor
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Event used to notify other classes when the benchmark is finished
+	 * @param Report The summary of the benchmark
+	 */
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FInputReplayBenchmarkFinished, const FInputReplayBenchmarkReport&, Report);
+
+public:
+	/**
+	 * @brief The name of the recording in the Saved/Benchmarks/Recordings directory
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	FString RecordingName = "InputRecording";
+
+	/**
+	 * @brief The class of the character spawned when the player isn't controlling a USK character
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	TSubclassOf<AUSKCharacter> CharacterClass;
+
+	/**
+	 * @brief The amount of replayed frames before the measurements start
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup",
+		meta=(ClampMin = "0"))
+	int WarmupFrames = 30;
+
+	/**
+	 * @brief Should the engine run at the fixed timestep of the recording while replaying?
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	bool bUseFixedTimestep = true;
+
+	/**
+	 * @brief Should the benchmark start automatically when the game starts?
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	bool bRunOnBeginPlay;
+
+	/**
+	 * @brief Should the game exit when the benchmark is finished? The exit code is 1 if the benchmark failed
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	bool bExitWhenFinished;
+
+	/**
+	 * @brief The name of the report files written to the Saved/Benchmarks directory
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Report")
+	FString ReportName = "InputReplayBenchmark";
+
+	/**
+	 * @brief The JSON report the results are compared against, relative to the project directory
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Report")
+	FString BaselineFile;
+
+	/**
+	 * @brief The percentage a timing can be slower than the baseline before the benchmark fails
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Report",
+		meta=(ClampMin = "0"))
+	float MaxRegressionPercent = 10.0f;
+
+	/**
+	 * @brief Event used to notify other classes when the benchmark is finished
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Ultimate Starter Kit|Benchmark|Events")
+	FInputReplayBenchmarkFinished OnBenchmarkFinished;
+
+	/**
+	 * @brief Create a new instance of the AInputReplayBenchmark actor
+	 */
+	AInputReplayBenchmark();
+
+	/**
+	 * @brief Feed the next frame of the recording to the character and record the measurements
+	 * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+	 */
+	virtual void Tick(float DeltaSeconds) override;
+
+	/**
+	 * @brief Load the recording and start replaying it
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Benchmark")
+	void StartBenchmark();
+
+	/**
+	 * @brief Check if the benchmark is running
+	 * @return A boolean value indicating if the benchmark is running
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Benchmark")
+	bool IsRunning() const;
+
+	/**
+	 * @brief Get the summary of the last benchmark
+	 * @return The summary of the last benchmark
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Benchmark")
+	FInputReplayBenchmarkReport GetReport() const;
+
+protected:
+	/**
+	 * @brief Overridable native event for when play begins for this actor
+	 */
+	virtual void BeginPlay() override;
+
+	/**
+	 * @brief Overridable function called whenever this actor is being removed from a level
+	 * @param EndPlayReason The reason this actor is being removed
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/**
+	 * @brief The character driven by the recording
+	 */
+	UPROPERTY()
+	AUSKCharacter* Character;
+
+	/**
+	 * @brief Was the character spawned by the benchmark?
+	 */
+	bool bSpawnedCharacter;
+
+	/**
+	 * @brief The recording being replayed
+	 */
+	FInputRecording Recording;
+
+	/**
+	 * @brief The index of the next frame fed to the character
+	 */
+	int FrameIndex;
+
+	/**
+	 * @brief The frame times in milliseconds measured after the warmup
+	 */
+	TArray<float> FrameTimes;
+
+	/**
+	 * @brief The game thread times in milliseconds measured after the warmup
+	 */
+	TArray<float> GameThreadTimes;
+
+	/**
+	 * @brief The real time at which the previous frame started
+	 */
+	double PreviousFrameTime;
+
+	/**
+	 * @brief The summary of the last benchmark
+	 */
+	FInputReplayBenchmarkReport Report;
+
+	/**
+	 * @brief Is the benchmark running?
+	 */
+	bool bIsRunning;
+
+	/**
+	 * @brief Was the engine using a fixed timestep before the benchmark started?
+	 */
+	bool bPreviousUseFixedTimestep;
+
+	/**
+	 * @brief The fixed timestep used by the engine before the benchmark started
+	 */
+	double PreviousFixedDeltaTime;
+
+	/**
+	 * @brief Find or spawn the character driven by the recording
+	 * @return A boolean value indicating if a character is available
+	 */
+	bool PrepareCharacter();
+
+	/**
+	 * @brief Stop replaying, write the reports and notify the listeners
+	 */
+	void FinishBenchmark();
+
+	/**
+	 * @brief Restore the timestep used by the engine before the benchmark started
+	 */
+	void RestoreTimestep() const;
+
+	/**
+	 * @brief Summarize the recorded measurements
+	 */
+	void CreateReport();
+
+	/**
+	 * @brief Write the summary and the frame times to the Saved/Benchmarks directory
+	 */
+	void WriteReport() const;
+
+	/**
+	 * @brief Compare the summary against the baseline report
+	 * @return A boolean value indicating if all timings are within the allowed regression
+	 */
+	bool CompareToBaseline() const;
+
+	/**
+	 * @brief Check if a timing is within the allowed regression of the baseline
+	 * @param Name The name of the timing
+	 * @param Value The measured value
+	 * @param BaselineValue The value of the baseline
+	 * @return A boolean value indicating if the timing is within the allowed regression
+	 */
+	bool IsWithinBaseline(const FString& Name, float Value, float BaselineValue) const;
+};
@@ -0,0 +1,75 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "InputReplayBenchmarkReport.generated.h"
+
+/**
+ * @brief The summary of an input replay benchmark that is written to file and compared against a baseline
+ */
+USTRUCT(BlueprintType)
+struct USK_API FInputReplayBenchmarkReport
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The name of the replayed input recording
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	FString RecordingName;
+
+	/**
+	 * @brief The amount of frames that were measured
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int FrameCount = 0;
+
+	/**
+	 * @brief The average frame time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float AverageFrameTime = 0.0f;
+
+	/**
+	 * @brief The median frame time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float MedianFrameTime = 0.0f;
+
+	/**
+	 * @brief The 90th percentile frame time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float P90FrameTime = 0.0f;
+
+	/**
+	 * @brief The 99th percentile frame time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float P99FrameTime = 0.0f;
+
+	/**
+	 * @brief The longest frame time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float MaxFrameTime = 0.0f;
+
+	/**
+	 * @brief The average game thread time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float AverageGameThreadTime = 0.0f;
+
+	/**
+	 * @brief The 99th percentile game thread time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float P99GameThreadTime = 0.0f;
+
+	/**
+	 * @brief Did the benchmark stay within the allowed regression of the baseline?
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	bool bPassed = true;
+};
@@ -0,0 +1,121 @@
+﻿// Created by Henry Jooste
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "USK/Data/TrackableDataSubsystem.h"
+
+/**
+ * @brief The amount of values and the amount of modifiers added to each value by the benchmark
+ */
+static constexpr int TrackableDataBenchmarkValues = 200;
+static constexpr int TrackableDataBenchmarkModifiersPerValue = 10;
+
+/**
+ * @brief Measure the cost of adding, reading and expiring trackable data modifiers
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FTrackableDataModifierBenchmarkTest, "USK.Benchmark.TrackableDataModifiers",
+	EAutomationTestFlags::EditorContext | EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief Run the trackable data modifier benchmark test
+ * @param Parameters The parameters of the test
+ * @return A boolean value indicating if the test passed
+ */
+bool FTrackableDataModifierBenchmarkTest::RunTest(const FString& Parameters)
+{
+	// An empty game world is used so the simulated time does not affect the modifiers of the game
+	UWorld* World = UWorld::CreateWorld(EWorldType::Game, false);
+	FWorldContext& WorldContext = GEngine->CreateNewWorldContext(EWorldType::Game);
+	WorldContext.SetCurrentWorld(World);
+
+	UTrackableDataSubsystem* Subsystem = World->GetSubsystem<UTrackableDataSubsystem>();
+	if (!TestNotNull(TEXT("The world has a trackable data subsystem"), Subsystem))
+	{
+		GEngine->DestroyWorldContext(World);
+		World->DestroyWorld(false);
+		return false;
+	}
+
+	FTrackableData Data;
+	Data.InitialValue = 100.0f;
+	Data.EnforceMaxValue = true;
+	Data.MaxValue = 100.0f;
+	Data.AutoGenerate = true;
+	Data.GenerateAmount = 5.0f;
+	Data.GenerateDelay = 0.0f;
+	Data.LazyGenerate = false;
+
+	TArray<int> Handles;
+	for (int Index = 0; Index < TrackableDataBenchmarkValues; Index++)
+	{
+		Handles.Add(Subsystem->RegisterValue(nullptr, NAME_None, Data));
+	}
+
+	FRandomStream Random(TrackableDataBenchmarkValues * 31 + TrackableDataBenchmarkModifiersPerValue);
+	double StartTime = FPlatformTime::Seconds();
+	for (const int Handle : Handles)
+	{
+		for (int Index = 0; Index < TrackableDataBenchmarkModifiersPerValue; Index++)
+		{
+			FTrackableDataModifier Modifier;
+			Modifier.Target = Random.FRand() < 0.5f ? ETrackableDataModifierTarget::MaxValue :
+				ETrackableDataModifierTarget::GenerateAmount;
+			Modifier.Type = Random.FRand() < 0.5f ? ETrackableDataModifierType::Flat :
+				ETrackableDataModifierType::Percentage;
+			Modifier.Value = Modifier.Type == ETrackableDataModifierType::Flat ? Random.FRandRange(-10.0f, 10.0f) :
+				Random.FRandRange(-0.2f, 0.2f);
+			Modifier.Duration = Random.FRandRange(1.0f, 60.0f);
+			Subsystem->AddModifier(Handle, Modifier);
+		}
+	}
+
+	const double AddDuration = FPlatformTime::Seconds() - StartTime;
+	const int ModifierCount = Subsystem->GetModifierCount();
+
+	StartTime = FPlatformTime::Seconds();
+	float Total = 0.0f;
+	for (const int Handle : Handles)
+	{
+		Total += Subsystem->GetMaxValue(Handle);
+	}
+
+	const double ReadDuration = FPlatformTime::Seconds() - StartTime;
+
+	// Tick the subsystem using simulated frames of 60 FPS until all the modifiers expired (at most 2 minutes)
+	int FrameCount = 0;
+	double MaxFrameDuration = 0.0;
+	StartTime = FPlatformTime::Seconds();
+	while (Subsystem->GetModifierCount() > 0 && FrameCount < 60 * 120)
+	{
+		FrameCount++;
+		World->TimeSeconds = FrameCount / 60.0;
+		const double FrameStartTime = FPlatformTime::Seconds();
+		Subsystem->Tick(1.0f / 60.0f);
+		MaxFrameDuration = FMath::Max(MaxFrameDuration, FPlatformTime::Seconds() - FrameStartTime);
+	}
+
+	const double TickDuration = FPlatformTime::Seconds() - StartTime;
+	TestEqual(TEXT("All the modifiers expired"), Subsystem->GetModifierCount(), 0);
+
+	for (const int Handle : Handles)
+	{
+		Subsystem->UnregisterValue(Handle);
+	}
+
+	GEngine->DestroyWorldContext(World);
+	World->DestroyWorld(false);
+
+	AddInfo(FString::Printf(TEXT("Trackable data modifiers: %d values, %d modifiers (checksum %.1f)"),
+		TrackableDataBenchmarkValues, ModifierCount, Total));
+	AddInfo(FString::Printf(TEXT("Add %.3f us/modifier, read %.3f us/value, tick %.3f ms over %d frames ")
+		TEXT("(%.3f us/frame, max %.3f us/frame)"), AddDuration * 1000000.0 / FMath::Max(ModifierCount, 1),
+		ReadDuration * 1000000.0 / TrackableDataBenchmarkValues, TickDuration * 1000.0, FrameCount,
+		TickDuration * 1000000.0 / FMath::Max(FrameCount, 1), MaxFrameDuration * 1000000.0));
+	return true;
+}
+
+#endif
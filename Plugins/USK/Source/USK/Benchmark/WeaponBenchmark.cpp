@@ -0,0 +1,526 @@
+﻿// Created by Henry Jooste
+
+#include "WeaponBenchmark.h"
+
+#include "BenchmarkStats.h"
+#include "EngineUtils.h"
+#include "JsonObjectConverter.h"
+#include "RenderCore.h"
+#include "Engine/World.h"
+#include "HAL/IConsoleManager.h"
+#include "HAL/PlatformTime.h"
+#include "Misc/App.h"
+#include "Misc/CommandLine.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "UObject/UObjectGlobals.h"
+#include "USK/Character/USKCharacter.h"
+#include "USK/Logger/Log.h"
+#include "USK/Weapons/Weapon.h"
+#include "USK/Weapons/WeaponProjectileDecalSubsystem.h"
+#include "USK/Weapons/WeaponProjectilePoolSubsystem.h"
+#include "USK/Weapons/WeaponProjectileSimulationSubsystem.h"
+#include "USK/Weapons/WeaponUtils.h"
+
+/**
+ * @brief Console command used to start all the weapon benchmarks in the current world
+ */
+static FAutoConsoleCommandWithWorld StartWeaponBenchmarksCommand(
+	TEXT("USK.Benchmark.Weapons"),
+	TEXT("Start all the weapon benchmarks in the current world"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](const UWorld* World)
+	{
+		for (TActorIterator<AWeaponBenchmark> It(World); It; ++It)
+		{
+			It->StartBenchmark();
+		}
+	}));
+
+/**
+ * @brief Create a new instance of the AWeaponBenchmark actor
+ */
+AWeaponBenchmark::AWeaponBenchmark()
+{
+	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bStartWithTickEnabled = false;
+}
+
+/**
+ * @brief Record the measurements of the current frame
+ * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+ */
+void AWeaponBenchmark::Tick(const float DeltaSeconds)
+{
+	Super::Tick(DeltaSeconds);
+	if (!bIsRunning)
+	{
+		return;
+	}
+
+	ElapsedTime += DeltaSeconds;
+	if (!bIsMeasuring)
+	{
+		if (ElapsedTime >= WarmupTime)
+		{
+			StartMeasuring();
+		}
+
+		return;
+	}
+
+	RecordSample();
+	if (ElapsedTime >= WarmupTime + Duration)
+	{
+		FinishBenchmark();
+	}
+}
+
+/**
+ * @brief Spawn the characters and targets and start firing
+ */
+void AWeaponBenchmark::StartBenchmark()
+{
+	if (bIsRunning)
+	{
+		USK_LOG_WARNING("Benchmark is already running");
+		return;
+	}
+
+	if (!IsValid(CharacterClass) || !IsValid(WeaponClass))
+	{
+		USK_LOG_ERROR("Character class or weapon class is not valid");
+		return;
+	}
+
+	USK_LOG_INFO(*FString::Format(TEXT("Starting weapon benchmark {0}"), { ReportName }));
+	DestroyActors();
+	Samples.Empty();
+	Report = FWeaponBenchmarkReport();
+	ElapsedTime = 0.0f;
+	bIsMeasuring = false;
+	bIsRunning = true;
+
+	SpawnTargets();
+	SpawnCharacters();
+	SetActorTickEnabled(true);
+}
+
+/**
+ * @brief Check if the benchmark is running
+ * @return A boolean value indicating if the benchmark is running
+ */
+bool AWeaponBenchmark::IsRunning() const
+{
+	return bIsRunning;
+}
+
+/**
+ * @brief Get the summary of the last benchmark
+ * @return The summary of the last benchmark
+ */
+FWeaponBenchmarkReport AWeaponBenchmark::GetReport() const
+{
+	return Report;
+}
+
+/**
+ * @brief Overridable native event for when play begins for this actor
+ */
+void AWeaponBenchmark::BeginPlay()
+{
+	Super::BeginPlay();
+
+	if (FParse::Param(FCommandLine::Get(), TEXT("USKWeaponBenchmark")))
+	{
+		bRunOnBeginPlay = true;
+		bExitWhenFinished = true;
+	}
+
+	if (bRunOnBeginPlay)
+	{
+		StartBenchmark();
+	}
+}
+
+/**
+ * @brief Overridable function called whenever this actor is being removed from a level
+ * @param EndPlayReason The reason this actor is being removed
+ */
+void AWeaponBenchmark::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	if (bIsMeasuring)
+	{
+		FBenchmarkStats::bEnabled = false;
+		FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+		FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	}
+
+	bIsRunning = false;
+	bIsMeasuring = false;
+	Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * @brief Spawn the characters and equip their weapons
+ */
+void AWeaponBenchmark::SpawnCharacters()
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+
+	const float RowOffset = (CharacterCount - 1) * CharacterSpacing * 0.5f;
+	for (int Index = 0; Index < CharacterCount; Index++)
+	{
+		const FVector Location = GetActorLocation() +
+			GetActorRightVector() * (Index * CharacterSpacing - RowOffset);
+		AUSKCharacter* Character = GetWorld()->SpawnActor<AUSKCharacter>(CharacterClass, Location,
+			GetActorRotation(), SpawnParams);
+		if (!IsValid(Character))
+		{
+			USK_LOG_ERROR("Failed to spawn benchmark character");
+			continue;
+		}
+
+		Character->SpawnDefaultController();
+		UWeaponUtils::EquipWeapon(Character, WeaponClass);
+		Characters.Add(Character);
+
+		AWeapon* Weapon = Character->GetWeapon();
+		if (!IsValid(Weapon))
+		{
+			USK_LOG_ERROR("Failed to equip benchmark weapon");
+			continue;
+		}
+
+		Weapon->WeaponFireMode = EWeaponFireMode::FullAuto;
+		Weapon->bInfiniteAmmo = true;
+		Weapon->StartFiring();
+	}
+
+	USK_LOG_INFO(*FString::Format(TEXT("Spawned {0} benchmark characters"), { Characters.Num() }));
+}
+
+/**
+ * @brief Spawn a target in front of each character
+ */
+void AWeaponBenchmark::SpawnTargets()
+{
+	if (!IsValid(TargetClass))
+	{
+		return;
+	}
+
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+
+	const float RowOffset = (CharacterCount - 1) * CharacterSpacing * 0.5f;
+	for (int Index = 0; Index < CharacterCount; Index++)
+	{
+		const FVector Location = GetActorLocation() + GetActorForwardVector() * TargetDistance +
+			GetActorRightVector() * (Index * CharacterSpacing - RowOffset);
+		AActor* Target = GetWorld()->SpawnActor<AActor>(TargetClass, Location,
+			(-GetActorForwardVector()).Rotation(), SpawnParams);
+		if (IsValid(Target))
+		{
+			Targets.Add(Target);
+		}
+	}
+}
+
+/**
+ * @brief Start recording the measurements after the warmup
+ */
+void AWeaponBenchmark::StartMeasuring()
+{
+	USK_LOG_INFO("Warmup completed. Recording measurements");
+	bIsMeasuring = true;
+	InitialShotsFired = GetShotsFired();
+	InitialProjectileActorsSpawned = GetProjectileActorsSpawned();
+	GarbageCollectionCount = 0;
+	GarbageCollectionTime = 0.0;
+	Samples.Reserve(FMath::CeilToInt(Duration * 120.0f));
+
+	FBenchmarkStats::Reset();
+	FBenchmarkStats::bEnabled = true;
+	PreGarbageCollectHandle = FCoreUObjectDelegates::GetPreGarbageCollectDelegate().AddUObject(
+		this, &AWeaponBenchmark::OnPreGarbageCollect);
+	PostGarbageCollectHandle = FCoreUObjectDelegates::GetPostGarbageCollect().AddUObject(
+		this, &AWeaponBenchmark::OnPostGarbageCollect);
+}
+
+/**
+ * @brief Record the measurements of the current frame
+ */
+void AWeaponBenchmark::RecordSample()
+{
+	FWeaponBenchmarkSample Sample;
+	Sample.Time = ElapsedTime - WarmupTime;
+	Sample.FrameTime = FApp::GetDeltaTime() * 1000.0f;
+	Sample.GameThreadTime = FPlatformTime::ToMilliseconds(GGameThreadTime);
+	Sample.SpawnProjectileTime = FBenchmarkStats::SpawnProjectileTime * 1000.0;
+	Sample.ProjectileHitTime = FBenchmarkStats::ProjectileHitTime * 1000.0;
+	Sample.ShotsFired = GetShotsFired() - InitialShotsFired;
+	Sample.ProjectileActorsSpawned = GetProjectileActorsSpawned() - InitialProjectileActorsSpawned;
+
+	const UWeaponProjectilePoolSubsystem* ProjectilePool = GetWorld()->GetSubsystem<UWeaponProjectilePoolSubsystem>();
+	if (IsValid(ProjectilePool))
+	{
+		Sample.ActiveProjectiles = ProjectilePool->GetTotalStats().Active;
+	}
+
+	const UWeaponProjectileSimulationSubsystem* ProjectileSimulation =
+		GetWorld()->GetSubsystem<UWeaponProjectileSimulationSubsystem>();
+	if (IsValid(ProjectileSimulation))
+	{
+		Sample.LightweightProjectiles = ProjectileSimulation->GetProjectileCount();
+	}
+
+	const UWeaponProjectileDecalSubsystem* DecalSubsystem = GetWorld()->GetSubsystem<UWeaponProjectileDecalSubsystem>();
+	if (IsValid(DecalSubsystem))
+	{
+		Sample.ActiveDecals = DecalSubsystem->GetActiveDecalCount();
+	}
+
+	FBenchmarkStats::SpawnProjectileTime = 0.0;
+	FBenchmarkStats::ProjectileHitTime = 0.0;
+	Samples.Add(Sample);
+}
+
+/**
+ * @brief Stop firing, write the reports and notify the listeners
+ */
+void AWeaponBenchmark::FinishBenchmark()
+{
+	FBenchmarkStats::bEnabled = false;
+	FCoreUObjectDelegates::GetPreGarbageCollectDelegate().Remove(PreGarbageCollectHandle);
+	FCoreUObjectDelegates::GetPostGarbageCollect().Remove(PostGarbageCollectHandle);
+	bIsMeasuring = false;
+	bIsRunning = false;
+	SetActorTickEnabled(false);
+
+	CreateReport();
+	Report.bPassed = CompareToBaseline();
+	WriteReport();
+	DestroyActors();
+
+	USK_LOG_INFO(*FString::Format(TEXT("Weapon benchmark {0} finished: {1}"),
+		{ ReportName, Report.bPassed ? TEXT("passed") : TEXT("failed") }));
+	OnBenchmarkFinished.Broadcast(Report);
+
+	if (bExitWhenFinished)
+	{
+		FPlatformMisc::RequestExitWithStatus(false, Report.bPassed ? 0 : 1);
+	}
+}
+
+/**
+ * @brief Destroy the characters and targets spawned for the benchmark
+ */
+void AWeaponBenchmark::DestroyActors()
+{
+	for (AUSKCharacter* Character : Characters)
+	{
+		if (!IsValid(Character))
+		{
+			continue;
+		}
+
+		AWeapon* Weapon = Character->GetWeapon();
+		if (IsValid(Weapon))
+		{
+			Weapon->StopFiring();
+		}
+
+		if (IsValid(Character->GetController()))
+		{
+			Character->GetController()->Destroy();
+		}
+
+		Character->Destroy();
+	}
+
+	for (AActor* Target : Targets)
+	{
+		if (IsValid(Target))
+		{
+			Target->Destroy();
+		}
+	}
+
+	Characters.Empty();
+	Targets.Empty();
+}
+
+/**
+ * @brief Summarize the recorded measurements
+ */
+void AWeaponBenchmark::CreateReport()
+{
+	const int SpawnProjectileCalls = FBenchmarkStats::SpawnProjectileCalls;
+	const int ProjectileHitCalls = FBenchmarkStats::ProjectileHitCalls;
+	Report = FWeaponBenchmarkReport();
+	Report.CharacterCount = Characters.Num();
+	Report.FrameCount = Samples.Num();
+	Report.GarbageCollectionCount = GarbageCollectionCount;
+	Report.GarbageCollectionTime = GarbageCollectionTime * 1000.0;
+	if (Samples.Num() == 0)
+	{
+		return;
+	}
+
+	float SpawnProjectileTime = 0.0f;
+	float ProjectileHitTime = 0.0f;
+	for (const FWeaponBenchmarkSample& Sample : Samples)
+	{
+		Report.AverageFrameTime += Sample.FrameTime;
+		Report.MaxFrameTime = FMath::Max(Report.MaxFrameTime, Sample.FrameTime);
+		Report.AverageGameThreadTime += Sample.GameThreadTime;
+		Report.MaxActiveProjectiles = FMath::Max(Report.MaxActiveProjectiles,
+			Sample.ActiveProjectiles + Sample.LightweightProjectiles);
+		Report.MaxActiveDecals = FMath::Max(Report.MaxActiveDecals, Sample.ActiveDecals);
+		SpawnProjectileTime += Sample.SpawnProjectileTime;
+		ProjectileHitTime += Sample.ProjectileHitTime;
+	}
+
+	Report.AverageFrameTime /= Samples.Num();
+	Report.AverageGameThreadTime /= Samples.Num();
+	Report.AverageSpawnProjectileTime = SpawnProjectileCalls > 0 ?
+		SpawnProjectileTime * 1000.0f / SpawnProjectileCalls : 0.0f;
+	Report.AverageProjectileHitTime = ProjectileHitCalls > 0 ? ProjectileHitTime * 1000.0f / ProjectileHitCalls : 0.0f;
+	Report.ShotsFired = Samples.Last().ShotsFired;
+	Report.ProjectileActorsSpawned = Samples.Last().ProjectileActorsSpawned;
+}
+
+/**
+ * @brief Write the summary and the measurements of each frame to the Saved/Benchmarks directory
+ */
+void AWeaponBenchmark::WriteReport() const
+{
+	const FString Directory = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"));
+
+	FString Json;
+	FJsonObjectConverter::UStructToJsonObjectString(Report, Json);
+	const FString JsonPath = FPaths::Combine(Directory, ReportName + TEXT(".json"));
+	if (!FFileHelper::SaveStringToFile(Json, *JsonPath))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Failed to write benchmark report to {0}"), { JsonPath }));
+	}
+
+	FString Csv = TEXT("Time,FrameTime,GameThreadTime,SpawnProjectileTime,ProjectileHitTime,ActiveProjectiles,")
+		TEXT("LightweightProjectiles,ActiveDecals,ShotsFired,ProjectileActorsSpawned\n");
+	for (const FWeaponBenchmarkSample& Sample : Samples)
+	{
+		Csv += FString::Printf(TEXT("%.4f,%.4f,%.4f,%.4f,%.4f,%d,%d,%d,%d,%d\n"), Sample.Time, Sample.FrameTime,
+			Sample.GameThreadTime, Sample.SpawnProjectileTime, Sample.ProjectileHitTime, Sample.ActiveProjectiles,
+			Sample.LightweightProjectiles, Sample.ActiveDecals, Sample.ShotsFired, Sample.ProjectileActorsSpawned);
+	}
+
+	const FString CsvPath = FPaths::Combine(Directory, ReportName + TEXT(".csv"));
+	if (!FFileHelper::SaveStringToFile(Csv, *CsvPath))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Failed to write benchmark samples to {0}"), { CsvPath }));
+		return;
+	}
+
+	USK_LOG_INFO(*FString::Format(TEXT("Benchmark report written to {0}"), { JsonPath }));
+}
+
+/**
+ * @brief Compare the summary against the baseline report
+ * @return A boolean value indicating if all timings are within the allowed regression
+ */
+bool AWeaponBenchmark::CompareToBaseline() const
+{
+	// Without a baseline a regression can't be detected, so the benchmark fails instead of passing silently
+	if (BaselineFile.IsEmpty())
+	{
+		USK_LOG_ERROR("Benchmark baseline is not set");
+		return false;
+	}
+
+	const FString BaselinePath = FPaths::Combine(FPaths::ProjectDir(), BaselineFile);
+	FString Json;
+	FWeaponBenchmarkReport Baseline;
+	if (!FFileHelper::LoadFileToString(Json, *BaselinePath) ||
+		!FJsonObjectConverter::JsonObjectStringToUStruct(Json, &Baseline, 0, 0))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Failed to read benchmark baseline {0}. Copy a report from ")
+			TEXT("Saved/Benchmarks to create it"), { BaselinePath }));
+		return false;
+	}
+
+	bool bPassed = IsWithinBaseline("AverageFrameTime", Report.AverageFrameTime, Baseline.AverageFrameTime);
+	bPassed &= IsWithinBaseline("AverageGameThreadTime", Report.AverageGameThreadTime,
+		Baseline.AverageGameThreadTime);
+	bPassed &= IsWithinBaseline("AverageSpawnProjectileTime", Report.AverageSpawnProjectileTime,
+		Baseline.AverageSpawnProjectileTime);
+	bPassed &= IsWithinBaseline("AverageProjectileHitTime", Report.AverageProjectileHitTime,
+		Baseline.AverageProjectileHitTime);
+	bPassed &= IsWithinBaseline("GarbageCollectionTime", Report.GarbageCollectionTime,
+		Baseline.GarbageCollectionTime);
+	return bPassed;
+}
+
+/**
+ * @brief Check if a timing is within the allowed regression of the baseline
+ * @param Name The name of the timing
+ * @param Value The measured value
+ * @param BaselineValue The value of the baseline
+ * @return A boolean value indicating if the timing is within the allowed regression
+ */
+bool AWeaponBenchmark::IsWithinBaseline(const FString& Name, const float Value, const float BaselineValue) const
+{
+	if (BaselineValue <= 0.0f || Value <= BaselineValue * (1.0f + MaxRegressionPercent / 100.0f))
+	{
+		return true;
+	}
+
+	USK_LOG_WARNING(*FString::Format(TEXT("{0} regressed from {1} to {2}"), { Name, BaselineValue, Value }));
+	return false;
+}
+
+/**
+ * @brief Get the total amount of shots fired by the characters
+ * @return The total amount of shots fired
+ */
+int AWeaponBenchmark::GetShotsFired() const
+{
+	int ShotsFired = 0;
+	for (const AUSKCharacter* Character : Characters)
+	{
+		const AWeapon* Weapon = IsValid(Character) ? Character->GetWeapon() : nullptr;
+		if (IsValid(Weapon))
+		{
+			ShotsFired += Weapon->GetShotsFired();
+		}
+	}
+
+	return ShotsFired;
+}
+
+/**
+ * @brief Get the total amount of projectile actors spawned because the projectile pool was empty
+ * @return The total amount of projectile actors spawned
+ */
+int AWeaponBenchmark::GetProjectileActorsSpawned() const
+{
+	const UWeaponProjectilePoolSubsystem* ProjectilePool = GetWorld()->GetSubsystem<UWeaponProjectilePoolSubsystem>();
+	return IsValid(ProjectilePool) ? ProjectilePool->GetTotalStats().Misses : 0;
+}
+
+/**
+ * @brief Called before garbage is collected
+ */
+void AWeaponBenchmark::OnPreGarbageCollect()
+{
+	GarbageCollectionStartTime = FPlatformTime::Seconds();
+}
+
+/**
+ * @brief Called after garbage is collected
+ */
+void AWeaponBenchmark::OnPostGarbageCollect()
+{
+	GarbageCollectionCount++;
+	GarbageCollectionTime += FPlatformTime::Seconds() - GarbageCollectionStartTime;
+}
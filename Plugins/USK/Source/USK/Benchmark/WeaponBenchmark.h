@@ -0,0 +1,306 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponBenchmarkReport.h"
+#include "WeaponBenchmarkSample.h"
+#include "GameFramework/Actor.h"
+#include "USK/Character/USKCharacter.h"
+#include "USK/Weapons/Weapon.h"
+#include "WeaponBenchmark.generated.h"
+
+/**
+ * @brief Actor used to measure the throughput of weapons, projectiles and decals without any player input
+ */
+UCLASS()
+class USK_API AWeaponBenchmark : public AActor
+{
+	GENERATED_BODY()
+
+	/**
+	 * @brief Event used to notify other classes when the benchmark is finished
+	 * @param Report The summary of the benchmark
+	 */
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FWeaponBenchmarkFinished, const FWeaponBenchmarkReport&, Report);
+
+public:
+	/**
+	 * @brief The class of the characters spawned to fire the weapons
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	TSubclassOf<AUSKCharacter> CharacterClass;
+
+	/**
+	 * @brief The class of the weapon equipped by each character
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	TSubclassOf<AWeapon> WeaponClass;
+
+	/**
+	 * @brief The amount of characters firing at the same time
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup",
+		meta=(ClampMin = "1"))
+	int CharacterCount = 8;
+
+	/**
+	 * @brief The distance between the characters
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	float CharacterSpacing = 150.0f;
+
+	/**
+	 * @brief The class of the targets placed in front of the characters. Leave empty to fire at the level geometry
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	TSubclassOf<AActor> TargetClass;
+
+	/**
+	 * @brief The distance between the characters and the targets
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	float TargetDistance = 2000.0f;
+
+	/**
+	 * @brief The amount of seconds the weapons fire before the measurements start
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	float WarmupTime = 2.0f;
+
+	/**
+	 * @brief The amount of seconds the measurements are recorded
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	float Duration = 10.0f;
+
+	/**
+	 * @brief Should the benchmark start automatically when the game starts?
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	bool bRunOnBeginPlay;
+
+	/**
+	 * @brief Should the game exit when the benchmark is finished? The exit code is 1 if the benchmark failed
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Setup")
+	bool bExitWhenFinished;
+
+	/**
+	 * @brief The name of the report files written to the Saved/Benchmarks directory
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Report")
+	FString ReportName = "WeaponBenchmark";
+
+	/**
+	 * @brief The JSON report the results are compared against, relative to the project directory (required)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Report")
+	FString BaselineFile = "Benchmarks/WeaponBenchmark.json";
+
+	/**
+	 * @brief The percentage a timing can be slower than the baseline before the benchmark fails
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Benchmark|Report",
+		meta=(ClampMin = "0"))
+	float MaxRegressionPercent = 10.0f;
+
+	/**
+	 * @brief Event used to notify other classes when the benchmark is finished
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Ultimate Starter Kit|Benchmark|Events")
+	FWeaponBenchmarkFinished OnBenchmarkFinished;
+
+	/**
+	 * @brief Create a new instance of the AWeaponBenchmark actor
+	 */
+	AWeaponBenchmark();
+
+	/**
+	 * @brief Record the measurements of the current frame
+	 * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+	 */
+	virtual void Tick(float DeltaSeconds) override;
+
+	/**
+	 * @brief Spawn the characters and targets and start firing
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Benchmark")
+	void StartBenchmark();
+
+	/**
+	 * @brief Check if the benchmark is running
+	 * @return A boolean value indicating if the benchmark is running
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Benchmark")
+	bool IsRunning() const;
+
+	/**
+	 * @brief Get the summary of the last benchmark
+	 * @return The summary of the last benchmark
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Benchmark")
+	FWeaponBenchmarkReport GetReport() const;
+
+protected:
+	/**
+	 * @brief Overridable native event for when play begins for this actor
+	 */
+	virtual void BeginPlay() override;
+
+	/**
+	 * @brief Overridable function called whenever this actor is being removed from a level
+	 * @param EndPlayReason The reason this actor is being removed
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/**
+	 * @brief The characters spawned for the benchmark
+	 */
+	UPROPERTY()
+	TArray<AUSKCharacter*> Characters;
+
+	/**
+	 * @brief The targets spawned for the benchmark
+	 */
+	UPROPERTY()
+	TArray<AActor*> Targets;
+
+	/**
+	 * @brief The measurements of each frame
+	 */
+	TArray<FWeaponBenchmarkSample> Samples;
+
+	/**
+	 * @brief The summary of the last benchmark
+	 */
+	FWeaponBenchmarkReport Report;
+
+	/**
+	 * @brief Is the benchmark running?
+	 */
+	bool bIsRunning;
+
+	/**
+	 * @brief Are the measurements being recorded?
+	 */
+	bool bIsMeasuring;
+
+	/**
+	 * @brief The amount of seconds since the benchmark started
+	 */
+	float ElapsedTime;
+
+	/**
+	 * @brief The amount of projectile actors spawned before the measurements started
+	 */
+	int InitialProjectileActorsSpawned;
+
+	/**
+	 * @brief The amount of shots fired before the measurements started
+	 */
+	int InitialShotsFired;
+
+	/**
+	 * @brief The amount of times garbage was collected since the measurements started
+	 */
+	int GarbageCollectionCount;
+
+	/**
+	 * @brief The amount of seconds spent collecting garbage since the measurements started
+	 */
+	double GarbageCollectionTime;
+
+	/**
+	 * @brief The time at which the current garbage collection started
+	 */
+	double GarbageCollectionStartTime;
+
+	/**
+	 * @brief The handle of the delegate called before garbage is collected
+	 */
+	FDelegateHandle PreGarbageCollectHandle;
+
+	/**
+	 * @brief The handle of the delegate called after garbage is collected
+	 */
+	FDelegateHandle PostGarbageCollectHandle;
+
+	/**
+	 * @brief Spawn the characters and equip their weapons
+	 */
+	void SpawnCharacters();
+
+	/**
+	 * @brief Spawn a target in front of each character
+	 */
+	void SpawnTargets();
+
+	/**
+	 * @brief Start recording the measurements after the warmup
+	 */
+	void StartMeasuring();
+
+	/**
+	 * @brief Record the measurements of the current frame
+	 */
+	void RecordSample();
+
+	/**
+	 * @brief Stop firing, write the reports and notify the listeners
+	 */
+	void FinishBenchmark();
+
+	/**
+	 * @brief Destroy the characters and targets spawned for the benchmark
+	 */
+	void DestroyActors();
+
+	/**
+	 * @brief Summarize the recorded measurements
+	 */
+	void CreateReport();
+
+	/**
+	 * @brief Write the summary and the measurements of each frame to the Saved/Benchmarks directory
+	 */
+	void WriteReport() const;
+
+	/**
+	 * @brief Compare the summary against the baseline report
+	 * @return A boolean value indicating if all timings are within the allowed regression
+	 */
+	bool CompareToBaseline() const;
+
+	/**
+	 * @brief Check if a timing is within the allowed regression of the baseline
+	 * @param Name The name of the timing
+	 * @param Value The measured value
+	 * @param BaselineValue The value of the baseline
+	 * @return A boolean value indicating if the timing is within the allowed regression
+	 */
+	bool IsWithinBaseline(const FString& Name, float Value, float BaselineValue) const;
+
+	/**
+	 * @brief Get the total amount of shots fired by the characters
+	 * @return The total amount of shots fired
+	 */
+	int GetShotsFired() const;
+
+	/**
+	 * @brief Get the total amount of projectile actors spawned because the projectile pool was empty
+	 * @return The total amount of projectile actors spawned
+	 */
+	int GetProjectileActorsSpawned() const;
+
+	/**
+	 * @brief Called before garbage is collected
+	 */
+	void OnPreGarbageCollect();
+
+	/**
+	 * @brief Called after garbage is collected
+	 */
+	void OnPostGarbageCollect();
+};
@@ -0,0 +1,99 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponBenchmarkReport.generated.h"
+
+/**
+ * @brief The summary of a weapon benchmark that is written to file and compared against a baseline
+ */
+USTRUCT(BlueprintType)
+struct USK_API FWeaponBenchmarkReport
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The amount of characters that were firing
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int CharacterCount = 0;
+
+	/**
+	 * @brief The amount of frames that were measured
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int FrameCount = 0;
+
+	/**
+	 * @brief The average frame time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float AverageFrameTime = 0.0f;
+
+	/**
+	 * @brief The longest frame time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float MaxFrameTime = 0.0f;
+
+	/**
+	 * @brief The average game thread time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float AverageGameThreadTime = 0.0f;
+
+	/**
+	 * @brief The average amount of microseconds spent spawning a single projectile
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float AverageSpawnProjectileTime = 0.0f;
+
+	/**
+	 * @brief The average amount of microseconds spent processing a single projectile hit
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float AverageProjectileHitTime = 0.0f;
+
+	/**
+	 * @brief The largest amount of projectiles in flight at the same time
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int MaxActiveProjectiles = 0;
+
+	/**
+	 * @brief The largest amount of projectile decals drawn at the same time
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int MaxActiveDecals = 0;
+
+	/**
+	 * @brief The total amount of shots fired
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int ShotsFired = 0;
+
+	/**
+	 * @brief The total amount of projectile actors spawned
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int ProjectileActorsSpawned = 0;
+
+	/**
+	 * @brief The amount of times garbage was collected
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int GarbageCollectionCount = 0;
+
+	/**
+	 * @brief The total amount of milliseconds spent collecting garbage
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float GarbageCollectionTime = 0.0f;
+
+	/**
+	 * @brief Did the benchmark stay within the allowed regression of the baseline?
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	bool bPassed = true;
+};
@@ -0,0 +1,75 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponBenchmarkSample.generated.h"
+
+/**
+ * @brief The measurements of a single frame of a weapon benchmark
+ */
+USTRUCT(BlueprintType)
+struct USK_API FWeaponBenchmarkSample
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The amount of seconds since the measurements started
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float Time = 0.0f;
+
+	/**
+	 * @brief The frame time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float FrameTime = 0.0f;
+
+	/**
+	 * @brief The game thread time in milliseconds
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float GameThreadTime = 0.0f;
+
+	/**
+	 * @brief The milliseconds spent spawning projectiles during the frame
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float SpawnProjectileTime = 0.0f;
+
+	/**
+	 * @brief The milliseconds spent processing projectile hits during the frame
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	float ProjectileHitTime = 0.0f;
+
+	/**
+	 * @brief The amount of projectile actors in flight
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int ActiveProjectiles = 0;
+
+	/**
+	 * @brief The amount of lightweight projectiles in flight
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int LightweightProjectiles = 0;
+
+	/**
+	 * @brief The amount of projectile decals drawn
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int ActiveDecals = 0;
+
+	/**
+	 * @brief The amount of shots fired since the measurements started
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int ShotsFired = 0;
+
+	/**
+	 * @brief The amount of projectile actors spawned since the measurements started
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Benchmark")
+	int ProjectileActorsSpawned = 0;
+};
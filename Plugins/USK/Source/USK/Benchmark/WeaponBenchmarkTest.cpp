@@ -0,0 +1,151 @@
+﻿// Created by Henry Jooste
+
+#include "WeaponBenchmark.h"
+
+#include "Misc/AutomationTest.h"
+
+#if WITH_DEV_AUTOMATION_TESTS
+
+#include "Engine/World.h"
+#include "Tests/AutomationCommon.h"
+#include "USK/Character/USKCharacter.h"
+#include "USK/Weapons/Weapon.h"
+
+/**
+ * @brief The map, character and weapon of the FPS demo used by the weapon benchmark test
+ */
+static const TCHAR* WeaponBenchmarkTestMap = TEXT("/Game/Demos/FPS/FPS");
+static const TCHAR* WeaponBenchmarkTestCharacter =
+	TEXT("/Game/Demos/FPS/Blueprints/Player/BP_FpsPlayer.BP_FpsPlayer_C");
+static const TCHAR* WeaponBenchmarkTestWeapon =
+	TEXT("/Game/Demos/FPS/Blueprints/Weapons/BP_FpsWeapon.BP_FpsWeapon_C");
+
+/**
+ * @brief The amount of seconds the benchmark can run longer than its warmup and duration before the test fails
+ */
+static constexpr float WeaponBenchmarkTestTimeout = 60.0f;
+
+/**
+ * @brief Latent command used to run a weapon benchmark in the game world and check its report
+ */
+class FRunWeaponBenchmarkCommand : public IAutomationLatentCommand
+{
+public:
+	/**
+	 * @brief Create a new instance of the FRunWeaponBenchmarkCommand
+	 * @param InTest The test that receives the results of the benchmark
+	 */
+	explicit FRunWeaponBenchmarkCommand(FAutomationTestBase* InTest) : Test(InTest)
+	{
+	}
+
+	/**
+	 * @brief Start the benchmark and wait for it to finish
+	 * @return A boolean value indicating if the command is finished
+	 */
+	virtual bool Update() override
+	{
+		if (!bStarted)
+		{
+			bStarted = true;
+			return !StartBenchmark();
+		}
+
+		if (!Benchmark.IsValid())
+		{
+			Test->AddError(TEXT("The weapon benchmark was destroyed before it finished"));
+			return true;
+		}
+
+		if (Benchmark->IsRunning())
+		{
+			if (GetCurrentRunTime() <= Benchmark->WarmupTime + Benchmark->Duration + WeaponBenchmarkTestTimeout)
+			{
+				return false;
+			}
+
+			Test->AddError(TEXT("The weapon benchmark did not finish in time"));
+			Benchmark->Destroy();
+			return true;
+		}
+
+		const FWeaponBenchmarkReport Report = Benchmark->GetReport();
+		Test->TestTrue(TEXT("The characters fired their weapons"), Report.ShotsFired > 0);
+		Test->TestTrue(TEXT("The timings are within the allowed regression of the baseline"), Report.bPassed);
+		Benchmark->Destroy();
+		return true;
+	}
+
+private:
+	/**
+	 * @brief The test that receives the results of the benchmark
+	 */
+	FAutomationTestBase* Test;
+
+	/**
+	 * @brief The benchmark spawned by the command
+	 */
+	TWeakObjectPtr<AWeaponBenchmark> Benchmark;
+
+	/**
+	 * @brief Was the benchmark started?
+	 */
+	bool bStarted = false;
+
+	/**
+	 * @brief Spawn the benchmark in the game world and start it
+	 * @return A boolean value indicating if the benchmark was started
+	 */
+	bool StartBenchmark()
+	{
+		UWorld* World = AutomationCommon::GetAnyGameWorld();
+		if (World == nullptr)
+		{
+			Test->AddError(TEXT("There is no game world to run the weapon benchmark in"));
+			return false;
+		}
+
+		const TSubclassOf<AUSKCharacter> CharacterClass = LoadClass<AUSKCharacter>(nullptr,
+			WeaponBenchmarkTestCharacter);
+		const TSubclassOf<AWeapon> WeaponClass = LoadClass<AWeapon>(nullptr, WeaponBenchmarkTestWeapon);
+		if (!IsValid(CharacterClass) || !IsValid(WeaponClass))
+		{
+			Test->AddError(TEXT("Failed to load the character or weapon used by the weapon benchmark"));
+			return false;
+		}
+
+		AWeaponBenchmark* NewBenchmark = World->SpawnActor<AWeaponBenchmark>();
+		if (!IsValid(NewBenchmark))
+		{
+			Test->AddError(TEXT("Failed to spawn the weapon benchmark"));
+			return false;
+		}
+
+		NewBenchmark->CharacterClass = CharacterClass;
+		NewBenchmark->WeaponClass = WeaponClass;
+		NewBenchmark->ReportName = TEXT("WeaponBenchmarkTest");
+		NewBenchmark->StartBenchmark();
+		Benchmark = NewBenchmark;
+		return NewBenchmark->IsRunning();
+	}
+};
+
+/**
+ * @brief Fire the weapons of the FPS demo at full auto and compare the timings against the committed baseline
+ */
+IMPLEMENT_SIMPLE_AUTOMATION_TEST(FWeaponBenchmarkTest, "USK.Benchmark.Weapons",
+	EAutomationTestFlags::ClientContext | EAutomationTestFlags::PerfFilter)
+
+/**
+ * @brief Run the weapon benchmark test
+ * @param Parameters The parameters of the test
+ * @return A boolean value indicating if the test was started
+ */
+bool FWeaponBenchmarkTest::RunTest(const FString& Parameters)
+{
+	AutomationOpenMap(WeaponBenchmarkTestMap);
+	ADD_LATENT_AUTOMATION_COMMAND(FRunWeaponBenchmarkCommand(this));
+	return true;
+}
+
+#endif
@@ -0,0 +1,39 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CharacterSignificanceBucket.generated.h"
+
+/**
+ * @brief The update rates used by characters that are assigned to a significance bucket
+ */
+USTRUCT(BlueprintType)
+struct USK_API FCharacterSignificanceBucket
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The maximum distance between the character and the closest viewer for the character to use this bucket
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Character|Significance")
+	float MaxDistance = 0.0f;
+
+	/**
+	 * @brief The amount of seconds between ticks of the character and its weapon (0 = every frame)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Character|Significance")
+	float TickInterval = 0.0f;
+
+	/**
+	 * @brief The amount of seconds between animation updates of the character mesh (0 = every frame)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Character|Significance")
+	float AnimationTickInterval = 0.0f;
+
+	/**
+	 * @brief Should cosmetic work like lean interpolation and the shadow decal be skipped?
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Character|Significance")
+	bool bSkipCosmetics = false;
+};
@@ -0,0 +1,36 @@
+﻿// Created by Henry Jooste
+
+#include "CharacterSignificanceConfig.h"
+
+/**
+ * @brief Get the bucket used by a character
+ * @param Distance The distance between the character and the closest viewer
+ * @param bRendered Was the character rendered recently?
+ * @param bPlayerControlled Is the character controlled by a player?
+ * @return The index of the bucket used by the character or -1 if there are no buckets
+ */
+int UCharacterSignificanceConfig::GetBucketIndex(const float Distance, const bool bRendered,
+	const bool bPlayerControlled) const
+{
+	if (Buckets.Num() == 0)
+	{
+		return -1;
+	}
+
+	if (bPlayerControlled && bPlayerControlledAlwaysSignificant)
+	{
+		return 0;
+	}
+
+	int BucketIndex = Buckets.Num() - 1;
+	for (int Index = 0; Index < Buckets.Num() - 1; Index++)
+	{
+		if (Distance <= Buckets[Index].MaxDistance)
+		{
+			BucketIndex = Index;
+			break;
+		}
+	}
+
+	return bRendered ? BucketIndex : FMath::Min(BucketIndex + NotRenderedBucketOffset, Buckets.Num() - 1);
+}
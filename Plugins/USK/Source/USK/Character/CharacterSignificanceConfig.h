@@ -0,0 +1,54 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CharacterSignificanceBucket.h"
+#include "Engine/DataAsset.h"
+#include "CharacterSignificanceConfig.generated.h"
+
+/**
+ * @brief The significance buckets used to reduce the update rates of characters far away from the viewers
+ */
+UCLASS(BlueprintType)
+class USK_API UCharacterSignificanceConfig : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief The buckets ordered from most to least significant. The last bucket is used beyond all the distances
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character Significance")
+	TArray<FCharacterSignificanceBucket> Buckets;
+
+	/**
+	 * @brief The amount of buckets a character is moved down when it was not rendered recently
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character Significance",
+		meta=(ClampMin = "0"))
+	int NotRenderedBucketOffset = 1;
+
+	/**
+	 * @brief The amount of seconds since the character was last rendered before it is treated as not rendered
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character Significance",
+		meta=(ClampMin = "0"))
+	float RenderedTimeTolerance = 0.5f;
+
+	/**
+	 * @brief Should characters controlled by a player always use the most significant bucket?
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character Significance")
+	bool bPlayerControlledAlwaysSignificant = true;
+
+	/**
+	 * @brief Get the bucket used by a character
+	 * @param Distance The distance between the character and the closest viewer
+	 * @param bRendered Was the character rendered recently?
+	 * @param bPlayerControlled Is the character controlled by a player?
+	 * @return The index of the bucket used by the character or -1 if there are no buckets
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character Significance")
+	int GetBucketIndex(float Distance, bool bRendered, bool bPlayerControlled) const;
+};
@@ -0,0 +1,225 @@
+﻿// Created by Henry Jooste
+
+#include "CharacterSignificanceSubsystem.h"
+
+#include "USKCharacter.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "USK/Core/USKGameInstance.h"
+#include "USK/Logger/Log.h"
+
+const FName UCharacterSignificanceSubsystem::SignificanceTag = "USKCharacter";
+
+/**
+ * @brief Check if the subsystem should be created for the world
+ * @param Outer The world that owns the subsystem
+ * @return A boolean value indicating if the subsystem should be created
+ */
+bool UCharacterSignificanceSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return Super::ShouldCreateSubsystem(Outer) && IsValid(World) && World->IsGameWorld();
+}
+
+/**
+ * @brief Remove all the characters from the significance manager when the world is torn down
+ */
+void UCharacterSignificanceSubsystem::Deinitialize()
+{
+	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld());
+	if (IsValid(SignificanceManager))
+	{
+		SignificanceManager->UnregisterAll(SignificanceTag);
+	}
+
+	Characters.Empty();
+	Super::Deinitialize();
+}
+
+/**
+ * @brief Update the significance of the characters using the view points of the local players
+ * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+ */
+void UCharacterSignificanceSubsystem::Tick(float DeltaTime)
+{
+	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld());
+	if (!IsValid(SignificanceManager))
+	{
+		return;
+	}
+
+	Viewpoints.Reset();
+	for (FConstPlayerControllerIterator Iterator = GetWorld()->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if (!IsValid(PlayerController) || !PlayerController->IsLocalController())
+		{
+			continue;
+		}
+
+		FVector ViewLocation;
+		FRotator ViewRotation;
+		PlayerController->GetPlayerViewPoint(ViewLocation, ViewRotation);
+		Viewpoints.Emplace(ViewRotation, ViewLocation);
+	}
+
+	SignificanceManager->Update(Viewpoints);
+}
+
+/**
+ * @brief Check if the subsystem should be ticked
+ * @return A boolean value indicating if the subsystem should be ticked
+ */
+bool UCharacterSignificanceSubsystem::IsTickable() const
+{
+	return Characters.Num() > 0;
+}
+
+/**
+ * @brief Get the tick type of the subsystem
+ * @return The tick type of the subsystem
+ */
+ETickableTickType UCharacterSignificanceSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+/**
+ * @brief Get the world the subsystem is ticked in
+ * @return The world the subsystem is ticked in
+ */
+UWorld* UCharacterSignificanceSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/**
+ * @brief Get the stat ID used to profile the subsystem
+ * @return The stat ID used to profile the subsystem
+ */
+TStatId UCharacterSignificanceSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UCharacterSignificanceSubsystem, STATGROUP_Tickables);
+}
+
+/**
+ * @brief Start managing the update rates of a character. Nothing happens if no significance config is set
+ * @param Character The character to manage
+ */
+void UCharacterSignificanceSubsystem::RegisterCharacter(AUSKCharacter* Character)
+{
+	if (!bIsConfigured)
+	{
+		Configure();
+	}
+
+	if (!IsValid(Character) || !IsValid(Config) || Config->Buckets.Num() == 0)
+	{
+		return;
+	}
+
+	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld());
+	if (!IsValid(SignificanceManager))
+	{
+		USK_LOG_WARNING("Unable to register character significance. Significance manager not found");
+		return;
+	}
+
+	if (Characters.Contains(Character))
+	{
+		return;
+	}
+
+	SignificanceManager->RegisterObject(Character, SignificanceTag,
+		[this](const USignificanceManager::FManagedObjectInfo* ObjectInfo, const FTransform& Viewpoint)
+		{
+			return GetSignificance(ObjectInfo, Viewpoint);
+		},
+		USignificanceManager::EPostSignificanceType::Sequential,
+		[this](const USignificanceManager::FManagedObjectInfo* ObjectInfo, const float OldSignificance,
+			const float Significance, const bool bFinal)
+		{
+			OnSignificanceUpdated(ObjectInfo, OldSignificance, Significance, bFinal);
+		});
+
+	Characters.Add(Character);
+	USK_LOG_TRACE(*FString::Format(TEXT("Registered character significance for {0}"), { Character->GetName() }));
+}
+
+/**
+ * @brief Stop managing the update rates of a character
+ * @param Character The character to stop managing
+ */
+void UCharacterSignificanceSubsystem::UnregisterCharacter(AUSKCharacter* Character)
+{
+	if (Characters.Remove(Character) == 0)
+	{
+		return;
+	}
+
+	USignificanceManager* SignificanceManager = FSignificanceManagerModule::Get(GetWorld());
+	if (IsValid(SignificanceManager))
+	{
+		SignificanceManager->UnregisterObject(Character);
+	}
+}
+
+/**
+ * @brief Read the significance config from the game instance
+ */
+void UCharacterSignificanceSubsystem::Configure()
+{
+	bIsConfigured = true;
+	const UUSKGameInstance* GameInstance = Cast<UUSKGameInstance>(GetWorld()->GetGameInstance());
+	if (!IsValid(GameInstance))
+	{
+		USK_LOG_WARNING("Game instance is not a USK game instance. Character significance is disabled");
+		return;
+	}
+
+	Config = GameInstance->CharacterSignificanceConfig;
+}
+
+/**
+ * @brief Get the significance of a character for a view point. Can be called from worker threads
+ * @param ObjectInfo The information of the character managed by the significance manager
+ * @param Viewpoint The view point of a local player
+ * @return The significance of the character (the amount of buckets minus the bucket index)
+ */
+float UCharacterSignificanceSubsystem::GetSignificance(const USignificanceManager::FManagedObjectInfo* ObjectInfo,
+	const FTransform& Viewpoint) const
+{
+	const AUSKCharacter* Character = Cast<AUSKCharacter>(ObjectInfo->GetObject());
+	if (!IsValid(Character) || !IsValid(Config))
+	{
+		return 0.0f;
+	}
+
+	const float Distance = FVector::Dist(Character->GetActorLocation(), Viewpoint.GetLocation());
+	const bool bRendered = Character->WasRecentlyRendered(Config->RenderedTimeTolerance);
+	const int BucketIndex = Config->GetBucketIndex(Distance, bRendered, Character->IsPlayerControlled());
+	return Config->Buckets.Num() - BucketIndex;
+}
+
+/**
+ * @brief Apply the bucket of a character after its significance was updated
+ * @param ObjectInfo The information of the character managed by the significance manager
+ * @param OldSignificance The previous significance of the character
+ * @param Significance The new significance of the character
+ * @param bFinal Is the character being unregistered?
+ */
+void UCharacterSignificanceSubsystem::OnSignificanceUpdated(const USignificanceManager::FManagedObjectInfo* ObjectInfo,
+	const float OldSignificance, const float Significance, const bool bFinal) const
+{
+	AUSKCharacter* Character = Cast<AUSKCharacter>(ObjectInfo->GetObject());
+	if (bFinal || !IsValid(Character) || !IsValid(Config))
+	{
+		return;
+	}
+
+	const int BucketIndex = Config->Buckets.Num() - FMath::RoundToInt(Significance);
+	if (Config->Buckets.IsValidIndex(BucketIndex))
+	{
+		Character->SetSignificanceBucket(BucketIndex, Config->Buckets[BucketIndex]);
+	}
+}
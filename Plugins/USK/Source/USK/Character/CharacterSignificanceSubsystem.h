@@ -0,0 +1,129 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "CharacterSignificanceConfig.h"
+#include "SignificanceManager.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "CharacterSignificanceSubsystem.generated.h"
+
+class AUSKCharacter;
+
+/**
+ * @brief World subsystem that assigns characters to significance buckets using the significance manager
+ */
+UCLASS()
+class USK_API UCharacterSignificanceSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Check if the subsystem should be created for the world
+	 * @param Outer The world that owns the subsystem
+	 * @return A boolean value indicating if the subsystem should be created
+	 */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/**
+	 * @brief Remove all the characters from the significance manager when the world is torn down
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Update the significance of the characters using the view points of the local players
+	 * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * @brief Check if the subsystem should be ticked
+	 * @return A boolean value indicating if the subsystem should be ticked
+	 */
+	virtual bool IsTickable() const override;
+
+	/**
+	 * @brief Get the tick type of the subsystem
+	 * @return The tick type of the subsystem
+	 */
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	/**
+	 * @brief Get the world the subsystem is ticked in
+	 * @return The world the subsystem is ticked in
+	 */
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/**
+	 * @brief Get the stat ID used to profile the subsystem
+	 * @return The stat ID used to profile the subsystem
+	 */
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Start managing the update rates of a character. Nothing happens if no significance config is set
+	 * @param Character The character to manage
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Character Significance")
+	void RegisterCharacter(AUSKCharacter* Character);
+
+	/**
+	 * @brief Stop managing the update rates of a character
+	 * @param Character The character to stop managing
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Character Significance")
+	void UnregisterCharacter(AUSKCharacter* Character);
+
+private:
+	/**
+	 * @brief The tag used to register the characters with the significance manager
+	 */
+	static const FName SignificanceTag;
+
+	/**
+	 * @brief The significance buckets read from the game instance
+	 */
+	UPROPERTY()
+	UCharacterSignificanceConfig* Config;
+
+	/**
+	 * @brief The characters that are currently registered
+	 */
+	TSet<TWeakObjectPtr<AUSKCharacter>> Characters;
+
+	/**
+	 * @brief The view points of the local players
+	 */
+	TArray<FTransform> Viewpoints;
+
+	/**
+	 * @brief Was the subsystem configured using the game instance?
+	 */
+	bool bIsConfigured;
+
+	/**
+	 * @brief Read the significance config from the game instance
+	 */
+	void Configure();
+
+	/**
+	 * @brief Get the significance of a character for a view point. Can be called from worker threads
+	 * @param ObjectInfo The information of the character managed by the significance manager
+	 * @param Viewpoint The view point of a local player
+	 * @return The significance of the character (the amount of buckets minus the bucket index)
+	 */
+	float GetSignificance(const USignificanceManager::FManagedObjectInfo* ObjectInfo,
+		const FTransform& Viewpoint) const;
+
+	/**
+	 * @brief Apply the bucket of a character after its significance was updated
+	 * @param ObjectInfo The information of the character managed by the significance manager
+	 * @param OldSignificance The previous significance of the character
+	 * @param Significance The new significance of the character
+	 * @param bFinal Is the character being unregistered?
+	 */
+	void OnSignificanceUpdated(const USignificanceManager::FManagedObjectInfo* ObjectInfo, float OldSignificance,
+		float Significance, bool bFinal) const;
+};
@@ -8,8 +8,9 @@
 
 /**
  * @brief Create a new instance of the AFpsCharacter actor
+ * @param ObjectInitializer The object initializer used to override the default subobject classes
  */
-AFpsCharacter::AFpsCharacter()
+AFpsCharacter::AFpsCharacter(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	PrimaryActorTick.bCanEverTick = true;
 	
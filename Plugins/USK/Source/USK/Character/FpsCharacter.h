@@ -16,6 +16,7 @@ class USK_API AFpsCharacter : public AUSKCharacter
 public:
 	/**
 	 * @brief Create a new instance of the AFpsCharacter actor
+	 * @param ObjectInitializer The object initializer used to override the default subobject classes
 	 */
-	AFpsCharacter();	
+	explicit AFpsCharacter(const FObjectInitializer& ObjectInitializer);
 };
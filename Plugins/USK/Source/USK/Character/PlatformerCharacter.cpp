@@ -11,8 +11,9 @@
 
 /**
  * @brief Create a new instance of the APlatformerCharacter actor
+ * @param ObjectInitializer The object initializer used to override the default subobject classes
  */
-APlatformerCharacter::APlatformerCharacter()
+APlatformerCharacter::APlatformerCharacter(const FObjectInitializer& ObjectInitializer) : Super(ObjectInitializer)
 {
 	PrimaryActorTick.bCanEverTick = true;
 	SpringArmComponent = CreateDefaultSubobject<USpringArmComponent>(TEXT("Camera Boom"));
@@ -45,6 +46,16 @@ void APlatformerCharacter::Tick(float DeltaSeconds)
 	AdjustCameraPosition(DeltaSeconds);
 }
 
+/**
+ * @brief Check if the character needs to tick to update its abilities
+ * @return A boolean value indicating if the character needs to tick
+ */
+bool APlatformerCharacter::IsTickRequired() const
+{
+	// The camera arm length follows the velocity of the character and is skipped for insignificant characters
+	return AreCosmeticsEnabled() || Super::IsTickRequired();
+}
+
 /**
  * @brief Update the character mesh location while crouching
  * @param SizeDifference The difference between the original capsule size and the crouched capsule size
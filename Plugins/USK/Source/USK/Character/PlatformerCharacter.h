@@ -23,8 +23,9 @@ class USK_API APlatformerCharacter : public AUSKCharacter
 public:
 	/**
 	 * @brief Create a new instance of the APlatformerCharacter actor
+	 * @param ObjectInitializer The object initializer used to override the default subobject classes
 	 */
-	APlatformerCharacter();
+	explicit APlatformerCharacter(const FObjectInitializer& ObjectInitializer);
 	
 	/**
 	 * @brief Get the spring arm component of the character
@@ -63,6 +64,12 @@ protected:
 	 */
 	virtual void Tick(float DeltaSeconds) override;
 
+	/**
+	 * @brief Check if the character needs to tick to update its abilities
+	 * @return A boolean value indicating if the character needs to tick
+	 */
+	virtual bool IsTickRequired() const override;
+
 	/**
 	 * @brief Update the character mesh location while crouching
 	 * @param SizeDifference The difference between the original capsule size and the crouched capsule size
@@ -5,16 +5,16 @@
 #include "Components/DecalComponent.h"
 #include "Engine/World.h"
 #include "GameFramework/Character.h"
-#include "GameFramework/PawnMovementComponent.h"
-#include "Kismet/KismetSystemLibrary.h"
+#include "GameFramework/CharacterMovementComponent.h"
 #include "USK/Logger/Log.h"
+#include "USK/Utils/GroundProbeSubsystem.h"
 
 /**
  * @brief Create a new instance of the AShadowDecal actor
  */
 AShadowDecal::AShadowDecal()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 /**
@@ -29,38 +29,111 @@ void AShadowDecal::Initialize(ACharacter* OwnerCharacter)
 	const FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget,
 		EAttachmentRule::KeepRelative, EAttachmentRule::KeepWorld, true);
 	AttachToActor(OwnerCharacter, AttachmentRules);
+	GetDecal()->SetUsingAbsoluteLocation(true);
 	GetDecal()->SetVisibility(false, true);
+
+	UGroundProbeSubsystem* GroundProbe = GetWorld()->GetSubsystem<UGroundProbeSubsystem>();
+	if (!IsValid(OwnerCharacter) || !IsValid(GroundProbe))
+	{
+		return;
+	}
+
+	float CapsuleRadius;
+	float CapsuleHalfHeight;
+	OwnerCharacter->GetCapsuleComponent()->GetUnscaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
+
+	GroundProbeId = GroundProbe->RegisterProbe(OwnerCharacter, CapsuleRadius + CapsuleHalfHeight + 25.0f, 10000.0f);
+	GroundProbe->SetProbeCallback(GroundProbeId,
+		FGroundProbeUpdated::CreateUObject(this, &AShadowDecal::OnGroundUpdated));
+	UpdateProbeEnabled();
+	OwnerCharacter->MovementModeChangedDelegate.AddDynamic(this, &AShadowDecal::OnMovementModeChanged);
 }
 
 /**
- * @brief Event called every frame, if ticking is enabled
- * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+ * @brief Enable or disable the shadow. The ground is not probed while the shadow is disabled
+ * @param bEnabled Should the shadow be enabled?
  */
-void AShadowDecal::Tick(float DeltaSeconds)
+void AShadowDecal::SetShadowEnabled(const bool bEnabled)
 {
-	Super::Tick(DeltaSeconds);
-	if (Character == nullptr || !Character->GetMovementComponent()->IsFalling())
+	bShadowEnabled = bEnabled;
+	UpdateProbeEnabled();
+	if (!bEnabled)
 	{
-		GetDecal()->SetVisibility(false, true);
-		return;
+		SetShadowVisible(false);
 	}
+}
 
-	float CapsuleRadius;
-	float CapsuleHalfHeight;
-	Character->GetCapsuleComponent()->GetUnscaledCapsuleSize(CapsuleRadius, CapsuleHalfHeight);
-
-	const FVector Start = Character->GetActorLocation() -
-		FVector(0.0f, 0.0f, CapsuleRadius + CapsuleHalfHeight + 25.0f);
-	const FVector End = Character->GetActorLocation() - FVector(0.0f, 0.0f, 10000.0f);
-	
-	FHitResult HitResult;
-	if (!UKismetSystemLibrary::LineTraceSingle(GetWorld(), Start, End, TraceTypeQuery1,
-		false, TArray<AActor*>(), EDrawDebugTrace::None, HitResult, true))
+/**
+ * @brief Overridable function called whenever this actor is being removed from a level
+ * @param EndPlayReason The reason this actor is being removed
+ */
+void AShadowDecal::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UGroundProbeSubsystem* GroundProbe = GetWorld()->GetSubsystem<UGroundProbeSubsystem>();
+	if (IsValid(GroundProbe))
 	{
-		GetDecal()->SetVisibility(false, true);
-		return;
+		GroundProbe->UnregisterProbe(GroundProbeId);
+	}
+
+	if (IsValid(Character))
+	{
+		Character->MovementModeChangedDelegate.RemoveDynamic(this, &AShadowDecal::OnMovementModeChanged);
 	}
 
-	GetDecal()->SetWorldLocation(HitResult.Location);
-	GetDecal()->SetVisibility(true, true);	
+	Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * @brief Called when the movement mode of the character changes
+ * @param OwnerCharacter The character owning this shadow decal
+ * @param PrevMovementMode Movement mode before the change
+ * @param PreviousCustomMode Custom mode before the change (applicable if PrevMovementMode is Custom)
+ */
+void AShadowDecal::OnMovementModeChanged(ACharacter* OwnerCharacter, EMovementMode PrevMovementMode,
+	uint8 PreviousCustomMode)
+{
+	UpdateProbeEnabled();
+	if (!OwnerCharacter->GetCharacterMovement()->IsFalling())
+	{
+		SetShadowVisible(false);
+	}
+}
+
+/**
+ * @brief Called when the ground below the character changes
+ * @param bHit Was ground found below the character?
+ * @param HitResult The result describing the ground below the character
+ */
+void AShadowDecal::OnGroundUpdated(const bool bHit, const FHitResult& HitResult)
+{
+	if (bHit)
+	{
+		GetDecal()->SetWorldLocation(HitResult.Location);
+	}
+
+	SetShadowVisible(bHit && bShadowEnabled);
+}
+
+/**
+ * @brief Enable the ground probe if the shadow is enabled and the character is in the air
+ */
+void AShadowDecal::UpdateProbeEnabled() const
+{
+	UGroundProbeSubsystem* GroundProbe = GetWorld()->GetSubsystem<UGroundProbeSubsystem>();
+	if (IsValid(GroundProbe) && IsValid(Character))
+	{
+		GroundProbe->SetProbeEnabled(GroundProbeId, bShadowEnabled && Character->GetCharacterMovement()->IsFalling());
+	}
+}
+
+/**
+ * @brief Show or hide the shadow
+ * @param bVisible Should the shadow be visible?
+ */
+void AShadowDecal::SetShadowVisible(const bool bVisible)
+{
+	if (GetDecal()->IsVisible() != bVisible)
+	{
+		GetDecal()->SetVisibility(bVisible, true);
+	}
 }
@@ -26,12 +26,19 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Shadow Decal")
 	void Initialize(ACharacter* OwnerCharacter);
 
+	/**
+	 * @brief Enable or disable the shadow. The ground is not probed while the shadow is disabled
+	 * @param bEnabled Should the shadow be enabled?
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Shadow Decal")
+	void SetShadowEnabled(bool bEnabled);
+
 protected:
 	/**
-	 * @brief Event called every frame, if ticking is enabled
-	 * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+	 * @brief Overridable function called whenever this actor is being removed from a level
+	 * @param EndPlayReason The reason this actor is being removed
 	 */
-	virtual void Tick(float DeltaSeconds) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
 	/**
@@ -39,4 +46,41 @@ private:
 	 */
 	UPROPERTY()
 	ACharacter* Character;
+
+	/**
+	 * @brief The ID of the ground probe used to find the ground below the character
+	 */
+	int GroundProbeId = -1;
+
+	/**
+	 * @brief Is the shadow enabled?
+	 */
+	bool bShadowEnabled = true;
+
+	/**
+	 * @brief Enable the ground probe if the shadow is enabled and the character is in the air
+	 */
+	void UpdateProbeEnabled() const;
+
+	/**
+	 * @brief Called when the movement mode of the character changes
+	 * @param OwnerCharacter The character owning this shadow decal
+	 * @param PrevMovementMode Movement mode before the change
+	 * @param PreviousCustomMode Custom mode before the change (applicable if PrevMovementMode is Custom)
+	 */
+	UFUNCTION()
+	void OnMovementModeChanged(ACharacter* OwnerCharacter, EMovementMode PrevMovementMode, uint8 PreviousCustomMode);
+
+	/**
+	 * @brief Called when the ground below the character changes
+	 * @param bHit Was ground found below the character?
+	 * @param HitResult The result describing the ground below the character
+	 */
+	void OnGroundUpdated(bool bHit, const FHitResult& HitResult);
+
+	/**
+	 * @brief Show or hide the shadow
+	 * @param bVisible Should the shadow be visible?
+	 */
+	void SetShadowVisible(bool bVisible);
 };
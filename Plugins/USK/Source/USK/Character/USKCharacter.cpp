@@ -4,28 +4,33 @@
 #include "GameFramework/CharacterMovementComponent.h"
 #include "Kismet/GameplayStatics.h"
 #include "Kismet/KismetMathLibrary.h"
-#include "Kismet/KismetSystemLibrary.h"
 #include "Engine/World.h"
 #include "EnhancedInputComponent.h"
 #include "EnhancedInputSubsystems.h"
 #include "Engine/LocalPlayer.h"
-#include "NiagaraFunctionLibrary.h"
 #include "Camera/CameraComponent.h"
 #include "Components/CapsuleComponent.h"
-#include "Components/TimelineComponent.h"
+#include "Curves/CurveFloat.h"
+#include "CharacterSignificanceSubsystem.h"
+#include "USKCharacterMovementComponent.h"
+#include "Net/UnrealNetwork.h"
+#include "USK/Benchmark/InputRecordingButton.h"
 #include "USK/Audio/AudioUtils.h"
+#include "USK/Effects/ParticleFxUtils.h"
 #include "USK/Logger/Log.h"
 #include "USK/Weapons/WeaponUtils.h"
 
 /**
  * @brief Create a new instance of the AUSKCharacter actor
+ * @param ObjectInitializer The object initializer used to override the default subobject classes
  */
-AUSKCharacter::AUSKCharacter()
+AUSKCharacter::AUSKCharacter(const FObjectInitializer& ObjectInitializer)
+	: Super(ObjectInitializer.SetDefaultSubobjectClass<UUSKCharacterMovementComponent>(CharacterMovementComponentName))
 {
 	PrimaryActorTick.bCanEverTick = true;
 
 	CameraComponent = CreateDefaultSubobject<UCameraComponent>(TEXT("Camera"));
-	CrouchTimeline = CreateDefaultSubobject<UTimelineComponent>(TEXT("Crouch Timeline"));
+	WeaponLoadout = CreateDefaultSubobject<UWeaponLoadoutComponent>(TEXT("Weapon Loadout"));
 
 	GetCharacterMovement()->RotationRate = FRotator(0.0f, 500.0f, 0.0f);
 	GetCharacterMovement()->bOrientRotationToMovement = true;
@@ -58,7 +63,8 @@ void AUSKCharacter::BeginPlay()
 	{
 		USK_LOG_TRACE("Adding shadow decal");
 		AActor* ShadowDecalActor = GetWorld()->SpawnActor(ShadowDecalClass);
-		dynamic_cast<AShadowDecal*>(ShadowDecalActor)->Initialize(this);
+		ShadowDecal = dynamic_cast<AShadowDecal*>(ShadowDecalActor);
+		ShadowDecal->Initialize(this);
 	}
 
 	if (IsValid(DefaultWeaponClass))
@@ -68,14 +74,51 @@ void AUSKCharacter::BeginPlay()
 	}
 
 	DefaultCapsuleSize = GetCapsuleComponent()->GetUnscaledCapsuleHalfHeight();
-	if (IsValid(CrouchCurve))
+    DefaultCameraLocation = GetCameraComponent()->GetRelativeLocation();
+
+	const FName TickFunctionName = GET_FUNCTION_NAME_CHECKED(AUSKCharacter, ReceiveTick);
+	bHasBlueprintTick = GetClass()->IsFunctionImplementedInScript(TickFunctionName);
+	UpdateMovementSpeed();
+	UpdateTickEnabled();
+
+	UCharacterSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UCharacterSignificanceSubsystem>();
+	if (IsValid(Significance))
 	{
-		CrouchTimelineUpdateEvent.BindUFunction(this, FName("OnCrouchTimelineUpdated"));
-		CrouchTimeline->AddInterpFloat(CrouchCurve, CrouchTimelineUpdateEvent);
-		CrouchTimeline->SetLooping(false);
+		Significance->RegisterCharacter(this);
 	}
+}
 
-    DefaultCameraLocation = GetCameraComponent()->GetRelativeLocation();
+/**
+ * @brief Overridable function called whenever this actor is being removed from a level
+ * @param EndPlayReason The reason this actor is being removed
+ */
+void AUSKCharacter::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	UCharacterSignificanceSubsystem* Significance = GetWorld()->GetSubsystem<UCharacterSignificanceSubsystem>();
+	if (IsValid(Significance))
+	{
+		Significance->UnregisterCharacter(this);
+	}
+
+	// The shadow decal and the equipped weapon are separate actors that would otherwise outlive the character
+	if (EndPlayReason == EEndPlayReason::Destroyed)
+	{
+		if (IsValid(ShadowDecal))
+		{
+			ShadowDecal->Destroy();
+		}
+
+		if (IsValid(Weapon))
+		{
+			Weapon->StopFiring();
+			Weapon->Destroy();
+		}
+
+		ShadowDecal = nullptr;
+		Weapon = nullptr;
+	}
+
+	Super::EndPlay(EndPlayReason);
 }
 
 /**
@@ -85,10 +128,32 @@ void AUSKCharacter::BeginPlay()
 void AUSKCharacter::Tick(float DeltaSeconds)
 {
 	Super::Tick(DeltaSeconds);
-	AirTime = GetCharacterMovement()->IsFalling() ? AirTime + DeltaSeconds : 0.0f;
-    UpdateLeaning(DeltaSeconds);
+	UpdateAbilityWindows();
+	UpdateCrouching(DeltaSeconds);
+	UpdateLeaning(DeltaSeconds);
 	UpdateSliding(DeltaSeconds);
-	UpdateMovementSpeed();
+}
+
+/**
+ * @brief Check if the character needs to tick to update its abilities
+ * @return A boolean value indicating if the character needs to tick
+ */
+bool AUSKCharacter::IsTickRequired() const
+{
+	return EnumHasAnyFlags(CharacterState, EUSKCharacterState::Sliding | EUSKCharacterState::Leaning) ||
+		CrouchCurveDirection != 0.0f || HasScheduledAbilityWindow();
+}
+
+/**
+ * @brief Enable or disable ticking based on the current ability states of the character
+ */
+void AUSKCharacter::UpdateTickEnabled()
+{
+	const bool bTickEnabled = bHasBlueprintTick || IsTickRequired();
+	if (IsActorTickEnabled() != bTickEnabled)
+	{
+		SetActorTickEnabled(bTickEnabled);
+	}
 }
 
 /**
@@ -141,18 +206,19 @@ void AUSKCharacter::Landed(const FHitResult& Hit)
 	USK_LOG_TRACE("Character Landed");
 	JumpMaxCount = 1;
 	CoyoteJumpPerformed = false;
+	IsDoubleJumping = false;
 	UAudioUtils::PlayRandomSound(this, LandedSoundEffects);
 
 	if (LandParticleFx != nullptr)
 	{
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), LandParticleFx,
+		UParticleFxUtils::SpawnParticleFx(GetWorld(), LandParticleFx,
 			Hit.Location + LandParticleFxSpawnOffset);
 	}
 
 	StopStomping();
-	if (bIsCrouching)
+	if (IsCrouching())
 	{
-		CrouchTimeline->Play();
+		PlayCrouchCurve(true);
 	}
 }
 
@@ -171,15 +237,11 @@ void AUSKCharacter::OnMovementModeChanged(EMovementMode PrevMovementMode, uint8
 		return;
 	}
 
-	CanPerformCoyoteJump = true;
-
-	USK_LOG_TRACE("Starting latent reset coyote jump action");
-	FLatentActionInfo LatentAction;
-	LatentAction.Linkage = 0;
-	LatentAction.CallbackTarget = this;
-	LatentAction.UUID = GetUniqueID();
-	LatentAction.ExecutionFunction = "ResetCoyoteJump";
-	UKismetSystemLibrary::RetriggerableDelay(GetWorld(), CoyoteJumpTime, LatentAction);
+	FallStartTime = GetWorld()->GetTimeSeconds();
+	if (CanCoyoteJump)
+	{
+		CoyoteJumpEndTime = FallStartTime + CoyoteJumpTime;
+	}
 }
 
 /**
@@ -191,13 +253,33 @@ UCameraComponent* AUSKCharacter::GetCameraComponent() const
 	return CameraComponent;
 }
 
+/**
+ * @brief Get the loadout component used to keep the weapons of the character alive between swaps
+ * @return The loadout component of the character
+ */
+UWeaponLoadoutComponent* AUSKCharacter::GetWeaponLoadout() const
+{
+	return WeaponLoadout;
+}
+
 /**
  * @brief Set the current weapon used by the character
  * @param NewWeapon The new weapon
  */
 void AUSKCharacter::SetWeapon(AWeapon* NewWeapon)
 {
+	if (Weapon == NewWeapon)
+	{
+		return;
+	}
+
 	Weapon = NewWeapon;
+	if (IsValid(Weapon) && SignificanceBucket >= 0)
+	{
+		Weapon->SetActorTickInterval(WeaponTickInterval);
+	}
+
+	OnWeaponChanged.Broadcast(Weapon);
 }
 
 /**
@@ -215,7 +297,16 @@ AWeapon* AUSKCharacter::GetWeapon() const
  */
 bool AUSKCharacter::IsCrouching() const
 {
-	return bIsCrouching;
+	return EnumHasAnyFlags(CharacterState, EUSKCharacterState::Crouching);
+}
+
+/**
+ * @brief Check if the character is sprinting
+ * @return A boolean value indicating if the character is sprinting
+ */
+bool AUSKCharacter::IsSprinting() const
+{
+	return EnumHasAnyFlags(CharacterState, EUSKCharacterState::Sprinting);
 }
 
 /**
@@ -224,7 +315,7 @@ bool AUSKCharacter::IsCrouching() const
  */
 bool AUSKCharacter::IsEndingCrouch() const
 {
-	return bIsEndingCrouch;
+	return EnumHasAnyFlags(CharacterState, EUSKCharacterState::EndingCrouch);
 }
 
 /**
@@ -233,7 +324,7 @@ bool AUSKCharacter::IsEndingCrouch() const
  */
 bool AUSKCharacter::IsStomping() const
 {
-	return bIsStomping;
+	return EnumHasAnyFlags(CharacterState, EUSKCharacterState::Stomping);
 }
 
 /**
@@ -242,7 +333,7 @@ bool AUSKCharacter::IsStomping() const
  */
 bool AUSKCharacter::IsStompStarting() const
 {
-	return bIsStomping && FMath::IsNearlyZero(GetCharacterMovement()->GravityScale);
+	return IsStomping() && FMath::IsNearlyZero(GetCharacterMovement()->GravityScale);
 }
 
 /**
@@ -260,7 +351,7 @@ float AUSKCharacter::GetLeanCameraRoll() const
  */
 bool AUSKCharacter::IsSliding() const
 {
-	return bIsSliding;
+	return EnumHasAnyFlags(CharacterState, EUSKCharacterState::Sliding);
 }
 
 /**
@@ -269,7 +360,270 @@ bool AUSKCharacter::IsSliding() const
  */
 bool AUSKCharacter::IsEndingSlide() const
 {
-	return bIsEndingSlide;
+	return EnumHasAnyFlags(CharacterState, EUSKCharacterState::EndingSlide);
+}
+
+/**
+ * @brief Get the bitfield containing the current ability states of the character
+ * @return The current ability states of the character
+ */
+EUSKCharacterState AUSKCharacter::GetCharacterState() const
+{
+	return CharacterState;
+}
+
+/**
+ * @brief Check if the character is in any of the specified ability states
+ * @param State The ability states to check
+ * @return A boolean value indicating if the character is in any of the specified ability states
+ */
+bool AUSKCharacter::HasCharacterState(const int32 State) const
+{
+	return EnumHasAnyFlags(CharacterState, static_cast<EUSKCharacterState>(State));
+}
+
+/**
+ * @brief Update the max walk speed of the character. Call this after changing the movement speeds at runtime
+ */
+void AUSKCharacter::UpdateMovementSpeed() const
+{
+	float TargetSpeed = IsSprinting() ? SprintSpeed : MovementSpeed;
+	if (IsSliding())
+	{
+		TargetSpeed = SlideSpeed;
+	}
+	else if (IsCrouching())
+	{
+		TargetSpeed = CrouchSpeed;
+	}
+
+	if (GetCharacterMovement()->MaxWalkSpeed != TargetSpeed)
+	{
+		GetCharacterMovement()->MaxWalkSpeed = TargetSpeed;
+	}
+}
+
+/**
+ * @brief Capture the state used by the animation instance. Must be called on the game thread
+ * @param Snapshot The snapshot to fill
+ */
+void AUSKCharacter::FillAnimationSnapshot(FUSKCharacterAnimationSnapshot& Snapshot) const
+{
+	Snapshot.Velocity = GetVelocity();
+	Snapshot.bIsFalling = GetCharacterMovement()->IsFalling();
+	Snapshot.CharacterState = CharacterState;
+	Snapshot.bIsStompStarting = IsStompStarting();
+	Snapshot.LeanCameraRoll = CurrentLeanCameraRoll;
+}
+
+/**
+ * @brief Get the significance bucket assigned to the character
+ * @return The index of the significance bucket or -1 if the character is updated at the full rate
+ */
+int AUSKCharacter::GetSignificanceBucket() const
+{
+	return SignificanceBucket;
+}
+
+/**
+ * @brief Check if cosmetic work like lean interpolation and the shadow decal is enabled
+ * @return A boolean value indicating if cosmetic work is enabled
+ */
+bool AUSKCharacter::AreCosmeticsEnabled() const
+{
+	return bCosmeticsEnabled;
+}
+
+/**
+ * @brief Apply the update rates of a significance bucket to the character, its animations, weapon and shadow
+ * @param BucketIndex The index of the significance bucket
+ * @param Bucket The significance bucket
+ */
+void AUSKCharacter::SetSignificanceBucket(const int BucketIndex, const FCharacterSignificanceBucket& Bucket)
+{
+	if (SignificanceBucket == BucketIndex)
+	{
+		return;
+	}
+
+	USK_LOG_TRACE(*FString::Format(TEXT("Significance bucket of {0} changed to {1}"), { GetName(), BucketIndex }));
+	SignificanceBucket = BucketIndex;
+	WeaponTickInterval = Bucket.TickInterval;
+	SetActorTickInterval(Bucket.TickInterval);
+	GetMesh()->SetComponentTickInterval(Bucket.AnimationTickInterval);
+	if (IsValid(Weapon))
+	{
+		Weapon->SetActorTickInterval(WeaponTickInterval);
+	}
+
+	if (bCosmeticsEnabled == !Bucket.bSkipCosmetics)
+	{
+		return;
+	}
+
+	bCosmeticsEnabled = !Bucket.bSkipCosmetics;
+	if (IsValid(ShadowDecal))
+	{
+		ShadowDecal->SetShadowEnabled(bCosmeticsEnabled);
+	}
+
+	UpdateLeaning(0.0f);
+	UpdateTickEnabled();
+}
+
+/**
+ * @brief Feed a frame of an input recording to the character as if the input actions were triggered
+ * @param Frame The input action values of the current frame
+ * @param PreviousFrame The input action values of the previous frame, used to detect pressed and released buttons
+ */
+void AUSKCharacter::ApplyRecordedInput(const FInputRecordingFrame& Frame, const FInputRecordingFrame& PreviousFrame)
+{
+	if (!Frame.Move.IsZero())
+	{
+		MoveCharacter(FInputActionValue(Frame.Move));
+	}
+
+	if (!Frame.Look.IsZero())
+	{
+		RotateCamera(FInputActionValue(Frame.Look));
+	}
+
+	// Lean is bound to both the triggered and completed events, so the release is replayed as well
+	if (Frame.Lean != 0.0f || PreviousFrame.Lean != 0.0f)
+	{
+		Lean(FInputActionValue(Frame.Lean));
+	}
+
+	const EInputRecordingButton Pressed = static_cast<EInputRecordingButton>(Frame.Buttons & ~PreviousFrame.Buttons);
+	const EInputRecordingButton Released = static_cast<EInputRecordingButton>(PreviousFrame.Buttons & ~Frame.Buttons);
+	if (EnumHasAnyFlags(Pressed, EInputRecordingButton::Jump))
+	{
+		Jump();
+	}
+	else if (EnumHasAnyFlags(Released, EInputRecordingButton::Jump))
+	{
+		StopJumping();
+	}
+
+	if (EnumHasAnyFlags(Pressed, EInputRecordingButton::Sprint))
+	{
+		Sprint();
+	}
+	else if (EnumHasAnyFlags(Released, EInputRecordingButton::Sprint))
+	{
+		StopSprinting();
+	}
+
+	if (EnumHasAnyFlags(Pressed, EInputRecordingButton::FireWeapon))
+	{
+		StartFiringWeapon();
+	}
+	else if (EnumHasAnyFlags(Released, EInputRecordingButton::FireWeapon))
+	{
+		StopFiringWeapon();
+	}
+
+	if (EnumHasAnyFlags(Pressed, EInputRecordingButton::Crouch))
+	{
+		StartCrouching();
+	}
+	else if (EnumHasAnyFlags(Released, EInputRecordingButton::Crouch))
+	{
+		StopCrouching();
+	}
+}
+
+/**
+ * @brief Get the direction of the current slide
+ * @return The direction of the current slide
+ */
+FVector AUSKCharacter::GetSlideDirection() const
+{
+	return SlideDirection;
+}
+
+/**
+ * @brief Apply the velocity and gravity changes of an ability. Called by the movement component during a move
+ * @param Launch The ability to apply
+ */
+void AUSKCharacter::ApplyMovementLaunch(const EUSKMovementLaunch Launch)
+{
+	switch (Launch)
+	{
+	case EUSKMovementLaunch::CoyoteJump:
+		LaunchCharacter(FVector(0.0f, 0.0f, CoyoteJumpVelocity), false, true);
+		break;
+	case EUSKMovementLaunch::CrouchJump:
+		LaunchCharacter(FVector(0.0f, 0.0f, CrouchJumpVelocity), false, true);
+		break;
+	case EUSKMovementLaunch::StompJump:
+		LaunchCharacter(FVector(0.0f, 0.0f, StompJumpVelocity), false, true);
+		break;
+	case EUSKMovementLaunch::LongJump:
+		LaunchCharacter(GetActorForwardVector() * FVector(LongJumpVelocity.X, LongJumpVelocity.Y, 0.0f) +
+			FVector(0.0f, 0.0f, LongJumpVelocity.Z), true, true);
+		break;
+	case EUSKMovementLaunch::StompStart:
+		GetCharacterMovement()->GravityScale = 0.0f;
+		GetCharacterMovement()->Velocity.Z = 0.0f;
+		break;
+	case EUSKMovementLaunch::StompDown:
+		GetCharacterMovement()->GravityScale = Gravity;
+		ApplyStompVelocity();
+		break;
+	case EUSKMovementLaunch::StompLand:
+		LaunchCharacter(FVector(0.0f, 0.0f, StompLandVelocity), false, true);
+		break;
+	default:
+		break;
+	}
+}
+
+/**
+ * @brief Mirror the abilities of a character that is controlled on another machine
+ * @param State The abilities that affect the movement of the character
+ * @param LeanRoll The lean camera roll of the character
+ */
+void AUSKCharacter::ApplyNetworkAbilityState(const EUSKCharacterState State, const float LeanRoll)
+{
+	constexpr EUSKCharacterState MirroredStates =
+		EUSKCharacterState::Sprinting | EUSKCharacterState::Sliding | EUSKCharacterState::Stomping;
+	SetCharacterState(MirroredStates & ~State, false);
+	SetCharacterState(MirroredStates & State, true);
+	CurrentLeanCameraRoll = LeanRoll;
+
+	const bool bWasCrouching = IsCrouching() && !IsEndingCrouch();
+	const bool bCrouching = EnumHasAnyFlags(State, EUSKCharacterState::Crouching);
+	if (bCrouching && !bWasCrouching)
+	{
+		SetCharacterState(EUSKCharacterState::EndingCrouch, false);
+		SetCharacterState(EUSKCharacterState::Crouching, true);
+		PlayCrouchCurve(true);
+	}
+	else if (!bCrouching && bWasCrouching)
+	{
+		SetCharacterState(EUSKCharacterState::EndingCrouch, true);
+		PlayCrouchCurve(false);
+	}
+}
+
+/**
+ * @brief Set the packed abilities that are replicated to the simulated proxies of the character
+ * @param PackedState The packed abilities
+ */
+void AUSKCharacter::SetReplicatedAbilityState(const uint8 PackedState)
+{
+	ReplicatedAbilityState = PackedState;
+}
+
+/**
+ * @brief Get the properties that are replicated for the lifetime of the character
+ * @param OutLifetimeProps The replicated properties
+ */
+void AUSKCharacter::GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const
+{
+	Super::GetLifetimeReplicatedProps(OutLifetimeProps);
+	DOREPLIFETIME_CONDITION(AUSKCharacter, ReplicatedAbilityState, COND_SimulatedOnly);
 }
 
 /**
@@ -277,10 +631,10 @@ bool AUSKCharacter::IsEndingSlide() const
  */
 void AUSKCharacter::Jump()
 {
-	if (bIsStompJumpAllowed)
+	if (EnumHasAnyFlags(CharacterState, EUSKCharacterState::StompJumpAllowed))
 	{
 		Super::Jump();
-		LaunchCharacter(FVector(0.0f, 0.0f, StompJumpVelocity), false, true);
+		RequestMovementLaunch(EUSKMovementLaunch::StompJump);
 		ResetStompJump();
 		return;
 	}
@@ -291,15 +645,15 @@ void AUSKCharacter::Jump()
 		return;
 	}
 
-	if (bCanCrouchJump && bIsCrouching)
+	if (bCanCrouchJump && IsCrouching())
 	{
 		StopCrouching();
 		Super::Jump();
-		LaunchCharacter(FVector(0.0f, 0.0f, CrouchJumpVelocity), false, true);
+		RequestMovementLaunch(EUSKMovementLaunch::CrouchJump);
 		return;
 	}
 	
-	if ((!CanJump() && !CanPerformCoyoteJump) || bIsStomping)
+	if ((!CanJump() && !IsCoyoteJumpWindowOpen()) || IsStomping())
 	{
 		USK_LOG_TRACE("Can't jump");
 		return;
@@ -313,19 +667,25 @@ void AUSKCharacter::Jump()
 	}
 	else
 	{		
-		LaunchCharacter(FVector(0.0f, 0.0f, CoyoteJumpVelocity), false, true);
+		RequestMovementLaunch(EUSKMovementLaunch::CoyoteJump);
 		CoyoteJumpPerformed = true;
-		CanPerformCoyoteJump = false;
+		CoyoteJumpEndTime = -1.0f;
 		USK_LOG_TRACE("Coyote jump performed");
 	}
 
 	JumpMaxCount = CanDoubleJump ? 2 : 1;
 	IsDoubleJumping = WasRegularJump && (CoyoteJumpPerformed || JumpCurrentCount > 0);
+	if (IsDoubleJumping)
+	{
+		USK_LOG_TRACE("Double jump performed");
+		OnDoubleJump.Broadcast();
+	}
+
 	UAudioUtils::PlayRandomSound(this, JumpSoundEffects);
 
 	if (JumpParticleFx != nullptr)
 	{
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), JumpParticleFx,
+		UParticleFxUtils::SpawnParticleFx(GetWorld(), JumpParticleFx,
 			GetActorLocation() + JumpParticleFxSpawnOffset);
 	}
 }
@@ -357,7 +717,8 @@ void AUSKCharacter::StopFiringWeapon()
  */
 void AUSKCharacter::StartCrouching()
 {	
-	if (bCanStomp && GetCharacterMovement()->IsFalling() && AirTime >= MinAirTimeBeforeStomping)
+	if (bCanStomp && GetCharacterMovement()->IsFalling() &&
+		GetWorld()->GetTimeSeconds() - FallStartTime >= MinAirTimeBeforeStomping)
 	{
 		StartStomping();
 		if (!bHoldToCrouch)
@@ -371,21 +732,21 @@ void AUSKCharacter::StartCrouching()
 		return;
 	}
 
-	if (!bHoldToCrouch && bIsCrouching)
+	if (!bHoldToCrouch && IsCrouching())
 	{
 		StopCrouchingInternal();
 		return;
 	}
 	
-	bIsCrouching = true;
-	bIsEndingCrouch = false;
+	SetCharacterState(EUSKCharacterState::EndingCrouch, false);
+	SetCharacterState(EUSKCharacterState::Crouching, true);
 	if (!GetCharacterMovement()->IsFalling())
 	{
-		CrouchTimeline->Play();
+		PlayCrouchCurve(true);
 	}
 
 	if (UKismetMathLibrary::VSizeXY(GetMovementComponent()->Velocity) >= SlideMinSpeed &&
-		!bIsSliding && CurrentSlidingCooldown <= 0.0f && !GetCharacterMovement()->IsFalling())
+		!IsSliding() && GetWorld()->GetTimeSeconds() >= SlideCooldownEndTime && !GetCharacterMovement()->IsFalling())
 	{
 		StartSliding();
 	}
@@ -415,17 +776,16 @@ void AUSKCharacter::UpdateCharacterMeshLocationWhileCrouching(float SizeDifferen
  */
 void AUSKCharacter::StartStomping()
 {
-	bIsStomping = true;
+	SetCharacterState(EUSKCharacterState::Stomping, true);
 	if (StompZeroGravityDuration <= 0.0f)
 	{
-		ApplyStompVelocity();
+		RequestMovementLaunch(EUSKMovementLaunch::StompDown);
 		return;
 	}
 	
-    GetCharacterMovement()->GravityScale = 0.0f;
-	const FVector CurrentVelocity = GetCharacterMovement()->Velocity;
-	GetCharacterMovement()->Velocity = FVector(CurrentVelocity.X, CurrentVelocity.Y, 0.0f);
-	UKismetSystemLibrary::K2_SetTimer(this, "StompAfterZeroGravity", StompZeroGravityDuration, false);
+	RequestMovementLaunch(EUSKMovementLaunch::StompStart);
+	StompZeroGravityEndTime = GetWorld()->GetTimeSeconds() + StompZeroGravityDuration;
+	UpdateTickEnabled();
 }
 
 /**
@@ -433,13 +793,13 @@ void AUSKCharacter::StartStomping()
  */
 void AUSKCharacter::StopStomping()
 {
-	if (!bIsStomping)
+	if (!IsStomping())
 	{
 		return;
 	}
 	
-	UKismetSystemLibrary::K2_SetTimer(this, "ResetStomping", 0.1f, false);
-	LaunchCharacter(FVector(0.0f, 0.0f, StompLandVelocity), false, true);
+	StompResetTime = GetWorld()->GetTimeSeconds() + 0.1f;
+	RequestMovementLaunch(EUSKMovementLaunch::StompLand);
 	
 	if (IsValid(StompCameraShake))
 	{
@@ -449,9 +809,11 @@ void AUSKCharacter::StopStomping()
 
 	if (bCanStompJump && StompJumpDuration > 0.0f)
 	{
-		bIsStompJumpAllowed = true;
-		UKismetSystemLibrary::K2_SetTimer(this, "ResetStompJump", StompJumpDuration, false);
+		StompJumpEndTime = GetWorld()->GetTimeSeconds() + StompJumpDuration;
+		SetCharacterState(EUSKCharacterState::StompJumpAllowed, true);
 	}
+
+	UpdateTickEnabled();
 }
 
 /**
@@ -468,7 +830,7 @@ void AUSKCharacter::ApplyStompVelocity()
  */
 void AUSKCharacter::MoveCharacter(const FInputActionValue& Input)
 {
-	if (bIsStomping || bIsSliding)
+	if (EnumHasAnyFlags(CharacterState, EUSKCharacterState::Stomping | EUSKCharacterState::Sliding))
 	{
 		return;
 	}
@@ -496,12 +858,50 @@ void AUSKCharacter::RotateCamera(const FInputActionValue& Input)
 }
 
 /**
- * @brief Reset the coyote jump values
+ * @brief Check if the coyote jump window is open
+ * @return A boolean value indicating if the character can perform a coyote jump
+ */
+bool AUSKCharacter::IsCoyoteJumpWindowOpen() const
+{
+	return GetWorld()->GetTimeSeconds() < CoyoteJumpEndTime;
+}
+
+/**
+ * @brief Check if any of the ability windows are waiting to close
+ * @return A boolean value indicating if an ability window is scheduled
  */
-void AUSKCharacter::ResetCoyoteJump()
+bool AUSKCharacter::HasScheduledAbilityWindow() const
 {
-	USK_LOG_TRACE("Resetting coyote jump");
-	CanPerformCoyoteJump = false;
+	return StompZeroGravityEndTime >= 0.0f || StompResetTime >= 0.0f || StompJumpEndTime >= 0.0f;
+}
+
+/**
+ * @brief Close the ability windows that expired since the last update
+ */
+void AUSKCharacter::UpdateAbilityWindows()
+{
+	if (!HasScheduledAbilityWindow())
+	{
+		return;
+	}
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	if (StompZeroGravityEndTime >= 0.0f && CurrentTime >= StompZeroGravityEndTime)
+	{
+		StompAfterZeroGravity();
+	}
+
+	if (StompResetTime >= 0.0f && CurrentTime >= StompResetTime)
+	{
+		ResetStomping();
+	}
+
+	if (StompJumpEndTime >= 0.0f && CurrentTime >= StompJumpEndTime)
+	{
+		ResetStompJump();
+	}
+
+	UpdateTickEnabled();
 }
 
 /**
@@ -509,14 +909,14 @@ void AUSKCharacter::ResetCoyoteJump()
  */
 void AUSKCharacter::StopCrouchingInternal()
 {
-	if (bIsSliding)
+	if (IsSliding())
 	{
 		bStopCrouchingAfterSliding = true;
 		return;
 	}
 	
-	bIsEndingCrouch = true;
-	CrouchTimeline->Reverse();
+	SetCharacterState(EUSKCharacterState::EndingCrouch, true);
+	PlayCrouchCurve(false);
 
 	if (bSprintQueued)
 	{
@@ -525,15 +925,74 @@ void AUSKCharacter::StopCrouchingInternal()
 }
 
 /**
- * @brief Called after the crouch timeline is updated
+ * @brief Start playing the crouch curve
+ * @param bForward Should the curve be played forward to crouch or in reverse to stand up?
  */
-void AUSKCharacter::OnCrouchTimelineUpdated(float Value)
+void AUSKCharacter::PlayCrouchCurve(const bool bForward)
+{
+	if (!IsValid(CrouchCurve))
+	{
+		// Without a curve the capsule is never resized, so standing up completes immediately
+		if (!bForward)
+		{
+			ApplyCrouchCurve(1.0f);
+		}
+
+		return;
+	}
+
+	float StartTime;
+	CrouchCurve->GetTimeRange(StartTime, CrouchCurveEndTime);
+	CrouchCurvePosition = FMath::Clamp(CrouchCurvePosition, 0.0f, CrouchCurveEndTime);
+	CrouchCurveDirection = bForward ? 1.0f : -1.0f;
+	UpdateTickEnabled();
+}
+
+/**
+ * @brief Advance the crouch curve and update the capsule size
+ * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+ */
+void AUSKCharacter::UpdateCrouching(const float DeltaSeconds)
+{
+	if (CrouchCurveDirection == 0.0f)
+	{
+		return;
+	}
+
+	if (!IsValid(CrouchCurve))
+	{
+		CrouchCurveDirection = 0.0f;
+		UpdateTickEnabled();
+		return;
+	}
+
+	CrouchCurvePosition = FMath::Clamp(CrouchCurvePosition + DeltaSeconds * CrouchCurveDirection,
+		0.0f, CrouchCurveEndTime);
+	const bool bFinished = CrouchCurveDirection > 0.0f
+		? CrouchCurvePosition >= CrouchCurveEndTime
+		: CrouchCurvePosition <= 0.0f;
+	if (bFinished)
+	{
+		CrouchCurveDirection = 0.0f;
+	}
+
+	ApplyCrouchCurve(CrouchCurve->GetFloatValue(CrouchCurvePosition));
+	if (bFinished)
+	{
+		UpdateTickEnabled();
+	}
+}
+
+/**
+ * @brief Update the capsule size using a value of the crouch curve
+ * @param Value The value of the crouch curve
+ */
+void AUSKCharacter::ApplyCrouchCurve(const float Value)
 {
 	if (FMath::IsNearlyEqual(Value, 1.0f))
 	{
-		bIsCrouching = false;
-		bIsEndingCrouch = false;
-		bIsEndingSlide = false;
+		SetCharacterState(EUSKCharacterState::Crouching | EUSKCharacterState::EndingCrouch |
+			EUSKCharacterState::EndingSlide, false);
 	}
 	
 	const float CapsuleHalfHeight = GetCharacterMovement()->IsFalling()
@@ -548,8 +1007,8 @@ void AUSKCharacter::OnCrouchTimelineUpdated(float Value)
  */
 void AUSKCharacter::StompAfterZeroGravity()
 {
-	GetCharacterMovement()->GravityScale = Gravity;
-	ApplyStompVelocity();
+	StompZeroGravityEndTime = -1.0f;
+	RequestMovementLaunch(EUSKMovementLaunch::StompDown);
 }
 
 /**
@@ -557,7 +1016,8 @@ void AUSKCharacter::StompAfterZeroGravity()
  */
 void AUSKCharacter::ResetStomping()
 {
-	bIsStomping = false;
+	StompResetTime = -1.0f;
+	SetCharacterState(EUSKCharacterState::Stomping, false);
 }
 
 /**
@@ -565,7 +1025,8 @@ void AUSKCharacter::ResetStomping()
  */
 void AUSKCharacter::ResetStompJump()
 {
-	bIsStompJumpAllowed = false;
+	StompJumpEndTime = -1.0f;
+	SetCharacterState(EUSKCharacterState::StompJumpAllowed, false);
 }
 
 /**
@@ -582,6 +1043,7 @@ void AUSKCharacter::Lean(const FInputActionValue& Input)
     const float InputValue = Input.Get<float>();
     TargetLeanCameraOffset = FVector(0.0f, InputValue * LeanOffset, 0.0f);
     TargetLeanCameraRoll = InputValue * LeanRotation;
+	SetCharacterState(EUSKCharacterState::Leaning, true);
 }
 
 /**
@@ -590,22 +1052,40 @@ void AUSKCharacter::Lean(const FInputActionValue& Input)
  */
 void AUSKCharacter::UpdateLeaning(const float DeltaSeconds)
 {
-    if (!bCanLean)
-    {
-        return;
-    }
-	
-    GetCameraComponent()->SetRelativeLocation(UKismetMathLibrary::VInterpTo(
-        GetCameraComponent()->GetRelativeLocation(), DefaultCameraLocation + TargetLeanCameraOffset,
-        DeltaSeconds, LeanSpeed));
+	if (!EnumHasAnyFlags(CharacterState, EUSKCharacterState::Leaning))
+	{
+		return;
+	}
 
-    AController* FpsController = GetController();
-    const FRotator ControlRotation = FpsController->GetControlRotation();
-	const FRotator NewLeanRotation = UKismetMathLibrary::RInterpTo(ControlRotation,
-		FRotator(ControlRotation.Pitch, ControlRotation.Yaw, TargetLeanCameraRoll),
-		DeltaSeconds, LeanSpeed);
-    FpsController->SetControlRotation(NewLeanRotation);
-	CurrentLeanCameraRoll = NewLeanRotation.Roll;
+	// Without cosmetics the lean snaps to its target instead of being interpolated over multiple frames
+	const FVector TargetCameraLocation = DefaultCameraLocation + TargetLeanCameraOffset;
+	const FVector NewCameraLocation = bCosmeticsEnabled
+		? UKismetMathLibrary::VInterpTo(GetCameraComponent()->GetRelativeLocation(), TargetCameraLocation,
+			DeltaSeconds, LeanSpeed)
+		: TargetCameraLocation;
+	GetCameraComponent()->SetRelativeLocation(NewCameraLocation);
+
+	AController* FpsController = GetController();
+	if (IsValid(FpsController))
+	{
+		const FRotator ControlRotation = FpsController->GetControlRotation();
+		const FRotator TargetLeanRotation = FRotator(ControlRotation.Pitch, ControlRotation.Yaw, TargetLeanCameraRoll);
+		const FRotator NewLeanRotation = bCosmeticsEnabled
+			? UKismetMathLibrary::RInterpTo(ControlRotation, TargetLeanRotation, DeltaSeconds, LeanSpeed)
+			: TargetLeanRotation;
+		FpsController->SetControlRotation(NewLeanRotation);
+		CurrentLeanCameraRoll = NewLeanRotation.Roll;
+	}
+	else
+	{
+		CurrentLeanCameraRoll = TargetLeanCameraRoll;
+	}
+
+	if (NewCameraLocation.Equals(TargetCameraLocation, 0.01f) &&
+		FMath::IsNearlyEqual(CurrentLeanCameraRoll, TargetLeanCameraRoll, 0.01f))
+	{
+		SetCharacterState(EUSKCharacterState::Leaning, false);
+	}
 }
 
 /**
@@ -618,7 +1098,7 @@ void AUSKCharacter::Sprint()
 		return;
 	}
 
-	if (bIsCrouching)
+	if (IsCrouching())
 	{
 		bSprintQueued = true;
 		return;
@@ -633,8 +1113,8 @@ void AUSKCharacter::Sprint()
 void AUSKCharacter::StartSprinting()
 {
 	USK_LOG_TRACE("Starting to sprint");
-	bIsSprinting = true;
 	bSprintQueued = false;
+	SetCharacterState(EUSKCharacterState::Sprinting, true);
 }
 
 /**
@@ -642,14 +1122,14 @@ void AUSKCharacter::StartSprinting()
  */
 void AUSKCharacter::StopSprinting()
 {
-	if (!bIsSprinting)
+	if (!IsSprinting())
 	{
 		bSprintQueued = false;
 		return;
 	}
 	
 	USK_LOG_TRACE("Stopping sprint");
-	bIsSprinting = false;
+	SetCharacterState(EUSKCharacterState::Sprinting, false);
 }
 
 /**
@@ -663,10 +1143,9 @@ void AUSKCharacter::StartSliding()
 	}
 	
 	USK_LOG_TRACE("Start sliding");
-	bIsSliding = true;
 	CurrentSlidingTime = SlidingTime;
-	CurrentSlidingCooldown = SlidingCooldown;
 	SlideDirection = GetActorForwardVector();
+	SetCharacterState(EUSKCharacterState::Sliding, true);
 	UAudioUtils::PlayRandomSound(this, SlideSoundEffects);
 }
 
@@ -676,12 +1155,17 @@ void AUSKCharacter::StartSliding()
 void AUSKCharacter::StopSliding()
 {
 	USK_LOG_TRACE("Stop sliding");
+	if (IsSliding())
+	{
+		SlideCooldownEndTime = GetWorld()->GetTimeSeconds() + SlidingCooldown;
+	}
+
 	CurrentSlidingTime = 0.0f;
-	bIsSliding = false;
+	SetCharacterState(EUSKCharacterState::Sliding, false);
 
-	if (bIsCrouching && bStopCrouchingAfterSliding)
+	if (IsCrouching() && bStopCrouchingAfterSliding)
 	{
-		bIsEndingSlide = true;
+		SetCharacterState(EUSKCharacterState::EndingSlide, true);
 		StopCrouchingInternal();
 		bStopCrouchingAfterSliding = false;
 	}
@@ -693,48 +1177,36 @@ void AUSKCharacter::StopSliding()
  */
 void AUSKCharacter::UpdateSliding(const float DeltaSeconds)
 {
-	if (!bIsSliding && CurrentSlidingCooldown <= 0.0f)
-	{
-		return;
-	}
-
-	if (CurrentSlidingTime > 0.0f)
+	// Remote characters receive the slide direction from the moves of the owning client
+	if (!IsSliding() || !IsLocallyControlled())
 	{
-		CurrentSlidingTime -= DeltaSeconds;
-		AddMovementInput(SlideDirection, 1.0f, false);
-		if (CurrentSlidingTime <= 0.0f)
-		{
-			StopSliding();
-		}
-		
 		return;
 	}
 
-	CurrentSlidingCooldown -= DeltaSeconds;
-	if (CurrentSlidingCooldown <= 0.0f)
+	CurrentSlidingTime -= DeltaSeconds;
+	AddMovementInput(SlideDirection, 1.0f, false);
+	if (CurrentSlidingTime <= 0.0f)
 	{
 		StopSliding();
 	}
 }
 
 /**
- * @brief Update the current movement speed of the character
+ * @brief Add or remove ability states and update the movement speed and ticking if the states changed
+ * @param State The ability states to add or remove
+ * @param bEnabled Should the ability states be added?
  */
-void AUSKCharacter::UpdateMovementSpeed() const
+void AUSKCharacter::SetCharacterState(const EUSKCharacterState State, const bool bEnabled)
 {
-	if (bIsSliding)
+	const EUSKCharacterState NewState = bEnabled ? CharacterState | State : CharacterState & ~State;
+	if (NewState == CharacterState)
 	{
-		GetCharacterMovement()->MaxWalkSpeed = SlideSpeed;
 		return;
 	}
 
-	if (bIsCrouching)
-	{
-		GetCharacterMovement()->MaxWalkSpeed = CrouchSpeed;
-		return;
-	}
-
-	GetCharacterMovement()->MaxWalkSpeed = bIsSprinting ? SprintSpeed : MovementSpeed;
+	CharacterState = NewState;
+	UpdateMovementSpeed();
+	UpdateTickEnabled();
 }
 
 /**
@@ -743,7 +1215,7 @@ void AUSKCharacter::UpdateMovementSpeed() const
  */
 bool AUSKCharacter::CanLongJump() const
 {
-	return bCanLongJump && bCanSlide && bIsSliding;
+	return bCanLongJump && bCanSlide && IsSliding();
 }
 
 /**
@@ -753,19 +1225,48 @@ void AUSKCharacter::PerformLongJump()
 {
 	USK_LOG_TRACE("Performing long jump");
 
-	CurrentSlidingCooldown = 0.0f;
 	StopSliding();
+	SlideCooldownEndTime = 0.0f;
 	
 	Super::Jump();
-	const FVector LaunchVelocity = GetActorForwardVector() *
-		FVector(LongJumpVelocity.X, LongJumpVelocity.Y, 0.0f) +
-		FVector(0.0f, 0.0f, LongJumpVelocity.Z);
-	LaunchCharacter(LaunchVelocity, true, true);
+	RequestMovementLaunch(EUSKMovementLaunch::LongJump);
 	UAudioUtils::PlayRandomSound(this, JumpSoundEffects);
 
 	if (JumpParticleFx != nullptr)
 	{
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), JumpParticleFx,
+		UParticleFxUtils::SpawnParticleFx(GetWorld(), JumpParticleFx,
 			GetActorLocation() + JumpParticleFxSpawnOffset);
 	}
 }
+
+/**
+ * @brief Let the movement component apply the velocity and gravity changes of an ability during the next move
+ * @param Launch The ability to apply
+ */
+void AUSKCharacter::RequestMovementLaunch(const EUSKMovementLaunch Launch)
+{
+	UUSKCharacterMovementComponent* Movement = Cast<UUSKCharacterMovementComponent>(GetCharacterMovement());
+	if (IsValid(Movement))
+	{
+		Movement->RequestLaunch(Launch);
+		return;
+	}
+
+	ApplyMovementLaunch(Launch);
+}
+
+/**
+ * @brief Mirror the replicated abilities on a simulated proxy
+ */
+void AUSKCharacter::OnRep_ReplicatedAbilityState()
+{
+	if (GetLocalRole() != ROLE_SimulatedProxy)
+	{
+		return;
+	}
+
+	EUSKCharacterState State;
+	uint8 LeanRoll;
+	UUSKCharacterMovementComponent::UnpackAbilityState(ReplicatedAbilityState, State, LeanRoll);
+	ApplyNetworkAbilityState(State, UUSKCharacterMovementComponent::DequantizeLeanRoll(LeanRoll, LeanRotation));
+}
@@ -2,13 +2,18 @@
 
 #pragma once
 
+#include "CharacterSignificanceBucket.h"
 #include "ShadowDecal.h"
+#include "USKCharacterAnimationSnapshot.h"
+#include "USKCharacterState.h"
+#include "USKMovementLaunch.h"
 #include "InputActionValue.h"
 #include "NiagaraCommon.h"
 #include "Camera/CameraShakeBase.h"
-#include "Components/TimelineComponent.h"
+#include "USK/Benchmark/InputRecordingFrame.h"
 #include "GameFramework/Character.h"
 #include "USK/Weapons/Weapon.h"
+#include "USK/Weapons/WeaponLoadoutComponent.h"
 #include "USKCharacter.generated.h"
 
 class UInputAction;
@@ -22,6 +27,17 @@ class USK_API AUSKCharacter : public ACharacter
 {
 	GENERATED_BODY()
 
+	/**
+	 * @brief Event used to notify other classes when the character performs a double jump
+	 */
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FCharacterDoubleJumped);
+
+	/**
+	 * @brief Event used to notify other classes when the current weapon of the character changed
+	 * @param NewWeapon The new weapon or nullptr if the character is unarmed
+	 */
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FCharacterWeaponChanged, AWeapon*, NewWeapon);
+
 	/**
 	 * @brief The camera used by the character
 	 */
@@ -30,11 +46,11 @@ class USK_API AUSKCharacter : public ACharacter
 	class UCameraComponent* CameraComponent;
 
 	/**
-	 * @brief The timeline component used for smooth crouching
+	 * @brief The loadout component used to keep the weapons of the character alive between swaps
 	 */
 	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character",
 		meta=(AllowPrivateAccess = "true"))
-	class UTimelineComponent* CrouchTimeline;
+	UWeaponLoadoutComponent* WeaponLoadout;
 
 public:
 	/**
@@ -232,6 +248,12 @@ public:
 		meta = (EditCondition = "CanDoubleJump", EditConditionHides))
 	bool IsDoubleJumping;
 
+	/**
+	 * @brief Event used to notify other classes when the character performs a double jump
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Ultimate Starter Kit|Character|Jump")
+	FCharacterDoubleJumped OnDoubleJump;
+
 	/**
 	 * @brief Is the character allowed to perform a long jump?
 	 */
@@ -419,10 +441,17 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Character|Weapons")
 	TSubclassOf<AWeapon> DefaultWeaponClass;
 
+	/**
+	 * @brief Event used to notify other classes when the current weapon of the character changed
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Ultimate Starter Kit|Character|Weapons")
+	FCharacterWeaponChanged OnWeaponChanged;
+
 	/**
 	 * @brief Create a new instance of the AUSKCharacter actor
+	 * @param ObjectInitializer The object initializer used to override the default subobject classes
 	 */
-	AUSKCharacter();
+	explicit AUSKCharacter(const FObjectInitializer& ObjectInitializer);
 
 	/**
 	 * @brief Get the camera used by the character
@@ -431,6 +460,13 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character|Camera")
 	UCameraComponent* GetCameraComponent() const;
 
+	/**
+	 * @brief Get the loadout component used to keep the weapons of the character alive between swaps
+	 * @return The loadout component of the character
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character|Weapons")
+	UWeaponLoadoutComponent* GetWeaponLoadout() const;
+
 	/**
 	 * @brief Set the current weapon used by the character
 	 * @param NewWeapon The new weapon
@@ -452,6 +488,13 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character|Movement")
 	bool IsCrouching() const;
 
+	/**
+	 * @brief Check if the character is sprinting
+	 * @return A boolean value indicating if the character is sprinting
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character|Movement")
+	bool IsSprinting() const;
+
 	/**
 	 * @brief Check if the character is busy ending the crouch
 	 * @return A boolean value indicating if the character is busy ending the crouch
@@ -494,18 +537,121 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character|Sliding")
 	bool IsEndingSlide() const;
 
+	/**
+	 * @brief Get the bitfield containing the current ability states of the character
+	 * @return The current ability states of the character
+	 */
+	EUSKCharacterState GetCharacterState() const;
+
+	/**
+	 * @brief Check if the character is in any of the specified ability states
+	 * @param State The ability states to check
+	 * @return A boolean value indicating if the character is in any of the specified ability states
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character")
+	bool HasCharacterState(UPARAM(meta=(Bitmask, BitmaskEnum = "EUSKCharacterState")) int32 State) const;
+
+	/**
+	 * @brief Update the max walk speed of the character. Call this after changing the movement speeds at runtime
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Character|Movement")
+	void UpdateMovementSpeed() const;
+
+	/**
+	 * @brief Capture the state used by the animation instance. Must be called on the game thread
+	 * @param Snapshot The snapshot to fill
+	 */
+	virtual void FillAnimationSnapshot(FUSKCharacterAnimationSnapshot& Snapshot) const;
+
+	/**
+	 * @brief Get the significance bucket assigned to the character
+	 * @return The index of the significance bucket or -1 if the character is updated at the full rate
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character|Significance")
+	int GetSignificanceBucket() const;
+
+	/**
+	 * @brief Check if cosmetic work like lean interpolation and the shadow decal is enabled
+	 * @return A boolean value indicating if cosmetic work is enabled
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character|Significance")
+	bool AreCosmeticsEnabled() const;
+
+	/**
+	 * @brief Apply the update rates of a significance bucket to the character, its animations, weapon and shadow
+	 * @param BucketIndex The index of the significance bucket
+	 * @param Bucket The significance bucket
+	 */
+	virtual void SetSignificanceBucket(int BucketIndex, const FCharacterSignificanceBucket& Bucket);
+
+	/**
+	 * @brief Feed a frame of an input recording to the character as if the input actions were triggered
+	 * @param Frame The input action values of the current frame
+	 * @param PreviousFrame The input action values of the previous frame, used to detect pressed and released buttons
+	 */
+	void ApplyRecordedInput(const FInputRecordingFrame& Frame, const FInputRecordingFrame& PreviousFrame);
+
+	/**
+	 * @brief Get the direction of the current slide
+	 * @return The direction of the current slide
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character|Sliding")
+	FVector GetSlideDirection() const;
+
+	/**
+	 * @brief Apply the velocity and gravity changes of an ability. Called by the movement component during a move
+	 * @param Launch The ability to apply
+	 */
+	virtual void ApplyMovementLaunch(EUSKMovementLaunch Launch);
+
+	/**
+	 * @brief Mirror the abilities of a character that is controlled on another machine
+	 * @param State The abilities that affect the movement of the character
+	 * @param LeanRoll The lean camera roll of the character
+	 */
+	void ApplyNetworkAbilityState(EUSKCharacterState State, float LeanRoll);
+
+	/**
+	 * @brief Set the packed abilities that are replicated to the simulated proxies of the character
+	 * @param PackedState The packed abilities
+	 */
+	void SetReplicatedAbilityState(uint8 PackedState);
+
+	/**
+	 * @brief Get the properties that are replicated for the lifetime of the character
+	 * @param OutLifetimeProps The replicated properties
+	 */
+	virtual void GetLifetimeReplicatedProps(TArray<FLifetimeProperty>& OutLifetimeProps) const override;
+
 protected:
 	/**
 	 * @brief Overridable native event for when play begins for this actor
 	 */
 	virtual void BeginPlay() override;
 
+	/**
+	 * @brief Overridable function called whenever this actor is being removed from a level
+	 * @param EndPlayReason The reason this actor is being removed
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
 	/**
 	 * @brief Event called every frame, if ticking is enabled
 	 * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
 	 */
 	virtual void Tick(float DeltaSeconds) override;
 
+	/**
+	 * @brief Check if the character needs to tick to update its abilities
+	 * @return A boolean value indicating if the character needs to tick
+	 */
+	virtual bool IsTickRequired() const;
+
+	/**
+	 * @brief Enable or disable ticking based on the current ability states of the character
+	 */
+	void UpdateTickEnabled();
+
 	/**
 	 * @brief Tell client that the Pawn is begin restarted
 	 */
@@ -587,36 +733,62 @@ private:
 	 */
 	UPROPERTY()
 	AWeapon* Weapon;
+
+	/**
+	 * @brief A reference to the shadow decal spawned for the character
+	 */
+	UPROPERTY()
+	AShadowDecal* ShadowDecal;
+
+	/**
+	 * @brief The index of the significance bucket assigned to the character
+	 */
+	int SignificanceBucket = -1;
+
+	/**
+	 * @brief The amount of seconds between ticks of the weapon
+	 */
+	float WeaponTickInterval;
+
+	/**
+	 * @brief Is cosmetic work like lean interpolation and the shadow decal enabled?
+	 */
+	bool bCosmeticsEnabled = true;
 	
 	/**
-	 * @brief Can the character perform a coyote jump?
+	 * @brief The time at which the coyote jump window closes
 	 */
-	bool CanPerformCoyoteJump;
+	float CoyoteJumpEndTime = -1.0f;
 
 	/**
-	 * @brief Was a coyote jump performed?
+	 * @brief The time at which the stomp velocity is applied after the zero gravity duration or -1 if not scheduled
 	 */
-	bool CoyoteJumpPerformed;
+	float StompZeroGravityEndTime = -1.0f;
+
+	/**
+	 * @brief The time at which the stomping values are reset or -1 if not scheduled
+	 */
+	float StompResetTime = -1.0f;
 
 	/**
-	 * @brief Is the character crouching?
+	 * @brief The time at which the stomp jump window closes or -1 if not scheduled
 	 */
-	bool bIsCrouching;
+	float StompJumpEndTime = -1.0f;
 
 	/**
-	 * @brief Is the character busy ending the crouch?
+	 * @brief Was a coyote jump performed?
 	 */
-	bool bIsEndingCrouch;
+	bool CoyoteJumpPerformed;
 
 	/**
-	 * @brief Is the character stomping?
+	 * @brief The current ability states of the character
 	 */
-	bool bIsStomping;
+	EUSKCharacterState CharacterState;
 
 	/**
-	 * @brief Is the character allowed to perform a stomp jump?
+	 * @brief Does the Blueprint class implement the tick event?
 	 */
-	bool bIsStompJumpAllowed;
+	bool bHasBlueprintTick;
 
 	/**
 	 * @brief The default capsule size of the character
@@ -624,14 +796,24 @@ private:
 	float DefaultCapsuleSize;
 
 	/**
-	 * @brief Event used to smoothly adjust the capsule size during crouching
+	 * @brief The current playback position of the crouch curve
+	 */
+	float CrouchCurvePosition;
+
+	/**
+	 * @brief The time of the last key of the crouch curve
+	 */
+	float CrouchCurveEndTime;
+
+	/**
+	 * @brief The direction the crouch curve is played in (1 to crouch, -1 to stand up and 0 if stopped)
 	 */
-	FOnTimelineFloat CrouchTimelineUpdateEvent;
+	float CrouchCurveDirection;
 
 	/**
-	 * @brief The current amount of time the character is in the air
+	 * @brief The time at which the character started falling
 	 */
-	float AirTime;
+	float FallStartTime;
 
 	/**
 	 * @brief The default camera location
@@ -653,30 +835,20 @@ private:
 	 */
 	float CurrentLeanCameraRoll;
 
-	/**
-	 * @brief Is the character sprinting?
-	 */
-	bool bIsSprinting;
-
 	/**
 	 * @brief Is sprinting queued?
 	 */
 	bool bSprintQueued;
 
-	/**
-	 * @brief Is the character sliding?
-	 */
-	bool bIsSliding;
-
 	/**
 	 * @brief The amount of time remaining for the current slide
 	 */
 	float CurrentSlidingTime;
 
 	/**
-	 * @brief The amount of time remaining for the slide cooldown
+	 * @brief The time at which the slide cooldown ends
 	 */
-	float CurrentSlidingCooldown;
+	float SlideCooldownEndTime;
 
 	/**
 	 * @brief The direction of the current slide
@@ -689,9 +861,10 @@ private:
 	bool bStopCrouchingAfterSliding;
 
 	/**
-	 * @brief Is the character busy ending the slide?
+	 * @brief The abilities and quantized lean camera roll replicated to the simulated proxies of the character
 	 */
-	bool bIsEndingSlide;
+	UPROPERTY(ReplicatedUsing = OnRep_ReplicatedAbilityState)
+	uint8 ReplicatedAbilityState;
 
 	/**
 	 * @brief Move the character
@@ -706,10 +879,21 @@ private:
 	void RotateCamera(const FInputActionValue& Input);
 
 	/**
-	 * @brief Reset the coyote jump values
+	 * @brief Check if the coyote jump window is open
+	 * @return A boolean value indicating if the character can perform a coyote jump
 	 */
-	UFUNCTION()
-	void ResetCoyoteJump();
+	bool IsCoyoteJumpWindowOpen() const;
+
+	/**
+	 * @brief Check if any of the ability windows are waiting to close
+	 * @return A boolean value indicating if an ability window is scheduled
+	 */
+	bool HasScheduledAbilityWindow() const;
+
+	/**
+	 * @brief Close the ability windows that expired since the last update
+	 */
+	void UpdateAbilityWindows();
 
 	/**
 	 * @brief Stop crouching
@@ -717,27 +901,36 @@ private:
 	void StopCrouchingInternal();
 
 	/**
-	 * @brief Called after the crouch timeline is updated
+	 * @brief Start playing the crouch curve
+	 * @param bForward Should the curve be played forward to crouch or in reverse to stand up?
 	 */
-	UFUNCTION()
-	void OnCrouchTimelineUpdated(float Value);
+	void PlayCrouchCurve(bool bForward);
+
+	/**
+	 * @brief Advance the crouch curve and update the capsule size
+	 * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+	 */
+	void UpdateCrouching(const float DeltaSeconds);
+
+	/**
+	 * @brief Update the capsule size using a value of the crouch curve
+	 * @param Value The value of the crouch curve
+	 */
+	void ApplyCrouchCurve(float Value);
 
 	/**
 	 * @brief Perform a stomp after the zero gravity duration has elapsed
 	 */
-	UFUNCTION()
 	void StompAfterZeroGravity();
 
 	/**
 	 * @brief Reset the stomping values
 	 */
-	UFUNCTION()
 	void ResetStomping();
 
 	/**
 	 * @brief Reset the stomp jump values
 	 */
-	UFUNCTION()
 	void ResetStompJump();
 
 	/**
@@ -788,9 +981,11 @@ private:
 	void UpdateSliding(const float DeltaSeconds);
 
 	/**
-	 * @brief Update the current movement speed of the character
+	 * @brief Add or remove ability states and update the movement speed and ticking if the states changed
+	 * @param State The ability states to add or remove
+	 * @param bEnabled Should the ability states be added?
 	 */
-	void UpdateMovementSpeed() const;
+	void SetCharacterState(EUSKCharacterState State, bool bEnabled);
 
 	/**
 	 * @brief Check if the character can perform a long jump
@@ -802,4 +997,16 @@ private:
 	 * @brief Perform a long jump
 	 */
 	void PerformLongJump();
+
+	/**
+	 * @brief Let the movement component apply the velocity and gravity changes of an ability during the next move
+	 * @param Launch The ability to apply
+	 */
+	void RequestMovementLaunch(EUSKMovementLaunch Launch);
+
+	/**
+	 * @brief Mirror the replicated abilities on a simulated proxy
+	 */
+	UFUNCTION()
+	void OnRep_ReplicatedAbilityState();
 };
\ No newline at end of file
@@ -1,10 +1,20 @@
 ﻿// Created by Henry Jooste
 
 #include "USKCharacterAnimationInstance.h"
+#include "Engine/AssetManager.h"
 #include "GameFramework/PawnMovementComponent.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "USK/Logger/Log.h"
 
+/**
+ * @brief Native initialization override point
+ */
+void UUSKCharacterAnimationInstance::NativeInitializeAnimation()
+{
+	Super::NativeInitializeAnimation();
+	UpdateAnimations();
+}
+
 /**
  * @brief Executed when begin play is called on the owning component
  */
@@ -14,6 +24,13 @@ void UUSKCharacterAnimationInstance::NativeBeginPlay()
 
 	USK_LOG_TRACE("Initializing character animation instance");
 	Character = dynamic_cast<AUSKCharacter*>(TryGetPawnOwner());
+	if (Character != nullptr)
+	{
+		Character->OnDoubleJump.AddUniqueDynamic(this, &UUSKCharacterAnimationInstance::OnCharacterDoubleJump);
+		Character->OnWeaponChanged.AddUniqueDynamic(this, &UUSKCharacterAnimationInstance::OnCharacterWeaponChanged);
+	}
+
+	UpdateAnimations();
 }
 
 /**
@@ -23,38 +40,38 @@ void UUSKCharacterAnimationInstance::NativeBeginPlay()
 void UUSKCharacterAnimationInstance::NativeUpdateAnimation(float DeltaSeconds)
 {
 	Super::NativeUpdateAnimation(DeltaSeconds);
-	if (Character == nullptr)
+	if (bAnimationsChanged)
 	{
-		USK_LOG_WARNING("Character is nullptr");
-		return;
+		Animations = PendingAnimations;
+		bAnimationsChanged = false;
 	}
 
-	const float NewMovementSpeed = UKismetMathLibrary::VSizeXY(Character->GetMovementComponent()->Velocity);
-	MovementSpeed = FMath::Lerp(MovementSpeed, NewMovementSpeed, DeltaSeconds * MovementBlendSpeed);
-	IsInAir = Character->GetMovementComponent()->IsFalling();
-	bIsCrouching = !IsInAir && Character->IsCrouching();
-	bIsEndingCrouch = Character->IsEndingCrouch();
-	bIsSliding = !IsInAir && Character->IsSliding();
-	bIsEndingSlide = Character->IsEndingSlide();
-    bIsStomping = Character->IsStomping();
-    bIsStompStarting = Character->IsStompStarting();
-	LeanCameraRoll = Character->GetLeanCameraRoll() * LeanCameraRotationModifier;
-
-	if (!Character->IsDoubleJumping)
+	if (Character == nullptr)
 	{
-		IsDoubleJumping = false;
+		USK_LOG_WARNING("Character is nullptr");
 		return;
 	}
 
-	if (!IsDoubleJumping)
-	{
-		IsDoubleJumping = true;
-		return;
-	}
+	Character->FillAnimationSnapshot(Snapshot);
+	Snapshot.bDoubleJumped = bDoubleJumpPending;
+	bDoubleJumpPending = false;
+
+#if ENGINE_MAJOR_VERSION < 5
+	UpdateFromSnapshot(DeltaSeconds);
+#endif
+}
 
-	USK_LOG_TRACE("Resetting character double jump");
-	Character->IsDoubleJumping = false;
+#if ENGINE_MAJOR_VERSION >= 5
+/**
+ * @brief Native thread safe update override point. Executed on a worker thread if multi-threaded animation is enabled
+ * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+ */
+void UUSKCharacterAnimationInstance::NativeThreadSafeUpdateAnimation(float DeltaSeconds)
+{
+	Super::NativeThreadSafeUpdateAnimation(DeltaSeconds);
+	UpdateFromSnapshot(DeltaSeconds);
 }
+#endif
 
 /**
  * @brief Get the idle animation based on the current armed state
@@ -62,7 +79,7 @@ void UUSKCharacterAnimationInstance::NativeUpdateAnimation(float DeltaSeconds)
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetIdleAnimation() const
 {
-	return GetAnimation(IdleAnimation, IdleWeaponOneHandedAnimation, IdleWeaponTwoHandedAnimation);
+	return Animations.IdleAnimation;
 }
 
 /**
@@ -71,7 +88,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetIdleAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetWalkAnimation() const
 {
-	return GetAnimation(WalkAnimation, WalkWeaponOneHandedAnimation, WalkWeaponTwoHandedAnimation);
+	return Animations.WalkAnimation;
 }
 
 /**
@@ -80,7 +97,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetWalkAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetRunAnimation() const
 {
-	return GetAnimation(RunAnimation, RunWeaponOneHandedAnimation, RunWeaponTwoHandedAnimation);
+	return Animations.RunAnimation;
 }
 
 /**
@@ -89,7 +106,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetRunAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetSprintAnimation() const
 {
-	return GetAnimation(SprintAnimation, SprintWeaponOneHandedAnimation, SprintWeaponTwoHandedAnimation);
+	return Animations.SprintAnimation;
 }
 
 /**
@@ -98,7 +115,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetSprintAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetJumpAnimation() const
 {
-	return GetAnimation(JumpAnimation, JumpWeaponOneHandedAnimation, JumpWeaponTwoHandedAnimation);
+	return Animations.JumpAnimation;
 }
 
 /**
@@ -107,7 +124,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetJumpAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetDoubleJumpAnimation() const
 {
-	return GetAnimation(DoubleJumpAnimation, DoubleJumpWeaponOneHandedAnimation, DoubleJumpWeaponTwoHandedAnimation);
+	return Animations.DoubleJumpAnimation;
 }
 
 /**
@@ -116,9 +133,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetDoubleJumpAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetFallAnimation() const
 {
-	return bIsStomping
-		? GetAnimation(StompFallAnimation, StompFallWeaponOneHandedAnimation, StompFallWeaponTwoHandedAnimation)
-		: GetAnimation(FallAnimation, FallWeaponOneHandedAnimation, FallWeaponTwoHandedAnimation);
+	return bIsStomping ? Animations.StompFallAnimation : Animations.FallAnimation;
 }
 
 /**
@@ -127,9 +142,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetFallAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetLandAnimation() const
 {
-	return bIsStomping
-		? GetAnimation(StompLandAnimation, StompLandWeaponOneHandedAnimation, StompLandWeaponTwoHandedAnimation)
-		: GetAnimation(LandAnimation, LandWeaponOneHandedAnimation, LandWeaponTwoHandedAnimation);
+	return bIsStomping ? Animations.StompLandAnimation : Animations.LandAnimation;
 }
 
 /**
@@ -138,8 +151,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetLandAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetCrouchStartAnimation() const
 {
-	return GetAnimation(CrouchStartAnimation,
-		CrouchStartWeaponOneHandedAnimation, CrouchStartWeaponTwoHandedAnimation);
+	return Animations.CrouchStartAnimation;
 }
 
 /**
@@ -148,8 +160,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetCrouchStartAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetCrouchEndAnimation() const
 {
-	return GetAnimation(CrouchEndAnimation,
-		CrouchEndWeaponOneHandedAnimation, CrouchEndWeaponTwoHandedAnimation);
+	return Animations.CrouchEndAnimation;
 }
 
 /**
@@ -158,8 +169,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetCrouchEndAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetCrouchIdleAnimation() const
 {
-	return GetAnimation(CrouchIdleAnimation,
-		CrouchIdleWeaponOneHandedAnimation, CrouchIdleWeaponTwoHandedAnimation);
+	return Animations.CrouchIdleAnimation;
 }
 
 /**
@@ -168,8 +178,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetCrouchIdleAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetCrouchWalkAnimation() const
 {
-	return GetAnimation(CrouchWalkAnimation,
-		CrouchWalkWeaponOneHandedAnimation, CrouchWalkWeaponTwoHandedAnimation);
+	return Animations.CrouchWalkAnimation;
 }
 
 /**
@@ -178,7 +187,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetCrouchWalkAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetStompStartAnimation() const
 {
-	return GetAnimation(StompStartAnimation, StompStartWeaponOneHandedAnimation, StompStartWeaponTwoHandedAnimation);
+	return Animations.StompStartAnimation;
 }
 
 /**
@@ -187,7 +196,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetStompStartAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetSlideStartAnimation() const
 {
-	return GetAnimation(SlideStartAnimation, SlideStartWeaponOneHandedAnimation, SlideStartWeaponTwoHandedAnimation);
+	return Animations.SlideStartAnimation;
 }
 
 /**
@@ -196,7 +205,7 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetSlideStartAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetSlideEndAnimation() const
 {
-	return GetAnimation(SlideEndAnimation, SlideEndWeaponOneHandedAnimation, SlideEndWeaponTwoHandedAnimation);
+	return Animations.SlideEndAnimation;
 }
 
 /**
@@ -205,25 +214,28 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetSlideEndAnimation() const
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetSlideLoopAnimation() const
 {
-	return GetAnimation(SlideLoopAnimation, SlideLoopWeaponOneHandedAnimation, SlideLoopWeaponTwoHandedAnimation);
+	return Animations.SlideLoopAnimation;
 }
 
 /**
- * @brief Get an animation based on the current armed state
+ * @brief Get an animation based on an armed state
  * @param UnarmedAnimation The unarmed animation
  * @param WeaponOneHandedAnimation The one handed weapon animation
  * @param WeaponTwoHandedAnimation The two handed weapon animation
+ * @param bHasWeapon Is the character holding a weapon?
+ * @param WeaponType The type of the weapon held by the character
  * @return The animation to play
  */
 UAnimSequence* UUSKCharacterAnimationInstance::GetAnimation(UAnimSequence* UnarmedAnimation,
-	UAnimSequence* WeaponOneHandedAnimation, UAnimSequence* WeaponTwoHandedAnimation) const
+	UAnimSequence* WeaponOneHandedAnimation, UAnimSequence* WeaponTwoHandedAnimation, const bool bHasWeapon,
+	const EWeaponType WeaponType)
 {
-	if (!IsValid(Character) || !IsValid(Character->GetWeapon()))
+	if (!bHasWeapon)
 	{
 		return UnarmedAnimation;
 	}
 
-	switch (Character->GetWeapon()->WeaponType)
+	switch (WeaponType)
 	{
 	case EWeaponType::WeaponOneHanded:
 		return WeaponOneHandedAnimation;
@@ -233,4 +245,150 @@ UAnimSequence* UUSKCharacterAnimationInstance::GetAnimation(UAnimSequence* Unarm
 		USK_LOG_ERROR("Invalid weapon type");
 		return nullptr;
 	}
+}
+
+/**
+ * @brief Resolve the animations of the current armed state, loading them first if required
+ */
+void UUSKCharacterAnimationInstance::UpdateAnimations()
+{
+	const AWeapon* Weapon = IsValid(Character) ? Character->GetWeapon() : nullptr;
+	const bool bHasWeapon = IsValid(Weapon);
+	const EWeaponType WeaponType = bHasWeapon ? Weapon->WeaponType : EWeaponType::WeaponOneHanded;
+	if (AnimationSet == nullptr)
+	{
+		ResolveAnimations(bHasWeapon, WeaponType);
+		return;
+	}
+
+	TSharedPtr<FStreamableHandle>& LoadHandle = GetLoadHandle(bHasWeapon, WeaponType);
+	if (!LoadHandle.IsValid())
+	{
+		TArray<FSoftObjectPath> Paths;
+		AnimationSet->GetAssetPaths(bHasWeapon, WeaponType, Paths);
+		if (Paths.Num() > 0)
+		{
+			USK_LOG_TRACE(*FString::Format(TEXT("Loading {0} character animations"), { Paths.Num() }));
+			bIsRequestingAnimations = true;
+			LoadHandle = UAssetManager::GetStreamableManager().RequestAsyncLoad(Paths,
+				FStreamableDelegate::CreateUObject(this, &UUSKCharacterAnimationInstance::OnAnimationsLoaded));
+			bIsRequestingAnimations = false;
+		}
+	}
+
+	if (LoadHandle.IsValid() && !LoadHandle->HasLoadCompleted())
+	{
+		return;
+	}
+
+	AnimationSet->ResolveAnimations(bHasWeapon, WeaponType, PendingAnimations);
+	bAnimationsChanged = true;
+}
+
+/**
+ * @brief Resolve the animations of an armed state using the individual animation properties
+ * @param bHasWeapon Is the character holding a weapon?
+ * @param WeaponType The type of the weapon held by the character
+ */
+void UUSKCharacterAnimationInstance::ResolveAnimations(const bool bHasWeapon, const EWeaponType WeaponType)
+{
+	PendingAnimations.IdleAnimation = GetAnimation(IdleAnimation,
+		IdleWeaponOneHandedAnimation, IdleWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.WalkAnimation = GetAnimation(WalkAnimation,
+		WalkWeaponOneHandedAnimation, WalkWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.RunAnimation = GetAnimation(RunAnimation,
+		RunWeaponOneHandedAnimation, RunWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.SprintAnimation = GetAnimation(SprintAnimation,
+		SprintWeaponOneHandedAnimation, SprintWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.JumpAnimation = GetAnimation(JumpAnimation,
+		JumpWeaponOneHandedAnimation, JumpWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.DoubleJumpAnimation = GetAnimation(DoubleJumpAnimation,
+		DoubleJumpWeaponOneHandedAnimation, DoubleJumpWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.FallAnimation = GetAnimation(FallAnimation,
+		FallWeaponOneHandedAnimation, FallWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.LandAnimation = GetAnimation(LandAnimation,
+		LandWeaponOneHandedAnimation, LandWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.CrouchStartAnimation = GetAnimation(CrouchStartAnimation,
+		CrouchStartWeaponOneHandedAnimation, CrouchStartWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.CrouchEndAnimation = GetAnimation(CrouchEndAnimation,
+		CrouchEndWeaponOneHandedAnimation, CrouchEndWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.CrouchIdleAnimation = GetAnimation(CrouchIdleAnimation,
+		CrouchIdleWeaponOneHandedAnimation, CrouchIdleWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.CrouchWalkAnimation = GetAnimation(CrouchWalkAnimation,
+		CrouchWalkWeaponOneHandedAnimation, CrouchWalkWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.StompStartAnimation = GetAnimation(StompStartAnimation,
+		StompStartWeaponOneHandedAnimation, StompStartWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.StompFallAnimation = GetAnimation(StompFallAnimation,
+		StompFallWeaponOneHandedAnimation, StompFallWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.StompLandAnimation = GetAnimation(StompLandAnimation,
+		StompLandWeaponOneHandedAnimation, StompLandWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.SlideStartAnimation = GetAnimation(SlideStartAnimation,
+		SlideStartWeaponOneHandedAnimation, SlideStartWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.SlideEndAnimation = GetAnimation(SlideEndAnimation,
+		SlideEndWeaponOneHandedAnimation, SlideEndWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	PendingAnimations.SlideLoopAnimation = GetAnimation(SlideLoopAnimation,
+		SlideLoopWeaponOneHandedAnimation, SlideLoopWeaponTwoHandedAnimation, bHasWeapon, WeaponType);
+	bAnimationsChanged = true;
+}
+
+/**
+ * @brief Get the handle keeping the animations of an armed state loaded
+ * @param bHasWeapon Is the character holding a weapon?
+ * @param WeaponType The type of the weapon held by the character
+ * @return The handle keeping the animations loaded
+ */
+TSharedPtr<FStreamableHandle>& UUSKCharacterAnimationInstance::GetLoadHandle(const bool bHasWeapon,
+	const EWeaponType WeaponType)
+{
+	return bHasWeapon ? WeaponLoadHandles.FindOrAdd(WeaponType) : UnarmedLoadHandle;
+}
+
+/**
+ * @brief Called when the animations requested from the streamable manager are loaded
+ */
+void UUSKCharacterAnimationInstance::OnAnimationsLoaded()
+{
+	if (bIsRequestingAnimations)
+	{
+		return;
+	}
+
+	USK_LOG_TRACE("Character animations loaded");
+	UpdateAnimations();
+}
+
+/**
+ * @brief Called when the current weapon of the character changed
+ * @param NewWeapon The new weapon or nullptr if the character is unarmed
+ */
+void UUSKCharacterAnimationInstance::OnCharacterWeaponChanged(AWeapon* NewWeapon)
+{
+	UpdateAnimations();
+}
+
+/**
+ * @brief Update the animation properties using the captured state of the character
+ * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+ */
+void UUSKCharacterAnimationInstance::UpdateFromSnapshot(const float DeltaSeconds)
+{
+	const float NewMovementSpeed = UKismetMathLibrary::VSizeXY(Snapshot.Velocity);
+	MovementSpeed = FMath::Lerp(MovementSpeed, NewMovementSpeed, DeltaSeconds * MovementBlendSpeed);
+	IsInAir = Snapshot.bIsFalling;
+	bIsCrouching = !IsInAir && EnumHasAnyFlags(Snapshot.CharacterState, EUSKCharacterState::Crouching);
+	bIsEndingCrouch = EnumHasAnyFlags(Snapshot.CharacterState, EUSKCharacterState::EndingCrouch);
+	bIsSliding = !IsInAir && EnumHasAnyFlags(Snapshot.CharacterState, EUSKCharacterState::Sliding);
+	bIsEndingSlide = EnumHasAnyFlags(Snapshot.CharacterState, EUSKCharacterState::EndingSlide);
+	bIsStomping = EnumHasAnyFlags(Snapshot.CharacterState, EUSKCharacterState::Stomping);
+	bIsStompStarting = Snapshot.bIsStompStarting;
+	LeanCameraRoll = Snapshot.LeanCameraRoll * LeanCameraRotationModifier;
+	IsDoubleJumping = Snapshot.bDoubleJumped;
+}
+
+/**
+ * @brief Called when the character performs a double jump
+ */
+void UUSKCharacterAnimationInstance::OnCharacterDoubleJump()
+{
+	bDoubleJumpPending = true;
 }
\ No newline at end of file
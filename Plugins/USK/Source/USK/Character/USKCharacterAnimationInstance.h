@@ -3,7 +3,10 @@
 #pragma once
 
 #include "Animation/AnimInstance.h"
+#include "Engine/StreamableManager.h"
 #include "USKCharacter.h"
+#include "USKCharacterAnimations.h"
+#include "USKCharacterAnimationSet.h"
 #include "USKCharacterAnimationInstance.generated.h"
 
 /**
@@ -15,6 +18,12 @@ class USK_API UUSKCharacterAnimationInstance : public UAnimInstance
 	GENERATED_BODY()
 
 public:
+	/**
+	 * @brief The animations used for each armed state. The individual animations are used if this is not set
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Character|Animations")
+	UUSKCharacterAnimationSet* AnimationSet;
+
 	/**
 	 * @brief The animation used when the character is in the idle state while unarmed
 	 */
@@ -418,6 +427,11 @@ public:
 	bool bIsEndingSlide;
 
 protected:
+	/**
+	 * @brief Native initialization override point
+	 */
+	virtual void NativeInitializeAnimation() override;
+
 	/**
 	 * @brief Executed when begin play is called on the owning component
 	 */
@@ -429,6 +443,14 @@ protected:
 	 */
 	virtual void NativeUpdateAnimation(float DeltaSeconds) override;
 
+#if ENGINE_MAJOR_VERSION >= 5
+	/**
+	 * @brief Native thread safe update override point. Executed on a worker thread if multi-threaded animation is enabled
+	 * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+	 */
+	virtual void NativeThreadSafeUpdateAnimation(float DeltaSeconds) override;
+#endif
+
 	/**
 	 * @brief Get the idle animation based on the current armed state
 	 * @return The idle animation to play
@@ -549,12 +571,100 @@ private:
 	AUSKCharacter* Character;
 
 	/**
-	 * @brief Get an animation based on the current armed state
+	 * @brief The state of the character captured on the game thread
+	 */
+	FUSKCharacterAnimationSnapshot Snapshot;
+
+	/**
+	 * @brief Did the character perform a double jump since the previous snapshot?
+	 */
+	bool bDoubleJumpPending;
+
+	/**
+	 * @brief The animations used for the current armed state
+	 */
+	UPROPERTY()
+	FUSKCharacterAnimations Animations;
+
+	/**
+	 * @brief The animations resolved on the game thread that will be used from the next update
+	 */
+	UPROPERTY()
+	FUSKCharacterAnimations PendingAnimations;
+
+	/**
+	 * @brief Were the pending animations resolved since the previous update?
+	 */
+	bool bAnimationsChanged;
+
+	/**
+	 * @brief Is the animation set busy requesting animations from the streamable manager?
+	 */
+	bool bIsRequestingAnimations;
+
+	/**
+	 * @brief The handle keeping the unarmed animations loaded
+	 */
+	TSharedPtr<FStreamableHandle> UnarmedLoadHandle;
+
+	/**
+	 * @brief The handles keeping the animations of each weapon type loaded
+	 */
+	TMap<EWeaponType, TSharedPtr<FStreamableHandle>> WeaponLoadHandles;
+
+	/**
+	 * @brief Update the animation properties using the captured state of the character
+	 * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+	 */
+	void UpdateFromSnapshot(float DeltaSeconds);
+
+	/**
+	 * @brief Called when the character performs a double jump
+	 */
+	UFUNCTION()
+	void OnCharacterDoubleJump();
+
+	/**
+	 * @brief Resolve the animations of the current armed state, loading them first if required
+	 */
+	void UpdateAnimations();
+
+	/**
+	 * @brief Resolve the animations of an armed state using the individual animation properties
+	 * @param bHasWeapon Is the character holding a weapon?
+	 * @param WeaponType The type of the weapon held by the character
+	 */
+	void ResolveAnimations(bool bHasWeapon, EWeaponType WeaponType);
+
+	/**
+	 * @brief Get the handle keeping the animations of an armed state loaded
+	 * @param bHasWeapon Is the character holding a weapon?
+	 * @param WeaponType The type of the weapon held by the character
+	 * @return The handle keeping the animations loaded
+	 */
+	TSharedPtr<FStreamableHandle>& GetLoadHandle(bool bHasWeapon, EWeaponType WeaponType);
+
+	/**
+	 * @brief Called when the animations requested from the streamable manager are loaded
+	 */
+	void OnAnimationsLoaded();
+
+	/**
+	 * @brief Called when the current weapon of the character changed
+	 * @param NewWeapon The new weapon or nullptr if the character is unarmed
+	 */
+	UFUNCTION()
+	void OnCharacterWeaponChanged(AWeapon* NewWeapon);
+
+	/**
+	 * @brief Get an animation based on an armed state
 	 * @param UnarmedAnimation The unarmed animation
 	 * @param WeaponOneHandedAnimation The one handed weapon animation
 	 * @param WeaponTwoHandedAnimation The two handed weapon animation
+	 * @param bHasWeapon Is the character holding a weapon?
+	 * @param WeaponType The type of the weapon held by the character
 	 * @return The animation to play
 	 */
-	UAnimSequence* GetAnimation(UAnimSequence* UnarmedAnimation, UAnimSequence* WeaponOneHandedAnimation,
-		UAnimSequence* WeaponTwoHandedAnimation) const;
+	static UAnimSequence* GetAnimation(UAnimSequence* UnarmedAnimation, UAnimSequence* WeaponOneHandedAnimation,
+		UAnimSequence* WeaponTwoHandedAnimation, bool bHasWeapon, EWeaponType WeaponType);
 };
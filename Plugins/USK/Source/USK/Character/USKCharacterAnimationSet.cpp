@@ -0,0 +1,103 @@
+﻿// Created by Henry Jooste
+
+#include "USKCharacterAnimationSet.h"
+
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Find the animations used for an armed state. The unarmed animations are used if the weapon type is missing
+ * @param bHasWeapon Is the character holding a weapon?
+ * @param WeaponType The type of the weapon held by the character
+ * @return The animations used for the armed state
+ */
+const FUSKCharacterAnimationSetEntry& UUSKCharacterAnimationSet::FindEntry(const bool bHasWeapon,
+	const EWeaponType WeaponType) const
+{
+	if (!bHasWeapon)
+	{
+		return Unarmed;
+	}
+
+	if (const FUSKCharacterAnimationSetEntry* Entry = Weapons.Find(WeaponType))
+	{
+		return *Entry;
+	}
+
+	USK_LOG_WARNING(*FString::Format(TEXT("No animations found for weapon type {0} in {1}"),
+		{ UEnum::GetValueAsString(WeaponType), GetName() }));
+	return Unarmed;
+}
+
+/**
+ * @brief Get the paths of the animations that must be loaded before an armed state can be used
+ * @param bHasWeapon Is the character holding a weapon?
+ * @param WeaponType The type of the weapon held by the character
+ * @param Paths The array the paths are added to
+ */
+void UUSKCharacterAnimationSet::GetAssetPaths(const bool bHasWeapon, const EWeaponType WeaponType,
+	TArray<FSoftObjectPath>& Paths) const
+{
+	const FUSKCharacterAnimationSetEntry& Entry = FindEntry(bHasWeapon, WeaponType);
+	AddAssetPath(Entry.IdleAnimation, Paths);
+	AddAssetPath(Entry.WalkAnimation, Paths);
+	AddAssetPath(Entry.RunAnimation, Paths);
+	AddAssetPath(Entry.SprintAnimation, Paths);
+	AddAssetPath(Entry.JumpAnimation, Paths);
+	AddAssetPath(Entry.DoubleJumpAnimation, Paths);
+	AddAssetPath(Entry.FallAnimation, Paths);
+	AddAssetPath(Entry.LandAnimation, Paths);
+	AddAssetPath(Entry.CrouchStartAnimation, Paths);
+	AddAssetPath(Entry.CrouchEndAnimation, Paths);
+	AddAssetPath(Entry.CrouchIdleAnimation, Paths);
+	AddAssetPath(Entry.CrouchWalkAnimation, Paths);
+	AddAssetPath(Entry.StompStartAnimation, Paths);
+	AddAssetPath(Entry.StompFallAnimation, Paths);
+	AddAssetPath(Entry.StompLandAnimation, Paths);
+	AddAssetPath(Entry.SlideStartAnimation, Paths);
+	AddAssetPath(Entry.SlideEndAnimation, Paths);
+	AddAssetPath(Entry.SlideLoopAnimation, Paths);
+}
+
+/**
+ * @brief Resolve the loaded animations of an armed state
+ * @param bHasWeapon Is the character holding a weapon?
+ * @param WeaponType The type of the weapon held by the character
+ * @param Animations The resolved animations
+ */
+void UUSKCharacterAnimationSet::ResolveAnimations(const bool bHasWeapon, const EWeaponType WeaponType,
+	FUSKCharacterAnimations& Animations) const
+{
+	const FUSKCharacterAnimationSetEntry& Entry = FindEntry(bHasWeapon, WeaponType);
+	Animations.IdleAnimation = Entry.IdleAnimation.Get();
+	Animations.WalkAnimation = Entry.WalkAnimation.Get();
+	Animations.RunAnimation = Entry.RunAnimation.Get();
+	Animations.SprintAnimation = Entry.SprintAnimation.Get();
+	Animations.JumpAnimation = Entry.JumpAnimation.Get();
+	Animations.DoubleJumpAnimation = Entry.DoubleJumpAnimation.Get();
+	Animations.FallAnimation = Entry.FallAnimation.Get();
+	Animations.LandAnimation = Entry.LandAnimation.Get();
+	Animations.CrouchStartAnimation = Entry.CrouchStartAnimation.Get();
+	Animations.CrouchEndAnimation = Entry.CrouchEndAnimation.Get();
+	Animations.CrouchIdleAnimation = Entry.CrouchIdleAnimation.Get();
+	Animations.CrouchWalkAnimation = Entry.CrouchWalkAnimation.Get();
+	Animations.StompStartAnimation = Entry.StompStartAnimation.Get();
+	Animations.StompFallAnimation = Entry.StompFallAnimation.Get();
+	Animations.StompLandAnimation = Entry.StompLandAnimation.Get();
+	Animations.SlideStartAnimation = Entry.SlideStartAnimation.Get();
+	Animations.SlideEndAnimation = Entry.SlideEndAnimation.Get();
+	Animations.SlideLoopAnimation = Entry.SlideLoopAnimation.Get();
+}
+
+/**
+ * @brief Add the path of an animation if it is set
+ * @param Animation The animation
+ * @param Paths The array the path is added to
+ */
+void UUSKCharacterAnimationSet::AddAssetPath(const TSoftObjectPtr<UAnimSequence>& Animation,
+	TArray<FSoftObjectPath>& Paths)
+{
+	if (!Animation.IsNull())
+	{
+		Paths.AddUnique(Animation.ToSoftObjectPath());
+	}
+}
@@ -0,0 +1,64 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "USKCharacterAnimations.h"
+#include "USKCharacterAnimationSetEntry.h"
+#include "Engine/DataAsset.h"
+#include "USK/Weapons/WeaponType.h"
+#include "USKCharacterAnimationSet.generated.h"
+
+/**
+ * @brief The animations used by a character for each armed state
+ */
+UCLASS(BlueprintType)
+class USK_API UUSKCharacterAnimationSet : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief The animations used when the character is unarmed
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character Animation Set")
+	FUSKCharacterAnimationSetEntry Unarmed;
+
+	/**
+	 * @brief The animations used when the character is holding a weapon of a specific type
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character Animation Set")
+	TMap<EWeaponType, FUSKCharacterAnimationSetEntry> Weapons;
+
+	/**
+	 * @brief Find the animations used for an armed state. The unarmed animations are used if the weapon type is missing
+	 * @param bHasWeapon Is the character holding a weapon?
+	 * @param WeaponType The type of the weapon held by the character
+	 * @return The animations used for the armed state
+	 */
+	const FUSKCharacterAnimationSetEntry& FindEntry(bool bHasWeapon, EWeaponType WeaponType) const;
+
+	/**
+	 * @brief Get the paths of the animations that must be loaded before an armed state can be used
+	 * @param bHasWeapon Is the character holding a weapon?
+	 * @param WeaponType The type of the weapon held by the character
+	 * @param Paths The array the paths are added to
+	 */
+	void GetAssetPaths(bool bHasWeapon, EWeaponType WeaponType, TArray<FSoftObjectPath>& Paths) const;
+
+	/**
+	 * @brief Resolve the loaded animations of an armed state
+	 * @param bHasWeapon Is the character holding a weapon?
+	 * @param WeaponType The type of the weapon held by the character
+	 * @param Animations The resolved animations
+	 */
+	void ResolveAnimations(bool bHasWeapon, EWeaponType WeaponType, FUSKCharacterAnimations& Animations) const;
+
+private:
+	/**
+	 * @brief Add the path of an animation if it is set
+	 * @param Animation The animation
+	 * @param Paths The array the path is added to
+	 */
+	static void AddAssetPath(const TSoftObjectPtr<UAnimSequence>& Animation, TArray<FSoftObjectPath>& Paths);
+};
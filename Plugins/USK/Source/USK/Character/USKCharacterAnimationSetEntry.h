@@ -0,0 +1,124 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimSequence.h"
+#include "USKCharacterAnimationSetEntry.generated.h"
+
+/**
+ * @brief The animations used by a character for a specific armed state. The animations are loaded when required
+ */
+USTRUCT(BlueprintType)
+struct USK_API FUSKCharacterAnimationSetEntry
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The animation used when the character is in the idle state
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> IdleAnimation;
+
+	/**
+	 * @brief The animation used when the character is walking
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> WalkAnimation;
+
+	/**
+	 * @brief The animation used when the character is running
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> RunAnimation;
+
+	/**
+	 * @brief The animation used when the character is sprinting
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> SprintAnimation;
+
+	/**
+	 * @brief The animation used when the character is jumping
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> JumpAnimation;
+
+	/**
+	 * @brief The animation used when the character is double jumping
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> DoubleJumpAnimation;
+
+	/**
+	 * @brief The animation used when the character is falling
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> FallAnimation;
+
+	/**
+	 * @brief The animation used when the character is landing
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> LandAnimation;
+
+	/**
+	 * @brief The animation used when the character is starting to crouch
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> CrouchStartAnimation;
+
+	/**
+	 * @brief The animation used when the character stops crouching
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> CrouchEndAnimation;
+
+	/**
+	 * @brief The animation used when the character is crouching in the idle state
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> CrouchIdleAnimation;
+
+	/**
+	 * @brief The animation used when the character is crouching and walking
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> CrouchWalkAnimation;
+
+	/**
+	 * @brief The animation used when the character is starting to stomp
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> StompStartAnimation;
+
+	/**
+	 * @brief The animation used when the character is falling while stomping
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> StompFallAnimation;
+
+	/**
+	 * @brief The animation used when the character is landing after a stomp
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> StompLandAnimation;
+
+	/**
+	 * @brief The animation used when the character is starting to slide
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> SlideStartAnimation;
+
+	/**
+	 * @brief The animation used when the character stops sliding
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> SlideEndAnimation;
+
+	/**
+	 * @brief The animation used when the character is sliding
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	TSoftObjectPtr<UAnimSequence> SlideLoopAnimation;
+};
@@ -0,0 +1,51 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "USKCharacterState.h"
+#include "USKCharacterAnimationSnapshot.generated.h"
+
+/**
+ * @brief The state of a character captured on the game thread and used to update the animations on a worker thread
+ */
+USTRUCT(BlueprintType)
+struct USK_API FUSKCharacterAnimationSnapshot
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The velocity of the character
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	FVector Velocity = FVector::ZeroVector;
+
+	/**
+	 * @brief Is the character currently in the air?
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	bool bIsFalling = false;
+
+	/**
+	 * @brief The current ability states of the character
+	 */
+	EUSKCharacterState CharacterState = EUSKCharacterState::None;
+
+	/**
+	 * @brief Is the character starting the stomp?
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	bool bIsStompStarting = false;
+
+	/**
+	 * @brief The current lean camera roll
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	float LeanCameraRoll = 0.0f;
+
+	/**
+	 * @brief Did the character perform a double jump since the previous snapshot?
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	bool bDoubleJumped = false;
+};
@@ -0,0 +1,124 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Animation/AnimSequence.h"
+#include "USKCharacterAnimations.generated.h"
+
+/**
+ * @brief The animations of a character resolved for the current armed state
+ */
+USTRUCT(BlueprintType)
+struct USK_API FUSKCharacterAnimations
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The animation used when the character is in the idle state
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* IdleAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is walking
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* WalkAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is running
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* RunAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is sprinting
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* SprintAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is jumping
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* JumpAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is double jumping
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* DoubleJumpAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is falling
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* FallAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is landing
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* LandAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is starting to crouch
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* CrouchStartAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character stops crouching
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* CrouchEndAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is crouching in the idle state
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* CrouchIdleAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is crouching and walking
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* CrouchWalkAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is starting to stomp
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* StompStartAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is falling while stomping
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* StompFallAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is landing after a stomp
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* StompLandAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is starting to slide
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* SlideStartAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character stops sliding
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* SlideEndAnimation = nullptr;
+
+	/**
+	 * @brief The animation used when the character is sliding
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Character|Animations")
+	UAnimSequence* SlideLoopAnimation = nullptr;
+};
@@ -0,0 +1,390 @@
+﻿// Created by Henry Jooste
+
+#include "USKCharacterMovementComponent.h"
+
+#include "USKCharacter.h"
+#include "EngineUtils.h"
+#include "Engine/NetConnection.h"
+#include "Engine/World.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief The abilities of the character that affect its movement and are sent with every move
+ */
+static constexpr EUSKCharacterState NetworkAbilityStates = EUSKCharacterState::Sprinting |
+	EUSKCharacterState::Crouching | EUSKCharacterState::Sliding | EUSKCharacterState::Stomping;
+
+/**
+ * @brief Console command used to log the bandwidth used by the moves of each USK character
+ */
+static FAutoConsoleCommandWithWorld ReportBandwidthCommand(
+	TEXT("USK.Net.ReportBandwidth"),
+	TEXT("Log the connection bandwidth and the ability data sent per move for each USK character and reset the stats"),
+	FConsoleCommandWithWorldDelegate::CreateLambda([](const UWorld* World)
+	{
+		for (TActorIterator<AUSKCharacter> Iterator(World); Iterator; ++Iterator)
+		{
+			UUSKCharacterMovementComponent* Movement =
+				Cast<UUSKCharacterMovementComponent>(Iterator->GetCharacterMovement());
+			if (!IsValid(Movement))
+			{
+				continue;
+			}
+
+			const UNetConnection* Connection = Iterator->GetNetConnection();
+			USK_LOG_INFO(*FString::Printf(TEXT("%s: %.1f moves/s, ability data %.1f bytes/s, connection in %d bytes/s, ")
+				TEXT("out %d bytes/s"), *Iterator->GetName(), Movement->GetMovesPerSecond(),
+				Movement->GetAbilityBytesPerSecond(), Connection != nullptr ? Connection->InBytesPerSecond : 0,
+				Connection != nullptr ? Connection->OutBytesPerSecond : 0));
+			Movement->ResetNetworkStats();
+		}
+	}));
+
+/**
+ * @brief Quantize a yaw into the slide yaw bits
+ * @param Yaw The yaw in degrees
+ * @return The quantized yaw
+ */
+static uint8 QuantizeSlideYaw(const float Yaw)
+{
+	constexpr int Steps = 1 << UUSKCharacterMovementComponent::SlideYawBits;
+	return static_cast<uint8>(FMath::RoundToInt(FRotator::ClampAxis(Yaw) * Steps / 360.0f) & (Steps - 1));
+}
+
+/**
+ * @brief Create a new instance of the UUSKCharacterMovementComponent component
+ */
+UUSKCharacterMovementComponent::UUSKCharacterMovementComponent()
+{
+	USKCharacterOwner = nullptr;
+	NetworkAbilityState = EUSKCharacterState::None;
+	PendingLaunch = EUSKMovementLaunch::None;
+	NetworkSlideYaw = 0;
+	NetworkLeanRoll = LeanRollSteps;
+	NetworkMoveCount = 0;
+	NetworkAbilityBits = 0;
+	NetworkStatsStartTime = 0.0;
+	SetNetworkMoveDataContainer(MoveDataContainer);
+}
+
+/**
+ * @brief Sync the abilities of a locally controlled character before the movement is performed
+ * @param DeltaTime The time since the last tick
+ * @param TickType The kind of tick this is
+ * @param ThisTickFunction The tick function that is being executed
+ */
+void UUSKCharacterMovementComponent::TickComponent(const float DeltaTime, const ELevelTick TickType,
+	FActorComponentTickFunction* ThisTickFunction)
+{
+	if (IsValid(USKCharacterOwner) && USKCharacterOwner->IsLocallyControlled())
+	{
+		SyncFromCharacter();
+	}
+
+	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
+}
+
+/**
+ * @brief Assign the component that is moved and cache the USK character that owns it
+ * @param NewUpdatedComponent The component that is moved
+ */
+void UUSKCharacterMovementComponent::SetUpdatedComponent(USceneComponent* NewUpdatedComponent)
+{
+	Super::SetUpdatedComponent(NewUpdatedComponent);
+	USKCharacterOwner = Cast<AUSKCharacter>(CharacterOwner);
+}
+
+/**
+ * @brief Get the maximum speed based on the abilities of the character
+ * @return The maximum speed for the current movement mode
+ */
+float UUSKCharacterMovementComponent::GetMaxSpeed() const
+{
+	if (!IsValid(USKCharacterOwner) ||
+		(MovementMode != MOVE_Walking && MovementMode != MOVE_NavWalking && MovementMode != MOVE_Falling))
+	{
+		return Super::GetMaxSpeed();
+	}
+
+	if (EnumHasAnyFlags(NetworkAbilityState, EUSKCharacterState::Sliding))
+	{
+		return USKCharacterOwner->SlideSpeed;
+	}
+
+	if (EnumHasAnyFlags(NetworkAbilityState, EUSKCharacterState::Crouching))
+	{
+		return USKCharacterOwner->CrouchSpeed;
+	}
+
+	return EnumHasAnyFlags(NetworkAbilityState, EUSKCharacterState::Sprinting)
+		? USKCharacterOwner->SprintSpeed
+		: USKCharacterOwner->MovementSpeed;
+}
+
+/**
+ * @brief Get the prediction data of the client
+ * @return The prediction data of the client
+ */
+FNetworkPredictionData_Client* UUSKCharacterMovementComponent::GetPredictionData_Client() const
+{
+	if (ClientPredictionData == nullptr)
+	{
+		UUSKCharacterMovementComponent* MutableThis = const_cast<UUSKCharacterMovementComponent*>(this);
+		MutableThis->ClientPredictionData = new FNetworkPredictionData_Client_USKCharacter(*this);
+	}
+
+	return ClientPredictionData;
+}
+
+/**
+ * @brief Unpack the abilities of the character from the compressed flags of a move
+ * @param Flags The compressed flags of the move
+ */
+void UUSKCharacterMovementComponent::UpdateFromCompressedFlags(const uint8 Flags)
+{
+	Super::UpdateFromCompressedFlags(Flags);
+
+	EUSKCharacterState State = EUSKCharacterState::None;
+	if ((Flags & FSavedMove_Character::FLAG_Custom_0) != 0)
+	{
+		State |= EUSKCharacterState::Sprinting;
+	}
+
+	if ((Flags & FSavedMove_Character::FLAG_Custom_1) != 0)
+	{
+		State |= EUSKCharacterState::Crouching;
+	}
+
+	if ((Flags & FSavedMove_Character::FLAG_Custom_2) != 0)
+	{
+		State |= EUSKCharacterState::Sliding;
+	}
+
+	if ((Flags & FSavedMove_Character::FLAG_Custom_3) != 0)
+	{
+		State |= EUSKCharacterState::Stomping;
+	}
+
+	NetworkAbilityState = State;
+}
+
+/**
+ * @brief Apply an ability that changes the velocity or gravity of the character during the next move
+ * @param Launch The ability to apply
+ */
+void UUSKCharacterMovementComponent::RequestLaunch(const EUSKMovementLaunch Launch)
+{
+	if (PendingLaunch != EUSKMovementLaunch::None)
+	{
+		USK_LOG_TRACE("Replacing a launch that wasn't applied yet");
+	}
+
+	PendingLaunch = Launch;
+}
+
+/**
+ * @brief Get the abilities that affect the movement of the character
+ * @return The abilities that affect the movement of the character
+ */
+EUSKCharacterState UUSKCharacterMovementComponent::GetNetworkAbilityState() const
+{
+	return NetworkAbilityState;
+}
+
+/**
+ * @brief Get the amount of moves serialized per second since the network stats were reset
+ * @return The amount of moves serialized per second
+ */
+float UUSKCharacterMovementComponent::GetMovesPerSecond() const
+{
+	const double Duration = GetWorld()->GetRealTimeSeconds() - NetworkStatsStartTime;
+	return Duration > 0.0 ? static_cast<float>(NetworkMoveCount / Duration) : 0.0f;
+}
+
+/**
+ * @brief Get the amount of bytes per second used by the ability data of the moves since the network stats were reset
+ * @return The amount of bytes per second used by the ability data
+ */
+float UUSKCharacterMovementComponent::GetAbilityBytesPerSecond() const
+{
+	const double Duration = GetWorld()->GetRealTimeSeconds() - NetworkStatsStartTime;
+	return Duration > 0.0 ? static_cast<float>(NetworkAbilityBits / 8.0 / Duration) : 0.0f;
+}
+
+/**
+ * @brief Reset the network stats
+ */
+void UUSKCharacterMovementComponent::ResetNetworkStats()
+{
+	NetworkMoveCount = 0;
+	NetworkAbilityBits = 0;
+	NetworkStatsStartTime = GetWorld()->GetRealTimeSeconds();
+}
+
+/**
+ * @brief Pack the abilities and the quantized lean camera roll into a single byte for replication
+ * @param State The abilities that affect the movement of the character
+ * @param LeanRoll The quantized lean camera roll
+ * @return The packed abilities
+ */
+uint8 UUSKCharacterMovementComponent::PackAbilityState(const EUSKCharacterState State, const uint8 LeanRoll)
+{
+	uint8 PackedState = static_cast<uint8>(LeanRoll << 4);
+	PackedState |= EnumHasAnyFlags(State, EUSKCharacterState::Sprinting) ? 1 << 0 : 0;
+	PackedState |= EnumHasAnyFlags(State, EUSKCharacterState::Crouching) ? 1 << 1 : 0;
+	PackedState |= EnumHasAnyFlags(State, EUSKCharacterState::Sliding) ? 1 << 2 : 0;
+	PackedState |= EnumHasAnyFlags(State, EUSKCharacterState::Stomping) ? 1 << 3 : 0;
+	return PackedState;
+}
+
+/**
+ * @brief Unpack the abilities and the quantized lean camera roll from a single byte
+ * @param PackedState The packed abilities
+ * @param State The abilities that affect the movement of the character
+ * @param LeanRoll The quantized lean camera roll
+ */
+void UUSKCharacterMovementComponent::UnpackAbilityState(const uint8 PackedState, EUSKCharacterState& State,
+	uint8& LeanRoll)
+{
+	State = EUSKCharacterState::None;
+	State |= (PackedState & 1 << 0) != 0 ? EUSKCharacterState::Sprinting : EUSKCharacterState::None;
+	State |= (PackedState & 1 << 1) != 0 ? EUSKCharacterState::Crouching : EUSKCharacterState::None;
+	State |= (PackedState & 1 << 2) != 0 ? EUSKCharacterState::Sliding : EUSKCharacterState::None;
+	State |= (PackedState & 1 << 3) != 0 ? EUSKCharacterState::Stomping : EUSKCharacterState::None;
+	LeanRoll = FMath::Min<uint8>(PackedState >> 4, LeanRollSteps * 2);
+}
+
+/**
+ * @brief Quantize a lean camera roll
+ * @param Roll The lean camera roll
+ * @param MaxRoll The maximum lean camera roll
+ * @return The quantized lean camera roll
+ */
+uint8 UUSKCharacterMovementComponent::QuantizeLeanRoll(const float Roll, const float MaxRoll)
+{
+	if (FMath::IsNearlyZero(MaxRoll))
+	{
+		return LeanRollSteps;
+	}
+
+	const float NormalizedRoll = FRotator::NormalizeAxis(Roll) / MaxRoll;
+	return static_cast<uint8>(FMath::Clamp(FMath::RoundToInt(NormalizedRoll * LeanRollSteps), -LeanRollSteps,
+		LeanRollSteps) + LeanRollSteps);
+}
+
+/**
+ * @brief Restore a quantized lean camera roll
+ * @param LeanRoll The quantized lean camera roll
+ * @param MaxRoll The maximum lean camera roll
+ * @return The lean camera roll
+ */
+float UUSKCharacterMovementComponent::DequantizeLeanRoll(const uint8 LeanRoll, const float MaxRoll)
+{
+	return static_cast<float>(static_cast<int>(LeanRoll) - LeanRollSteps) / LeanRollSteps * MaxRoll;
+}
+
+/**
+ * @brief Mirror the abilities of remote characters and apply the requested launch before the movement is performed
+ * @param DeltaSeconds The delta time of the move
+ */
+void UUSKCharacterMovementComponent::UpdateCharacterStateBeforeMovement(const float DeltaSeconds)
+{
+	Super::UpdateCharacterStateBeforeMovement(DeltaSeconds);
+	if (!IsValid(USKCharacterOwner))
+	{
+		return;
+	}
+
+	if (CharacterOwner->GetLocalRole() == ROLE_Authority && !CharacterOwner->IsLocallyControlled())
+	{
+		USKCharacterOwner->ApplyNetworkAbilityState(NetworkAbilityState,
+			DequantizeLeanRoll(NetworkLeanRoll, USKCharacterOwner->LeanRotation));
+	}
+
+	if (PendingLaunch == EUSKMovementLaunch::None)
+	{
+		return;
+	}
+
+	const EUSKMovementLaunch Launch = PendingLaunch;
+	PendingLaunch = EUSKMovementLaunch::None;
+	USKCharacterOwner->ApplyMovementLaunch(Launch);
+}
+
+/**
+ * @brief Read the custom move data received from the client and perform the move
+ * @param ClientTimeStamp The time stamp of the move
+ * @param DeltaTime The delta time of the move
+ * @param CompressedFlags The compressed flags of the move
+ * @param NewAccel The acceleration of the move
+ */
+void UUSKCharacterMovementComponent::MoveAutonomous(const float ClientTimeStamp, const float DeltaTime,
+	const uint8 CompressedFlags, const FVector& NewAccel)
+{
+	const FUSKCharacterNetworkMoveData* MoveData =
+		static_cast<const FUSKCharacterNetworkMoveData*>(GetCurrentNetworkMoveData());
+	if (MoveData != nullptr)
+	{
+		PendingLaunch = MoveData->Launch;
+		NetworkSlideYaw = MoveData->SlideYaw;
+		NetworkLeanRoll = MoveData->LeanRoll;
+	}
+
+	Super::MoveAutonomous(ClientTimeStamp, DeltaTime, CompressedFlags, NewAccel);
+}
+
+/**
+ * @brief Keep the acceleration in the quantized slide direction while sliding
+ * @param InputAcceleration The input acceleration
+ * @return The constrained acceleration
+ */
+FVector UUSKCharacterMovementComponent::ConstrainInputAcceleration(const FVector& InputAcceleration) const
+{
+	const FVector Acceleration = Super::ConstrainInputAcceleration(InputAcceleration);
+	if (!EnumHasAnyFlags(NetworkAbilityState, EUSKCharacterState::Sliding))
+	{
+		return Acceleration;
+	}
+
+	return GetNetworkSlideDirection() * Acceleration.Size();
+}
+
+/**
+ * @brief Update the replicated abilities after the movement was performed on the server
+ * @param DeltaSeconds The delta time of the move
+ * @param OldLocation The location before the move
+ * @param OldVelocity The velocity before the move
+ */
+void UUSKCharacterMovementComponent::OnMovementUpdated(const float DeltaSeconds, const FVector& OldLocation,
+	const FVector& OldVelocity)
+{
+	Super::OnMovementUpdated(DeltaSeconds, OldLocation, OldVelocity);
+	if (IsValid(USKCharacterOwner) && CharacterOwner->GetLocalRole() == ROLE_Authority)
+	{
+		USKCharacterOwner->SetReplicatedAbilityState(PackAbilityState(NetworkAbilityState, NetworkLeanRoll));
+	}
+}
+
+/**
+ * @brief Copy the abilities of the locally controlled character
+ */
+void UUSKCharacterMovementComponent::SyncFromCharacter()
+{
+	NetworkAbilityState = USKCharacterOwner->GetCharacterState() & NetworkAbilityStates;
+	if (USKCharacterOwner->IsEndingCrouch())
+	{
+		NetworkAbilityState &= ~EUSKCharacterState::Crouching;
+	}
+
+	NetworkSlideYaw = QuantizeSlideYaw(USKCharacterOwner->GetSlideDirection().Rotation().Yaw);
+	NetworkLeanRoll = QuantizeLeanRoll(USKCharacterOwner->GetLeanCameraRoll(), USKCharacterOwner->LeanRotation);
+}
+
+/**
+ * @brief Get the direction of the slide from the quantized yaw
+ * @return The direction of the slide
+ */
+FVector UUSKCharacterMovementComponent::GetNetworkSlideDirection() const
+{
+	return FRotator(0.0f, NetworkSlideYaw * 360.0f / (1 << SlideYawBits), 0.0f).Vector();
+}
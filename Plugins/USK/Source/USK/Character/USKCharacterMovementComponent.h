@@ -0,0 +1,227 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "USKCharacterState.h"
+#include "USKCharacterNetworkPrediction.h"
+#include "USKMovementLaunch.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "USKCharacterMovementComponent.generated.h"
+
+class AUSKCharacter;
+
+/**
+ * @brief Movement component that predicts the abilities of a USK character using compressed flags and move data
+ */
+UCLASS()
+class USK_API UUSKCharacterMovementComponent : public UCharacterMovementComponent
+{
+	GENERATED_BODY()
+
+	friend struct FUSKCharacterNetworkMoveData;
+	friend class FSavedMove_USKCharacter;
+
+public:
+	/**
+	 * @brief Create a new instance of the UUSKCharacterMovementComponent component
+	 */
+	UUSKCharacterMovementComponent();
+
+	/**
+	 * @brief The amount of steps on either side of the quantized lean camera roll
+	 */
+	static constexpr int LeanRollSteps = 3;
+
+	/**
+	 * @brief The amount of bits used to send the quantized slide yaw of a move
+	 */
+	static constexpr int SlideYawBits = 6;
+
+	/**
+	 * @brief Sync the abilities of a locally controlled character before the movement is performed
+	 * @param DeltaTime The time since the last tick
+	 * @param TickType The kind of tick this is
+	 * @param ThisTickFunction The tick function that is being executed
+	 */
+	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
+		FActorComponentTickFunction* ThisTickFunction) override;
+
+	/**
+	 * @brief Assign the component that is moved and cache the USK character that owns it
+	 * @param NewUpdatedComponent The component that is moved
+	 */
+	virtual void SetUpdatedComponent(USceneComponent* NewUpdatedComponent) override;
+
+	/**
+	 * @brief Get the maximum speed based on the abilities of the character
+	 * @return The maximum speed for the current movement mode
+	 */
+	virtual float GetMaxSpeed() const override;
+
+	/**
+	 * @brief Get the prediction data of the client
+	 * @return The prediction data of the client
+	 */
+	virtual FNetworkPredictionData_Client* GetPredictionData_Client() const override;
+
+	/**
+	 * @brief Unpack the abilities of the character from the compressed flags of a move
+	 * @param Flags The compressed flags of the move
+	 */
+	virtual void UpdateFromCompressedFlags(uint8 Flags) override;
+
+	/**
+	 * @brief Apply an ability that changes the velocity or gravity of the character during the next move
+	 * @param Launch The ability to apply
+	 */
+	void RequestLaunch(EUSKMovementLaunch Launch);
+
+	/**
+	 * @brief Get the abilities that affect the movement of the character
+	 * @return The abilities that affect the movement of the character
+	 */
+	EUSKCharacterState GetNetworkAbilityState() const;
+
+	/**
+	 * @brief Get the amount of moves serialized per second since the network stats were reset
+	 * @return The amount of moves serialized per second
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character|Network")
+	float GetMovesPerSecond() const;
+
+	/**
+	 * @brief Get the amount of bytes per second used by the ability data of the moves since the network stats were reset
+	 * @return The amount of bytes per second used by the ability data
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Character|Network")
+	float GetAbilityBytesPerSecond() const;
+
+	/**
+	 * @brief Reset the network stats
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Character|Network")
+	void ResetNetworkStats();
+
+	/**
+	 * @brief Pack the abilities and the quantized lean camera roll into a single byte for replication
+	 * @param State The abilities that affect the movement of the character
+	 * @param LeanRoll The quantized lean camera roll
+	 * @return The packed abilities
+	 */
+	static uint8 PackAbilityState(EUSKCharacterState State, uint8 LeanRoll);
+
+	/**
+	 * @brief Unpack the abilities and the quantized lean camera roll from a single byte
+	 * @param PackedState The packed abilities
+	 * @param State The abilities that affect the movement of the character
+	 * @param LeanRoll The quantized lean camera roll
+	 */
+	static void UnpackAbilityState(uint8 PackedState, EUSKCharacterState& State, uint8& LeanRoll);
+
+	/**
+	 * @brief Quantize a lean camera roll
+	 * @param Roll The lean camera roll
+	 * @param MaxRoll The maximum lean camera roll
+	 * @return The quantized lean camera roll
+	 */
+	static uint8 QuantizeLeanRoll(float Roll, float MaxRoll);
+
+	/**
+	 * @brief Restore a quantized lean camera roll
+	 * @param LeanRoll The quantized lean camera roll
+	 * @param MaxRoll The maximum lean camera roll
+	 * @return The lean camera roll
+	 */
+	static float DequantizeLeanRoll(uint8 LeanRoll, float MaxRoll);
+
+protected:
+	/**
+	 * @brief Mirror the abilities of remote characters and apply the requested launch before the movement is performed
+	 * @param DeltaSeconds The delta time of the move
+	 */
+	virtual void UpdateCharacterStateBeforeMovement(float DeltaSeconds) override;
+
+	/**
+	 * @brief Read the custom move data received from the client and perform the move
+	 * @param ClientTimeStamp The time stamp of the move
+	 * @param DeltaTime The delta time of the move
+	 * @param CompressedFlags The compressed flags of the move
+	 * @param NewAccel The acceleration of the move
+	 */
+	virtual void MoveAutonomous(float ClientTimeStamp, float DeltaTime, uint8 CompressedFlags,
+		const FVector& NewAccel) override;
+
+	/**
+	 * @brief Keep the acceleration in the quantized slide direction while sliding
+	 * @param InputAcceleration The input acceleration
+	 * @return The constrained acceleration
+	 */
+	virtual FVector ConstrainInputAcceleration(const FVector& InputAcceleration) const override;
+
+	/**
+	 * @brief Update the replicated abilities after the movement was performed on the server
+	 * @param DeltaSeconds The delta time of the move
+	 * @param OldLocation The location before the move
+	 * @param OldVelocity The velocity before the move
+	 */
+	virtual void OnMovementUpdated(float DeltaSeconds, const FVector& OldLocation, const FVector& OldVelocity) override;
+
+private:
+	/**
+	 * @brief The USK character that owns the component
+	 */
+	UPROPERTY()
+	AUSKCharacter* USKCharacterOwner;
+
+	/**
+	 * @brief The abilities that affect the movement of the character
+	 */
+	EUSKCharacterState NetworkAbilityState;
+
+	/**
+	 * @brief The ability that changes the velocity or gravity of the character during the next move
+	 */
+	EUSKMovementLaunch PendingLaunch;
+
+	/**
+	 * @brief The quantized yaw of the slide direction
+	 */
+	uint8 NetworkSlideYaw;
+
+	/**
+	 * @brief The quantized lean camera roll
+	 */
+	uint8 NetworkLeanRoll;
+
+	/**
+	 * @brief The storage of the move data sent to the server
+	 */
+	FUSKCharacterNetworkMoveDataContainer MoveDataContainer;
+
+	/**
+	 * @brief The amount of moves serialized since the network stats were reset
+	 */
+	int NetworkMoveCount;
+
+	/**
+	 * @brief The amount of bits of ability data serialized since the network stats were reset
+	 */
+	int NetworkAbilityBits;
+
+	/**
+	 * @brief The time at which the network stats were reset
+	 */
+	double NetworkStatsStartTime;
+
+	/**
+	 * @brief Copy the abilities of the locally controlled character
+	 */
+	void SyncFromCharacter();
+
+	/**
+	 * @brief Get the direction of the slide from the quantized yaw
+	 * @return The direction of the slide
+	 */
+	FVector GetNetworkSlideDirection() const;
+};
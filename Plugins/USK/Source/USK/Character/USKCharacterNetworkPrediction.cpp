@@ -0,0 +1,218 @@
+﻿// Created by Henry Jooste
+
+#include "USKCharacterNetworkPrediction.h"
+
+#include "USKCharacterMovementComponent.h"
+
+/**
+ * @brief The amount of bits used to send the launch of a move
+ */
+static constexpr int LaunchBits = 3;
+
+/**
+ * @brief The amount of bits used to send the quantized lean camera roll of a move
+ */
+static constexpr int LeanRollBits = 3;
+
+static_assert(static_cast<int>(EUSKMovementLaunch::Count) <= 1 << LaunchBits,
+	"EUSKMovementLaunch doesn't fit in the launch bits of the network move data");
+
+/**
+ * @brief Fill the move data using a saved move of the client
+ * @param ClientMove The saved move
+ * @param MoveType The type of the move
+ */
+void FUSKCharacterNetworkMoveData::ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove,
+	const ENetworkMoveType MoveType)
+{
+	FCharacterNetworkMoveData::ClientFillNetworkMoveData(ClientMove, MoveType);
+
+	const FSavedMove_USKCharacter& SavedMove = static_cast<const FSavedMove_USKCharacter&>(ClientMove);
+	Launch = SavedMove.SavedLaunch;
+	SlideYaw = SavedMove.SavedSlideYaw;
+	LeanRoll = SavedMove.SavedLeanRoll;
+}
+
+/**
+ * @brief Read or write the move data
+ * @param CharacterMovement The movement component that owns the move data
+ * @param Archive The archive used to read or write the move data
+ * @param PackageMap The package map used to serialize object references
+ * @param MoveType The type of the move
+ * @return A boolean value indicating if the move data was serialized without errors
+ */
+bool FUSKCharacterNetworkMoveData::Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Archive,
+	UPackageMap* PackageMap, const ENetworkMoveType MoveType)
+{
+	if (!FCharacterNetworkMoveData::Serialize(CharacterMovement, Archive, PackageMap, MoveType))
+	{
+		return false;
+	}
+
+	int Bits = LaunchBits + LeanRollBits;
+	uint8 LaunchValue = static_cast<uint8>(Launch);
+	Archive.SerializeBits(&LaunchValue, LaunchBits);
+	Archive.SerializeBits(&LeanRoll, LeanRollBits);
+
+	// The slide yaw is only relevant while sliding, so the bits are skipped for all other moves
+	if ((CompressedMoveFlags & FSavedMove_Character::FLAG_Custom_2) != 0)
+	{
+		Archive.SerializeBits(&SlideYaw, UUSKCharacterMovementComponent::SlideYawBits);
+		Bits += UUSKCharacterMovementComponent::SlideYawBits;
+	}
+
+	if (Archive.IsLoading())
+	{
+		LaunchValue &= (1 << LaunchBits) - 1;
+		Launch = LaunchValue < static_cast<uint8>(EUSKMovementLaunch::Count)
+			? static_cast<EUSKMovementLaunch>(LaunchValue)
+			: EUSKMovementLaunch::None;
+		LeanRoll = FMath::Min<uint8>(LeanRoll & ((1 << LeanRollBits) - 1),
+			UUSKCharacterMovementComponent::LeanRollSteps * 2);
+		SlideYaw &= (1 << UUSKCharacterMovementComponent::SlideYawBits) - 1;
+	}
+
+	UUSKCharacterMovementComponent* Movement = Cast<UUSKCharacterMovementComponent>(&CharacterMovement);
+	if (IsValid(Movement))
+	{
+		Movement->NetworkMoveCount++;
+		Movement->NetworkAbilityBits += Bits;
+	}
+
+	return !Archive.IsError();
+}
+
+/**
+ * @brief Create a new instance of the container
+ */
+FUSKCharacterNetworkMoveDataContainer::FUSKCharacterNetworkMoveDataContainer()
+{
+	NewMoveData = &MoveData[0];
+	PendingMoveData = &MoveData[1];
+	OldMoveData = &MoveData[2];
+}
+
+/**
+ * @brief Reset the saved move so it can be reused
+ */
+void FSavedMove_USKCharacter::Clear()
+{
+	FSavedMove_Character::Clear();
+	SavedAbilityState = EUSKCharacterState::None;
+	SavedLaunch = EUSKMovementLaunch::None;
+	SavedSlideYaw = 0;
+	SavedLeanRoll = UUSKCharacterMovementComponent::LeanRollSteps;
+}
+
+/**
+ * @brief Get the compressed flags of the move
+ * @return The compressed flags of the move
+ */
+uint8 FSavedMove_USKCharacter::GetCompressedFlags() const
+{
+	uint8 Flags = FSavedMove_Character::GetCompressedFlags();
+	if (EnumHasAnyFlags(SavedAbilityState, EUSKCharacterState::Sprinting))
+	{
+		Flags |= FLAG_Custom_0;
+	}
+
+	if (EnumHasAnyFlags(SavedAbilityState, EUSKCharacterState::Crouching))
+	{
+		Flags |= FLAG_Custom_1;
+	}
+
+	if (EnumHasAnyFlags(SavedAbilityState, EUSKCharacterState::Sliding))
+	{
+		Flags |= FLAG_Custom_2;
+	}
+
+	if (EnumHasAnyFlags(SavedAbilityState, EUSKCharacterState::Stomping))
+	{
+		Flags |= FLAG_Custom_3;
+	}
+
+	return Flags;
+}
+
+/**
+ * @brief Check if this move can be combined with a new move to save bandwidth
+ * @param NewMove The new move
+ * @param Character The character performing the moves
+ * @param MaxDelta The maximum delta time of the combined move
+ * @return A boolean value indicating if the moves can be combined
+ */
+bool FSavedMove_USKCharacter::CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* Character,
+	const float MaxDelta) const
+{
+	const FSavedMove_USKCharacter* NewUSKMove = static_cast<const FSavedMove_USKCharacter*>(NewMove.Get());
+	if (SavedLaunch != EUSKMovementLaunch::None || NewUSKMove->SavedLaunch != EUSKMovementLaunch::None ||
+		SavedAbilityState != NewUSKMove->SavedAbilityState || SavedSlideYaw != NewUSKMove->SavedSlideYaw ||
+		SavedLeanRoll != NewUSKMove->SavedLeanRoll)
+	{
+		return false;
+	}
+
+	return FSavedMove_Character::CanCombineWith(NewMove, Character, MaxDelta);
+}
+
+/**
+ * @brief Save the current state of the character for the move
+ * @param Character The character performing the move
+ * @param InDeltaTime The delta time of the move
+ * @param NewAccel The acceleration of the move
+ * @param ClientData The prediction data of the client
+ */
+void FSavedMove_USKCharacter::SetMoveFor(ACharacter* Character, const float InDeltaTime, FVector const& NewAccel,
+	FNetworkPredictionData_Client_Character& ClientData)
+{
+	FSavedMove_Character::SetMoveFor(Character, InDeltaTime, NewAccel, ClientData);
+
+	const UUSKCharacterMovementComponent* Movement =
+		Cast<UUSKCharacterMovementComponent>(Character->GetCharacterMovement());
+	if (!IsValid(Movement))
+	{
+		return;
+	}
+
+	SavedAbilityState = Movement->NetworkAbilityState;
+	SavedLaunch = Movement->PendingLaunch;
+	SavedSlideYaw = Movement->NetworkSlideYaw;
+	SavedLeanRoll = Movement->NetworkLeanRoll;
+}
+
+/**
+ * @brief Restore the saved state of the character before the move is replayed
+ * @param Character The character performing the move
+ */
+void FSavedMove_USKCharacter::PrepMoveFor(ACharacter* Character)
+{
+	FSavedMove_Character::PrepMoveFor(Character);
+
+	UUSKCharacterMovementComponent* Movement =
+		Cast<UUSKCharacterMovementComponent>(Character->GetCharacterMovement());
+	if (!IsValid(Movement))
+	{
+		return;
+	}
+
+	Movement->NetworkAbilityState = SavedAbilityState;
+	Movement->PendingLaunch = SavedLaunch;
+	Movement->NetworkSlideYaw = SavedSlideYaw;
+	Movement->NetworkLeanRoll = SavedLeanRoll;
+}
+
+/**
+ * @brief Create a new instance of the prediction data
+ * @param ClientMovement The movement component of the client
+ */
+FNetworkPredictionData_Client_USKCharacter::FNetworkPredictionData_Client_USKCharacter(
+	const UCharacterMovementComponent& ClientMovement) : FNetworkPredictionData_Client_Character(ClientMovement) { }
+
+/**
+ * @brief Allocate a new saved move
+ * @return The new saved move
+ */
+FSavedMovePtr FNetworkPredictionData_Client_USKCharacter::AllocateNewMove()
+{
+	return FSavedMovePtr(new FSavedMove_USKCharacter());
+}
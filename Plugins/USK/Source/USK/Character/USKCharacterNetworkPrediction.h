@@ -0,0 +1,145 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "USKCharacterState.h"
+#include "USKMovementLaunch.h"
+#include "GameFramework/CharacterMovementComponent.h"
+
+/**
+ * @brief The move data sent to the server containing the abilities of a character that aren't in the compressed flags
+ */
+struct USK_API FUSKCharacterNetworkMoveData : public FCharacterNetworkMoveData
+{
+	/**
+	 * @brief The ability that changes the velocity or gravity of the character during the move
+	 */
+	EUSKMovementLaunch Launch = EUSKMovementLaunch::None;
+
+	/**
+	 * @brief The quantized yaw of the slide direction. Only sent while sliding
+	 */
+	uint8 SlideYaw = 0;
+
+	/**
+	 * @brief The quantized lean camera roll
+	 */
+	uint8 LeanRoll = 0;
+
+	/**
+	 * @brief Fill the move data using a saved move of the client
+	 * @param ClientMove The saved move
+	 * @param MoveType The type of the move
+	 */
+	virtual void ClientFillNetworkMoveData(const FSavedMove_Character& ClientMove, ENetworkMoveType MoveType) override;
+
+	/**
+	 * @brief Read or write the move data
+	 * @param CharacterMovement The movement component that owns the move data
+	 * @param Archive The archive used to read or write the move data
+	 * @param PackageMap The package map used to serialize object references
+	 * @param MoveType The type of the move
+	 * @return A boolean value indicating if the move data was serialized without errors
+	 */
+	virtual bool Serialize(UCharacterMovementComponent& CharacterMovement, FArchive& Archive, UPackageMap* PackageMap,
+		ENetworkMoveType MoveType) override;
+};
+
+/**
+ * @brief The container of the new, pending and old move data sent to the server
+ */
+struct USK_API FUSKCharacterNetworkMoveDataContainer : public FCharacterNetworkMoveDataContainer
+{
+	/**
+	 * @brief Create a new instance of the container
+	 */
+	FUSKCharacterNetworkMoveDataContainer();
+
+	/**
+	 * @brief The storage of the new, pending and old move data
+	 */
+	FUSKCharacterNetworkMoveData MoveData[3];
+};
+
+/**
+ * @brief A move saved by the client that also stores the abilities of the character so it can be replayed
+ */
+class USK_API FSavedMove_USKCharacter : public FSavedMove_Character
+{
+public:
+	/**
+	 * @brief The abilities that affect the movement of the character (sprinting, crouching, sliding and stomping)
+	 */
+	EUSKCharacterState SavedAbilityState;
+
+	/**
+	 * @brief The ability that changes the velocity or gravity of the character during the move
+	 */
+	EUSKMovementLaunch SavedLaunch;
+
+	/**
+	 * @brief The quantized yaw of the slide direction
+	 */
+	uint8 SavedSlideYaw;
+
+	/**
+	 * @brief The quantized lean camera roll
+	 */
+	uint8 SavedLeanRoll;
+
+	/**
+	 * @brief Reset the saved move so it can be reused
+	 */
+	virtual void Clear() override;
+
+	/**
+	 * @brief Get the compressed flags of the move
+	 * @return The compressed flags of the move
+	 */
+	virtual uint8 GetCompressedFlags() const override;
+
+	/**
+	 * @brief Check if this move can be combined with a new move to save bandwidth
+	 * @param NewMove The new move
+	 * @param Character The character performing the moves
+	 * @param MaxDelta The maximum delta time of the combined move
+	 * @return A boolean value indicating if the moves can be combined
+	 */
+	virtual bool CanCombineWith(const FSavedMovePtr& NewMove, ACharacter* Character, float MaxDelta) const override;
+
+	/**
+	 * @brief Save the current state of the character for the move
+	 * @param Character The character performing the move
+	 * @param InDeltaTime The delta time of the move
+	 * @param NewAccel The acceleration of the move
+	 * @param ClientData The prediction data of the client
+	 */
+	virtual void SetMoveFor(ACharacter* Character, float InDeltaTime, FVector const& NewAccel,
+		FNetworkPredictionData_Client_Character& ClientData) override;
+
+	/**
+	 * @brief Restore the saved state of the character before the move is replayed
+	 * @param Character The character performing the move
+	 */
+	virtual void PrepMoveFor(ACharacter* Character) override;
+};
+
+/**
+ * @brief The prediction data of the client that allocates USK saved moves
+ */
+class USK_API FNetworkPredictionData_Client_USKCharacter : public FNetworkPredictionData_Client_Character
+{
+public:
+	/**
+	 * @brief Create a new instance of the prediction data
+	 * @param ClientMovement The movement component of the client
+	 */
+	explicit FNetworkPredictionData_Client_USKCharacter(const UCharacterMovementComponent& ClientMovement);
+
+	/**
+	 * @brief Allocate a new saved move
+	 * @return The new saved move
+	 */
+	virtual FSavedMovePtr AllocateNewMove() override;
+};
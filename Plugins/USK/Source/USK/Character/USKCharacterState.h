@@ -0,0 +1,59 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "USKCharacterState.generated.h"
+
+/**
+ * @brief The ability states of a character that can be combined into a single bitfield
+ */
+UENUM(BlueprintType, meta=(Bitflags, UseEnumValuesAsMaskValuesInEditor = "true"))
+enum class EUSKCharacterState : uint8
+{
+	/**
+	 * @brief The character is not using any abilities
+	 */
+	None = 0 UMETA(Hidden),
+
+	/**
+	 * @brief The character is sprinting
+	 */
+	Sprinting = 1 << 0,
+
+	/**
+	 * @brief The character is crouching
+	 */
+	Crouching = 1 << 1,
+
+	/**
+	 * @brief The character is busy ending the crouch
+	 */
+	EndingCrouch = 1 << 2,
+
+	/**
+	 * @brief The character is sliding
+	 */
+	Sliding = 1 << 3,
+
+	/**
+	 * @brief The character is busy ending the slide
+	 */
+	EndingSlide = 1 << 4,
+
+	/**
+	 * @brief The character is stomping
+	 */
+	Stomping = 1 << 5,
+
+	/**
+	 * @brief The character is allowed to perform a stomp jump
+	 */
+	StompJumpAllowed = 1 << 6,
+
+	/**
+	 * @brief The camera is moving towards the target lean offset and roll
+	 */
+	Leaning = 1 << 7
+};
+ENUM_CLASS_FLAGS(EUSKCharacterState);
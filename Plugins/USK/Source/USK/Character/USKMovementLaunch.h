@@ -0,0 +1,58 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "USKMovementLaunch.generated.h"
+
+/**
+ * @brief The abilities that change the velocity or gravity of a character and are predicted by the movement component
+ */
+UENUM(BlueprintType)
+enum class EUSKMovementLaunch : uint8
+{
+	/**
+	 * @brief No ability is applied
+	 */
+	None,
+
+	/**
+	 * @brief Launch the character upwards after walking off a ledge
+	 */
+	CoyoteJump,
+
+	/**
+	 * @brief Launch the character upwards while crouching
+	 */
+	CrouchJump,
+
+	/**
+	 * @brief Launch the character upwards after landing a stomp
+	 */
+	StompJump,
+
+	/**
+	 * @brief Launch the character forwards and upwards while sliding
+	 */
+	LongJump,
+
+	/**
+	 * @brief Disable gravity and stop the vertical movement at the start of a stomp
+	 */
+	StompStart,
+
+	/**
+	 * @brief Restore gravity and launch the character downwards after the zero gravity duration
+	 */
+	StompDown,
+
+	/**
+	 * @brief Bounce the character upwards when a stomp lands
+	 */
+	StompLand,
+
+	/**
+	 * @brief The amount of values. Must fit in the bits reserved for the launch in the network move data
+	 */
+	Count UMETA(Hidden)
+};
@@ -5,13 +5,87 @@
 #include "EnhancedInputSubsystems.h"
 #include "InputDevice.h"
 #include "InputMappingContext.h"
+#include "PlatformFeatures.h"
+#include "SaveGameSystem.h"
+#include "TimerManager.h"
+#include "Async/Async.h"
 #include "Engine/World.h"
+#include "HAL/FileManager.h"
 #include "Kismet/GameplayStatics.h"
+#include "Misc/CoreDelegates.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
 #include "USK/Logger/Log.h"
 #include "USK/Settings/SettingsUtils.h"
 #include "USK/Utils/PlatformUtils.h"
 #include "Runtime/Launch/Resources/Version.h"
 
+/**
+ * @brief Get the path of the file used by the generic save game system on desktop platforms
+ * @param SlotName The name of the save slot
+ * @return The path of the save file
+ */
+static FString GetSaveFilePath(const FString& SlotName)
+{
+	return FPaths::ProjectSavedDir() / TEXT("SaveGames") / SlotName + TEXT(".sav");
+}
+
+/**
+ * @brief Write the bytes of a save slot to disk. Desktop platforms write a temporary file that replaces the save file
+ * and keep the previous save file as a backup
+ * @param SlotName The name of the save slot
+ * @param SaveBytes The bytes of the save data
+ * @return A boolean value indicating if the save data was written successfully
+ */
+static bool WriteSaveFile(const FString& SlotName, const TArray<uint8>& SaveBytes)
+{
+#if PLATFORM_DESKTOP
+	// Replacing a file deletes it before the move, so the previous save file is moved to the backup file first. A
+	// crash during the write leaves the save file intact, and a crash between the moves leaves the backup file intact
+	const FString FilePath = GetSaveFilePath(SlotName);
+	const FString TempFilePath = FilePath + TEXT(".tmp");
+	const FString BackupFilePath = FilePath + TEXT(".bak");
+	IFileManager& FileManager = IFileManager::Get();
+	if (!FFileHelper::SaveArrayToFile(SaveBytes, *TempFilePath))
+	{
+		return false;
+	}
+
+	if (FileManager.FileExists(*FilePath) && !FileManager.Move(*BackupFilePath, *FilePath, true, true))
+	{
+		return false;
+	}
+
+	return FileManager.Move(*FilePath, *TempFilePath, false, true);
+#else
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	return SaveSystem != nullptr && SaveSystem->SaveGame(false, *SlotName, 0, SaveBytes);
+#endif
+}
+
+/**
+ * @brief Read the bytes of a save slot from disk
+ * @param SlotName The name of the save slot
+ * @return The bytes of the save data or an empty array if the save slot is not used
+ */
+static TArray<uint8> ReadSaveFile(const FString& SlotName)
+{
+	TArray<uint8> SaveBytes;
+	ISaveGameSystem* SaveSystem = IPlatformFeaturesModule::Get().GetSaveGameSystem();
+	if (SaveSystem != nullptr && SaveSystem->LoadGame(false, *SlotName, 0, SaveBytes))
+	{
+		return SaveBytes;
+	}
+
+#if PLATFORM_DESKTOP
+	// The save file is missing if the game crashed after it was moved to the backup file
+	SaveBytes.Reset();
+	FFileHelper::LoadFileToArray(SaveBytes, *(GetSaveFilePath(SlotName) + TEXT(".bak")), FILEREAD_Silent);
+#endif
+
+	return SaveBytes;
+}
+
 /**
  * @brief Virtual function to allow custom GameInstances an opportunity to set up what it needs
  */
@@ -19,6 +93,10 @@ void UUSKGameInstance::Init()
 {
 	Super::Init();
 	InitializeFeaturesAfterDelay();
+	PreLoadMapHandle = FCoreUObjectDelegates::PreLoadMap.AddUObject(this, &UUSKGameInstance::OnPreLoadMap);
+	EnterBackgroundHandle = FCoreDelegates::ApplicationWillEnterBackgroundDelegate.AddUObject(this,
+		&UUSKGameInstance::OnApplicationWillEnterBackground);
+	PrefetchSaveSlot(CurrentSaveSlot);
 
 #if UE_EDITOR || WITH_EDITOR
 	ULog::Configure(LogConfigEditor);
@@ -45,6 +123,17 @@ void UUSKGameInstance::LoadComplete(const float LoadTime, const FString& MapName
 	}
 }
 
+/**
+ * @brief Virtual function to allow custom GameInstances an opportunity to do cleanup when shutting down
+ */
+void UUSKGameInstance::Shutdown()
+{
+	FCoreUObjectDelegates::PreLoadMap.Remove(PreLoadMapHandle);
+	FCoreDelegates::ApplicationWillEnterBackgroundDelegate.Remove(EnterBackgroundHandle);
+	FlushSaveDataAndWait();
+	Super::Shutdown();
+}
+
 /**
  * @brief Get the save data that is currently loaded
  * @return A reference to the current save data
@@ -64,14 +153,45 @@ UUSKSaveGame* UUSKGameInstance::GetSaveData() const
  */
 void UUSKGameInstance::SaveData()
 {
-	if (CurrentSaveGame == nullptr)
+	bIsSaveDataDirty = true;
+	FlushSaveData();
+}
+
+/**
+ * @brief Mark the save data as modified so it is written to disk on the next flush
+ */
+void UUSKGameInstance::RequestSaveData()
+{
+	bIsSaveDataDirty = true;
+	if (GetTimerManager().IsTimerActive(SaveDataFlushTimer))
 	{
-		USK_LOG_ERROR("Save Game is nullptr");
 		return;
 	}
 
-	USK_LOG_INFO("Saving data");
-	UGameplayStatics::SaveGameToSlot(CurrentSaveGame, GetSaveSlotName(CurrentSaveSlot), 0);
+	// Changes made during the flush interval are coalesced into a single write
+	const float Delay = SaveDataFlushInterval - static_cast<float>(FPlatformTime::Seconds() - LastSaveDataFlushTime);
+	GetTimerManager().SetTimer(SaveDataFlushTimer, this, &UUSKGameInstance::FlushSaveData,
+		FMath::Max(Delay, KINDA_SMALL_NUMBER), false);
+}
+
+/**
+ * @brief Write the modified save data to disk without waiting for the flush interval
+ */
+void UUSKGameInstance::FlushSaveData()
+{
+	GetTimerManager().ClearTimer(SaveDataFlushTimer);
+	if (!bIsSaveDataDirty)
+	{
+		return;
+	}
+
+	if (PendingSaveDataWrite.IsValid() && !PendingSaveDataWrite.IsReady())
+	{
+		bIsSaveDataFlushQueued = true;
+		return;
+	}
+
+	WriteSaveData();
 }
 
 /**
@@ -82,10 +202,46 @@ void UUSKGameInstance::SetCurrentSaveSlot(const int Index)
 {	
 	USK_LOG_INFO(*FString::Format(TEXT("Changing save slot index to {0}"), { FString::FromInt(Index) }));
 	
+	FlushSaveDataAndWait();
 	CurrentSaveSlot = Index;
 	LoadData(Index);
 }
 
+/**
+ * @brief Start reading a save slot on a worker thread so it is ready when the save slot is selected
+ * @param Index The index of the save slot
+ */
+void UUSKGameInstance::PrefetchSaveSlot(const int Index)
+{
+	if (PrefetchedSaveSlot == Index && PrefetchedSaveData.IsValid())
+	{
+		return;
+	}
+
+	// Only the current save slot is written, so its pending write must complete before the file is read
+	if (Index == CurrentSaveSlot)
+	{
+		FlushSaveDataAndWait();
+	}
+
+	USK_LOG_TRACE(*FString::Format(TEXT("Prefetching save slot {0}"), { FString::FromInt(Index) }));
+	const FString SlotName = GetSaveSlotName(Index);
+	PrefetchedSaveSlot = Index;
+	PrefetchedSaveData = Async(EAsyncExecution::ThreadPool, [SlotName]()
+	{
+		return ReadSaveFile(SlotName);
+	});
+}
+
+/**
+ * @brief Check if the save data of the current save slot is still being loaded
+ * @return A boolean value indicating if the save data is being loaded
+ */
+bool UUSKGameInstance::IsLoadingSaveData() const
+{
+	return bIsLoadingSaveData;
+}
+
 /**
  * @brief Check if a save slot is used
  * @param Index The index of the save slot to check
@@ -309,23 +465,73 @@ void UUSKGameInstance::UnpauseGame()
 }
 
 /**
- * @brief Load data at the specified index
+ * @brief Load data at the specified index. The file is read on a worker thread
  * @param Index The save slot index to load data from
  */
 void UUSKGameInstance::LoadData(const int Index)
 {
-	if (!IsSaveSlotUsed(Index))
+	USK_LOG_INFO(*FString::Format(TEXT("Loading data from slot {0}"), { FString::FromInt(Index) }));
+	const int LoadRequest = ++SaveDataLoadRequest;
+	bIsLoadingSaveData = true;
+	bIsSaveDataDirty = false;
+	CurrentSaveGame = nullptr;
+
+	TFuture<TArray<uint8>> SaveDataRead;
+	if (PrefetchedSaveSlot == Index && PrefetchedSaveData.IsValid())
 	{
-		USK_LOG_INFO(*FString::Format(TEXT("Creating new save data in slot {0}"), { FString::FromInt(Index) }));
-		USaveGame* NewData = UGameplayStatics::CreateSaveGameObject(SaveGameClass);
-		CurrentSaveGame = dynamic_cast<UUSKSaveGame*>(NewData);
-		OnDataLoadedEvent.Broadcast();
+		SaveDataRead = MoveTemp(PrefetchedSaveData);
+	}
+	else
+	{
+		const FString SlotName = GetSaveSlotName(Index);
+		SaveDataRead = Async(EAsyncExecution::ThreadPool, [SlotName]()
+		{
+			return ReadSaveFile(SlotName);
+		});
+	}
+
+	PrefetchedSaveSlot = INDEX_NONE;
+	if (SaveDataRead.IsReady())
+	{
+		OnSaveDataRead(LoadRequest, SaveDataRead.Get());
 		return;
 	}
 
-	USK_LOG_INFO(*FString::Format(TEXT("Loading data from slot {0}"), { FString::FromInt(Index) }));
-	USaveGame* LoadedData = UGameplayStatics::LoadGameFromSlot(GetSaveSlotName(Index), 0); 
+	TWeakObjectPtr<UUSKGameInstance> WeakThis(this);
+	SaveDataRead.Then([WeakThis, LoadRequest](TFuture<TArray<uint8>> Future)
+	{
+		AsyncTask(ENamedThreads::GameThread, [WeakThis, LoadRequest, SaveBytes = Future.Get()]()
+		{
+			if (WeakThis.IsValid())
+			{
+				WeakThis->OnSaveDataRead(LoadRequest, SaveBytes);
+			}
+		});
+	});
+}
+
+/**
+ * @brief Called on the game thread after the save data was read from disk
+ * @param LoadRequest The ID of the load
+ * @param SaveBytes The bytes of the save data or an empty array if the save slot is not used
+ */
+void UUSKGameInstance::OnSaveDataRead(const int LoadRequest, const TArray<uint8>& SaveBytes)
+{
+	if (LoadRequest != SaveDataLoadRequest)
+	{
+		return;
+	}
+
+	bIsLoadingSaveData = false;
+	USaveGame* LoadedData = SaveBytes.Num() > 0 ? UGameplayStatics::LoadGameFromMemory(SaveBytes) : nullptr;
 	CurrentSaveGame = dynamic_cast<UUSKSaveGame*>(LoadedData);
+	if (CurrentSaveGame == nullptr)
+	{
+		USK_LOG_INFO(*FString::Format(TEXT("Creating new save data in slot {0}"), { FString::FromInt(CurrentSaveSlot) }));
+		USaveGame* NewData = UGameplayStatics::CreateSaveGameObject(SaveGameClass);
+		CurrentSaveGame = dynamic_cast<UUSKSaveGame*>(NewData);
+	}
+
 	OnDataLoadedEvent.Broadcast();
 }
 
@@ -339,6 +545,121 @@ FString UUSKGameInstance::GetSaveSlotName(const int Index) const
 	return *FString::Format(TEXT("SaveData{0}"), { FString::FromInt(Index) });
 }
 
+/**
+ * @brief Capture the save data in memory and write it to disk on a worker thread
+ */
+void UUSKGameInstance::WriteSaveData()
+{
+	if (bIsLoadingSaveData)
+	{
+		return;
+	}
+
+	if (CurrentSaveGame == nullptr)
+	{
+		USK_LOG_ERROR("Save Game is nullptr");
+		return;
+	}
+
+	OnSaveDataFlushing.Broadcast();
+	bIsSaveDataDirty = false;
+	LastSaveDataFlushTime = FPlatformTime::Seconds();
+	if (PrefetchedSaveSlot == CurrentSaveSlot)
+	{
+		PrefetchedSaveSlot = INDEX_NONE;
+		PrefetchedSaveData = TFuture<TArray<uint8>>();
+	}
+
+	TArray<uint8> SaveBytes;
+	if (!UGameplayStatics::SaveGameToMemory(CurrentSaveGame, SaveBytes))
+	{
+		USK_LOG_ERROR("Failed to serialize the save data");
+		return;
+	}
+
+	USK_LOG_INFO("Saving data");
+	const FString SlotName = GetSaveSlotName(CurrentSaveSlot);
+	TWeakObjectPtr<UUSKGameInstance> WeakThis(this);
+	PendingSaveDataWrite = Async(EAsyncExecution::ThreadPool,
+		[SlotName, SaveBytes = MoveTemp(SaveBytes), WeakThis]()
+		{
+			const bool bSuccess = WriteSaveFile(SlotName, SaveBytes);
+			AsyncTask(ENamedThreads::GameThread, [WeakThis, bSuccess]()
+			{
+				if (WeakThis.IsValid())
+				{
+					WeakThis->OnSaveDataWritten(bSuccess);
+				}
+			});
+
+			return bSuccess;
+		});
+}
+
+/**
+ * @brief Called on the game thread after the save data was written to disk
+ * @param bSuccess Was the save data written successfully?
+ */
+void UUSKGameInstance::OnSaveDataWritten(const bool bSuccess)
+{
+	if (!bSuccess)
+	{
+		USK_LOG_ERROR("Failed to write the save data");
+		RequestSaveData();
+	}
+
+	OnSaveCompleted.Broadcast(bSuccess);
+
+	if (bIsSaveDataFlushQueued)
+	{
+		bIsSaveDataFlushQueued = false;
+		FlushSaveData();
+	}
+}
+
+/**
+ * @brief Write the modified save data and wait until all writes completed
+ */
+void UUSKGameInstance::FlushSaveDataAndWait()
+{
+	if (PendingSaveDataWrite.IsValid())
+	{
+		PendingSaveDataWrite.Wait();
+	}
+
+	bIsSaveDataFlushQueued = false;
+	if (bIsSaveDataDirty)
+	{
+		WriteSaveData();
+	}
+
+	if (PendingSaveDataWrite.IsValid())
+	{
+		PendingSaveDataWrite.Wait();
+	}
+}
+
+/**
+ * @brief Flush the modified save data before a new map is loaded
+ * @param MapName The name of the map that will be loaded
+ */
+void UUSKGameInstance::OnPreLoadMap(const FString& MapName)
+{
+	FlushSaveData();
+	if (CurrentSaveGame == nullptr && !bIsLoadingSaveData)
+	{
+		PrefetchSaveSlot(CurrentSaveSlot);
+	}
+}
+
+/**
+ * @brief Flush the modified save data before the application is suspended
+ */
+void UUSKGameInstance::OnApplicationWillEnterBackground()
+{
+	FlushSaveDataAndWait();
+}
+
 /**
  * @brief Initialize the features of the game instance after a delay
  */
@@ -3,12 +3,16 @@
 #pragma once
 
 #include "InputDevice.h"
+#include "NiagaraSystem.h"
+#include "Async/Future.h"
 #include "Engine/GameInstance.h"
 #include "USKSaveGame.h"
 #include "USK/Settings/SettingsConfig.h"
+#include "USK/Weapons/WeaponProjectileDecalEvictionPolicy.h"
 #include "USKGameInstance.generated.h"
 
 class ULogConfig;
+class UCharacterSignificanceConfig;
 class UInputAction;
 class UInputMappingContext;
 
@@ -25,6 +29,17 @@ class USK_API UUSKGameInstance : public UGameInstance
 	 */
 	DECLARE_DYNAMIC_MULTICAST_DELEGATE(FGameInstanceOnDataLoadedDelegate);
 
+	/**
+	 * @brief Event used to let other classes write their modified values into the save data before it is written
+	 */
+	DECLARE_MULTICAST_DELEGATE(FGameInstanceOnSaveDataFlushingDelegate);
+
+	/**
+	 * @brief Event used to notify other classes when the save data was written to disk
+	 * @param bSuccess Was the save data written successfully?
+	 */
+	DECLARE_DYNAMIC_MULTICAST_DELEGATE_OneParam(FGameInstanceOnSaveCompletedDelegate, bool, bSuccess);
+
 	/**
 	 * @brief Event used to notify other classes when the current input device is updated
 	 */
@@ -71,18 +86,113 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Save Data")
 	TSubclassOf<UUSKSaveGame> SaveGameClass;
 
+	/**
+	 * @brief The minimum amount of seconds between writes of modified save data to disk
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Save Data")
+	float SaveDataFlushInterval = 5.0f;
+
 	/**
 	 * @brief The configuration for the settings
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Settings")
 	USettingsConfig* SettingsConfig;
 
+	/**
+	 * @brief The maximum amount of projectile decals drawn at the same time
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapons|Decals")
+	int MaxWeaponProjectileDecals = 100;
+
+	/**
+	 * @brief The policy used to decide which projectile decal is removed when the budget is reached
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapons|Decals")
+	EWeaponProjectileDecalEvictionPolicy WeaponProjectileDecalEvictionPolicy = EWeaponProjectileDecalEvictionPolicy::OldestFirst;
+
+	/**
+	 * @brief The maximum distance from the camera at which projectile decals are spawned (0 = unlimited)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapons|Decals")
+	float WeaponProjectileDecalCullDistance = 5000.0f;
+
+	/**
+	 * @brief The maximum amount of active instances of each particle system
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Particle FX")
+	int MaxParticleFxInstances = 16;
+
+	/**
+	 * @brief The maximum amount of active instances for specific particle systems
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Particle FX")
+	TMap<UNiagaraSystem*, int> ParticleFxInstanceLimits;
+
+	/**
+	 * @brief The maximum distance from the camera at which particle FX are spawned (0 = unlimited)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Particle FX")
+	float ParticleFxCullDistance = 10000.0f;
+
+	/**
+	 * @brief The particle systems whose requests during a frame are combined into a single spawn
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Particle FX")
+	TArray<UNiagaraSystem*> BatchedParticleFx;
+
+	/**
+	 * @brief The user vector array parameter of batched particle systems that receives the spawn locations
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Particle FX")
+	FName ParticleFxBatchParameter = "BatchPositions";
+
+	/**
+	 * @brief The distance from the camera within which ground probes are updated every frame
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Ground Probes")
+	float GroundProbeNearDistance = 2000.0f;
+
+	/**
+	 * @brief The distance from the camera at which ground probes are updated at the far interval
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Ground Probes")
+	float GroundProbeFarDistance = 8000.0f;
+
+	/**
+	 * @brief The amount of seconds between updates of ground probes at the far distance (0 = every frame)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Ground Probes")
+	float GroundProbeFarInterval = 0.25f;
+
+	/**
+	 * @brief The horizontal distance an actor must move before the ground below it is traced again
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Ground Probes")
+	float GroundProbeReuseDistance = 5.0f;
+
+	/**
+	 * @brief The significance buckets used to reduce the update rates of characters far away from the players
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Character Significance")
+	UCharacterSignificanceConfig* CharacterSignificanceConfig;
+
 	/**
 	 * @brief Event used to notify other classes when the save data is loaded
 	 */
 	UPROPERTY(BlueprintAssignable, Category = "Ultimate Starter Kit|Save Data|Events")
 	FGameInstanceOnDataLoadedDelegate OnDataLoadedEvent;
 
+	/**
+	 * @brief Event used to notify other classes when the save data was written to disk
+	 */
+	UPROPERTY(BlueprintAssignable, Category = "Ultimate Starter Kit|Save Data|Events")
+	FGameInstanceOnSaveCompletedDelegate OnSaveCompleted;
+
+	/**
+	 * @brief Event used to let other classes write their modified values into the save data before it is written
+	 */
+	FGameInstanceOnSaveDataFlushingDelegate OnSaveDataFlushing;
+
 	/**
 	 * @brief Is the input indicators feature enabled?
 	 */
@@ -163,6 +273,18 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Save Data")
 	void SaveData();
 
+	/**
+	 * @brief Mark the save data as modified so it is written to disk on the next flush
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Save Data")
+	void RequestSaveData();
+
+	/**
+	 * @brief Write the modified save data to disk without waiting for the flush interval
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Save Data")
+	void FlushSaveData();
+
 	/**
 	 * @brief Set the current save slot
 	 * @param Index The index of the save slot
@@ -170,6 +292,20 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Save Data")
 	void SetCurrentSaveSlot(int Index);
 
+	/**
+	 * @brief Start reading a save slot on a worker thread so it is ready when the save slot is selected
+	 * @param Index The index of the save slot
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Save Data")
+	void PrefetchSaveSlot(int Index);
+
+	/**
+	 * @brief Check if the save data of the current save slot is still being loaded
+	 * @return A boolean value indicating if the save data is being loaded
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Save Data")
+	bool IsLoadingSaveData() const;
+
 	/**
 	 * @brief Check if a save slot is used
 	 * @param Index The index of the save slot to check
@@ -248,6 +384,11 @@ protected:
 	 * @param MapName The name of the map that was loaded
 	 */
 	virtual void LoadComplete(const float LoadTime, const FString& MapName) override;
+
+	/**
+	 * @brief Virtual function to allow custom GameInstances an opportunity to do cleanup when shutting down
+	 */
+	virtual void Shutdown() override;
 	
 private:	
 	/**
@@ -276,6 +417,61 @@ private:
 	 */
 	int CurrentSaveSlot;
 
+	/**
+	 * @brief Was the save data modified since it was last written to disk?
+	 */
+	bool bIsSaveDataDirty = false;
+
+	/**
+	 * @brief Should the save data be written again after the current write completes?
+	 */
+	bool bIsSaveDataFlushQueued = false;
+
+	/**
+	 * @brief The time at which the save data was last written to disk
+	 */
+	double LastSaveDataFlushTime = 0.0;
+
+	/**
+	 * @brief The timer used to write the modified save data after the flush interval
+	 */
+	FTimerHandle SaveDataFlushTimer;
+
+	/**
+	 * @brief The write of the save data that is currently running on a worker thread
+	 */
+	TFuture<bool> PendingSaveDataWrite;
+
+	/**
+	 * @brief Is the save data of the current save slot being loaded?
+	 */
+	bool bIsLoadingSaveData = false;
+
+	/**
+	 * @brief The ID of the latest load of the save data. Older loads are ignored when they complete
+	 */
+	int SaveDataLoadRequest = 0;
+
+	/**
+	 * @brief The bytes of the prefetched save slot that are read on a worker thread
+	 */
+	TFuture<TArray<uint8>> PrefetchedSaveData;
+
+	/**
+	 * @brief The index of the prefetched save slot or -1 if no save slot is prefetched
+	 */
+	int PrefetchedSaveSlot = INDEX_NONE;
+
+	/**
+	 * @brief The handle of the delegate used to flush the save data before a map is loaded
+	 */
+	FDelegateHandle PreLoadMapHandle;
+
+	/**
+	 * @brief The handle of the delegate used to flush the save data when the application enters the background
+	 */
+	FDelegateHandle EnterBackgroundHandle;
+
 	/**
 	 * @brief The current input device used by the player
 	 */
@@ -287,10 +483,17 @@ private:
 	bool bIsUsingGamepad;
 
 	/**
-	 * @brief Load data at the specified index
+	 * @brief Load data at the specified index. The file is read on a worker thread
 	 * @param Index The save slot index to load data from
 	 */
 	void LoadData(int Index);
+
+	/**
+	 * @brief Called on the game thread after the save data was read from disk
+	 * @param LoadRequest The ID of the load
+	 * @param SaveBytes The bytes of the save data or an empty array if the save slot is not used
+	 */
+	void OnSaveDataRead(int LoadRequest, const TArray<uint8>& SaveBytes);
 	
 	/**
 	 * @brief Get the save file name for the save slot
@@ -299,6 +502,33 @@ private:
 	 */
 	FString GetSaveSlotName(int Index) const;
 
+	/**
+	 * @brief Capture the save data in memory and write it to disk on a worker thread
+	 */
+	void WriteSaveData();
+
+	/**
+	 * @brief Called on the game thread after the save data was written to disk
+	 * @param bSuccess Was the save data written successfully?
+	 */
+	void OnSaveDataWritten(bool bSuccess);
+
+	/**
+	 * @brief Write the modified save data and wait until all writes completed
+	 */
+	void FlushSaveDataAndWait();
+
+	/**
+	 * @brief Flush the modified save data before a new map is loaded
+	 * @param MapName The name of the map that will be loaded
+	 */
+	void OnPreLoadMap(const FString& MapName);
+
+	/**
+	 * @brief Flush the modified save data before the application is suspended
+	 */
+	void OnApplicationWillEnterBackground();
+
 	/**
 	 * @brief Initialize the features of the game instance after a delay
 	 */
@@ -60,12 +60,9 @@ struct USK_API FTrackableData
 	float GenerateDelay;
 
 	/**
-	 * @brief The current delay before regenerating the value
+	 * @brief Should the generated value be calculated when it is read instead of every frame?
 	 */
-	float CurrentGenerateDelay;
-
-	/**
-	 * @brief The current value of the data
-	 */
-	float CurrentValue;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Trackable Data",
+		DisplayName = "Generate value when it is read", meta = (EditCondition = "AutoGenerate"))
+	bool LazyGenerate;
 };
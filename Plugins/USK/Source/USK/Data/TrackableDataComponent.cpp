@@ -2,6 +2,8 @@
 
 #include "TrackableDataComponent.h"
 
+#include "TrackableDataSubsystem.h"
+#include "TimerManager.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "USK/Core/USKGameInstance.h"
@@ -12,7 +14,7 @@
  */
 UTrackableDataComponent::UTrackableDataComponent()
 {
-	PrimaryComponentTick.bCanEverTick = true;
+	PrimaryComponentTick.bCanEverTick = false;
 }
 
 /**
@@ -24,44 +26,56 @@ void UTrackableDataComponent::BeginPlay()
 
 	UGameInstance* CurrentGameInstance = UGameplayStatics::GetGameInstance(GetWorld());
 	GameInstance = dynamic_cast<UUSKGameInstance*>(CurrentGameInstance);
-	
+
+	Subsystem = GetWorld()->GetSubsystem<UTrackableDataSubsystem>();
+	if (Subsystem == nullptr)
+	{
+		USK_LOG_ERROR("TrackableDataSubsystem is nullptr");
+	}
+	else
+	{
+		for (const TPair<FName, FTrackableData>& Item : Data)
+		{
+			Handles.Add(Item.Key, Subsystem->RegisterValue(this, Item.Key, Item.Value));
+		}
+	}
+
 	LoadData();
+	RegisterQueuedSubscriptions();
 	if (GameInstance != nullptr)
 	{
 		GameInstance->OnDataLoadedEvent.AddDynamic(this, &UTrackableDataComponent::LoadData);
+		GameInstance->OnSaveDataFlushing.AddUObject(this, &UTrackableDataComponent::WriteDirtyValues);
 	}
 }
 
 /**
- * @brief Function called every frame on this ActorComponent
- * @param DeltaTime The time since the last tick
- * @param TickType The kind of tick this is, for example, are we paused, or 'simulating' in the editor
- * @param ThisTickFunction Internal tick function struct that caused this to run
+ * @brief Ends gameplay for this component
+ * @param EndPlayReason The reason the component is ending play
  */
-void UTrackableDataComponent::TickComponent(float DeltaTime, ELevelTick TickType,
-                                            FActorComponentTickFunction* ThisTickFunction)
+void UTrackableDataComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
 {
-	Super::TickComponent(DeltaTime, TickType, ThisTickFunction);
-
-	TArray<FName> Keys;
-	Data.GetKeys(Keys);
-	for (FName Key : Keys)
+	if (GameInstance != nullptr)
 	{
-		if (!Data[Key].AutoGenerate || Data[Key].GenerateAmount <= 0.0f ||
-			Data[Key].CurrentValue >= Data[Key].MaxValue)
-		{
-			continue;
-		}
+		WriteDirtyValues();
+		GameInstance->OnSaveDataFlushing.RemoveAll(this);
+	}
 
-		if (Data[Key].CurrentGenerateDelay > 0.0f)
+	if (Subsystem != nullptr)
+	{
+		for (const TPair<FName, int>& Handle : Handles)
 		{
-			USK_LOG_TRACE(*FString::Format(TEXT("Reducing regenerate delay for {0}"), { Key.ToString() }));
-			Data[Key].CurrentGenerateDelay -= DeltaTime;
-			continue;
+			Subsystem->UnregisterValue(Handle.Value);
 		}
-
-		Add(Key, Data[Key].GenerateAmount * DeltaTime);
 	}
+
+	Handles.Empty();
+	Subscriptions.Empty();
+	QueuedSubscriptions.Empty();
+	ChangedHandles.Empty();
+	PendingHandles.Empty();
+	GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
+	Super::EndPlay(EndPlayReason);
 }
 
 /**
@@ -71,13 +85,14 @@ void UTrackableDataComponent::TickComponent(float DeltaTime, ELevelTick TickType
  */
 float UTrackableDataComponent::GetValue(const FName Name)
 {
-	if (!Data.Contains(Name))
+	const int Handle = GetHandle(Name);
+	if (Handle == INDEX_NONE)
 	{
 		USK_LOG_ERROR(*FString::Format(TEXT("Data not added to map ({0})"), { Name.ToString() }));
 		return 0.0f;
 	}
 
-	return Data[Name].CurrentValue;
+	return GetValueByHandle(Handle);
 }
 
 /**
@@ -87,39 +102,113 @@ float UTrackableDataComponent::GetValue(const FName Name)
  */
 float UTrackableDataComponent::GetValuePercentage(const FName Name)
 {
-	if (!Data.Contains(Name))
+	const int Handle = GetHandle(Name);
+	if (Handle == INDEX_NONE)
 	{
 		USK_LOG_ERROR(*FString::Format(TEXT("Data not added to map ({0})"), { Name.ToString() }));
 		return 0.0f;
 	}
 
-	if (Data[Name].MaxValue == 0.0f)
+	return GetValuePercentageByHandle(Handle);
+}
+
+/**
+ * @brief Add an amount to the data
+ * @param Name The name of the data item
+ * @param Amount The amount to add
+ * @return The new amount of the data item
+ */
+float UTrackableDataComponent::Add(const FName Name, const float Amount)
+{
+	const int Handle = GetHandle(Name);
+	if (Handle == INDEX_NONE)
 	{
-		USK_LOG_ERROR(*FString::Format(TEXT("Max value is 0.0f ({0})"), { Name.ToString() }));
+		USK_LOG_ERROR(*FString::Format(TEXT("Data not added to map ({0})"), { Name.ToString() }));
 		return 0.0f;
 	}
 
-	return Data[Name].CurrentValue / Data[Name].MaxValue;
+	return AddByHandle(Handle, Amount);
 }
 
 /**
- * @brief Add an amount to the data
+ * @brief Remove an amount from the data
  * @param Name The name of the data item
+ * @param Amount The amount to remove
+ * @return The new amount of the data item
+ */
+float UTrackableDataComponent::Remove(const FName Name, const float Amount)
+{
+	return Add(Name, -Amount);
+}
+
+/**
+ * @brief Get the handle used to access the data without looking up the name
+ * @param Name The name of the data item
+ * @return The handle of the data item or -1 if the data item is not tracked
+ */
+int UTrackableDataComponent::GetHandle(const FName Name) const
+{
+	const int* Handle = Handles.Find(Name);
+	return Handle == nullptr ? INDEX_NONE : *Handle;
+}
+
+/**
+ * @brief Get the amount of the data using a handle
+ * @param Handle The handle of the data item
+ * @return The current amount of the data item
+ */
+float UTrackableDataComponent::GetValueByHandle(const int Handle) const
+{
+	if (Subsystem == nullptr || !Subsystem->IsValidHandle(Handle))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Invalid trackable data handle ({0})"), { Handle }));
+		return 0.0f;
+	}
+
+	return Subsystem->GetValue(Handle);
+}
+
+/**
+ * @brief Get the value of the data as a percentage of to the max value using a handle
+ * @param Handle The handle of the data item
+ * @return The value of the data as a percentage of to the max value
+ */
+float UTrackableDataComponent::GetValuePercentageByHandle(const int Handle) const
+{
+	if (Subsystem == nullptr || !Subsystem->IsValidHandle(Handle))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Invalid trackable data handle ({0})"), { Handle }));
+		return 0.0f;
+	}
+
+	const float MaxValue = Subsystem->GetMaxValue(Handle);
+	if (MaxValue == 0.0f)
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Max value is 0.0f ({0})"), { Subsystem->GetName(Handle).ToString() }));
+		return 0.0f;
+	}
+
+	return Subsystem->GetValue(Handle) / MaxValue;
+}
+
+/**
+ * @brief Add an amount to the data using a handle
+ * @param Handle The handle of the data item
  * @param Amount The amount to add
  * @return The new amount of the data item
  */
-float UTrackableDataComponent::Add(const FName Name, const float Amount)
+float UTrackableDataComponent::AddByHandle(const int Handle, const float Amount)
 {
-	if (!Data.Contains(Name))
+	if (Subsystem == nullptr || !Subsystem->IsValidHandle(Handle))
 	{
-		USK_LOG_ERROR(*FString::Format(TEXT("Data not added to map ({0})"), { Name.ToString() }));
+		USK_LOG_ERROR(*FString::Format(TEXT("Invalid trackable data handle ({0})"), { Handle }));
 		return 0.0f;
 	}
 
-	const float Max = Data[Name].EnforceMaxValue ? Data[Name].MaxValue : FLT_MAX;
-	Data[Name].CurrentValue = FMath::Clamp(Data[Name].CurrentValue + Amount, 0.0f, Max);	
-	const int NewValue = Data[Name].CurrentValue;
-	OnValueUpdated.Broadcast(Name, NewValue, GetValuePercentage(Name));
+	const FName Name = Subsystem->GetName(Handle);
+	const int NewValue = Subsystem->AddValue(Handle, Amount);
+	OnValueUpdated.Broadcast(Name, NewValue, GetValuePercentageByHandle(Handle));
+	QueueNotification(Handle);
 
 	if (NewValue == 0.0f)
 	{
@@ -127,25 +216,162 @@ float UTrackableDataComponent::Add(const FName Name, const float Amount)
 		OnValueZero.Broadcast(Name);
 	}
 
-	if (Amount < 0.0f && Data[Name].AutoGenerate)
-	{
-		USK_LOG_INFO(*FString::Format(TEXT("Resetting regenerate delay for {0}"), { Name.ToString() }));
-		Data[Name].CurrentGenerateDelay = Data[Name].GenerateDelay;
-	}
-	
-	SaveValue(Name, NewValue);
+	SaveValue(Name);
 	return NewValue;
 }
 
 /**
- * @brief Remove an amount from the data
- * @param Name The name of the data item
+ * @brief Remove an amount from the data using a handle
+ * @param Handle The handle of the data item
  * @param Amount The amount to remove
  * @return The new amount of the data item
  */
-float UTrackableDataComponent::Remove(const FName Name, const float Amount)
+float UTrackableDataComponent::RemoveByHandle(const int Handle, const float Amount)
 {
-	return Add(Name, -Amount);
+	return AddByHandle(Handle, -Amount);
+}
+
+/**
+ * @brief Get the maximum value of the data after the modifiers are applied
+ * @param Name The name of the data item
+ * @return The maximum value of the data item
+ */
+float UTrackableDataComponent::GetMaxValue(const FName Name) const
+{
+	const int Handle = GetHandle(Name);
+	if (Subsystem == nullptr || !Subsystem->IsValidHandle(Handle))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Data not added to map ({0})"), { Name.ToString() }));
+		return 0.0f;
+	}
+
+	return Subsystem->GetMaxValue(Handle);
+}
+
+/**
+ * @brief Apply a buff or debuff to the maximum value or generate amount of the data
+ * @param Name The name of the data item
+ * @param Modifier The modifier to apply
+ * @return The ID of the modifier or -1 if the data item is not tracked
+ */
+int UTrackableDataComponent::AddModifier(const FName Name, const FTrackableDataModifier& Modifier)
+{
+	const int Handle = GetHandle(Name);
+	if (Subsystem == nullptr || !Subsystem->IsValidHandle(Handle))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Data not added to map ({0})"), { Name.ToString() }));
+		return INDEX_NONE;
+	}
+
+	return Subsystem->AddModifier(Handle, Modifier);
+}
+
+/**
+ * @brief Remove a modifier before it expires
+ * @param ModifierId The ID of the modifier
+ * @return A boolean value indicating if the modifier was removed
+ */
+bool UTrackableDataComponent::RemoveModifier(const int ModifierId)
+{
+	return Subsystem != nullptr && Subsystem->RemoveModifier(ModifierId);
+}
+
+/**
+ * @brief Notify a listener at most once per frame when the value of a single data item changes
+ * @param Name The name of the data item
+ * @param Callback The delegate called when the value changes
+ * @param MinDelta The minimum change in value since the last notification before the listener is notified again
+ * @param MinInterval The minimum amount of seconds between notifications
+ * @return The ID of the subscription or -1 if the data item is not tracked
+ */
+int UTrackableDataComponent::Subscribe(const FName Name, FTrackableDataSubscriptionDelegate Callback,
+	const float MinDelta, const float MinInterval)
+{
+	const int Handle = GetHandle(Name);
+	if (Handle == INDEX_NONE && (HasBegunPlay() || !Data.Contains(Name)))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Data not added to map ({0})"), { Name.ToString() }));
+		return INDEX_NONE;
+	}
+
+	FTrackableDataSubscription Subscription;
+	Subscription.Id = NextSubscriptionId++;
+	Subscription.Callback = Callback;
+	Subscription.MinDelta = FMath::Max(MinDelta, 0.0f);
+	Subscription.MinInterval = FMath::Max(MinInterval, 0.0f);
+
+	// The data is only registered with the subsystem once the component begins play
+	if (Handle == INDEX_NONE)
+	{
+		QueuedSubscriptions.FindOrAdd(Name).Add(Subscription);
+		return Subscription.Id;
+	}
+
+	Subscription.LastValue = Subsystem->GetValue(Handle);
+	Subscriptions.FindOrAdd(Handle).Add(Subscription);
+	UpdateNotifyThreshold(Handle);
+	return Subscription.Id;
+}
+
+/**
+ * @brief Stop notifying a listener
+ * @param SubscriptionId The ID of the subscription
+ */
+void UTrackableDataComponent::Unsubscribe(const int SubscriptionId)
+{
+	for (TPair<FName, TArray<FTrackableDataSubscription>>& Item : QueuedSubscriptions)
+	{
+		const int Removed = Item.Value.RemoveAll([SubscriptionId](const FTrackableDataSubscription& Subscription)
+		{
+			return Subscription.Id == SubscriptionId;
+		});
+
+		if (Removed > 0)
+		{
+			return;
+		}
+	}
+
+	for (TPair<int, TArray<FTrackableDataSubscription>>& Item : Subscriptions)
+	{
+		const int Removed = Item.Value.RemoveAll([SubscriptionId](const FTrackableDataSubscription& Subscription)
+		{
+			return Subscription.Id == SubscriptionId;
+		});
+
+		if (Removed > 0)
+		{
+			UpdateNotifyThreshold(Item.Key);
+			return;
+		}
+	}
+}
+
+/**
+ * @brief Register the subscriptions that were added before the component began play
+ */
+void UTrackableDataComponent::RegisterQueuedSubscriptions()
+{
+	for (TPair<FName, TArray<FTrackableDataSubscription>>& Item : QueuedSubscriptions)
+	{
+		const int Handle = GetHandle(Item.Key);
+		if (Handle == INDEX_NONE)
+		{
+			USK_LOG_ERROR(*FString::Format(TEXT("Data not added to map ({0})"), { Item.Key.ToString() }));
+			continue;
+		}
+
+		// The listeners are notified of changes made after the data was loaded
+		for (FTrackableDataSubscription& Subscription : Item.Value)
+		{
+			Subscription.LastValue = Subsystem->GetValue(Handle);
+			Subscriptions.FindOrAdd(Handle).Add(Subscription);
+		}
+
+		UpdateNotifyThreshold(Handle);
+	}
+
+	QueuedSubscriptions.Empty();
 }
 
 /**
@@ -167,28 +393,32 @@ void UTrackableDataComponent::LoadData()
 		USK_LOG_ERROR("SaveGame is nullptr");
 	}
 
-	TArray<FName> Keys;
-	Data.GetKeys(Keys);
-	for (FName Key : Keys)
+	if (Subsystem == nullptr)
 	{
-		if (DisableSaveData || !Data[Key].AutoSave || !SaveGame->TrackableData.Contains(Key))
+		return;
+	}
+
+	DirtyKeys.Reset();
+	for (const TPair<FName, int>& Handle : Handles)
+	{
+		const FTrackableData& Item = Data[Handle.Key];
+		if (DisableSaveData || !Item.AutoSave || !SaveGame->TrackableData.Contains(Handle.Key))
 		{
-			USK_LOG_INFO(*FString::Format(TEXT("Resetting {0} to initial value"), { Key.ToString() }));
-			Data[Key].CurrentValue = Data[Key].InitialValue;
+			USK_LOG_INFO(*FString::Format(TEXT("Resetting {0} to initial value"), { Handle.Key.ToString() }));
+			Subsystem->SetValue(Handle.Value, Item.InitialValue);
 			continue;
 		}
 
-		USK_LOG_INFO(*FString::Format(TEXT("Loading saved value for {0}"), { Key.ToString() }));
-		Data[Key].CurrentValue = SaveGame->TrackableData[Key];
+		USK_LOG_INFO(*FString::Format(TEXT("Loading saved value for {0}"), { Handle.Key.ToString() }));
+		Subsystem->SetValue(Handle.Value, SaveGame->TrackableData[Handle.Key]);
 	}
 }
 
 /**
- * @brief Save the value of the data
+ * @brief Mark the value of the data as modified so it is saved on the next flush of the save data
  * @param Name The name of the data item
- * @param Amount The current amount to save
  */
-void UTrackableDataComponent::SaveValue(const FName Name, const int Amount)
+void UTrackableDataComponent::SaveValue(const FName Name)
 {
 	if (!Data[Name].AutoSave)
 	{
@@ -201,21 +431,178 @@ void UTrackableDataComponent::SaveValue(const FName Name, const int Amount)
 		return;
 	}
 
+	DirtyKeys.Add(Name);
+	GameInstance->RequestSaveData();
+}
+
+/**
+ * @brief Write the modified values into the save data
+ */
+void UTrackableDataComponent::WriteDirtyValues()
+{
+	if (DirtyKeys.Num() == 0)
+	{
+		return;
+	}
+
 	UUSKSaveGame* SaveGame = GameInstance->GetSaveData();
 	if (SaveGame == nullptr)
 	{
-		USK_LOG_ERROR("GameInstance is nullptr");
+		USK_LOG_ERROR("SaveGame is nullptr");
 		return;
 	}
 
-	if (SaveGame->TrackableData.Contains(Name))
+	for (const FName& Key : DirtyKeys)
 	{
-		SaveGame->TrackableData[Name] = Amount;	
+		const int Handle = GetHandle(Key);
+		if (Handle != INDEX_NONE)
+		{
+			SaveGame->TrackableData.Add(Key, static_cast<int>(Subsystem->GetValue(Handle)));
+		}
 	}
-	else
+
+	DirtyKeys.Reset();
+}
+
+/**
+ * @brief Called by the subsystem after the value of the data was regenerated or its maximum value was modified
+ * @param Handle The handle of the data item
+ */
+void UTrackableDataComponent::OnValueChangedBySubsystem(const int Handle)
+{
+	const FName Name = Subsystem->GetName(Handle);
+	const int NewValue = Subsystem->GetValue(Handle);
+	OnValueUpdated.Broadcast(Name, NewValue, GetValuePercentageByHandle(Handle));
+	QueueNotification(Handle);
+	SaveValue(Name);
+}
+
+/**
+ * @brief Queue a notification for the subscriptions of a data item
+ * @param Handle The handle of the data item
+ */
+void UTrackableDataComponent::QueueNotification(const int Handle)
+{
+	const TArray<FTrackableDataSubscription>* DataSubscriptions = Subscriptions.Find(Handle);
+	if (DataSubscriptions == nullptr || DataSubscriptions->Num() == 0)
+	{
+		return;
+	}
+
+	// All the changes made during the frame are reported with a single notification
+	ChangedHandles.AddUnique(Handle);
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if (!TimerManager.IsTimerActive(NotifyTimer))
+	{
+		NotifyTimer = TimerManager.SetTimerForNextTick(this, &UTrackableDataComponent::NotifySubscriptions);
+	}
+}
+
+/**
+ * @brief Notify the subscriptions of the data items that changed
+ */
+void UTrackableDataComponent::NotifySubscriptions()
+{
+	TArray<int> NotifyHandles = MoveTemp(ChangedHandles);
+	for (const int Handle : PendingHandles)
+	{
+		NotifyHandles.AddUnique(Handle);
+	}
+
+	ChangedHandles.Reset();
+	PendingHandles.Reset();
+
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	float PendingDelay = FLT_MAX;
+	TArray<TPair<FTrackableDataSubscriptionDelegate, int>> Callbacks;
+	for (const int Handle : NotifyHandles)
+	{
+		TArray<FTrackableDataSubscription>* DataSubscriptions = Subscriptions.Find(Handle);
+		if (DataSubscriptions == nullptr || Subsystem == nullptr || !Subsystem->IsValidHandle(Handle))
+		{
+			continue;
+		}
+
+		const float Value = Subsystem->GetValue(Handle);
+		const bool bIsLimit = Value <= 0.0f || Value >= Subsystem->GetMaxValue(Handle);
+		for (FTrackableDataSubscription& Subscription : *DataSubscriptions)
+		{
+			// Reaching zero or the maximum value is always reported so listeners never show a stale final value
+			if (Value == Subscription.LastValue ||
+				(!bIsLimit && FMath::Abs(Value - Subscription.LastValue) < Subscription.MinDelta))
+			{
+				continue;
+			}
+
+			const double NextNotifyTime = Subscription.LastNotifyTime + Subscription.MinInterval;
+			if (CurrentTime < NextNotifyTime)
+			{
+				PendingHandles.AddUnique(Handle);
+				PendingDelay = FMath::Min(PendingDelay, static_cast<float>(NextNotifyTime - CurrentTime));
+				continue;
+			}
+
+			Subscription.LastValue = Value;
+			Subscription.LastNotifyTime = CurrentTime;
+			Callbacks.Add(TPair<FTrackableDataSubscriptionDelegate, int>(Subscription.Callback, Handle));
+		}
+
+		UpdateNotifyThreshold(Handle);
+	}
+
+	if (PendingHandles.Num() > 0)
 	{
-		SaveGame->TrackableData.Add(Name, Amount);
+		GetWorld()->GetTimerManager().SetTimer(PendingNotifyTimer, this, &UTrackableDataComponent::NotifySubscriptions,
+			FMath::Max(PendingDelay, KINDA_SMALL_NUMBER), false);
+	}
+
+	// The listeners are notified after the loop because they are allowed to subscribe and unsubscribe
+	for (const TPair<FTrackableDataSubscriptionDelegate, int>& Callback : Callbacks)
+	{
+		if (Subsystem->IsValidHandle(Callback.Value))
+		{
+			Callback.Key.ExecuteIfBound(Subsystem->GetName(Callback.Value), Subsystem->GetValue(Callback.Value),
+				GetValuePercentageByHandle(Callback.Value));
+		}
+	}
+}
+
+/**
+ * @brief Notify the subscriptions of the data items that changed without waiting for the next frame
+ */
+void UTrackableDataComponent::FlushNotifications()
+{
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	if (TimerManager.IsTimerActive(NotifyTimer))
+	{
+		TimerManager.ClearTimer(NotifyTimer);
+		NotifySubscriptions();
+	}
+}
+
+/**
+ * @brief Let the subsystem notify the component when a lazily generated value changes enough for a subscription
+ * @param Handle The handle of the data item
+ */
+void UTrackableDataComponent::UpdateNotifyThreshold(const int Handle)
+{
+	if (Subsystem == nullptr)
+	{
+		return;
+	}
+
+	// Subscriptions without a minimum delta only want changes, so the value is left to generate until it is full
+	float Threshold = FLT_MAX;
+	if (const TArray<FTrackableDataSubscription>* DataSubscriptions = Subscriptions.Find(Handle))
+	{
+		for (const FTrackableDataSubscription& Subscription : *DataSubscriptions)
+		{
+			if (Subscription.MinDelta > 0.0f)
+			{
+				Threshold = FMath::Min(Threshold, Subscription.LastValue + Subscription.MinDelta);
+			}
+		}
 	}
 
-	GameInstance->SaveData();
+	Subsystem->SetNotifyThreshold(Handle, Threshold);
 }
@@ -4,9 +4,13 @@
 
 #include "Components/ActorComponent.h"
 #include "TrackableData.h"
+#include "TrackableDataModifier.h"
+#include "TrackableDataSubscription.h"
 #include "USK/Core/USKGameInstance.h"
 #include "TrackableDataComponent.generated.h"
 
+class UTrackableDataSubsystem;
+
 /**
  * @brief A component that is used to easily manage/track different types of actor data
  */
@@ -15,6 +19,8 @@ class USK_API UTrackableDataComponent : public UActorComponent
 {
 	GENERATED_BODY()
 
+	friend class UTrackableDataSubsystem;
+
 	/**
 	 * @brief Event used to notify other classes every time the data value reaches 0
 	 * @param Name The name of the data item
@@ -87,6 +93,93 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Trackable Data")
 	virtual float Remove(const FName Name, const float Amount);
 
+	/**
+	 * @brief Get the handle used to access the data without looking up the name
+	 * @param Name The name of the data item
+	 * @return The handle of the data item or -1 if the data item is not tracked
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Trackable Data")
+	int GetHandle(const FName Name) const;
+
+	/**
+	 * @brief Get the amount of the data using a handle
+	 * @param Handle The handle of the data item
+	 * @return The current amount of the data item
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Trackable Data")
+	float GetValueByHandle(const int Handle) const;
+
+	/**
+	 * @brief Get the value of the data as a percentage of to the max value using a handle
+	 * @param Handle The handle of the data item
+	 * @return The value of the data as a percentage of to the max value
+	 */
+	UFUNCTION(BlueprintPure, Category = "Ultimate Starter Kit|Trackable Data")
+	float GetValuePercentageByHandle(const int Handle) const;
+
+	/**
+	 * @brief Add an amount to the data using a handle
+	 * @param Handle The handle of the data item
+	 * @param Amount The amount to add
+	 * @return The new amount of the data item
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Trackable Data")
+	float AddByHandle(const int Handle, const float Amount);
+
+	/**
+	 * @brief Remove an amount from the data using a handle
+	 * @param Handle The handle of the data item
+	 * @param Amount The amount to remove
+	 * @return The new amount of the data item
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Trackable Data")
+	float RemoveByHandle(const int Handle, const float Amount);
+
+	/**
+	 * @brief Get the maximum value of the data after the modifiers are applied
+	 * @param Name The name of the data item
+	 * @return The maximum value of the data item
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Trackable Data")
+	float GetMaxValue(const FName Name) const;
+
+	/**
+	 * @brief Apply a buff or debuff to the maximum value or generate amount of the data
+	 * @param Name The name of the data item
+	 * @param Modifier The modifier to apply
+	 * @return The ID of the modifier or -1 if the data item is not tracked
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Trackable Data")
+	int AddModifier(const FName Name, const FTrackableDataModifier& Modifier);
+
+	/**
+	 * @brief Remove a modifier before it expires
+	 * @param ModifierId The ID of the modifier
+	 * @return A boolean value indicating if the modifier was removed
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Trackable Data")
+	bool RemoveModifier(const int ModifierId);
+
+	/**
+	 * @brief Notify a listener at most once per frame when the value of a single data item changes. Lazily generated
+	 * values notify the listener while generating each time they change by MinDelta, or only when they reach their
+	 * maximum value if MinDelta is 0
+	 * @param Name The name of the data item
+	 * @param Callback The delegate called when the value changes
+	 * @param MinDelta The minimum change in value since the last notification before the listener is notified again
+	 * @param MinInterval The minimum amount of seconds between notifications
+	 * @return The ID of the subscription or -1 if the data item is not tracked
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Trackable Data")
+	int Subscribe(const FName Name, FTrackableDataSubscriptionDelegate Callback, float MinDelta = 0.0f, float MinInterval = 0.0f);
+
+	/**
+	 * @brief Stop notifying a listener
+	 * @param SubscriptionId The ID of the subscription
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Trackable Data")
+	void Unsubscribe(const int SubscriptionId);
+
 protected:
 	/**
 	 * @brief Begins Play for the component
@@ -94,13 +187,10 @@ protected:
 	virtual void BeginPlay() override;
 
 	/**
-	 * @brief Function called every frame on this ActorComponent
-	 * @param DeltaTime The time since the last tick
-	 * @param TickType The kind of tick this is, for example, are we paused, or 'simulating' in the editor
-	 * @param ThisTickFunction Internal tick function struct that caused this to run
+	 * @brief Ends gameplay for this component
+	 * @param EndPlayReason The reason the component is ending play
 	 */
-	virtual void TickComponent(float DeltaTime, ELevelTick TickType,
-		FActorComponentTickFunction* ThisTickFunction) override;
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
 
 private:
 	/**
@@ -108,16 +198,104 @@ private:
 	 */
 	UPROPERTY()
 	UUSKGameInstance* GameInstance;
+
+	/**
+	 * @brief The subsystem that stores and regenerates the values of the data
+	 */
+	UPROPERTY()
+	UTrackableDataSubsystem* Subsystem;
+
+	/**
+	 * @brief The handle of each data item
+	 */
+	TMap<FName, int> Handles;
+
+	/**
+	 * @brief The subscriptions of each data item by handle
+	 */
+	TMap<int, TArray<FTrackableDataSubscription>> Subscriptions;
+
+	/**
+	 * @brief The subscriptions added before the component began play by the name of the data item
+	 */
+	TMap<FName, TArray<FTrackableDataSubscription>> QueuedSubscriptions;
+
+	/**
+	 * @brief The ID assigned to the next subscription
+	 */
+	int NextSubscriptionId;
+
+	/**
+	 * @brief The handles of the subscribed data items that changed since the subscriptions were last notified
+	 */
+	TArray<int> ChangedHandles;
+
+	/**
+	 * @brief The handles of the data items with subscriptions that are waiting for their minimum interval
+	 */
+	TArray<int> PendingHandles;
+
+	/**
+	 * @brief The timer used to notify the subscriptions once during the next frame
+	 */
+	FTimerHandle NotifyTimer;
+
+	/**
+	 * @brief The timer used to notify the subscriptions that are waiting for their minimum interval
+	 */
+	FTimerHandle PendingNotifyTimer;
+
+	/**
+	 * @brief The names of the data items that were modified since they were written into the save data
+	 */
+	TSet<FName> DirtyKeys;
 	
+	/**
+	 * @brief Register the subscriptions that were added before the component began play
+	 */
+	void RegisterQueuedSubscriptions();
+
 	/**
 	 * @brief Load the data managed by this component
 	 */
 	void LoadData();
 
 	/**
-	 * @brief Save the value of the data
+	 * @brief Mark the value of the data as modified so it is saved on the next flush of the save data
 	 * @param Name The name of the data item
-	 * @param Amount The current amount to save
 	 */
-	void SaveValue(const FName Name, const int Amount);
+	void SaveValue(const FName Name);
+
+	/**
+	 * @brief Write the modified values into the save data
+	 */
+	void WriteDirtyValues();
+
+	/**
+	 * @brief Called by the subsystem after the value of the data was regenerated or its maximum value was modified
+	 * @param Handle The handle of the data item
+	 */
+	void OnValueChangedBySubsystem(const int Handle);
+
+	/**
+	 * @brief Queue a notification for the subscriptions of a data item
+	 * @param Handle The handle of the data item
+	 */
+	void QueueNotification(const int Handle);
+
+	/**
+	 * @brief Notify the subscriptions of the data items that changed
+	 */
+	void NotifySubscriptions();
+
+	/**
+	 * @brief Notify the subscriptions of the data items that changed without waiting for the next frame
+	 */
+	void FlushNotifications();
+
+	/**
+	 * @brief Let the subsystem notify the component when a lazily generated value changes enough for a subscription
+	 * @param Handle The handle of the data item
+	 */
+	void UpdateNotifyThreshold(const int Handle);
 };
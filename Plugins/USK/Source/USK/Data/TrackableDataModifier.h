@@ -0,0 +1,41 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TrackableDataModifierTarget.h"
+#include "TrackableDataModifierType.h"
+#include "TrackableDataModifier.generated.h"
+
+/**
+ * @brief A buff or debuff that changes the maximum value or generate amount of trackable data
+ */
+USTRUCT(BlueprintType)
+struct USK_API FTrackableDataModifier
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The property of the data that is changed
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Trackable Data")
+	ETrackableDataModifierTarget Target = ETrackableDataModifierTarget::MaxValue;
+
+	/**
+	 * @brief The way in which the property is changed
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Trackable Data")
+	ETrackableDataModifierType Type = ETrackableDataModifierType::Flat;
+
+	/**
+	 * @brief The amount added to the property (negative for a debuff)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Trackable Data")
+	float Value = 0.0f;
+
+	/**
+	 * @brief The amount of seconds before the modifier is removed (0 = until it is removed manually)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Trackable Data")
+	float Duration = 0.0f;
+};
@@ -0,0 +1,42 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TrackableDataModifier.h"
+
+/**
+ * @brief The modifiers applied to a single trackable value and their aggregated totals
+ */
+struct FTrackableDataModifierStack
+{
+	/**
+	 * @brief The ID of each modifier
+	 */
+	TArray<int> Ids;
+
+	/**
+	 * @brief The modifiers applied to the value
+	 */
+	TArray<FTrackableDataModifier> Modifiers;
+
+	/**
+	 * @brief The sum of the flat modifiers of the maximum value
+	 */
+	float FlatMaxValue = 0.0f;
+
+	/**
+	 * @brief The sum of the percentage modifiers of the maximum value
+	 */
+	float PercentageMaxValue = 0.0f;
+
+	/**
+	 * @brief The sum of the flat modifiers of the generate amount
+	 */
+	float FlatGenerateAmount = 0.0f;
+
+	/**
+	 * @brief The sum of the percentage modifiers of the generate amount
+	 */
+	float PercentageGenerateAmount = 0.0f;
+};
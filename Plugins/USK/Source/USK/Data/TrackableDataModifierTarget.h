@@ -0,0 +1,23 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TrackableDataModifierTarget.generated.h"
+
+/**
+ * @brief The properties of trackable data that can be changed by a modifier
+ */
+UENUM(BlueprintType)
+enum class ETrackableDataModifierTarget : uint8
+{
+	/**
+	 * @brief Change the maximum value of the data
+	 */
+	MaxValue,
+
+	/**
+	 * @brief Change the amount of value generated every second
+	 */
+	GenerateAmount,
+};
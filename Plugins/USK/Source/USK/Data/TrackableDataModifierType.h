@@ -0,0 +1,23 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TrackableDataModifierType.generated.h"
+
+/**
+ * @brief The ways in which a modifier changes a property of trackable data
+ */
+UENUM(BlueprintType)
+enum class ETrackableDataModifierType : uint8
+{
+	/**
+	 * @brief Add the value of the modifier to the property
+	 */
+	Flat,
+
+	/**
+	 * @brief Add a percentage of the property after all the flat modifiers are applied (0.25 = 25%)
+	 */
+	Percentage,
+};
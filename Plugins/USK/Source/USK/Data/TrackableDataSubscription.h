@@ -0,0 +1,50 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TrackableDataSubscription.generated.h"
+
+/**
+ * @brief Delegate called when the value of a subscribed data item changes
+ * @param Name The name of the data item
+ * @param Value The current value of the data item
+ * @param ValuePercentage The percentage of the current value compared to the max value of the data item
+ */
+DECLARE_DYNAMIC_DELEGATE_ThreeParams(FTrackableDataSubscriptionDelegate, FName, Name, float, Value, float, ValuePercentage);
+
+/**
+ * @brief A listener that is notified when the value of a single data item changes
+ */
+struct FTrackableDataSubscription
+{
+	/**
+	 * @brief The ID of the subscription
+	 */
+	int Id = INDEX_NONE;
+
+	/**
+	 * @brief The delegate called when the value changes
+	 */
+	FTrackableDataSubscriptionDelegate Callback;
+
+	/**
+	 * @brief The minimum change in value since the last notification before the listener is notified again
+	 */
+	float MinDelta = 0.0f;
+
+	/**
+	 * @brief The minimum amount of seconds between notifications
+	 */
+	float MinInterval = 0.0f;
+
+	/**
+	 * @brief The value the listener was last notified with
+	 */
+	float LastValue = 0.0f;
+
+	/**
+	 * @brief The time at which the listener was last notified
+	 */
+	double LastNotifyTime = -DBL_MAX;
+};
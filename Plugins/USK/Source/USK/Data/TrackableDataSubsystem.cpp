@@ -0,0 +1,684 @@
+﻿// Created by Henry Jooste
+
+#include "TrackableDataSubsystem.h"
+
+#include "TrackableDataComponent.h"
+#include "TimerManager.h"
+#include "Engine/World.h"
+
+/**
+ * @brief Check if the subsystem should be created for the world
+ * @param Outer The world that owns the subsystem
+ * @return A boolean value indicating if the subsystem should be created
+ */
+bool UTrackableDataSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return Super::ShouldCreateSubsystem(Outer) && IsValid(World) && World->IsGameWorld();
+}
+
+/**
+ * @brief Remove all the values when the world is torn down
+ */
+void UTrackableDataSubsystem::Deinitialize()
+{
+	GetWorld()->GetTimerManager().ClearAllTimersForObject(this);
+	CurrentValues.Empty();
+	MaxValues.Empty();
+	BaseMaxValues.Empty();
+	EnforceMaxValues.Empty();
+	ClampValues.Empty();
+	GenerateAmounts.Empty();
+	BaseGenerateAmounts.Empty();
+	GenerateDelays.Empty();
+	CurrentGenerateDelays.Empty();
+	LazyValues.Empty();
+	GenerateStartTimes.Empty();
+	NotifyThresholds.Empty();
+	GenerateTimers.Empty();
+	GeneratedAmounts.Empty();
+	Owners.Empty();
+	Names.Empty();
+	IndexHandles.Empty();
+	HandleIndices.Empty();
+	FreeHandles.Empty();
+	UpdatedHandles.Empty();
+	NotifiedOwners.Empty();
+	ModifierStacks.Empty();
+	ModifierHandles.Empty();
+	ModifierExpiries.Reset();
+	RegeneratingCount = 0;
+	Super::Deinitialize();
+}
+
+/**
+ * @brief Remove the expired modifiers and regenerate the values that are below their maximum value
+ * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+ */
+void UTrackableDataSubsystem::Tick(float DeltaTime)
+{
+	if (ModifierExpiries.Num() > 0)
+	{
+		ExpireModifiers(GetWorld()->GetTimeSeconds());
+	}
+
+	const int Count = RegeneratingCount;
+	GeneratedAmounts.SetNumUninitialized(Count, false);
+
+	float* Values = CurrentValues.GetData();
+	float* Delays = CurrentGenerateDelays.GetData();
+	float* Generated = GeneratedAmounts.GetData();
+	const float* Maximums = MaxValues.GetData();
+	const float* Amounts = GenerateAmounts.GetData();
+
+	// The loop has no branches or lookups so the compiler is able to vectorize it
+	for (int Index = 0; Index < Count; Index++)
+	{
+		const float Amount = Delays[Index] > 0.0f ? 0.0f : Amounts[Index] * DeltaTime;
+		const float NewValue = FMath::Min(Values[Index] + Amount, Maximums[Index]);
+		Generated[Index] = NewValue - Values[Index];
+		Values[Index] = NewValue;
+		Delays[Index] = FMath::Max(Delays[Index] - DeltaTime, 0.0f);
+	}
+
+	UpdatedHandles.Reset();
+	for (int Index = 0; Index < Count; Index++)
+	{
+		if (Generated[Index] > 0.0f)
+		{
+			UpdatedHandles.Add(IndexHandles[Index]);
+		}
+	}
+
+	// The regenerating range is updated before the owners are notified because they are allowed to update values
+	for (const int Handle : UpdatedHandles)
+	{
+		UpdateRegeneration(Handle);
+	}
+
+	for (const int Handle : UpdatedHandles)
+	{
+		if (!IsValidHandle(Handle))
+		{
+			continue;
+		}
+
+		NotifyOwner(Handle);
+	}
+
+	FlushNotifications();
+}
+
+/**
+ * @brief Check if the subsystem should be ticked
+ * @return A boolean value indicating if the subsystem should be ticked
+ */
+bool UTrackableDataSubsystem::IsTickable() const
+{
+	return RegeneratingCount > 0 || ModifierExpiries.Num() > 0;
+}
+
+/**
+ * @brief Get the tick type of the subsystem
+ * @return The tick type of the subsystem
+ */
+ETickableTickType UTrackableDataSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+/**
+ * @brief Get the world the subsystem is ticked in
+ * @return The world the subsystem is ticked in
+ */
+UWorld* UTrackableDataSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/**
+ * @brief Get the stat ID used to profile the subsystem
+ * @return The stat ID used to profile the subsystem
+ */
+TStatId UTrackableDataSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UTrackableDataSubsystem, STATGROUP_Tickables);
+}
+
+/**
+ * @brief Start tracking a value
+ * @param Owner The component that owns the value
+ * @param Name The name of the data item
+ * @param Data The default values and behaviours of the data item
+ * @return The handle of the value
+ */
+int UTrackableDataSubsystem::RegisterValue(UTrackableDataComponent* Owner, const FName Name, const FTrackableData& Data)
+{
+	const int Handle = FreeHandles.Num() > 0 ? FreeHandles.Pop(false) : HandleIndices.Add(INDEX_NONE);
+	const int Index = CurrentValues.Add(Data.InitialValue);
+	const float GenerateAmount = Data.AutoGenerate ? FMath::Max(Data.GenerateAmount, 0.0f) : 0.0f;
+	MaxValues.Add(Data.MaxValue);
+	BaseMaxValues.Add(Data.MaxValue);
+	EnforceMaxValues.Add(Data.EnforceMaxValue);
+	ClampValues.Add(Data.EnforceMaxValue ? Data.MaxValue : FLT_MAX);
+	GenerateAmounts.Add(GenerateAmount);
+	BaseGenerateAmounts.Add(GenerateAmount);
+	GenerateDelays.Add(Data.GenerateDelay);
+	CurrentGenerateDelays.Add(0.0f);
+	LazyValues.Add(Data.LazyGenerate);
+	GenerateStartTimes.Add(GetWorld()->GetTimeSeconds());
+	NotifyThresholds.Add(FLT_MAX);
+	GenerateTimers.AddDefaulted();
+	Owners.Add(Owner);
+	Names.Add(Name);
+	IndexHandles.Add(Handle);
+	HandleIndices[Handle] = Index;
+
+	UpdateRegeneration(Handle);
+	return Handle;
+}
+
+/**
+ * @brief Stop tracking a value
+ * @param Handle The handle of the value
+ */
+void UTrackableDataSubsystem::UnregisterValue(const int Handle)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return;
+	}
+
+	if (const FTrackableDataModifierStack* Stack = ModifierStacks.Find(Handle))
+	{
+		for (const int ModifierId : Stack->Ids)
+		{
+			ModifierHandles.Remove(ModifierId);
+		}
+
+		ModifierStacks.Remove(Handle);
+	}
+
+	int Index = HandleIndices[Handle];
+	GetWorld()->GetTimerManager().ClearTimer(GenerateTimers[Index]);
+	if (Index < RegeneratingCount)
+	{
+		RegeneratingCount--;
+		SwapValues(Index, RegeneratingCount);
+		Index = RegeneratingCount;
+	}
+
+	SwapValues(Index, CurrentValues.Num() - 1);
+	CurrentValues.Pop(false);
+	MaxValues.Pop(false);
+	BaseMaxValues.Pop(false);
+	EnforceMaxValues.Pop(false);
+	ClampValues.Pop(false);
+	GenerateAmounts.Pop(false);
+	BaseGenerateAmounts.Pop(false);
+	GenerateDelays.Pop(false);
+	CurrentGenerateDelays.Pop(false);
+	LazyValues.Pop(false);
+	GenerateStartTimes.Pop(false);
+	NotifyThresholds.Pop(false);
+	GenerateTimers.Pop(false);
+	Owners.Pop(false);
+	Names.Pop(false);
+	IndexHandles.Pop(false);
+
+	HandleIndices[Handle] = INDEX_NONE;
+	FreeHandles.Add(Handle);
+}
+
+/**
+ * @brief Check if a handle refers to a value that is being tracked
+ * @param Handle The handle of the value
+ * @return A boolean value indicating if the handle is valid
+ */
+bool UTrackableDataSubsystem::IsValidHandle(const int Handle) const
+{
+	return HandleIndices.IsValidIndex(Handle) && HandleIndices[Handle] != INDEX_NONE;
+}
+
+/**
+ * @brief Get the name of the data item of a value
+ * @param Handle The handle of the value
+ * @return The name of the data item
+ */
+FName UTrackableDataSubsystem::GetName(const int Handle) const
+{
+	return IsValidHandle(Handle) ? Names[HandleIndices[Handle]] : NAME_None;
+}
+
+/**
+ * @brief Get the current amount of a value. Values that are generated lazily are calculated from the time they last changed
+ * @param Handle The handle of the value
+ * @return The current amount of the value
+ */
+float UTrackableDataSubsystem::GetValue(const int Handle) const
+{
+	return IsValidHandle(Handle) ? EvaluateValue(HandleIndices[Handle]) : 0.0f;
+}
+
+/**
+ * @brief Get the maximum amount of a value
+ * @param Handle The handle of the value
+ * @return The maximum amount of the value
+ */
+float UTrackableDataSubsystem::GetMaxValue(const int Handle) const
+{
+	return IsValidHandle(Handle) ? MaxValues[HandleIndices[Handle]] : 0.0f;
+}
+
+/**
+ * @brief Add an amount to a value and restart the regenerate delay if the amount is negative
+ * @param Handle The handle of the value
+ * @param Amount The amount to add
+ * @return The new amount of the value
+ */
+float UTrackableDataSubsystem::AddValue(const int Handle, const float Amount)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return 0.0f;
+	}
+
+	const int Index = HandleIndices[Handle];
+	MaterializeValue(Index);
+	CurrentValues[Index] = FMath::Clamp(CurrentValues[Index] + Amount, 0.0f, ClampValues[Index]);
+	if (Amount < 0.0f && GenerateAmounts[Index] > 0.0f)
+	{
+		CurrentGenerateDelays[Index] = GenerateDelays[Index];
+		GenerateStartTimes[Index] = GetWorld()->GetTimeSeconds() + GenerateDelays[Index];
+	}
+
+	const float NewValue = CurrentValues[Index];
+	UpdateRegeneration(Handle);
+	return NewValue;
+}
+
+/**
+ * @brief Replace the current amount of a value without restarting the regenerate delay
+ * @param Handle The handle of the value
+ * @param Value The new amount of the value
+ */
+void UTrackableDataSubsystem::SetValue(const int Handle, const float Value)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return;
+	}
+
+	const int Index = HandleIndices[Handle];
+	MaterializeValue(Index);
+	CurrentValues[Index] = Value;
+	UpdateRegeneration(Handle);
+}
+
+/**
+ * @brief Set the amount at which the owner is notified while a lazily generated value is generating
+ * @param Handle The handle of the value
+ * @param Threshold The amount at which the owner is notified (FLT_MAX = only when the maximum amount is reached)
+ */
+void UTrackableDataSubsystem::SetNotifyThreshold(const int Handle, const float Threshold)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return;
+	}
+
+	const int Index = HandleIndices[Handle];
+	if (!LazyValues[Index] || NotifyThresholds[Index] == Threshold)
+	{
+		return;
+	}
+
+	NotifyThresholds[Index] = Threshold;
+	ScheduleGenerateTimer(Handle);
+}
+
+/**
+ * @brief Apply a modifier to the maximum value or generate amount of a value
+ * @param Handle The handle of the value
+ * @param Modifier The modifier to apply
+ * @return The ID of the modifier or -1 if the handle is not valid
+ */
+int UTrackableDataSubsystem::AddModifier(const int Handle, const FTrackableDataModifier& Modifier)
+{
+	return AddModifierAt(Handle, Modifier, GetWorld()->GetTimeSeconds());
+}
+
+/**
+ * @brief Remove a modifier before it expires
+ * @param ModifierId The ID of the modifier
+ * @return A boolean value indicating if the modifier was removed
+ */
+bool UTrackableDataSubsystem::RemoveModifier(const int ModifierId)
+{
+	int Handle;
+	if (!ModifierHandles.RemoveAndCopyValue(ModifierId, Handle))
+	{
+		return false;
+	}
+
+	// The expiry stays in the timing wheel and is ignored when it is reached
+	FTrackableDataModifierStack& Stack = ModifierStacks.FindChecked(Handle);
+	const int Index = Stack.Ids.Find(ModifierId);
+	AggregateModifier(Stack, Stack.Modifiers[Index], -1.0f);
+	Stack.Ids.RemoveAtSwap(Index, 1, false);
+	Stack.Modifiers.RemoveAtSwap(Index, 1, false);
+	if (Stack.Ids.Num() == 0)
+	{
+		ModifierStacks.Remove(Handle);
+	}
+
+	ApplyModifiers(Handle);
+	return true;
+}
+
+/**
+ * @brief Get the amount of modifiers that are applied to all the values
+ * @return The amount of modifiers that are applied to all the values
+ */
+int UTrackableDataSubsystem::GetModifierCount() const
+{
+	return ModifierHandles.Num();
+}
+
+/**
+ * @brief Get the amount of values that are being tracked
+ * @return The amount of values that are being tracked
+ */
+int UTrackableDataSubsystem::GetValueCount() const
+{
+	return CurrentValues.Num();
+}
+
+/**
+ * @brief Get the amount of values that are currently regenerating
+ * @return The amount of values that are currently regenerating
+ */
+int UTrackableDataSubsystem::GetRegeneratingCount() const
+{
+	return RegeneratingCount;
+}
+
+/**
+ * @brief Move a value in or out of the regenerating range based on its current amount
+ * @param Handle The handle of the value
+ */
+void UTrackableDataSubsystem::UpdateRegeneration(const int Handle)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return;
+	}
+
+	const int Index = HandleIndices[Handle];
+	if (LazyValues[Index])
+	{
+		ScheduleGenerateTimer(Handle);
+		return;
+	}
+
+	const bool bShouldRegenerate = GenerateAmounts[Index] > 0.0f && CurrentValues[Index] < MaxValues[Index];
+	const bool bIsRegenerating = Index < RegeneratingCount;
+	if (bShouldRegenerate == bIsRegenerating)
+	{
+		return;
+	}
+
+	if (bShouldRegenerate)
+	{
+		SwapValues(Index, RegeneratingCount);
+		RegeneratingCount++;
+		return;
+	}
+
+	RegeneratingCount--;
+	SwapValues(Index, RegeneratingCount);
+}
+
+/**
+ * @brief Swap the storage of two values
+ * @param IndexA The index of the first value
+ * @param IndexB The index of the second value
+ */
+void UTrackableDataSubsystem::SwapValues(const int IndexA, const int IndexB)
+{
+	if (IndexA == IndexB)
+	{
+		return;
+	}
+
+	CurrentValues.Swap(IndexA, IndexB);
+	MaxValues.Swap(IndexA, IndexB);
+	BaseMaxValues.Swap(IndexA, IndexB);
+	EnforceMaxValues.Swap(IndexA, IndexB);
+	ClampValues.Swap(IndexA, IndexB);
+	GenerateAmounts.Swap(IndexA, IndexB);
+	BaseGenerateAmounts.Swap(IndexA, IndexB);
+	GenerateDelays.Swap(IndexA, IndexB);
+	CurrentGenerateDelays.Swap(IndexA, IndexB);
+	LazyValues.Swap(IndexA, IndexB);
+	GenerateStartTimes.Swap(IndexA, IndexB);
+	NotifyThresholds.Swap(IndexA, IndexB);
+	GenerateTimers.Swap(IndexA, IndexB);
+	Owners.Swap(IndexA, IndexB);
+	Names.Swap(IndexA, IndexB);
+	IndexHandles.Swap(IndexA, IndexB);
+	HandleIndices[IndexHandles[IndexA]] = IndexA;
+	HandleIndices[IndexHandles[IndexB]] = IndexB;
+}
+
+/**
+ * @brief Apply a modifier to a value at a specific time
+ * @param Handle The handle of the value
+ * @param Modifier The modifier to apply
+ * @param CurrentTime The time at which the modifier is applied
+ * @return The ID of the modifier or -1 if the handle is not valid
+ */
+int UTrackableDataSubsystem::AddModifierAt(const int Handle, const FTrackableDataModifier& Modifier,
+	const double CurrentTime)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return INDEX_NONE;
+	}
+
+	const int ModifierId = NextModifierId++;
+	FTrackableDataModifierStack& Stack = ModifierStacks.FindOrAdd(Handle);
+	Stack.Ids.Add(ModifierId);
+	Stack.Modifiers.Add(Modifier);
+	AggregateModifier(Stack, Modifier, 1.0f);
+	ModifierHandles.Add(ModifierId, Handle);
+	if (Modifier.Duration > 0.0f)
+	{
+		ModifierExpiries.Schedule(ModifierId, CurrentTime + Modifier.Duration);
+	}
+
+	ApplyModifiers(Handle);
+	return ModifierId;
+}
+
+/**
+ * @brief Add or remove a modifier from the aggregated totals of a stack
+ * @param Stack The stack containing the modifier
+ * @param Modifier The modifier to add or remove
+ * @param Sign 1 to add the modifier or -1 to remove it
+ */
+void UTrackableDataSubsystem::AggregateModifier(FTrackableDataModifierStack& Stack,
+	const FTrackableDataModifier& Modifier, const float Sign)
+{
+	const bool bIsFlat = Modifier.Type == ETrackableDataModifierType::Flat;
+	if (Modifier.Target == ETrackableDataModifierTarget::MaxValue)
+	{
+		(bIsFlat ? Stack.FlatMaxValue : Stack.PercentageMaxValue) += Modifier.Value * Sign;
+		return;
+	}
+
+	(bIsFlat ? Stack.FlatGenerateAmount : Stack.PercentageGenerateAmount) += Modifier.Value * Sign;
+}
+
+/**
+ * @brief Update the maximum amount and generate amount of a value from its aggregated modifiers
+ * @param Handle The handle of the value
+ */
+void UTrackableDataSubsystem::ApplyModifiers(const int Handle)
+{
+	const int Index = HandleIndices[Handle];
+	MaterializeValue(Index);
+
+	const FTrackableDataModifierStack* Stack = ModifierStacks.Find(Handle);
+	const float MaxValue = Stack == nullptr ? BaseMaxValues[Index] : FMath::Max(
+		(BaseMaxValues[Index] + Stack->FlatMaxValue) * (1.0f + Stack->PercentageMaxValue), 0.0f);
+	const float GenerateAmount = Stack == nullptr ? BaseGenerateAmounts[Index] : FMath::Max(
+		(BaseGenerateAmounts[Index] + Stack->FlatGenerateAmount) * (1.0f + Stack->PercentageGenerateAmount), 0.0f);
+	if (MaxValue == MaxValues[Index] && GenerateAmount == GenerateAmounts[Index])
+	{
+		return;
+	}
+
+	MaxValues[Index] = MaxValue;
+	GenerateAmounts[Index] = GenerateAmount;
+	if (EnforceMaxValues[Index])
+	{
+		ClampValues[Index] = MaxValue;
+		CurrentValues[Index] = FMath::Min(CurrentValues[Index], MaxValue);
+	}
+
+	UpdateRegeneration(Handle);
+	NotifyOwner(Handle);
+}
+
+/**
+ * @brief Remove the modifiers that expired
+ * @param CurrentTime The current time
+ */
+void UTrackableDataSubsystem::ExpireModifiers(const double CurrentTime)
+{
+	TArray<int> ExpiredIds;
+	ModifierExpiries.Advance(CurrentTime, ExpiredIds);
+	for (const int ModifierId : ExpiredIds)
+	{
+		RemoveModifier(ModifierId);
+	}
+}
+
+/**
+ * @brief Calculate the current amount of a lazily generated value
+ * @param Index The index of the value
+ * @return The current amount of the value
+ */
+float UTrackableDataSubsystem::EvaluateValue(const int Index) const
+{
+	const float Value = CurrentValues[Index];
+	if (!LazyValues[Index] || GenerateAmounts[Index] <= 0.0f || Value >= MaxValues[Index])
+	{
+		return Value;
+	}
+
+	const double Elapsed = FMath::Max(GetWorld()->GetTimeSeconds() - GenerateStartTimes[Index], 0.0);
+	return FMath::Min(Value + GenerateAmounts[Index] * static_cast<float>(Elapsed), MaxValues[Index]);
+}
+
+/**
+ * @brief Store the calculated amount of a lazily generated value as its current amount
+ * @param Index The index of the value
+ */
+void UTrackableDataSubsystem::MaterializeValue(const int Index)
+{
+	if (!LazyValues[Index])
+	{
+		return;
+	}
+
+	// The value keeps generating from the new amount unless it is still waiting for the generate delay
+	const double CurrentTime = GetWorld()->GetTimeSeconds();
+	CurrentValues[Index] = EvaluateValue(Index);
+	GenerateStartTimes[Index] = FMath::Max(GenerateStartTimes[Index], CurrentTime);
+}
+
+/**
+ * @brief Schedule the timer that fires when a lazily generated value reaches its threshold or maximum amount
+ * @param Handle The handle of the value
+ */
+void UTrackableDataSubsystem::ScheduleGenerateTimer(const int Handle)
+{
+	const int Index = HandleIndices[Handle];
+	FTimerManager& TimerManager = GetWorld()->GetTimerManager();
+	TimerManager.ClearTimer(GenerateTimers[Index]);
+	if (GenerateAmounts[Index] <= 0.0f || CurrentValues[Index] >= MaxValues[Index])
+	{
+		return;
+	}
+
+	// A threshold below the stored amount was already passed and is reported by the next notification of the owner
+	const float TargetValue = NotifyThresholds[Index] > CurrentValues[Index]
+		? FMath::Min(NotifyThresholds[Index], MaxValues[Index])
+		: MaxValues[Index];
+	const float GenerateTime = (TargetValue - CurrentValues[Index]) / GenerateAmounts[Index];
+	const double TargetTime = GenerateStartTimes[Index] + GenerateTime;
+	const float Delay = FMath::Max(static_cast<float>(TargetTime - GetWorld()->GetTimeSeconds()), KINDA_SMALL_NUMBER);
+	TimerManager.SetTimer(GenerateTimers[Index], FTimerDelegate::CreateUObject(this,
+		&UTrackableDataSubsystem::OnGenerateTimer, Handle), Delay, false);
+}
+
+/**
+ * @brief Called when a lazily generated value reaches its threshold or maximum amount
+ * @param Handle The handle of the value
+ */
+void UTrackableDataSubsystem::OnGenerateTimer(const int Handle)
+{
+	if (!IsValidHandle(Handle))
+	{
+		return;
+	}
+
+	// The timer is only accurate to the frame, so the value is snapped to the maximum amount once it is reached
+	const int Index = HandleIndices[Handle];
+	const float Threshold = NotifyThresholds[Index];
+	const bool bReachedMax = Threshold <= CurrentValues[Index] || Threshold >= MaxValues[Index];
+	MaterializeValue(Index);
+	if (bReachedMax)
+	{
+		CurrentValues[Index] = FMath::Max(CurrentValues[Index], MaxValues[Index]);
+	}
+
+	// The owner sets the next threshold after it notified its listeners
+	NotifyThresholds[Index] = FLT_MAX;
+	ScheduleGenerateTimer(Handle);
+	NotifyOwner(Handle);
+	FlushNotifications();
+}
+
+/**
+ * @brief Notify the component that owns a value that the value changed
+ * @param Handle The handle of the value
+ */
+void UTrackableDataSubsystem::NotifyOwner(const int Handle)
+{
+	UTrackableDataComponent* Owner = Owners[HandleIndices[Handle]].Get();
+	if (Owner != nullptr)
+	{
+		Owner->OnValueChangedBySubsystem(Handle);
+		NotifiedOwners.AddUnique(Owner);
+	}
+}
+
+/**
+ * @brief Notify the subscriptions of the notified owners during the current frame
+ */
+void UTrackableDataSubsystem::FlushNotifications()
+{
+	// The timer manager already ticked this frame, so queued notifications would only be sent during the next frame
+	TArray<TWeakObjectPtr<UTrackableDataComponent>> FlushedOwners = MoveTemp(NotifiedOwners);
+	NotifiedOwners.Reset();
+	for (const TWeakObjectPtr<UTrackableDataComponent>& Owner : FlushedOwners)
+	{
+		if (Owner.IsValid())
+		{
+			Owner->FlushNotifications();
+		}
+	}
+}
@@ -0,0 +1,378 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "TrackableData.h"
+#include "TrackableDataModifier.h"
+#include "TrackableDataModifierStack.h"
+#include "TrackableDataTimingWheel.h"
+#include "Tickable.h"
+#include "Engine/EngineTypes.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "TrackableDataSubsystem.generated.h"
+
+class UTrackableDataComponent;
+
+/**
+ * @brief World subsystem that stores the values of all trackable data components and regenerates them in a single pass
+ */
+UCLASS()
+class USK_API UTrackableDataSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Check if the subsystem should be created for the world
+	 * @param Outer The world that owns the subsystem
+	 * @return A boolean value indicating if the subsystem should be created
+	 */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/**
+	 * @brief Remove all the values when the world is torn down
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Remove the expired modifiers and regenerate the values that are below their maximum value
+	 * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * @brief Check if the subsystem should be ticked
+	 * @return A boolean value indicating if the subsystem should be ticked
+	 */
+	virtual bool IsTickable() const override;
+
+	/**
+	 * @brief Get the tick type of the subsystem
+	 * @return The tick type of the subsystem
+	 */
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	/**
+	 * @brief Get the world the subsystem is ticked in
+	 * @return The world the subsystem is ticked in
+	 */
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/**
+	 * @brief Get the stat ID used to profile the subsystem
+	 * @return The stat ID used to profile the subsystem
+	 */
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Start tracking a value
+	 * @param Owner The component that owns the value
+	 * @param Name The name of the data item
+	 * @param Data The default values and behaviours of the data item
+	 * @return The handle of the value
+	 */
+	int RegisterValue(UTrackableDataComponent* Owner, FName Name, const FTrackableData& Data);
+
+	/**
+	 * @brief Stop tracking a value
+	 * @param Handle The handle of the value
+	 */
+	void UnregisterValue(int Handle);
+
+	/**
+	 * @brief Check if a handle refers to a value that is being tracked
+	 * @param Handle The handle of the value
+	 * @return A boolean value indicating if the handle is valid
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Trackable Data")
+	bool IsValidHandle(int Handle) const;
+
+	/**
+	 * @brief Get the name of the data item of a value
+	 * @param Handle The handle of the value
+	 * @return The name of the data item
+	 */
+	FName GetName(int Handle) const;
+
+	/**
+	 * @brief Get the current amount of a value. Values that are generated lazily are calculated from the time they last changed
+	 * @param Handle The handle of the value
+	 * @return The current amount of the value
+	 */
+	float GetValue(int Handle) const;
+
+	/**
+	 * @brief Get the maximum amount of a value
+	 * @param Handle The handle of the value
+	 * @return The maximum amount of the value
+	 */
+	float GetMaxValue(int Handle) const;
+
+	/**
+	 * @brief Add an amount to a value and restart the regenerate delay if the amount is negative
+	 * @param Handle The handle of the value
+	 * @param Amount The amount to add
+	 * @return The new amount of the value
+	 */
+	float AddValue(int Handle, float Amount);
+
+	/**
+	 * @brief Replace the current amount of a value without restarting the regenerate delay
+	 * @param Handle The handle of the value
+	 * @param Value The new amount of the value
+	 */
+	void SetValue(int Handle, float Value);
+
+	/**
+	 * @brief Set the amount at which the owner is notified while a lazily generated value is generating
+	 * @param Handle The handle of the value
+	 * @param Threshold The amount at which the owner is notified (FLT_MAX = only when the maximum amount is reached)
+	 */
+	void SetNotifyThreshold(int Handle, float Threshold);
+
+	/**
+	 * @brief Apply a modifier to the maximum value or generate amount of a value
+	 * @param Handle The handle of the value
+	 * @param Modifier The modifier to apply
+	 * @return The ID of the modifier or -1 if the handle is not valid
+	 */
+	int AddModifier(int Handle, const FTrackableDataModifier& Modifier);
+
+	/**
+	 * @brief Remove a modifier before it expires
+	 * @param ModifierId The ID of the modifier
+	 * @return A boolean value indicating if the modifier was removed
+	 */
+	bool RemoveModifier(int ModifierId);
+
+	/**
+	 * @brief Get the amount of modifiers that are applied to all the values
+	 * @return The amount of modifiers that are applied to all the values
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Trackable Data")
+	int GetModifierCount() const;
+
+	/**
+	 * @brief Get the amount of values that are being tracked
+	 * @return The amount of values that are being tracked
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Trackable Data")
+	int GetValueCount() const;
+
+	/**
+	 * @brief Get the amount of values that are currently regenerating
+	 * @return The amount of values that are currently regenerating
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Trackable Data")
+	int GetRegeneratingCount() const;
+
+private:
+	/**
+	 * @brief The current amount of each value
+	 */
+	TArray<float> CurrentValues;
+
+	/**
+	 * @brief The maximum amount of each value after the modifiers are applied
+	 */
+	TArray<float> MaxValues;
+
+	/**
+	 * @brief The maximum amount of each value before the modifiers are applied
+	 */
+	TArray<float> BaseMaxValues;
+
+	/**
+	 * @brief Is the maximum amount of each value enforced?
+	 */
+	TArray<bool> EnforceMaxValues;
+
+	/**
+	 * @brief The amount above which each value is clamped when it is updated
+	 */
+	TArray<float> ClampValues;
+
+	/**
+	 * @brief The amount generated every second for each value after the modifiers are applied (0 = no regeneration)
+	 */
+	TArray<float> GenerateAmounts;
+
+	/**
+	 * @brief The amount generated every second for each value before the modifiers are applied
+	 */
+	TArray<float> BaseGenerateAmounts;
+
+	/**
+	 * @brief The delay before each value starts generating after losing value
+	 */
+	TArray<float> GenerateDelays;
+
+	/**
+	 * @brief The remaining delay before each value starts generating
+	 */
+	TArray<float> CurrentGenerateDelays;
+
+	/**
+	 * @brief Is each value generated when it is read instead of every frame?
+	 */
+	TArray<bool> LazyValues;
+
+	/**
+	 * @brief The time at which each lazily generated value starts generating from its current amount
+	 */
+	TArray<double> GenerateStartTimes;
+
+	/**
+	 * @brief The amount at which the owner of each lazily generated value is notified before it reaches its maximum
+	 */
+	TArray<float> NotifyThresholds;
+
+	/**
+	 * @brief The timer used to notify the owner when each lazily generated value reaches its threshold or maximum amount
+	 */
+	TArray<FTimerHandle> GenerateTimers;
+
+	/**
+	 * @brief The amount generated for each regenerating value during the last tick
+	 */
+	TArray<float> GeneratedAmounts;
+
+	/**
+	 * @brief The component that owns each value
+	 */
+	TArray<TWeakObjectPtr<UTrackableDataComponent>> Owners;
+
+	/**
+	 * @brief The name of the data item of each value
+	 */
+	TArray<FName> Names;
+
+	/**
+	 * @brief The handle of each value
+	 */
+	TArray<int> IndexHandles;
+
+	/**
+	 * @brief The index of the value of each handle or INDEX_NONE if the handle is not used
+	 */
+	TArray<int> HandleIndices;
+
+	/**
+	 * @brief The handles that can be reused by new values
+	 */
+	TArray<int> FreeHandles;
+
+	/**
+	 * @brief The handles of the values updated during the last tick
+	 */
+	TArray<int> UpdatedHandles;
+
+	/**
+	 * @brief The components notified of changed values since the last flush of their subscriptions
+	 */
+	TArray<TWeakObjectPtr<UTrackableDataComponent>> NotifiedOwners;
+
+	/**
+	 * @brief The amount of values at the start of the arrays that are regenerating
+	 */
+	int RegeneratingCount;
+
+	/**
+	 * @brief The modifiers of each value by handle
+	 */
+	TMap<int, FTrackableDataModifierStack> ModifierStacks;
+
+	/**
+	 * @brief The handle of the value of each modifier
+	 */
+	TMap<int, int> ModifierHandles;
+
+	/**
+	 * @brief The expiry times of the modifiers with a duration
+	 */
+	FTrackableDataTimingWheel ModifierExpiries;
+
+	/**
+	 * @brief The ID assigned to the next modifier
+	 */
+	int NextModifierId;
+
+	/**
+	 * @brief Apply a modifier to a value at a specific time
+	 * @param Handle The handle of the value
+	 * @param Modifier The modifier to apply
+	 * @param CurrentTime The time at which the modifier is applied
+	 * @return The ID of the modifier or -1 if the handle is not valid
+	 */
+	int AddModifierAt(int Handle, const FTrackableDataModifier& Modifier, double CurrentTime);
+
+	/**
+	 * @brief Add or remove a modifier from the aggregated totals of a stack
+	 * @param Stack The stack containing the modifier
+	 * @param Modifier The modifier to add or remove
+	 * @param Sign 1 to add the modifier or -1 to remove it
+	 */
+	static void AggregateModifier(FTrackableDataModifierStack& Stack, const FTrackableDataModifier& Modifier, float Sign);
+
+	/**
+	 * @brief Update the maximum amount and generate amount of a value from its aggregated modifiers
+	 * @param Handle The handle of the value
+	 */
+	void ApplyModifiers(int Handle);
+
+	/**
+	 * @brief Remove the modifiers that expired
+	 * @param CurrentTime The current time
+	 */
+	void ExpireModifiers(double CurrentTime);
+
+	/**
+	 * @brief Move a value in or out of the regenerating range based on its current amount
+	 * @param Handle The handle of the value
+	 */
+	void UpdateRegeneration(int Handle);
+
+	/**
+	 * @brief Calculate the current amount of a lazily generated value
+	 * @param Index The index of the value
+	 * @return The current amount of the value
+	 */
+	float EvaluateValue(int Index) const;
+
+	/**
+	 * @brief Store the calculated amount of a lazily generated value as its current amount
+	 * @param Index The index of the value
+	 */
+	void MaterializeValue(int Index);
+
+	/**
+	 * @brief Schedule the timer that fires when a lazily generated value reaches its threshold or maximum amount
+	 * @param Handle The handle of the value
+	 */
+	void ScheduleGenerateTimer(int Handle);
+
+	/**
+	 * @brief Called when a lazily generated value reaches its threshold or maximum amount
+	 * @param Handle The handle of the value
+	 */
+	void OnGenerateTimer(int Handle);
+
+	/**
+	 * @brief Notify the component that owns a value that the value changed
+	 * @param Handle The handle of the value
+	 */
+	void NotifyOwner(int Handle);
+
+	/**
+	 * @brief Notify the subscriptions of the notified owners during the current frame
+	 */
+	void FlushNotifications();
+
+	/**
+	 * @brief Swap the storage of two values
+	 * @param IndexA The index of the first value
+	 * @param IndexB The index of the second value
+	 */
+	void SwapValues(int IndexA, int IndexB);
+};
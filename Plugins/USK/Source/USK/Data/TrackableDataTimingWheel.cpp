@@ -0,0 +1,82 @@
+﻿// Created by Henry Jooste
+
+#include "TrackableDataTimingWheel.h"
+
+/**
+ * @brief Create a new timing wheel
+ * @param InSlotCount The amount of slots in the wheel
+ * @param InResolution The amount of seconds covered by each slot
+ */
+FTrackableDataTimingWheel::FTrackableDataTimingWheel(const int InSlotCount, const float InResolution)
+{
+	Slots.SetNum(FMath::Max(InSlotCount, 1));
+	Resolution = FMath::Max(InResolution, KINDA_SMALL_NUMBER);
+	CurrentTick = 0;
+	Count = 0;
+}
+
+/**
+ * @brief Schedule an ID to expire at a time. IDs that expire beyond the span of the wheel stay in their slot until they are due
+ * @param Id The ID to schedule
+ * @param ExpireTime The time at which the ID expires
+ */
+void FTrackableDataTimingWheel::Schedule(const int Id, const double ExpireTime)
+{
+	const int64 Tick = FMath::Max(static_cast<int64>(FMath::CeilToDouble(ExpireTime / Resolution)), CurrentTick + 1);
+	Slots[Tick % Slots.Num()].Add({ Id, Tick });
+	Count++;
+}
+
+/**
+ * @brief Move the wheel forward and collect the IDs that expired. Only the slots that were passed are visited
+ * @param Time The current time
+ * @param OutExpired The IDs that expired
+ */
+void FTrackableDataTimingWheel::Advance(const double Time, TArray<int>& OutExpired)
+{
+	const int64 TargetTick = static_cast<int64>(FMath::FloorToDouble(Time / Resolution));
+	if (TargetTick <= CurrentTick)
+	{
+		return;
+	}
+
+	// Every slot holds each tick that maps to it, so a full turn of the wheel visits all the pending IDs
+	const int64 Steps = FMath::Min(TargetTick - CurrentTick, static_cast<int64>(Slots.Num()));
+	for (int64 Step = 1; Step <= Steps && Count > 0; Step++)
+	{
+		TArray<FEntry>& Slot = Slots[(CurrentTick + Step) % Slots.Num()];
+		for (int Index = Slot.Num() - 1; Index >= 0; Index--)
+		{
+			if (Slot[Index].Tick <= TargetTick)
+			{
+				OutExpired.Add(Slot[Index].Id);
+				Slot.RemoveAtSwap(Index, 1, false);
+				Count--;
+			}
+		}
+	}
+
+	CurrentTick = TargetTick;
+}
+
+/**
+ * @brief Remove all the scheduled IDs
+ */
+void FTrackableDataTimingWheel::Reset()
+{
+	for (TArray<FEntry>& Slot : Slots)
+	{
+		Slot.Reset();
+	}
+
+	Count = 0;
+}
+
+/**
+ * @brief Get the amount of scheduled IDs
+ * @return The amount of scheduled IDs
+ */
+int FTrackableDataTimingWheel::Num() const
+{
+	return Count;
+}
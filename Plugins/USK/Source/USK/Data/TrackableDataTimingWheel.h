@@ -0,0 +1,81 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+
+/**
+ * @brief Hashed timing wheel that stores the expiry times of trackable data modifiers in fixed time slots
+ */
+class USK_API FTrackableDataTimingWheel
+{
+public:
+	/**
+	 * @brief Create a new timing wheel
+	 * @param InSlotCount The amount of slots in the wheel
+	 * @param InResolution The amount of seconds covered by each slot
+	 */
+	FTrackableDataTimingWheel(int InSlotCount = 512, float InResolution = 0.1f);
+
+	/**
+	 * @brief Schedule an ID to expire at a time. IDs that expire beyond the span of the wheel stay in their slot until they are due
+	 * @param Id The ID to schedule
+	 * @param ExpireTime The time at which the ID expires
+	 */
+	void Schedule(int Id, double ExpireTime);
+
+	/**
+	 * @brief Move the wheel forward and collect the IDs that expired. Only the slots that were passed are visited
+	 * @param Time The current time
+	 * @param OutExpired The IDs that expired
+	 */
+	void Advance(double Time, TArray<int>& OutExpired);
+
+	/**
+	 * @brief Remove all the scheduled IDs
+	 */
+	void Reset();
+
+	/**
+	 * @brief Get the amount of scheduled IDs
+	 * @return The amount of scheduled IDs
+	 */
+	int Num() const;
+
+private:
+	/**
+	 * @brief An ID scheduled in a slot of the wheel
+	 */
+	struct FEntry
+	{
+		/**
+		 * @brief The scheduled ID
+		 */
+		int Id;
+
+		/**
+		 * @brief The tick of the wheel at which the ID expires
+		 */
+		int64 Tick;
+	};
+
+	/**
+	 * @brief The scheduled IDs of each slot
+	 */
+	TArray<TArray<FEntry>> Slots;
+
+	/**
+	 * @brief The amount of seconds covered by each slot
+	 */
+	float Resolution;
+
+	/**
+	 * @brief The last tick the wheel moved to
+	 */
+	int64 CurrentTick;
+
+	/**
+	 * @brief The amount of scheduled IDs
+	 */
+	int Count;
+};
@@ -0,0 +1,40 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NiagaraSystem.h"
+#include "ParticleFxBatch.generated.h"
+
+/**
+ * @brief The particle FX requests of a single system that are spawned together at the end of the frame
+ */
+USTRUCT()
+struct FParticleFxBatch
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The particle system to spawn
+	 */
+	UPROPERTY()
+	UNiagaraSystem* System = nullptr;
+
+	/**
+	 * @brief The rotation of the first request in the batch
+	 */
+	UPROPERTY()
+	FRotator Rotation = FRotator::ZeroRotator;
+
+	/**
+	 * @brief The scale of the first request in the batch
+	 */
+	UPROPERTY()
+	FVector Scale = FVector::OneVector;
+
+	/**
+	 * @brief The world location of each request in the batch
+	 */
+	UPROPERTY()
+	TArray<FVector> Locations;
+};
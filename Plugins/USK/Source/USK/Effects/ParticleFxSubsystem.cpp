@@ -0,0 +1,276 @@
+﻿// Created by Henry Jooste
+
+#include "ParticleFxSubsystem.h"
+
+#include "NiagaraDataInterfaceArrayFunctionLibrary.h"
+#include "NiagaraFunctionLibrary.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "USK/Core/USKGameInstance.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Check if the subsystem should be created for the world
+ * @param Outer The world that owns the subsystem
+ * @return A boolean value indicating if the subsystem should be created
+ */
+bool UParticleFxSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return Super::ShouldCreateSubsystem(Outer) && IsValid(World) && World->IsGameWorld();
+}
+
+/**
+ * @brief Spawn the particle FX that were batched during the frame
+ * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+ */
+void UParticleFxSubsystem::Tick(const float DeltaTime)
+{
+	TArray<FParticleFxBatch> Batches = MoveTemp(PendingBatches);
+	PendingBatches.Reset();
+
+	for (const FParticleFxBatch& Batch : Batches)
+	{
+		if (!IsValid(Batch.System) || Batch.Locations.Num() == 0)
+		{
+			continue;
+		}
+
+		ReserveInstance(Batch.System);
+		UNiagaraComponent* Component = UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), Batch.System,
+			Batch.Locations[0], Batch.Rotation, Batch.Scale, true, false, ENCPoolMethod::AutoRelease);
+		if (!IsValid(Component))
+		{
+			continue;
+		}
+
+		// The system spawns its particles at each of the batched locations
+		UNiagaraDataInterfaceArrayFunctionLibrary::SetNiagaraArrayVector(Component, BatchParameter, Batch.Locations);
+		Component->Activate(true);
+		TrackComponent(Batch.System, Component);
+	}
+}
+
+/**
+ * @brief Check if the subsystem should be ticked
+ * @return A boolean value indicating if the subsystem should be ticked
+ */
+bool UParticleFxSubsystem::IsTickable() const
+{
+	return PendingBatches.Num() > 0;
+}
+
+/**
+ * @brief Get the tick type of the subsystem
+ * @return The tick type of the subsystem
+ */
+ETickableTickType UParticleFxSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+/**
+ * @brief Get the world the subsystem is ticked in
+ * @return The world the subsystem is ticked in
+ */
+UWorld* UParticleFxSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/**
+ * @brief Get the stat ID used to profile the subsystem
+ * @return The stat ID used to profile the subsystem
+ */
+TStatId UParticleFxSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UParticleFxSubsystem, STATGROUP_Tickables);
+}
+
+/**
+ * @brief Spawn a particle FX at a location
+ * @param System The particle system to spawn
+ * @param Location The location of the particle FX
+ * @param Rotation The rotation of the particle FX
+ * @param Scale The scale of the particle FX
+ * @return The spawned component or nullptr if the particle FX was culled or batched
+ */
+UNiagaraComponent* UParticleFxSubsystem::SpawnAtLocation(UNiagaraSystem* System, const FVector Location,
+	const FRotator Rotation, const FVector Scale)
+{
+	if (!IsValid(System))
+	{
+		return nullptr;
+	}
+
+	if (!bIsConfigured)
+	{
+		Configure();
+	}
+
+	if (ShouldCull(Location))
+	{
+		USK_LOG_TRACE("Particle FX culled");
+		return nullptr;
+	}
+
+	if (BatchedSystems.Contains(System))
+	{
+		FParticleFxBatch* Batch = PendingBatches.FindByPredicate([System](const FParticleFxBatch& PendingBatch)
+		{
+			return PendingBatch.System == System;
+		});
+
+		if (Batch == nullptr)
+		{
+			Batch = &PendingBatches.AddDefaulted_GetRef();
+			Batch->System = System;
+			Batch->Rotation = Rotation;
+			Batch->Scale = Scale;
+		}
+
+		Batch->Locations.Add(Location);
+		return nullptr;
+	}
+
+	ReserveInstance(System);
+	UNiagaraComponent* Component = UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), System, Location,
+		Rotation, Scale, true, true, ENCPoolMethod::AutoRelease);
+	TrackComponent(System, Component);
+	return Component;
+}
+
+/**
+ * @brief Spawn a particle FX attached to a component
+ * @param System The particle system to spawn
+ * @param AttachToComponent The component to attach the particle FX to
+ * @param AttachPointName The socket to attach the particle FX to
+ * @param Location The location of the particle FX
+ * @param Rotation The rotation of the particle FX
+ * @param LocationType How the location and rotation are applied
+ * @return The spawned component or nullptr if the particle FX was culled
+ */
+UNiagaraComponent* UParticleFxSubsystem::SpawnAttached(UNiagaraSystem* System, USceneComponent* AttachToComponent,
+	const FName AttachPointName, const FVector Location, const FRotator Rotation,
+	const EAttachLocation::Type LocationType)
+{
+	if (!IsValid(System) || !IsValid(AttachToComponent))
+	{
+		return nullptr;
+	}
+
+	if (!bIsConfigured)
+	{
+		Configure();
+	}
+
+	if (ShouldCull(AttachToComponent->GetComponentLocation()))
+	{
+		USK_LOG_TRACE("Particle FX culled");
+		return nullptr;
+	}
+
+	ReserveInstance(System);
+	UNiagaraComponent* Component = UNiagaraFunctionLibrary::SpawnSystemAttached(System, AttachToComponent,
+		AttachPointName, Location, Rotation, LocationType, true, true, ENCPoolMethod::AutoRelease);
+	TrackComponent(System, Component);
+	return Component;
+}
+
+/**
+ * @brief Get the amount of active instances of a particle system spawned by the subsystem
+ * @param System The particle system
+ * @return The amount of active instances
+ */
+int UParticleFxSubsystem::GetActiveCount(UNiagaraSystem* System)
+{
+	TArray<TWeakObjectPtr<UNiagaraComponent>>* Components = ActiveComponents.Find(System);
+	if (Components == nullptr)
+	{
+		return 0;
+	}
+
+	// Pooled components are deactivated when they finish and may be reused by another system
+	Components->RemoveAll([System](const TWeakObjectPtr<UNiagaraComponent>& Component)
+	{
+		return !Component.IsValid() || !Component->IsActive() || Component->GetAsset() != System;
+	});
+
+	return Components->Num();
+}
+
+/**
+ * @brief Read the configuration from the game instance
+ */
+void UParticleFxSubsystem::Configure()
+{
+	const UUSKGameInstance* GameInstance = Cast<UUSKGameInstance>(GetWorld()->GetGameInstance());
+	if (IsValid(GameInstance))
+	{
+		MaxInstances = GameInstance->MaxParticleFxInstances;
+		InstanceLimits = GameInstance->ParticleFxInstanceLimits;
+		CullDistance = GameInstance->ParticleFxCullDistance;
+		BatchedSystems = GameInstance->BatchedParticleFx;
+		BatchParameter = GameInstance->ParticleFxBatchParameter;
+	}
+	else
+	{
+		USK_LOG_WARNING("GameInstance is not UUSKGameInstance. Using the default particle FX budget");
+	}
+
+	bIsConfigured = true;
+}
+
+/**
+ * @brief Check if a particle FX at a specific location should be culled
+ * @param Location The location of the particle FX
+ * @return A boolean value indicating if the particle FX should be culled
+ */
+bool UParticleFxSubsystem::ShouldCull(const FVector& Location) const
+{
+	if (CullDistance <= 0.0f)
+	{
+		return false;
+	}
+
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!IsValid(PlayerController) || !IsValid(PlayerController->PlayerCameraManager))
+	{
+		return false;
+	}
+
+	return FVector::DistSquared(PlayerController->PlayerCameraManager->GetCameraLocation(), Location) >
+		FMath::Square(CullDistance);
+}
+
+/**
+ * @brief Make room for a new instance of a particle system by removing the oldest instance if the limit is reached
+ * @param System The particle system
+ */
+void UParticleFxSubsystem::ReserveInstance(UNiagaraSystem* System)
+{
+	const int* InstanceLimit = InstanceLimits.Find(System);
+	const int Limit = InstanceLimit != nullptr ? *InstanceLimit : MaxInstances;
+	if (Limit <= 0 || GetActiveCount(System) < Limit)
+	{
+		return;
+	}
+
+	TArray<TWeakObjectPtr<UNiagaraComponent>>& Components = ActiveComponents.FindChecked(System);
+	USK_LOG_TRACE(*FString::Format(TEXT("Particle FX limit reached for {0}"), { System->GetName() }));
+	Components[0]->DeactivateImmediate();
+	Components.RemoveAt(0);
+}
+
+/**
+ * @brief Track a component spawned by the subsystem
+ * @param System The particle system
+ * @param Component The spawned component
+ */
+void UParticleFxSubsystem::TrackComponent(UNiagaraSystem* System, UNiagaraComponent* Component)
+{
+	if (IsValid(Component))
+	{
+		ActiveComponents.FindOrAdd(System).AddUnique(Component);
+	}
+}
@@ -0,0 +1,161 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "NiagaraComponent.h"
+#include "NiagaraSystem.h"
+#include "ParticleFxBatch.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "ParticleFxSubsystem.generated.h"
+
+/**
+ * @brief World subsystem that spawns particle FX from the Niagara component pool with concurrency limits and culling
+ */
+UCLASS()
+class USK_API UParticleFxSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Check if the subsystem should be created for the world
+	 * @param Outer The world that owns the subsystem
+	 * @return A boolean value indicating if the subsystem should be created
+	 */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/**
+	 * @brief Spawn the particle FX that were batched during the frame
+	 * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * @brief Check if the subsystem should be ticked
+	 * @return A boolean value indicating if the subsystem should be ticked
+	 */
+	virtual bool IsTickable() const override;
+
+	/**
+	 * @brief Get the tick type of the subsystem
+	 * @return The tick type of the subsystem
+	 */
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	/**
+	 * @brief Get the world the subsystem is ticked in
+	 * @return The world the subsystem is ticked in
+	 */
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/**
+	 * @brief Get the stat ID used to profile the subsystem
+	 * @return The stat ID used to profile the subsystem
+	 */
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Spawn a particle FX at a location
+	 * @param System The particle system to spawn
+	 * @param Location The location of the particle FX
+	 * @param Rotation The rotation of the particle FX
+	 * @param Scale The scale of the particle FX
+	 * @return The spawned component or nullptr if the particle FX was culled or batched
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Particle FX")
+	UNiagaraComponent* SpawnAtLocation(UNiagaraSystem* System, FVector Location,
+		FRotator Rotation = FRotator::ZeroRotator, FVector Scale = FVector(1.0f));
+
+	/**
+	 * @brief Spawn a particle FX attached to a component
+	 * @param System The particle system to spawn
+	 * @param AttachToComponent The component to attach the particle FX to
+	 * @param AttachPointName The socket to attach the particle FX to
+	 * @param Location The location of the particle FX
+	 * @param Rotation The rotation of the particle FX
+	 * @param LocationType How the location and rotation are applied
+	 * @return The spawned component or nullptr if the particle FX was culled
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Particle FX")
+	UNiagaraComponent* SpawnAttached(UNiagaraSystem* System, USceneComponent* AttachToComponent, FName AttachPointName,
+		FVector Location, FRotator Rotation, EAttachLocation::Type LocationType);
+
+	/**
+	 * @brief Get the amount of active instances of a particle system spawned by the subsystem
+	 * @param System The particle system
+	 * @return The amount of active instances
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Particle FX")
+	int GetActiveCount(UNiagaraSystem* System);
+
+private:
+	/**
+	 * @brief The components spawned for each particle system
+	 */
+	TMap<TWeakObjectPtr<UNiagaraSystem>, TArray<TWeakObjectPtr<UNiagaraComponent>>> ActiveComponents;
+
+	/**
+	 * @brief The particle FX requests waiting to be spawned at the end of the frame
+	 */
+	UPROPERTY()
+	TArray<FParticleFxBatch> PendingBatches;
+
+	/**
+	 * @brief The maximum amount of active instances of each particle system
+	 */
+	int MaxInstances = 16;
+
+	/**
+	 * @brief The maximum amount of active instances for specific particle systems
+	 */
+	UPROPERTY()
+	TMap<UNiagaraSystem*, int> InstanceLimits;
+
+	/**
+	 * @brief The maximum distance from the camera at which particle FX are spawned, or zero to disable culling
+	 */
+	float CullDistance = 10000.0f;
+
+	/**
+	 * @brief The particle systems whose requests are batched into a single spawn each frame
+	 */
+	UPROPERTY()
+	TArray<UNiagaraSystem*> BatchedSystems;
+
+	/**
+	 * @brief The name of the user vector array parameter that receives the locations of a batch
+	 */
+	FName BatchParameter = "BatchPositions";
+
+	/**
+	 * @brief Has the configuration been read from the game instance?
+	 */
+	bool bIsConfigured;
+
+	/**
+	 * @brief Read the configuration from the game instance
+	 */
+	void Configure();
+
+	/**
+	 * @brief Check if a particle FX at a specific location should be culled
+	 * @param Location The location of the particle FX
+	 * @return A boolean value indicating if the particle FX should be culled
+	 */
+	bool ShouldCull(const FVector& Location) const;
+
+	/**
+	 * @brief Make room for a new instance of a particle system by removing the oldest instance if the limit is reached
+	 * @param System The particle system
+	 */
+	void ReserveInstance(UNiagaraSystem* System);
+
+	/**
+	 * @brief Track a component spawned by the subsystem
+	 * @param System The particle system
+	 * @param Component The spawned component
+	 */
+	void TrackComponent(UNiagaraSystem* System, UNiagaraComponent* Component);
+};
@@ -0,0 +1,73 @@
+﻿// Created by Henry Jooste
+
+#include "ParticleFxUtils.h"
+
+#include "NiagaraFunctionLibrary.h"
+#include "ParticleFxSubsystem.h"
+#include "Engine/Engine.h"
+#include "Engine/World.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Spawn a particle FX at a location
+ * @param WorldContext The top level object representing a map
+ * @param System The particle system to spawn
+ * @param Location The location of the particle FX
+ * @param Rotation The rotation of the particle FX
+ * @param Scale The scale of the particle FX
+ */
+void UParticleFxUtils::SpawnParticleFx(const UObject* WorldContext, UNiagaraSystem* System, const FVector Location,
+	const FRotator Rotation, const FVector Scale)
+{
+	if (!IsValid(System))
+	{
+		USK_LOG_ERROR("Trying to spawn a nullptr particle FX");
+		return;
+	}
+
+	UWorld* World = GEngine->GetWorldFromContextObject(WorldContext, EGetWorldErrorMode::LogAndReturnNull);
+	if (!IsValid(World))
+	{
+		return;
+	}
+
+	UParticleFxSubsystem* ParticleFxSubsystem = World->GetSubsystem<UParticleFxSubsystem>();
+	if (IsValid(ParticleFxSubsystem))
+	{
+		ParticleFxSubsystem->SpawnAtLocation(System, Location, Rotation, Scale);
+		return;
+	}
+
+	UNiagaraFunctionLibrary::SpawnSystemAtLocation(World, System, Location, Rotation, Scale);
+}
+
+/**
+ * @brief Spawn a particle FX attached to a component
+ * @param System The particle system to spawn
+ * @param AttachToComponent The component to attach the particle FX to
+ * @param AttachPointName The socket to attach the particle FX to
+ * @param Location The location of the particle FX
+ * @param Rotation The rotation of the particle FX
+ * @param LocationType How the location and rotation are applied
+ */
+void UParticleFxUtils::SpawnParticleFxAttached(UNiagaraSystem* System, USceneComponent* AttachToComponent,
+	const FName AttachPointName, const FVector Location, const FRotator Rotation,
+	const EAttachLocation::Type LocationType)
+{
+	if (!IsValid(System) || !IsValid(AttachToComponent))
+	{
+		USK_LOG_ERROR("Trying to spawn a nullptr particle FX");
+		return;
+	}
+
+	UParticleFxSubsystem* ParticleFxSubsystem = AttachToComponent->GetWorld()->GetSubsystem<UParticleFxSubsystem>();
+	if (IsValid(ParticleFxSubsystem))
+	{
+		ParticleFxSubsystem->SpawnAttached(System, AttachToComponent, AttachPointName, Location, Rotation,
+			LocationType);
+		return;
+	}
+
+	UNiagaraFunctionLibrary::SpawnSystemAttached(System, AttachToComponent, AttachPointName, Location, Rotation,
+		LocationType, true);
+}
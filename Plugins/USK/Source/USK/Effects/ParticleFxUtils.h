@@ -0,0 +1,42 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "NiagaraSystem.h"
+#include "Kismet/BlueprintFunctionLibrary.h"
+#include "ParticleFxUtils.generated.h"
+
+/**
+ * @brief The particle FX utils class is used to spawn particle FX through the particle FX subsystem
+ */
+UCLASS()
+class USK_API UParticleFxUtils : public UBlueprintFunctionLibrary
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Spawn a particle FX at a location
+	 * @param WorldContext The top level object representing a map
+	 * @param System The particle system to spawn
+	 * @param Location The location of the particle FX
+	 * @param Rotation The rotation of the particle FX
+	 * @param Scale The scale of the particle FX
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Ultimate Starter Kit|Particle FX", meta=(WorldContext="WorldContext"))
+	static void SpawnParticleFx(const UObject* WorldContext, UNiagaraSystem* System, FVector Location,
+		FRotator Rotation = FRotator::ZeroRotator, FVector Scale = FVector(1.0f));
+
+	/**
+	 * @brief Spawn a particle FX attached to a component
+	 * @param System The particle system to spawn
+	 * @param AttachToComponent The component to attach the particle FX to
+	 * @param AttachPointName The socket to attach the particle FX to
+	 * @param Location The location of the particle FX
+	 * @param Rotation The rotation of the particle FX
+	 * @param LocationType How the location and rotation are applied
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintCosmetic, Category = "Ultimate Starter Kit|Particle FX")
+	static void SpawnParticleFxAttached(UNiagaraSystem* System, USceneComponent* AttachToComponent,
+		FName AttachPointName, FVector Location, FRotator Rotation, EAttachLocation::Type LocationType);
+};
@@ -15,7 +15,19 @@ void UInventoryComponent::BeginPlay()
 	UGameInstance* CurrentGameInstance = UGameplayStatics::GetGameInstance(GetWorld());
 	GameInstance = dynamic_cast<UUSKGameInstance*>(CurrentGameInstance);
 
-	if (AutoSave)
+	if (!AutoSave)
+	{
+		return;
+	}
+
+	// The save data is read asynchronously, so the inventory is loaded once the read completed
+	if (IsValid(GameInstance))
+	{
+		GameInstance->OnDataLoadedEvent.AddDynamic(this, &UInventoryComponent::OnSaveDataLoaded);
+		bIsLoadPending = GameInstance->IsLoadingSaveData();
+	}
+
+	if (!bIsLoadPending)
 	{
 		LoadInventory();
 	}
@@ -176,6 +188,12 @@ void UInventoryComponent::SaveInventory()
 		USK_LOG_ERROR("Unable to save inventory. Game instance is not valid");
 		return;
 	}
+
+	if (bIsLoadPending)
+	{
+		USK_LOG_INFO("Inventory will be saved after the save data is loaded");
+		return;
+	}
 	
 	UUSKSaveGame* SaveData = GameInstance->GetSaveData();
 	if (!IsValid(SaveData))
@@ -195,4 +213,25 @@ void UInventoryComponent::SaveInventory()
 	GameInstance->SaveData();
 
 	USK_LOG_INFO("Inventory saved");
+}
+
+/**
+ * @brief Load the inventory after the save data was loaded. Items added while the save data was loading are added to
+ * the saved inventory
+ */
+void UInventoryComponent::OnSaveDataLoaded()
+{
+	if (!bIsLoadPending)
+	{
+		LoadInventory();
+		return;
+	}
+
+	bIsLoadPending = false;
+	const TArray<FInventoryItem> AddedItems = GetItems();
+	LoadInventory();
+	for (const FInventoryItem& Item : AddedItems)
+	{
+		AddItem(Item.Id, Item.Amount);
+	}
 }
\ No newline at end of file
@@ -116,8 +116,20 @@ private:
 	UPROPERTY()
 	UUSKGameInstance* GameInstance;
 
+	/**
+	 * @brief Is the inventory waiting for the save data to be loaded?
+	 */
+	bool bIsLoadPending = false;
+
 	/**
 	 * @brief The map of all items in the inventory
 	 */
 	TMap<FName, int> Items;	
+
+	/**
+	 * @brief Load the inventory after the save data was loaded. Items added while the save data was loading are added
+	 * to the saved inventory
+	 */
+	UFUNCTION()
+	void OnSaveDataLoaded();
 };
@@ -2,13 +2,13 @@
 
 #include "CollectableItem.h"
 
-#include "NiagaraFunctionLibrary.h"
 #include "GameFramework/Character.h"
 #include "Kismet/GameplayStatics.h"
 #include "Engine/World.h"
 #include "USK/Audio/AudioUtils.h"
 #include "USK/Character/FpsCharacter.h"
 #include "USK/Character/PlatformerCharacter.h"
+#include "USK/Effects/ParticleFxUtils.h"
 #include "USK/Logger/Log.h"
 
 /**
@@ -77,7 +77,7 @@ void ACollectableItem::CollectItem(AActor* Collector)
 	UAudioUtils::PlayRandomSound(this, CollectedSoundEffects);
 	if (CollectedParticleFx != nullptr)
 	{
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), CollectedParticleFx,
+		UParticleFxUtils::SpawnParticleFx(GetWorld(), CollectedParticleFx,
 			GetActorLocation() + CollectedParticleFxSpawnOffset);
 	}
 	
@@ -26,7 +26,11 @@ public class USK : ModuleRules
 			"Engine",
 			"Slate",
 			"SlateCore",
-			"GameplayTags"
+			"GameplayTags",
+			"Json",
+			"JsonUtilities",
+			"RenderCore",
+			"SignificanceManager"
 		});
 
 		DynamicallyLoadedModuleNames.AddRange(new string[] { });
@@ -2,11 +2,23 @@
 
 #include "USK.h"
 
+#include "Engine/World.h"
+#include "USK/Weapons/WeaponProjectile.h"
+
 #define LOCTEXT_NAMESPACE "FUSKModule"
 
-void FUSKModule::StartupModule() { }
+void FUSKModule::StartupModule()
+{
+	WorldCleanupHandle = FWorldDelegates::OnWorldCleanup.AddLambda([](UWorld*, bool, bool)
+	{
+		AWeaponProjectile::InvalidateDefaultImpactCaches();
+	});
+}
 
-void FUSKModule::ShutdownModule() { }
+void FUSKModule::ShutdownModule()
+{
+	FWorldDelegates::OnWorldCleanup.Remove(WorldCleanupHandle);
+}
 
 #undef LOCTEXT_NAMESPACE
 	
@@ -9,4 +9,7 @@ class FUSKModule : public IModuleInterface
 public:
 	virtual void StartupModule() override;
 	virtual void ShutdownModule() override;
+
+private:
+	FDelegateHandle WorldCleanupHandle;
 };
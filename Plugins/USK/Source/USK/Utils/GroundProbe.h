@@ -0,0 +1,80 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+
+/**
+ * @brief Delegate called when the ground below a probed actor changes
+ * @param bHit Was ground found below the actor?
+ * @param HitResult The result describing the ground below the actor
+ */
+DECLARE_DELEGATE_TwoParams(FGroundProbeUpdated, bool, const FHitResult&);
+
+/**
+ * @brief An actor whose ground is probed by the ground probe subsystem
+ */
+struct FGroundProbe
+{
+	/**
+	 * @brief The actor whose ground is probed
+	 */
+	TWeakObjectPtr<AActor> Actor;
+
+	/**
+	 * @brief The distance below the actor location at which the trace starts
+	 */
+	float StartOffset = 0.0f;
+
+	/**
+	 * @brief The maximum distance below the actor location at which ground is found
+	 */
+	float MaxDistance = 10000.0f;
+
+	/**
+	 * @brief The collision channel used to find the ground
+	 */
+	TEnumAsByte<ECollisionChannel> TraceChannel = ECC_Visibility;
+
+	/**
+	 * @brief Is the probe updated?
+	 */
+	bool bEnabled = true;
+
+	/**
+	 * @brief Delegate called when the ground below the actor changes
+	 */
+	FGroundProbeUpdated OnUpdated;
+
+	/**
+	 * @brief The handle of the trace that is currently in flight
+	 */
+	FTraceHandle PendingTrace;
+
+	/**
+	 * @brief The time at which the probe should be updated next
+	 */
+	float NextUpdateTime = 0.0f;
+
+	/**
+	 * @brief The actor location used by the last trace
+	 */
+	FVector TraceLocation = FVector::ZeroVector;
+
+	/**
+	 * @brief Does the probe have a result?
+	 */
+	bool bHasResult = false;
+
+	/**
+	 * @brief Was ground found below the actor?
+	 */
+	bool bHit = false;
+
+	/**
+	 * @brief The result describing the ground below the actor
+	 */
+	FHitResult HitResult;
+};
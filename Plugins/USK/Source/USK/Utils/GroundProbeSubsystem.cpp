@@ -0,0 +1,329 @@
+﻿// Created by Henry Jooste
+
+#include "GroundProbeSubsystem.h"
+
+#include "Camera/PlayerCameraManager.h"
+#include "Engine/World.h"
+#include "GameFramework/Actor.h"
+#include "GameFramework/PlayerController.h"
+#include "USK/Core/USKGameInstance.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Initialize the subsystem
+ * @param Collection The collection of subsystems
+ */
+void UGroundProbeSubsystem::Initialize(FSubsystemCollectionBase& Collection)
+{
+	Super::Initialize(Collection);
+	TraceDelegate.BindUObject(this, &UGroundProbeSubsystem::OnTraceCompleted);
+}
+
+/**
+ * @brief Check if the subsystem should be created for the world
+ * @param Outer The world that owns the subsystem
+ * @return A boolean value indicating if the subsystem should be created
+ */
+bool UGroundProbeSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return Super::ShouldCreateSubsystem(Outer) && IsValid(World) && World->IsGameWorld();
+}
+
+/**
+ * @brief Remove all the probes when the world is torn down
+ */
+void UGroundProbeSubsystem::Deinitialize()
+{
+	Probes.Empty();
+	TraceDelegate.Unbind();
+	Super::Deinitialize();
+}
+
+/**
+ * @brief Start the traces of the probes that are due for an update
+ * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+ */
+void UGroundProbeSubsystem::Tick(float DeltaTime)
+{
+	if (!bIsConfigured)
+	{
+		Configure();
+	}
+
+	FVector ViewLocation;
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	const bool bHasViewLocation = IsValid(PlayerController) && IsValid(PlayerController->PlayerCameraManager);
+	if (bHasViewLocation)
+	{
+		ViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	}
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	TArray<int, TInlineAllocator<16>> ReusedProbes;
+	for (TPair<int, FGroundProbe>& ProbeData : Probes)
+	{
+		FGroundProbe& Probe = ProbeData.Value;
+		const AActor* Actor = Probe.Actor.Get();
+		if (!Probe.bEnabled || Probe.PendingTrace.IsValid() || CurrentTime < Probe.NextUpdateTime ||
+			!IsValid(Actor))
+		{
+			continue;
+		}
+
+		const FVector Location = Actor->GetActorLocation();
+		Probe.NextUpdateTime = CurrentTime + GetUpdateInterval(Location, bHasViewLocation ? &ViewLocation : nullptr);
+		if (Probe.bHasResult && FVector::DistSquared2D(Location, Probe.TraceLocation) <= FMath::Square(ReuseDistance))
+		{
+			ReusedProbes.Add(ProbeData.Key);
+			continue;
+		}
+
+		const FVector Start = Location - FVector(0.0f, 0.0f, Probe.StartOffset);
+		const FVector End = Location - FVector(0.0f, 0.0f, Probe.MaxDistance);
+		const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(GroundProbe), false, Actor);
+
+		// All the probes started during this frame are resolved together at the start of the next frame
+		Probe.TraceLocation = Location;
+		Probe.PendingTrace = GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, End,
+			Probe.TraceChannel, QueryParams, FCollisionResponseParams::DefaultResponseParam, &TraceDelegate,
+			ProbeData.Key);
+	}
+
+	// The listeners are notified after the loop because they are allowed to register and unregister probes
+	for (const int ProbeId : ReusedProbes)
+	{
+		FGroundProbe* Probe = Probes.Find(ProbeId);
+		if (Probe == nullptr || !Probe->bHit || !Probe->Actor.IsValid())
+		{
+			continue;
+		}
+
+		// The actor barely moved, so the ground below it is the same and only needs to follow it
+		const FVector Location = Probe->Actor->GetActorLocation();
+		FHitResult HitResult = Probe->HitResult;
+		HitResult.Location = FVector(Location.X, Location.Y, HitResult.Location.Z);
+		SetResult(*Probe, true, HitResult);
+	}
+}
+
+/**
+ * @brief Check if the subsystem should be ticked
+ * @return A boolean value indicating if the subsystem should be ticked
+ */
+bool UGroundProbeSubsystem::IsTickable() const
+{
+	return Probes.Num() > 0;
+}
+
+/**
+ * @brief Get the tick type of the subsystem
+ * @return The tick type of the subsystem
+ */
+ETickableTickType UGroundProbeSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+/**
+ * @brief Get the world the subsystem is ticked in
+ * @return The world the subsystem is ticked in
+ */
+UWorld* UGroundProbeSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/**
+ * @brief Get the stat ID used to profile the subsystem
+ * @return The stat ID used to profile the subsystem
+ */
+TStatId UGroundProbeSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UGroundProbeSubsystem, STATGROUP_Tickables);
+}
+
+/**
+ * @brief Start probing the ground below an actor
+ * @param Actor The actor whose ground is probed
+ * @param StartOffset The distance below the actor location at which the trace starts
+ * @param MaxDistance The maximum distance below the actor location at which ground is found
+ * @param TraceChannel The collision channel used to find the ground
+ * @return The ID of the probe or -1 if the actor is not valid
+ */
+int UGroundProbeSubsystem::RegisterProbe(AActor* Actor, const float StartOffset, const float MaxDistance,
+	const ECollisionChannel TraceChannel)
+{
+	if (!IsValid(Actor))
+	{
+		USK_LOG_ERROR("Unable to register ground probe. Actor is not valid");
+		return -1;
+	}
+
+	FGroundProbe Probe;
+	Probe.Actor = Actor;
+	Probe.StartOffset = StartOffset;
+	Probe.MaxDistance = MaxDistance;
+	Probe.TraceChannel = TraceChannel;
+
+	const int ProbeId = NextProbeId++;
+	Probes.Add(ProbeId, Probe);
+	USK_LOG_TRACE(*FString::Format(TEXT("Registered ground probe for {0}"), { Actor->GetName() }));
+	return ProbeId;
+}
+
+/**
+ * @brief Stop probing the ground below an actor
+ * @param ProbeId The ID of the probe
+ */
+void UGroundProbeSubsystem::UnregisterProbe(const int ProbeId)
+{
+	Probes.Remove(ProbeId);
+}
+
+/**
+ * @brief Pause or resume a probe. The result of a paused probe is cleared
+ * @param ProbeId The ID of the probe
+ * @param bEnabled Should the probe be updated?
+ */
+void UGroundProbeSubsystem::SetProbeEnabled(const int ProbeId, const bool bEnabled)
+{
+	FGroundProbe* Probe = Probes.Find(ProbeId);
+	if (Probe == nullptr || Probe->bEnabled == bEnabled)
+	{
+		return;
+	}
+
+	Probe->bEnabled = bEnabled;
+	Probe->NextUpdateTime = 0.0f;
+	if (!bEnabled)
+	{
+		Probe->PendingTrace = FTraceHandle();
+		Probe->bHasResult = false;
+		Probe->bHit = false;
+	}
+}
+
+/**
+ * @brief Get the last ground found below the actor of a probe
+ * @param ProbeId The ID of the probe
+ * @param HitResult The result describing the ground below the actor
+ * @return A boolean value indicating if ground was found below the actor
+ */
+bool UGroundProbeSubsystem::GetGround(const int ProbeId, FHitResult& HitResult) const
+{
+	const FGroundProbe* Probe = Probes.Find(ProbeId);
+	if (Probe == nullptr || !Probe->bHit)
+	{
+		return false;
+	}
+
+	HitResult = Probe->HitResult;
+	return true;
+}
+
+/**
+ * @brief Set the delegate called when the ground below the actor of a probe changes
+ * @param ProbeId The ID of the probe
+ * @param OnUpdated The delegate called when the ground changes
+ */
+void UGroundProbeSubsystem::SetProbeCallback(const int ProbeId, const FGroundProbeUpdated& OnUpdated)
+{
+	FGroundProbe* Probe = Probes.Find(ProbeId);
+	if (Probe != nullptr)
+	{
+		Probe->OnUpdated = OnUpdated;
+	}
+}
+
+/**
+ * @brief Read the probe settings from the game instance
+ */
+void UGroundProbeSubsystem::Configure()
+{
+	const UUSKGameInstance* GameInstance = Cast<UUSKGameInstance>(GetWorld()->GetGameInstance());
+	if (IsValid(GameInstance))
+	{
+		NearDistance = GameInstance->GroundProbeNearDistance;
+		FarDistance = GameInstance->GroundProbeFarDistance;
+		FarInterval = GameInstance->GroundProbeFarInterval;
+		ReuseDistance = GameInstance->GroundProbeReuseDistance;
+	}
+	else
+	{
+		USK_LOG_WARNING("GameInstance is not UUSKGameInstance. Using the default ground probe settings");
+	}
+
+	bIsConfigured = true;
+}
+
+/**
+ * @brief Get the amount of seconds between updates of a probe based on its distance to the camera
+ * @param Location The location of the probed actor
+ * @param ViewLocation The location of the camera or nullptr if there is no camera
+ * @return The amount of seconds between updates of the probe
+ */
+float UGroundProbeSubsystem::GetUpdateInterval(const FVector& Location, const FVector* ViewLocation) const
+{
+	if (ViewLocation == nullptr || FarInterval <= 0.0f || FarDistance <= NearDistance)
+	{
+		return 0.0f;
+	}
+
+	const float Distance = FVector::Dist(*ViewLocation, Location);
+	return FMath::Clamp(FMath::GetRangePct(NearDistance, FarDistance, Distance), 0.0f, 1.0f) * FarInterval;
+}
+
+/**
+ * @brief Update the result of a probe and notify the listener if the ground changed
+ * @param Probe The probe to update
+ * @param bHit Was ground found below the actor?
+ * @param HitResult The result describing the ground below the actor
+ */
+void UGroundProbeSubsystem::SetResult(FGroundProbe& Probe, const bool bHit, const FHitResult& HitResult)
+{
+	const bool bChanged = !Probe.bHasResult || Probe.bHit != bHit ||
+		(bHit && !Probe.HitResult.Location.Equals(HitResult.Location, 0.1f));
+	Probe.bHasResult = true;
+	Probe.bHit = bHit;
+	if (bHit)
+	{
+		Probe.HitResult = HitResult;
+	}
+
+	if (!bChanged)
+	{
+		return;
+	}
+
+	// The listener can register or unregister probes and reallocate the probe map, so it is called with copies
+	const FGroundProbeUpdated OnUpdated = Probe.OnUpdated;
+	const FHitResult UpdatedHitResult = Probe.HitResult;
+	OnUpdated.ExecuteIfBound(bHit, UpdatedHitResult);
+}
+
+/**
+ * @brief Called when a probe trace is completed
+ * @param TraceHandle The handle of the trace
+ * @param TraceDatum The result of the trace
+ */
+void UGroundProbeSubsystem::OnTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	FGroundProbe* Probe = Probes.Find(TraceDatum.UserData);
+	if (Probe == nullptr || Probe->PendingTrace != TraceHandle)
+	{
+		return;
+	}
+
+	Probe->PendingTrace = FTraceHandle();
+	for (const FHitResult& HitResult : TraceDatum.OutHits)
+	{
+		if (HitResult.bBlockingHit)
+		{
+			SetResult(*Probe, true, HitResult);
+			return;
+		}
+	}
+
+	SetResult(*Probe, false, FHitResult());
+}
@@ -0,0 +1,178 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "GroundProbe.h"
+#include "Tickable.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "GroundProbeSubsystem.generated.h"
+
+/**
+ * @brief World subsystem that finds the ground below actors using batched async traces
+ */
+UCLASS()
+class USK_API UGroundProbeSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Initialize the subsystem
+	 * @param Collection The collection of subsystems
+	 */
+	virtual void Initialize(FSubsystemCollectionBase& Collection) override;
+
+	/**
+	 * @brief Check if the subsystem should be created for the world
+	 * @param Outer The world that owns the subsystem
+	 * @return A boolean value indicating if the subsystem should be created
+	 */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/**
+	 * @brief Remove all the probes when the world is torn down
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Start the traces of the probes that are due for an update
+	 * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * @brief Check if the subsystem should be ticked
+	 * @return A boolean value indicating if the subsystem should be ticked
+	 */
+	virtual bool IsTickable() const override;
+
+	/**
+	 * @brief Get the tick type of the subsystem
+	 * @return The tick type of the subsystem
+	 */
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	/**
+	 * @brief Get the world the subsystem is ticked in
+	 * @return The world the subsystem is ticked in
+	 */
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/**
+	 * @brief Get the stat ID used to profile the subsystem
+	 * @return The stat ID used to profile the subsystem
+	 */
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Start probing the ground below an actor
+	 * @param Actor The actor whose ground is probed
+	 * @param StartOffset The distance below the actor location at which the trace starts
+	 * @param MaxDistance The maximum distance below the actor location at which ground is found
+	 * @param TraceChannel The collision channel used to find the ground
+	 * @return The ID of the probe or -1 if the actor is not valid
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Ground Probe")
+	int RegisterProbe(AActor* Actor, float StartOffset = 0.0f, float MaxDistance = 10000.0f, ECollisionChannel TraceChannel = ECC_Visibility);
+
+	/**
+	 * @brief Stop probing the ground below an actor
+	 * @param ProbeId The ID of the probe
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Ground Probe")
+	void UnregisterProbe(int ProbeId);
+
+	/**
+	 * @brief Pause or resume a probe. The result of a paused probe is cleared
+	 * @param ProbeId The ID of the probe
+	 * @param bEnabled Should the probe be updated?
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Ground Probe")
+	void SetProbeEnabled(int ProbeId, bool bEnabled);
+
+	/**
+	 * @brief Get the last ground found below the actor of a probe
+	 * @param ProbeId The ID of the probe
+	 * @param HitResult The result describing the ground below the actor
+	 * @return A boolean value indicating if ground was found below the actor
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Ground Probe")
+	bool GetGround(int ProbeId, FHitResult& HitResult) const;
+
+	/**
+	 * @brief Set the delegate called when the ground below the actor of a probe changes
+	 * @param ProbeId The ID of the probe
+	 * @param OnUpdated The delegate called when the ground changes
+	 */
+	void SetProbeCallback(int ProbeId, const FGroundProbeUpdated& OnUpdated);
+
+private:
+	/**
+	 * @brief The probes that are currently registered
+	 */
+	TMap<int, FGroundProbe> Probes;
+
+	/**
+	 * @brief The ID assigned to the next probe
+	 */
+	int NextProbeId;
+
+	/**
+	 * @brief Delegate called when a probe trace is completed
+	 */
+	FTraceDelegate TraceDelegate;
+
+	/**
+	 * @brief The distance from the camera within which probes are updated every frame
+	 */
+	float NearDistance = 2000.0f;
+
+	/**
+	 * @brief The distance from the camera at which probes are updated at the far interval
+	 */
+	float FarDistance = 8000.0f;
+
+	/**
+	 * @brief The amount of seconds between updates of probes at the far distance
+	 */
+	float FarInterval = 0.25f;
+
+	/**
+	 * @brief The horizontal distance an actor must move before the ground below it is traced again
+	 */
+	float ReuseDistance = 5.0f;
+
+	/**
+	 * @brief Was the subsystem configured using the game instance?
+	 */
+	bool bIsConfigured;
+
+	/**
+	 * @brief Read the probe settings from the game instance
+	 */
+	void Configure();
+
+	/**
+	 * @brief Get the amount of seconds between updates of a probe based on its distance to the camera
+	 * @param Location The location of the probed actor
+	 * @param ViewLocation The location of the camera or nullptr if there is no camera
+	 * @return The amount of seconds between updates of the probe
+	 */
+	float GetUpdateInterval(const FVector& Location, const FVector* ViewLocation) const;
+
+	/**
+	 * @brief Update the result of a probe and notify the listener if the ground changed
+	 * @param Probe The probe to update
+	 * @param bHit Was ground found below the actor?
+	 * @param HitResult The result describing the ground below the actor
+	 */
+	static void SetResult(FGroundProbe& Probe, bool bHit, const FHitResult& HitResult);
+
+	/**
+	 * @brief Called when a probe trace is completed
+	 * @param TraceHandle The handle of the trace
+	 * @param TraceDatum The result of the trace
+	 */
+	void OnTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
+};
@@ -2,14 +2,19 @@
 
 #include "Weapon.h"
 
-#include "NiagaraFunctionLibrary.h"
 #include "WeaponProjectile.h"
+#include "WeaponProjectilePoolSubsystem.h"
+#include "WeaponProjectileSimulationSubsystem.h"
 #include "Kismet/KismetMathLibrary.h"
 #include "Kismet/KismetSystemLibrary.h"
 #include "Components/SkeletalMeshComponent.h"
+#include "Components/SphereComponent.h"
 #include "Engine/World.h"
+#include "GameFramework/ProjectileMovementComponent.h"
 #include "USK/Audio/AudioUtils.h"
+#include "USK/Benchmark/BenchmarkStats.h"
 #include "USK/Character/USKCharacter.h"
+#include "USK/Effects/ParticleFxUtils.h"
 #include "USK/Logger/Log.h"
 
 /**
@@ -21,6 +26,7 @@ AWeapon::AWeapon()
 	RootComponent = CreateDefaultSubobject<USceneComponent>("Weapon Root");
 	MuzzleFlash = CreateDefaultSubobject<USceneComponent>("Muzzle Flash");
 	MuzzleFlash->SetupAttachment(RootComponent);
+	HitscanTraceDelegate.BindUObject(this, &AWeapon::OnHitscanTraceCompleted);
 }
 
 /**
@@ -30,6 +36,26 @@ void AWeapon::BeginPlay()
 {
 	Super::BeginPlay();
 	AmmoRemaining = Ammo;
+
+	UWeaponProjectilePoolSubsystem* ProjectilePool = GetWorld()->GetSubsystem<UWeaponProjectilePoolSubsystem>();
+	if (!IsValid(ProjectilePool))
+	{
+		return;
+	}
+
+	for (const FWeaponProjectileData& Projectile : Projectiles)
+	{
+		if (!IsValid(Projectile.ProjectileClass) || Projectile.bHitscan)
+		{
+			continue;
+		}
+
+		const AWeaponProjectile* DefaultProjectile = Projectile.ProjectileClass->GetDefaultObject<AWeaponProjectile>();
+		if (!DefaultProjectile->bLightweight)
+		{
+			ProjectilePool->Prewarm(Projectile.ProjectileClass, DefaultProjectile->PoolSize);
+		}
+	}
 }
 
 /**
@@ -49,6 +75,11 @@ void AWeapon::Tick(float DeltaSeconds)
 	{
 		ApplyRecoilRecovery(DeltaSeconds);
 	}
+
+	if (bIsFiring && WeaponFireMode != EWeaponFireMode::SingleShot)
+	{
+		UpdateFiring(DeltaSeconds);
+	}
 }
 
 /**
@@ -64,6 +95,10 @@ void AWeapon::Equip(AUSKCharacter* TargetCharacter)
 	}
 
 	PlayerController = dynamic_cast<APlayerController*>(Character->GetController());
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(true);
+
 	const FAttachmentTransformRules AttachmentRules(EAttachmentRule::SnapToTarget, true);
 	AttachToComponent(Character->GetMesh(), AttachmentRules, WeaponAttachPoint);
 	Character->SetWeapon(this);
@@ -87,26 +122,50 @@ void AWeapon::Unequip()
 	Destroy();
 }
 
+/**
+ * @brief Unequip the weapon and keep it hidden so that it can be equipped again later
+ */
+void AWeapon::Stow()
+{
+	StopFiring();
+	StopRecoilRecovery();
+	if (IsValid(Character) && Character->GetWeapon() == this)
+	{
+		Character->SetWeapon(nullptr);
+		OnWeaponUnequipped.Broadcast();
+		USK_LOG_INFO("Weapon stowed");
+	}
+
+	DetachFromActor(FDetachmentTransformRules::KeepWorldTransform);
+	SetActorHiddenInGame(true);
+	SetActorEnableCollision(false);
+	SetActorTickEnabled(false);
+	Character = nullptr;
+	PlayerController = nullptr;
+}
+
 /**
  * @brief Start firing the weapon
  */
 void AWeapon::StartFiring()
 {
 	bIsFiring = true;
-	ShotsRemaining = MaxShotsPerFireEvent;
+	FiringTime = 0.0f;
+	ShotsFired = 0;
+	PreviousMuzzleLocation = MuzzleFlash->GetComponentLocation();
+	PreviousAimRotation = GetAimRotation();
 
 	StartRecoil();
 	switch (WeaponFireMode)
 	{
 	case EWeaponFireMode::SingleShot:
-		StartFiringSingleShot();
+		FireShot(PreviousMuzzleLocation, PreviousAimRotation, 0.0f, true);
+		ShotsFired++;
 		UKismetSystemLibrary::K2_SetTimer(this, "StopRecoil", RecoilRecoveryDelay, false);
 		break;
 	case EWeaponFireMode::SemiAuto:
-		StartFiringSemiAuto();
-		break;
 	case EWeaponFireMode::FullAuto:
-		StartFiringFullAuto();
+		UpdateFiring(0.0f);
 		break;
 	default:
 		USK_LOG_ERROR("Invalid weapon fire mode");
@@ -159,12 +218,42 @@ int AWeapon::GetAmmoRemaining() const
 	return AmmoRemaining;
 }
 
+/**
+ * @brief Get the amount of shots fired since the weapon started firing
+ * @return The amount of shots fired
+ */
+int AWeapon::GetShotsFired() const
+{
+	return ShotsFired;
+}
+
+/**
+ * @brief Get the amount of shots fired after holding the trigger for a duration, independent of the frame rate
+ * @param FiringDuration The amount of seconds the weapon has been firing
+ * @return The amount of shots fired after the duration
+ */
+int AWeapon::GetExpectedShotCount(const float FiringDuration) const
+{
+	if (FiringDuration < 0.0f)
+	{
+		return 0;
+	}
+
+	if (WeaponFireMode == EWeaponFireMode::SingleShot)
+	{
+		return 1;
+	}
+
+	const int ShotCount = FMath::FloorToInt(FiringDuration / GetShotInterval()) + 1;
+	return WeaponFireMode == EWeaponFireMode::SemiAuto ? FMath::Min(ShotCount, MaxShotsPerFireEvent) : ShotCount;
+}
+
 /**
  * @brief Start applying recoil to the weapon
  */
 void AWeapon::StartRecoil()
 {
-	if (!IsValid(RecoilCurve))
+	if (!HasRecoil())
 	{
 		return;
 	}
@@ -184,7 +273,7 @@ void AWeapon::StartRecoil()
  */
 void AWeapon::StopRecoil()
 {
-	if (!IsValid(RecoilCurve) || !bRecoil)
+	if (!HasRecoil() || !bRecoil)
 	{
 		return;
 	}
@@ -200,8 +289,17 @@ void AWeapon::StopRecoil()
 void AWeapon::ApplyRecoil(const float DeltaSeconds)
 {
 	RecoilTime += DeltaSeconds;
-	FRotator Recoil = FRotator::MakeFromEuler(RecoilCurve->GetVectorValue(RecoilTime));
-	Recoil.Roll = 0;
+	FRotator Recoil;
+	if (IsValid(RecoilPattern))
+	{
+		const FVector2D RecoilOffset = RecoilPattern->GetRecoilOffset(RecoilTime);
+		Recoil = FRotator(RecoilOffset.X, RecoilOffset.Y, 0.0f);
+	}
+	else
+	{
+		Recoil = FRotator::MakeFromEuler(RecoilCurve->GetVectorValue(RecoilTime));
+		Recoil.Roll = 0;
+	}
 	
 	PlayerDeltaRot = PlayerController->GetControlRotation() - RecoilStartRotation - RecoilDeltaRot;
 	PlayerController->SetControlRotation(RecoilStartRotation + PlayerDeltaRot + Recoil);
@@ -214,6 +312,13 @@ void AWeapon::ApplyRecoil(const float DeltaSeconds)
 void AWeapon::StartRecoilRecovery()
 {
 	bRecoilRecovery = true;
+	if (IsValid(RecoilPattern))
+	{
+		RecoilRecoveryTimeRemaining = RecoilPattern->RecoveryTime;
+		RecoilRecoveryStartRot = RecoilDeltaRot;
+		return;
+	}
+
 	RecoilRecoveryTimeRemaining = RecoveryTime;
 
 	const float MaxAdjustment = FMath::Max3(RecoilDeltaRot.Pitch, RecoilDeltaRot.Roll, RecoilDeltaRot.Yaw);
@@ -237,6 +342,17 @@ void AWeapon::StopRecoilRecovery()
  */
 void AWeapon::ApplyRecoilRecovery(const float DeltaSeconds)
 {
+	if (RecoilRecoveryTimeRemaining >= 0.0f && IsValid(RecoilPattern))
+	{
+		RecoilRecoveryTimeRemaining -= DeltaSeconds;
+		const float RecoveryAlpha = RecoilPattern->GetRecoveryAlpha(
+			RecoilPattern->RecoveryTime - RecoilRecoveryTimeRemaining);
+		const FRotator Recoil = RecoilRecoveryStartRot * RecoveryAlpha;
+		PlayerController->SetControlRotation(PlayerController->GetControlRotation() + Recoil - RecoilDeltaRot);
+		RecoilDeltaRot = Recoil;
+		return;
+	}
+
 	if (RecoilRecoveryTimeRemaining >= 0.0f)
 	{
 		const FRotator CurrentRotation = PlayerController->GetControlRotation();
@@ -251,9 +367,58 @@ void AWeapon::ApplyRecoilRecovery(const float DeltaSeconds)
 }
 
 /**
- * @brief Fire a single shot weapon
+ * @brief Check if the weapon has a recoil curve or recoil pattern and is held by a player
+ * @return A boolean value indicating if the weapon has recoil
+ */
+bool AWeapon::HasRecoil() const
+{
+	return IsValid(PlayerController) && (IsValid(RecoilCurve) || IsValid(RecoilPattern));
+}
+
+/**
+ * @brief Fire all the shots that are due for a semi-auto or full auto weapon
+ * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
  */
-void AWeapon::StartFiringSingleShot()
+void AWeapon::UpdateFiring(const float DeltaSeconds)
+{
+	FiringTime += DeltaSeconds;
+	const FVector MuzzleLocation = MuzzleFlash->GetComponentLocation();
+	const FRotator AimRotation = GetAimRotation();
+	const float ShotInterval = GetShotInterval();
+	const int ExpectedShots = GetExpectedShotCount(FiringTime);
+
+	// Shots that were due earlier during the frame are fired from where the muzzle was at that time
+	while (bIsFiring && ShotsFired < ExpectedShots)
+	{
+		const float ShotAge = FMath::Max(FiringTime - ShotsFired * ShotInterval, 0.0f);
+		const float Alpha = DeltaSeconds > 0.0f ? FMath::Clamp(1.0f - ShotAge / DeltaSeconds, 0.0f, 1.0f) : 1.0f;
+		const FVector ShotLocation = FMath::Lerp(PreviousMuzzleLocation, MuzzleLocation, Alpha);
+		const FRotator ShotRotation = FQuat::Slerp(PreviousAimRotation.Quaternion(), AimRotation.Quaternion(),
+			Alpha).Rotator();
+
+		ShotsFired++;
+		FireShot(ShotLocation, ShotRotation, ShotAge, ShotsFired == ExpectedShots);
+	}
+
+	PreviousMuzzleLocation = MuzzleLocation;
+	PreviousAimRotation = AimRotation;
+
+	if (WeaponFireMode == EWeaponFireMode::SemiAuto && FiringTime >= MaxShotsPerFireEvent * ShotInterval)
+	{
+		bIsFiring = false;
+		StopRecoil();
+	}
+}
+
+/**
+ * @brief Fire a single shot
+ * @param MuzzleLocation The location of the muzzle at the time of the shot
+ * @param AimRotation The aim rotation at the time of the shot
+ * @param ShotAge The amount of seconds between the time of the shot and the current time
+ * @param bPlayEffects Should the sound, muzzle flash and animation be played for the shot?
+ */
+void AWeapon::FireShot(const FVector& MuzzleLocation, const FRotator& AimRotation, const float ShotAge,
+	const bool bPlayEffects)
 {
 	if (!bIsFiring || !IsValid(Character) || !IsValid(Character->GetController()))
 	{
@@ -262,8 +427,12 @@ void AWeapon::StartFiringSingleShot()
 
 	if (!bInfiniteAmmo && AmmoRemaining <= 0)
 	{
-		UAudioUtils::PlayRandomSound(this, EmptyClipFireSound);
-		PlayEmptyClipFireAnimation();
+		if (bPlayEffects)
+		{
+			UAudioUtils::PlayRandomSound(this, EmptyClipFireSound);
+			PlayEmptyClipFireAnimation();
+		}
+
 		StopRecoil();
 		OnWeaponFiredEmptyClip.Broadcast();
 		return;
@@ -273,82 +442,164 @@ void AWeapon::StartFiringSingleShot()
 	{
 		RemoveAmmo(1);
 	}
-	
-	UAudioUtils::PlayRandomSound(this, FireSound);
-	for (FWeaponProjectileData Projectile : Projectiles)
+
+	for (int i = 0; i < Projectiles.Num(); i++)
 	{
-		SpawnProjectile(Projectile);
+		SpawnProjectile(i, MuzzleLocation, AimRotation, ShotAge);
 	}
 
-	if (IsValid(MuzzleFlashParticleFx))
+	// Only the last shot of a frame plays the effects to avoid stacking them when firing faster than the frame rate
+	if (bPlayEffects)
 	{
-		UNiagaraFunctionLibrary::SpawnSystemAttached(MuzzleFlashParticleFx, MuzzleFlash, NAME_None,
-			FVector::ZeroVector, FRotator::ZeroRotator,
-			EAttachLocation::SnapToTarget, true);
+		UAudioUtils::PlayRandomSound(this, FireSound);
+		if (IsValid(MuzzleFlashParticleFx))
+		{
+			UParticleFxUtils::SpawnParticleFxAttached(MuzzleFlashParticleFx, MuzzleFlash, NAME_None,
+				FVector::ZeroVector, FRotator::ZeroRotator, EAttachLocation::SnapToTarget);
+		}
+
+		PlayFireAnimation();
 	}
-	
-	PlayFireAnimation();
+
 	OnWeaponFired.Broadcast();
 }
 
 /**
- * @brief Fire a semi-auto weapon
+ * @brief Get the rotation the weapon is currently aimed at
+ * @return The aim rotation
  */
-void AWeapon::StartFiringSemiAuto()
+FRotator AWeapon::GetAimRotation() const
 {
-	if (!bIsFiring)
+	if (!IsValid(PlayerController) || !IsValid(PlayerController->PlayerCameraManager))
 	{
-		return;
+		return MuzzleFlash->GetComponentRotation();
 	}
 
-	ShotsRemaining--;
-	if (ShotsRemaining < 0)
-	{
-		StopRecoil();
-		return;
-	}
-	
-	StartFiringSingleShot();
-	UKismetSystemLibrary::K2_SetTimer(this, "StartFiringSemiAuto", FireRate, false);
+	return PlayerController->PlayerCameraManager->GetCameraRotation();
 }
 
 /**
- * @brief Fire a full auto weapon
+ * @brief Get the amount of seconds between each shot
+ * @return The amount of seconds between each shot
  */
-void AWeapon::StartFiringFullAuto()
+float AWeapon::GetShotInterval() const
 {
-	if (!bIsFiring)
-	{
-		return;
-	}
-	
-	StartFiringSingleShot();
-	UKismetSystemLibrary::K2_SetTimer(this, "StartFiringFullAuto", FireRate, false);
+	// Prevent a zero fire rate from firing an unlimited amount of shots in a single frame
+	return FMath::Max(FireRate, 0.001f);
 }
 
 /**
  * @brief Spawn the projectile
- * @param Projectile The projectile to spawn
+ * @param ProjectileIndex The index of the projectile in the projectiles array
+ * @param MuzzleLocation The location of the muzzle at the time of the shot
+ * @param AimRotation The aim rotation at the time of the shot
+ * @param ShotAge The amount of seconds between the time of the shot and the current time
  */
-void AWeapon::SpawnProjectile(const FWeaponProjectileData& Projectile) const
+void AWeapon::SpawnProjectile(const int ProjectileIndex, const FVector& MuzzleLocation, const FRotator& AimRotation,
+	const float ShotAge) const
 {
+	USK_BENCHMARK_SCOPE(SpawnProjectile);
+	const FWeaponProjectileData& Projectile = Projectiles[ProjectileIndex];
 	if (!IsValid(Projectile.ProjectileClass))
 	{
 		return;
 	}
 
-	const FRotator SpawnRotation = UKismetMathLibrary::ComposeRotators(
-		PlayerController->PlayerCameraManager->GetCameraRotation(), Projectile.SpawnTransform.Rotator());
-	const FVector SpawnLocation = MuzzleFlash->GetComponentLocation() + Projectile.SpawnTransform.GetLocation();
+	const FRotator SpawnRotation = UKismetMathLibrary::ComposeRotators(AimRotation,
+		Projectile.SpawnTransform.Rotator());
+	FVector SpawnLocation = MuzzleLocation + Projectile.SpawnTransform.GetLocation();
+	if (Projectile.bHitscan)
+	{
+		TraceHitscanProjectile(ProjectileIndex, SpawnLocation, SpawnRotation.Vector());
+		return;
+	}
+
+	// Move the projectile to where it would have been if it was spawned at the exact time of the shot
+	const AWeaponProjectile* DefaultProjectile = Projectile.ProjectileClass->GetDefaultObject<AWeaponProjectile>();
+	if (ShotAge > 0.0f)
+	{
+		const FVector OffsetLocation = SpawnLocation + SpawnRotation.Vector() *
+			DefaultProjectile->GetProjectileMovementComponent()->InitialSpeed * ShotAge;
+
+		// The offset is swept so a late shot never skips past the geometry in front of the muzzle
+		const USphereComponent* Collision = DefaultProjectile->GetCollisionComponent();
+		FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WeaponProjectileOffset), false, this);
+		QueryParams.AddIgnoredActor(Character);
+		FHitResult HitResult;
+		const bool bHit = GetWorld()->SweepSingleByChannel(HitResult, SpawnLocation, OffsetLocation, FQuat::Identity,
+			Collision->GetCollisionObjectType(), FCollisionShape::MakeSphere(Collision->GetScaledSphereRadius()),
+			QueryParams, FCollisionResponseParams(Collision->GetCollisionResponseToChannels()));
+		SpawnLocation = bHit ? HitResult.Location + HitResult.Normal * KINDA_SMALL_NUMBER : OffsetLocation;
+	}
+
+	const FTransform ProjectileTransform(SpawnRotation, SpawnLocation, Projectile.SpawnTransform.GetScale3D());
+	if (DefaultProjectile->bLightweight)
+	{
+		UWeaponProjectileSimulationSubsystem* ProjectileSimulation =
+			GetWorld()->GetSubsystem<UWeaponProjectileSimulationSubsystem>();
+		if (IsValid(ProjectileSimulation))
+		{
+			ProjectileSimulation->SpawnProjectile(Projectile.ProjectileClass, ProjectileTransform);
+			return;
+		}
+	}
+
+	UWeaponProjectilePoolSubsystem* ProjectilePool = GetWorld()->GetSubsystem<UWeaponProjectilePoolSubsystem>();
+	if (IsValid(ProjectilePool))
+	{
+		ProjectilePool->Acquire(Projectile.ProjectileClass, ProjectileTransform);
+		return;
+	}
 
 	FActorSpawnParameters SpawnParams;
 	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
-	AWeaponProjectile* WeaponProjectile = GetWorld()->SpawnActor<AWeaponProjectile>(Projectile.ProjectileClass,
-		SpawnLocation, SpawnRotation, SpawnParams);
-	
-	if (IsValid(WeaponProjectile))
+	GetWorld()->SpawnActor<AWeaponProjectile>(Projectile.ProjectileClass, ProjectileTransform, SpawnParams);
+}
+
+/**
+ * @brief Start an async line trace for a hitscan projectile
+ * @param ProjectileIndex The index of the projectile in the projectiles array
+ * @param Start The start location of the line trace
+ * @param Direction The direction of the line trace
+ */
+void AWeapon::TraceHitscanProjectile(const int ProjectileIndex, const FVector& Start, const FVector& Direction) const
+{
+	const FWeaponProjectileData& Projectile = Projectiles[ProjectileIndex];
+	FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WeaponHitscan), false, this);
+	QueryParams.AddIgnoredActor(Character);
+
+	// All the traces started during this frame are resolved together at the start of the next frame
+	GetWorld()->AsyncLineTraceByChannel(EAsyncTraceType::Single, Start, Start + Direction * Projectile.HitscanRange,
+		Projectile.HitscanTraceChannel, QueryParams, FCollisionResponseParams::DefaultResponseParam,
+		&HitscanTraceDelegate, ProjectileIndex);
+}
+
+/**
+ * @brief Called when a hitscan line trace is completed
+ * @param TraceHandle The handle of the line trace
+ * @param TraceDatum The result of the line trace
+ */
+void AWeapon::OnHitscanTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum)
+{
+	const int ProjectileIndex = TraceDatum.UserData;
+	if (!Projectiles.IsValidIndex(ProjectileIndex) || !IsValid(Projectiles[ProjectileIndex].ProjectileClass))
 	{
-		WeaponProjectile->SetActorScale3D(Projectile.SpawnTransform.GetScale3D());
+		return;
+	}
+
+	for (const FHitResult& HitResult : TraceDatum.OutHits)
+	{
+		if (!HitResult.bBlockingHit)
+		{
+			continue;
+		}
+
+		const AWeaponProjectile* Projectile =
+			Projectiles[ProjectileIndex].ProjectileClass->GetDefaultObject<AWeaponProjectile>();
+		const FVector Velocity = (TraceDatum.End - TraceDatum.Start).GetSafeNormal() *
+			Projectile->GetProjectileMovementComponent()->InitialSpeed;
+
+		Projectile->ApplyHit(HitResult.GetActor(), HitResult.GetComponent(), Velocity, HitResult);
 	}
 }
 
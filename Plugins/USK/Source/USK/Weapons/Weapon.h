@@ -8,7 +8,9 @@
 #include "GameFramework/Actor.h"
 #include "Animation/AnimMontage.h"
 #include "WeaponProjectileData.h"
+#include "WeaponRecoilPattern.h"
 #include "WeaponType.h"
+#include "WorldCollision.h"
 #include "Curves/CurveVector.h"
 #include "Weapon.generated.h"
 
@@ -125,18 +127,24 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon|Recoil")
 	UCurveVector* RecoilCurve;
 
+	/**
+	 * @brief The baked recoil pattern used instead of the recoil curve
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon|Recoil")
+	UWeaponRecoilPattern* RecoilPattern;
+
 	/**
 	 * @brief The recovery time after recoil was applied
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon|Recoil",
-		meta=(EditCondition = "RecoilCurve != nullptr", EditConditionHides))
+		meta=(EditCondition = "RecoilCurve != nullptr && RecoilPattern == nullptr", EditConditionHides))
 	float RecoveryTime = 1.0f;
 
 	/**
 	 * @brief The delay before we start recovering from recoil
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon|Recoil",
-		meta=(EditCondition = "RecoilCurve != nullptr && WeaponFireMode == EWeaponFireMode::SingleSHot",
+		meta=(EditCondition = "(RecoilCurve != nullptr || RecoilPattern != nullptr) && WeaponFireMode == EWeaponFireMode::SingleSHot",
 			EditConditionHides))
 	float RecoilRecoveryDelay = 0.15f;
 
@@ -224,6 +232,12 @@ public:
 	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon")
 	void Unequip();
 
+	/**
+	 * @brief Unequip the weapon and keep it hidden so that it can be equipped again later
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon")
+	void Stow();
+
 	/**
 	 * @brief Start firing the weapon
 	 */
@@ -255,7 +269,22 @@ public:
 	 * @return The amount of ammo remaining
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon")
-	int GetAmmoRemaining() const;	
+	int GetAmmoRemaining() const;
+
+	/**
+	 * @brief Get the amount of shots fired since the weapon started firing
+	 * @return The amount of shots fired
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon")
+	int GetShotsFired() const;
+
+	/**
+	 * @brief Get the amount of shots fired after holding the trigger for a duration, independent of the frame rate
+	 * @param FiringDuration The amount of seconds the weapon has been firing
+	 * @return The amount of shots fired after the duration
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon")
+	int GetExpectedShotCount(float FiringDuration) const;
 
 protected:
 	/**
@@ -326,9 +355,24 @@ private:
 	bool bIsFiring;
 
 	/**
-	 * @brief The amount of shots remaining before the weapon stops firing
+	 * @brief The amount of seconds the weapon has been firing
+	 */
+	float FiringTime;
+
+	/**
+	 * @brief The amount of shots fired since the weapon started firing
+	 */
+	int ShotsFired;
+
+	/**
+	 * @brief The location of the muzzle during the previous frame
 	 */
-	int ShotsRemaining;
+	FVector PreviousMuzzleLocation;
+
+	/**
+	 * @brief The aim rotation during the previous frame
+	 */
+	FRotator PreviousAimRotation;
 
 	/**
 	 * @brief The amount of ammo remaining
@@ -376,28 +420,72 @@ private:
 	FRotator PlayerDeltaRot;
 
 	/**
-	 * @brief Fire a single shot weapon
+	 * @brief The rotation change because of recoil at the time we started recovering
+	 */
+	FRotator RecoilRecoveryStartRot;
+
+	/**
+	 * @brief Check if the weapon has a recoil curve or recoil pattern and is held by a player
+	 * @return A boolean value indicating if the weapon has recoil
+	 */
+	bool HasRecoil() const;
+
+	/**
+	 * @brief Fire all the shots that are due for a semi-auto or full auto weapon
+	 * @param DeltaSeconds Game time elapsed during last frame modified by the time dilation
+	 */
+	void UpdateFiring(float DeltaSeconds);
+
+	/**
+	 * @brief Fire a single shot
+	 * @param MuzzleLocation The location of the muzzle at the time of the shot
+	 * @param AimRotation The aim rotation at the time of the shot
+	 * @param ShotAge The amount of seconds between the time of the shot and the current time
+	 * @param bPlayEffects Should the sound, muzzle flash and animation be played for the shot?
+	 */
+	void FireShot(const FVector& MuzzleLocation, const FRotator& AimRotation, float ShotAge, bool bPlayEffects);
+
+	/**
+	 * @brief Get the rotation the weapon is currently aimed at
+	 * @return The aim rotation
 	 */
-	UFUNCTION()
-	void StartFiringSingleShot();
+	FRotator GetAimRotation() const;
 
 	/**
-	 * @brief Fire a semi-auto weapon
+	 * @brief Get the amount of seconds between each shot
+	 * @return The amount of seconds between each shot
 	 */
-	UFUNCTION()
-	void StartFiringSemiAuto();
+	float GetShotInterval() const;
 
 	/**
-	 * @brief Fire a full auto weapon
+	 * @brief The delegate called when a hitscan line trace is completed
 	 */
-	UFUNCTION()
-	void StartFiringFullAuto();
+	FTraceDelegate HitscanTraceDelegate;
 
 	/**
 	 * @brief Spawn the projectile
-	 * @param Projectile The projectile to spawn
+	 * @param ProjectileIndex The index of the projectile in the projectiles array
+	 * @param MuzzleLocation The location of the muzzle at the time of the shot
+	 * @param AimRotation The aim rotation at the time of the shot
+	 * @param ShotAge The amount of seconds between the time of the shot and the current time
+	 */
+	void SpawnProjectile(int ProjectileIndex, const FVector& MuzzleLocation, const FRotator& AimRotation,
+		float ShotAge) const;
+
+	/**
+	 * @brief Start an async line trace for a hitscan projectile
+	 * @param ProjectileIndex The index of the projectile in the projectiles array
+	 * @param Start The start location of the line trace
+	 * @param Direction The direction of the line trace
+	 */
+	void TraceHitscanProjectile(int ProjectileIndex, const FVector& Start, const FVector& Direction) const;
+
+	/**
+	 * @brief Called when a hitscan line trace is completed
+	 * @param TraceHandle The handle of the line trace
+	 * @param TraceDatum The result of the line trace
 	 */
-	void SpawnProjectile(const FWeaponProjectileData& Projectile) const;
+	void OnHitscanTraceCompleted(const FTraceHandle& TraceHandle, FTraceDatum& TraceDatum);
 
 	/**
 	 * @brief Play the fire animation
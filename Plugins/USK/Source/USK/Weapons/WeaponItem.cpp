@@ -3,8 +3,24 @@
 #include "WeaponItem.h"
 
 #include "WeaponUtils.h"
+#include "Engine/World.h"
+#include "Kismet/GameplayStatics.h"
+#include "TimerManager.h"
 #include "USK/Character/USKCharacter.h"
 
+/**
+ * @brief Overridable native event for when play begins for this actor
+ */
+void AWeaponItem::BeginPlay()
+{
+	Super::BeginPlay();
+	if (bPrefetchWeapon && IsValid(WeaponClass))
+	{
+		GetWorldTimerManager().SetTimer(PrefetchTimer, this, &AWeaponItem::CheckPrefetchDistance,
+			FMath::Max(PrefetchCheckInterval, 0.01f), true);
+	}
+}
+
 /**
  * @brief Called after the item is collected
  * @param Collector A pointer to the actor that collected the item
@@ -15,3 +31,19 @@ void AWeaponItem::OnItemCollected_Implementation(AActor* Collector)
 	AUSKCharacter* Character = dynamic_cast<AUSKCharacter*>(Collector);
 	UWeaponUtils::EquipWeapon(Character, WeaponClass);
 }
+
+/**
+ * @brief Spawn the weapon in advance if the player is close enough to the item
+ */
+void AWeaponItem::CheckPrefetchDistance()
+{
+	const AUSKCharacter* Character = Cast<AUSKCharacter>(UGameplayStatics::GetPlayerPawn(this, 0));
+	if (!IsValid(Character) || !IsValid(Character->GetWeaponLoadout()) ||
+		FVector::DistSquared(Character->GetActorLocation(), GetActorLocation()) > FMath::Square(PrefetchDistance))
+	{
+		return;
+	}
+
+	GetWorldTimerManager().ClearTimer(PrefetchTimer);
+	Character->GetWeaponLoadout()->PrefetchWeapon(WeaponClass);
+}
@@ -22,9 +22,46 @@ public:
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Item")
 	TSubclassOf<AWeapon> WeaponClass;
 
+	/**
+	 * @brief Should the weapon be spawned in advance when the player comes close to the item?
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Item|Prefetch")
+	bool bPrefetchWeapon = true;
+
+	/**
+	 * @brief The distance from the player at which the weapon is spawned in advance
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Item|Prefetch",
+		meta=(EditCondition = "bPrefetchWeapon", EditConditionHides))
+	float PrefetchDistance = 1500.0f;
+
+	/**
+	 * @brief The amount of seconds between each check of the distance to the player
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Item|Prefetch",
+		meta=(EditCondition = "bPrefetchWeapon", EditConditionHides))
+	float PrefetchCheckInterval = 0.25f;
+
 	/**
 	 * @brief Called after the item is collected
 	 * @param Collector A pointer to the actor that collected the item
 	 */
 	virtual void OnItemCollected_Implementation(AActor* Collector) override;
+
+protected:
+	/**
+	 * @brief Overridable native event for when play begins for this actor
+	 */
+	virtual void BeginPlay() override;
+
+private:
+	/**
+	 * @brief The timer used to check the distance to the player
+	 */
+	FTimerHandle PrefetchTimer;
+
+	/**
+	 * @brief Spawn the weapon in advance if the player is close enough to the item
+	 */
+	void CheckPrefetchDistance();
 };
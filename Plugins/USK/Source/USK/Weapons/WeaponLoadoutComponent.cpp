@@ -0,0 +1,236 @@
+﻿// Created by Henry Jooste
+
+#include "WeaponLoadoutComponent.h"
+
+#include "Engine/World.h"
+#include "TimerManager.h"
+#include "USK/Character/USKCharacter.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Equip a weapon, reusing the cached weapon of the same class if there is one
+ * @param WeaponClass The weapon class to equip
+ * @return The equipped weapon
+ */
+AWeapon* UWeaponLoadoutComponent::EquipWeapon(const TSubclassOf<AWeapon> WeaponClass)
+{
+	AUSKCharacter* Character = GetCharacter();
+	if (!IsValid(Character))
+	{
+		USK_LOG_ERROR("Unable to equip weapon. Loadout is not owned by a character");
+		return nullptr;
+	}
+
+	if (!IsValid(WeaponClass))
+	{
+		USK_LOG_ERROR("Weapon class is not valid");
+		return nullptr;
+	}
+
+	AWeapon* CurrentWeapon = Character->GetWeapon();
+	if (IsValid(CurrentWeapon) && CurrentWeapon->GetClass() == WeaponClass)
+	{
+		TouchWeapon(CurrentWeapon);
+		return CurrentWeapon;
+	}
+
+	AWeapon* Weapon = GetCachedWeapon(WeaponClass);
+	if (!IsValid(Weapon))
+	{
+		PendingPrefetches.Remove(WeaponClass);
+		Weapon = SpawnWeapon(WeaponClass);
+		if (!IsValid(Weapon))
+		{
+			USK_LOG_ERROR("Failed to spawn weapon");
+			return nullptr;
+		}
+	}
+
+	if (IsValid(CurrentWeapon))
+	{
+		if (CachedWeapons.Contains(CurrentWeapon))
+		{
+			CurrentWeapon->Stow();
+		}
+		else
+		{
+			CurrentWeapon->Unequip();
+		}
+	}
+
+	Weapon->Equip(Character);
+	TouchWeapon(Weapon);
+	EvictWeapons();
+	return Weapon;
+}
+
+/**
+ * @brief Spawn a weapon in advance so that it is ready when it is equipped
+ * @param WeaponClass The weapon class to spawn
+ */
+void UWeaponLoadoutComponent::PrefetchWeapon(const TSubclassOf<AWeapon> WeaponClass)
+{
+	if (!IsValid(WeaponClass) || IsValid(GetCachedWeapon(WeaponClass)) || PendingPrefetches.Contains(WeaponClass))
+	{
+		return;
+	}
+
+	// Weapons are spawned one per frame so that several pickups coming into range don't cause a hitch
+	USK_LOG_TRACE(*FString::Format(TEXT("Prefetching weapon {0}"), { WeaponClass->GetName() }));
+	PendingPrefetches.Add(WeaponClass);
+	if (PendingPrefetches.Num() == 1)
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UWeaponLoadoutComponent::ProcessNextPrefetch);
+	}
+}
+
+/**
+ * @brief Get the cached weapon of a specific class
+ * @param WeaponClass The weapon class
+ * @return The cached weapon or nullptr if the weapon is not cached
+ */
+AWeapon* UWeaponLoadoutComponent::GetCachedWeapon(const TSubclassOf<AWeapon> WeaponClass) const
+{
+	for (AWeapon* Weapon : CachedWeapons)
+	{
+		if (IsValid(Weapon) && Weapon->GetClass() == WeaponClass)
+		{
+			return Weapon;
+		}
+	}
+
+	return nullptr;
+}
+
+/**
+ * @brief Get the amount of weapons currently kept alive
+ * @return The amount of cached weapons
+ */
+int UWeaponLoadoutComponent::GetCachedWeaponCount() const
+{
+	return CachedWeapons.Num();
+}
+
+/**
+ * @brief Destroy all the cached weapons that are not equipped
+ */
+void UWeaponLoadoutComponent::ClearCachedWeapons()
+{
+	const AUSKCharacter* Character = GetCharacter();
+	const AWeapon* CurrentWeapon = IsValid(Character) ? Character->GetWeapon() : nullptr;
+	for (int i = CachedWeapons.Num() - 1; i >= 0; i--)
+	{
+		if (CachedWeapons[i] == CurrentWeapon)
+		{
+			continue;
+		}
+
+		if (IsValid(CachedWeapons[i]))
+		{
+			CachedWeapons[i]->Destroy();
+		}
+
+		CachedWeapons.RemoveAt(i);
+	}
+
+	PendingPrefetches.Empty();
+}
+
+/**
+ * @brief Called when the component is removed from the world
+ * @param EndPlayReason The reason the component is removed
+ */
+void UWeaponLoadoutComponent::EndPlay(const EEndPlayReason::Type EndPlayReason)
+{
+	ClearCachedWeapons();
+	Super::EndPlay(EndPlayReason);
+}
+
+/**
+ * @brief Get the character that owns the component
+ * @return The character that owns the component
+ */
+AUSKCharacter* UWeaponLoadoutComponent::GetCharacter() const
+{
+	return Cast<AUSKCharacter>(GetOwner());
+}
+
+/**
+ * @brief Spawn a new weapon that is owned by the loadout
+ * @param WeaponClass The weapon class to spawn
+ * @return The spawned weapon
+ */
+AWeapon* UWeaponLoadoutComponent::SpawnWeapon(const TSubclassOf<AWeapon> WeaponClass)
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.Owner = GetOwner();
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AWeapon* Weapon = GetWorld()->SpawnActor<AWeapon>(WeaponClass, GetOwner()->GetActorTransform(), SpawnParams);
+	if (IsValid(Weapon))
+	{
+		CachedWeapons.Add(Weapon);
+	}
+
+	return Weapon;
+}
+
+/**
+ * @brief Spawn the next weapon waiting to be spawned in advance
+ */
+void UWeaponLoadoutComponent::ProcessNextPrefetch()
+{
+	if (PendingPrefetches.Num() == 0)
+	{
+		return;
+	}
+
+	const TSubclassOf<AWeapon> WeaponClass = PendingPrefetches[0];
+	PendingPrefetches.RemoveAt(0);
+	if (IsValid(WeaponClass) && !IsValid(GetCachedWeapon(WeaponClass)))
+	{
+		AWeapon* Weapon = SpawnWeapon(WeaponClass);
+		if (IsValid(Weapon))
+		{
+			Weapon->Stow();
+			EvictWeapons();
+		}
+	}
+
+	if (PendingPrefetches.Num() > 0)
+	{
+		GetWorld()->GetTimerManager().SetTimerForNextTick(this, &UWeaponLoadoutComponent::ProcessNextPrefetch);
+	}
+}
+
+/**
+ * @brief Move a weapon to the end of the cache to mark it as the most recently used weapon
+ * @param Weapon The weapon that was used
+ */
+void UWeaponLoadoutComponent::TouchWeapon(AWeapon* Weapon)
+{
+	CachedWeapons.Remove(Weapon);
+	CachedWeapons.Add(Weapon);
+}
+
+/**
+ * @brief Destroy the least recently used weapons until the cache fits in the budget
+ */
+void UWeaponLoadoutComponent::EvictWeapons()
+{
+	CachedWeapons.RemoveAll([](const AWeapon* Weapon) { return !IsValid(Weapon); });
+
+	const AUSKCharacter* Character = GetCharacter();
+	const AWeapon* CurrentWeapon = IsValid(Character) ? Character->GetWeapon() : nullptr;
+	for (int i = 0; i < CachedWeapons.Num() && CachedWeapons.Num() > FMath::Max(MaxCachedWeapons, 1); )
+	{
+		if (CachedWeapons[i] == CurrentWeapon)
+		{
+			i++;
+			continue;
+		}
+
+		USK_LOG_TRACE(*FString::Format(TEXT("Evicting cached weapon {0}"), { CachedWeapons[i]->GetName() }));
+		CachedWeapons[i]->Destroy();
+		CachedWeapons.RemoveAt(i);
+	}
+}
@@ -0,0 +1,112 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Weapon.h"
+#include "Components/ActorComponent.h"
+#include "WeaponLoadoutComponent.generated.h"
+
+class AUSKCharacter;
+
+/**
+ * @brief Actor component that keeps the weapons of a character alive so they can be swapped without respawning
+ */
+UCLASS(Blueprintable, meta=(BlueprintSpawnableComponent))
+class USK_API UWeaponLoadoutComponent : public UActorComponent
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief The maximum amount of weapons kept alive, including the equipped weapon
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Loadout",
+		meta=(ClampMin = "1"))
+	int MaxCachedWeapons = 4;
+
+	/**
+	 * @brief Equip a weapon, reusing the cached weapon of the same class if there is one
+	 * @param WeaponClass The weapon class to equip
+	 * @return The equipped weapon
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon Loadout")
+	AWeapon* EquipWeapon(TSubclassOf<AWeapon> WeaponClass);
+
+	/**
+	 * @brief Spawn a weapon in advance so that it is ready when it is equipped
+	 * @param WeaponClass The weapon class to spawn
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon Loadout")
+	void PrefetchWeapon(TSubclassOf<AWeapon> WeaponClass);
+
+	/**
+	 * @brief Get the cached weapon of a specific class
+	 * @param WeaponClass The weapon class
+	 * @return The cached weapon or nullptr if the weapon is not cached
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon Loadout")
+	AWeapon* GetCachedWeapon(TSubclassOf<AWeapon> WeaponClass) const;
+
+	/**
+	 * @brief Get the amount of weapons currently kept alive
+	 * @return The amount of cached weapons
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon Loadout")
+	int GetCachedWeaponCount() const;
+
+	/**
+	 * @brief Destroy all the cached weapons that are not equipped
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon Loadout")
+	void ClearCachedWeapons();
+
+protected:
+	/**
+	 * @brief Called when the component is removed from the world
+	 * @param EndPlayReason The reason the component is removed
+	 */
+	virtual void EndPlay(const EEndPlayReason::Type EndPlayReason) override;
+
+private:
+	/**
+	 * @brief The cached weapons ordered from least to most recently used
+	 */
+	UPROPERTY()
+	TArray<AWeapon*> CachedWeapons;
+
+	/**
+	 * @brief The weapon classes waiting to be spawned in advance
+	 */
+	UPROPERTY()
+	TArray<TSubclassOf<AWeapon>> PendingPrefetches;
+
+	/**
+	 * @brief Get the character that owns the component
+	 * @return The character that owns the component
+	 */
+	AUSKCharacter* GetCharacter() const;
+
+	/**
+	 * @brief Spawn a new weapon that is owned by the loadout
+	 * @param WeaponClass The weapon class to spawn
+	 * @return The spawned weapon
+	 */
+	AWeapon* SpawnWeapon(TSubclassOf<AWeapon> WeaponClass);
+
+	/**
+	 * @brief Spawn the next weapon waiting to be spawned in advance
+	 */
+	void ProcessNextPrefetch();
+
+	/**
+	 * @brief Move a weapon to the end of the cache to mark it as the most recently used weapon
+	 * @param Weapon The weapon that was used
+	 */
+	void TouchWeapon(AWeapon* Weapon);
+
+	/**
+	 * @brief Destroy the least recently used weapons until the cache fits in the budget
+	 */
+	void EvictWeapons();
+};
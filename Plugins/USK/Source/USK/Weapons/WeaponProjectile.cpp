@@ -2,10 +2,15 @@
 
 #include "WeaponProjectile.h"
 
-#include "NiagaraFunctionLibrary.h"
+#include "WeaponProjectileDecalSubsystem.h"
+#include "WeaponProjectilePoolSubsystem.h"
 #include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "UObject/UObjectIterator.h"
 #include "GameFramework/ProjectileMovementComponent.h"
 #include "USK/Audio/AudioUtils.h"
+#include "USK/Benchmark/BenchmarkStats.h"
+#include "USK/Effects/ParticleFxUtils.h"
 #include "USK/Logger/Log.h"
 
 /**
@@ -50,33 +55,182 @@ UProjectileMovementComponent* AWeaponProjectile::GetProjectileMovementComponent(
 }
 
 /**
- * @brief Called after the projectile hits something
- * @param HitComponent The component responsible for the hit
+ * @brief Apply the impulse, hit reaction and decal of the projectile to the actor that was hit
  * @param OtherActor The actor that was hit
  * @param OtherComponent The component that was hit
- * @param NormalImpulse The normal impulse of the hit
+ * @param Velocity The velocity of the projectile at the time of the hit
  * @param HitResult Result describing the hit
  */
-void AWeaponProjectile::OnHit_Implementation(UPrimitiveComponent* HitComponent, AActor* OtherActor,
-	UPrimitiveComponent* OtherComponent, FVector NormalImpulse, const FHitResult& HitResult)
+void AWeaponProjectile::ApplyHit(AActor* OtherActor, UPrimitiveComponent* OtherComponent, const FVector& Velocity,
+	const FHitResult& HitResult) const
 {
-	if (!IsValid(OtherActor) || OtherActor == this)
+	if (!IsValid(OtherActor))
 	{
 		return;
 	}
 
+	USK_BENCHMARK_SCOPE(ProjectileHit);
 	USK_LOG_TRACE(*FString::Format(TEXT("Projectile hit {0}"), { OtherActor->GetName() }));
 	if (IsValid(OtherComponent) && !FMath::IsNearlyZero(HitImpulse) && OtherComponent->IsSimulatingPhysics())
 	{
-		OtherComponent->AddImpulseAtLocation(GetVelocity() * HitImpulse, GetActorLocation());
+		OtherComponent->AddImpulseAtLocation(Velocity * HitImpulse, HitResult.Location);
 	}
 
 	ProcessHitReaction(OtherActor, HitResult);
 	SpawnDecal(OtherActor, HitResult);
-	
+}
+
+/**
+ * @brief Clear the cached hit reactions and decals. Call this after changing the hit reactions or decals at runtime
+ */
+void AWeaponProjectile::InvalidateImpactCache()
+{
+	// The values of a spawned projectile no longer match its class, so it stops sharing the cache of its class
+	bOwnsImpactCache = !HasAnyFlags(RF_ClassDefaultObject);
+	ImpactCache.Empty();
+}
+
+/**
+ * @brief Clear the impact caches of the class default objects, which apply the hits of hitscan and lightweight
+ * projectiles and outlive the world
+ */
+void AWeaponProjectile::InvalidateDefaultImpactCaches()
+{
+	for (TObjectIterator<UClass> Iterator; Iterator; ++Iterator)
+	{
+		if (!Iterator->IsChildOf(StaticClass()))
+		{
+			continue;
+		}
+
+		if (AWeaponProjectile* DefaultProjectile = Cast<AWeaponProjectile>(Iterator->GetDefaultObject(false)))
+		{
+			DefaultProjectile->InvalidateImpactCache();
+		}
+	}
+}
+
+/**
+ * @brief Destroy the projectile or return it to the projectile pool
+ */
+void AWeaponProjectile::DestroyProjectile()
+{
+	UWeaponProjectilePoolSubsystem* ProjectilePool = GetWorld()->GetSubsystem<UWeaponProjectilePoolSubsystem>();
+	if (bIsPooled && IsValid(ProjectilePool))
+	{
+		ProjectilePool->Release(this);
+		return;
+	}
+
+	Destroy();
+}
+
+/**
+ * @brief Activate the projectile after it was taken from the projectile pool
+ * @param SpawnTransform The transform of the projectile
+ */
+void AWeaponProjectile::ActivateProjectile(const FTransform& SpawnTransform)
+{
+	SetActorTransform(SpawnTransform, false, nullptr, ETeleportType::ResetPhysics);
+	SetActorHiddenInGame(false);
+	SetActorEnableCollision(true);
+	SetActorTickEnabled(PrimaryActorTick.bStartWithTickEnabled);
+
+	ProjectileMovementComponent->SetUpdatedComponent(CollisionComponent);
+	ProjectileMovementComponent->Velocity = SpawnTransform.GetRotation().GetForwardVector() *
+		ProjectileMovementComponent->InitialSpeed;
+	ProjectileMovementComponent->Activate(true);
+	ProjectileMovementComponent->UpdateComponentVelocity();
+
+	SetLifeSpan(InitialLifeSpan);
+	OnProjectileReset();
+}
+
+/**
+ * @brief Deactivate the projectile before it is returned to the projectile pool
+ */
+void AWeaponProjectile::DeactivateProjectile()
+{
+	SetLifeSpan(0.0f);
+	ProjectileMovementComponent->StopMovementImmediately();
+	ProjectileMovementComponent->Deactivate();
+
+	SetActorTickEnabled(false);
+	SetActorEnableCollision(false);
+	SetActorHiddenInGame(true);
+}
+
+/**
+ * @brief Check if the projectile is owned by the projectile pool
+ * @return A boolean value indicating if the projectile is owned by the projectile pool
+ */
+bool AWeaponProjectile::IsPooled() const
+{
+	return bIsPooled;
+}
+
+/**
+ * @brief Set whether the projectile is owned by the projectile pool
+ * @param bPooled Is the projectile owned by the projectile pool?
+ */
+void AWeaponProjectile::SetPooled(const bool bPooled)
+{
+	bIsPooled = bPooled;
+}
+
+#if WITH_EDITOR
+/**
+ * @brief Called when a property on this object has been modified externally
+ * @param PropertyChangedEvent The event containing information about the property that was changed
+ */
+void AWeaponProjectile::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	InvalidateImpactCache();
+}
+#endif
+
+/**
+ * @brief Called when the lifespan of the projectile expires
+ */
+void AWeaponProjectile::LifeSpanExpired()
+{
+	if (bIsPooled)
+	{
+		DestroyProjectile();
+		return;
+	}
+
+	Super::LifeSpanExpired();
+}
+
+/**
+ * @brief Called after the projectile was taken from the projectile pool and reset
+ */
+void AWeaponProjectile::OnProjectileReset_Implementation()
+{
+}
+
+/**
+ * @brief Called after the projectile hits something. Not called for lightweight projectiles
+ * @param HitComponent The component responsible for the hit
+ * @param OtherActor The actor that was hit
+ * @param OtherComponent The component that was hit
+ * @param NormalImpulse The normal impulse of the hit
+ * @param HitResult Result describing the hit
+ */
+void AWeaponProjectile::OnHit_Implementation(UPrimitiveComponent* HitComponent, AActor* OtherActor,
+	UPrimitiveComponent* OtherComponent, FVector NormalImpulse, const FHitResult& HitResult)
+{
+	if (!IsValid(OtherActor) || OtherActor == this)
+	{
+		return;
+	}
+
+	ApplyHit(OtherActor, OtherComponent, GetVelocity(), HitResult);
 	if (bDestroyOnHit)
 	{
-		Destroy();	
+		DestroyProjectile();
 	}
 }
 
@@ -85,21 +239,13 @@ void AWeaponProjectile::OnHit_Implementation(UPrimitiveComponent* HitComponent,
  * @param OtherActor The actor that was hit
  * @param HitResult The result describing the hit
  */
-void AWeaponProjectile::ProcessHitReaction(AActor* OtherActor, const FHitResult& HitResult)
+void AWeaponProjectile::ProcessHitReaction(AActor* OtherActor, const FHitResult& HitResult) const
 {
-	FWeaponProjectileHitData HitReaction = DefaultHitReaction;
-	for (const TTuple<TSubclassOf<AActor>, FWeaponProjectileHitData> HitReactionData : HitReactions)
-	{
-		if (OtherActor->IsA(HitReactionData.Key))
-		{
-			HitReaction = HitReactionData.Value;
-			break;
-		}
-	}
+	const FWeaponProjectileHitData& HitReaction = GetImpactCacheEntry(OtherActor).HitReaction;
 
 	if (IsValid(HitReaction.HitParticleFx))
 	{
-		UNiagaraFunctionLibrary::SpawnSystemAtLocation(GetWorld(), HitReaction.HitParticleFx,
+		UParticleFxUtils::SpawnParticleFx(OtherActor, HitReaction.HitParticleFx,
 			HitResult.Location + HitReaction.HitParticleFxTransform.GetLocation(),
 			HitReaction.HitParticleFxTransform.Rotator(), HitReaction.HitParticleFxTransform.GetScale3D());
 	}
@@ -112,24 +258,64 @@ void AWeaponProjectile::ProcessHitReaction(AActor* OtherActor, const FHitResult&
  * @param OtherActor The actor that was hit
  * @param HitResult The result describing the hit
  */
-void AWeaponProjectile::SpawnDecal(const AActor* OtherActor, const FHitResult& HitResult)
+void AWeaponProjectile::SpawnDecal(const AActor* OtherActor, const FHitResult& HitResult) const
 {
-	TSubclassOf<AWeaponProjectileDecal> Decal = DefaultDecal;
-	for (const TTuple<TSubclassOf<AActor>, TSubclassOf<AWeaponProjectileDecal>> DecalData : Decals)
+	const TSubclassOf<AWeaponProjectileDecal>& Decal = GetImpactCacheEntry(OtherActor).Decal;
+
+	if (!IsValid(Decal))
+	{
+		return;
+	}
+
+	USK_LOG_TRACE("Spawning projectile decal");
+	const FTransform DecalTransform = FTransform(HitResult.ImpactNormal.Rotation(), HitResult.ImpactPoint);
+	UWorld* World = OtherActor->GetWorld();
+	UWeaponProjectileDecalSubsystem* DecalSubsystem = World->GetSubsystem<UWeaponProjectileDecalSubsystem>();
+	if (IsValid(DecalSubsystem))
 	{
-		if (OtherActor->IsA(DecalData.Key))
+		DecalSubsystem->SpawnDecal(Decal, DecalTransform);
+		return;
+	}
+
+	World->SpawnActor<AWeaponProjectileDecal>(Decal, DecalTransform);
+}
+
+/**
+ * @brief Get the hit reaction and decal used for an actor, resolving them if they are not cached yet
+ * @param OtherActor The actor that was hit
+ * @return The hit reaction and decal used for the actor
+ */
+const FWeaponProjectileImpactCacheEntry& AWeaponProjectile::GetImpactCacheEntry(const AActor* OtherActor) const
+{
+	// The impacts are resolved once per projectile class and shared by all the projectiles of the class
+	const AWeaponProjectile* CacheOwner = bOwnsImpactCache ? this : GetClass()->GetDefaultObject<AWeaponProjectile>();
+	const UClass* OtherClass = OtherActor->GetClass();
+	if (const FWeaponProjectileImpactCacheEntry* CachedEntry = CacheOwner->ImpactCache.Find(OtherClass))
+	{
+		return *CachedEntry;
+	}
+
+	FWeaponProjectileImpactCacheEntry Entry;
+	Entry.HitReaction = CacheOwner->DefaultHitReaction;
+	for (const TPair<TSubclassOf<AActor>, FWeaponProjectileHitData>& HitReactionData : CacheOwner->HitReactions)
+	{
+		if (OtherClass->IsChildOf(HitReactionData.Key))
 		{
-			Decal = DecalData.Value;
+			Entry.HitReaction = HitReactionData.Value;
 			break;
 		}
 	}
 
-	if (!IsValid(Decal))
+	Entry.Decal = CacheOwner->DefaultDecal;
+	for (const TPair<TSubclassOf<AActor>, TSubclassOf<AWeaponProjectileDecal>>& DecalData : CacheOwner->Decals)
 	{
-		return;
+		if (OtherClass->IsChildOf(DecalData.Key))
+		{
+			Entry.Decal = DecalData.Value;
+			break;
+		}
 	}
 
-	USK_LOG_TRACE("Spawning projectile decal");
-	const FTransform DecalTransform = FTransform(HitResult.ImpactNormal.Rotation(), HitResult.ImpactPoint);
-	GetWorld()->SpawnActor<AWeaponProjectileDecal>(Decal, DecalTransform);
+	USK_LOG_TRACE(*FString::Format(TEXT("Cached projectile impact for {0}"), { OtherClass->GetName() }));
+	return CacheOwner->ImpactCache.Add(OtherClass, Entry);
 }
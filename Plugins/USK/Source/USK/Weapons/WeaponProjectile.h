@@ -5,7 +5,10 @@
 #include "CoreMinimal.h"
 #include "WeaponProjectileDecal.h"
 #include "WeaponProjectileHitData.h"
+#include "WeaponProjectileImpactCacheEntry.h"
+#include "Engine/StaticMesh.h"
 #include "GameFramework/Actor.h"
+#include "Materials/MaterialInterface.h"
 #include "WeaponProjectile.generated.h"
 
 /**
@@ -65,7 +68,40 @@ public:
 	 * @brief A list of decals for specific actors
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile|Decals")
-	TMap<TSubclassOf<AWeaponProjectileDecal>, TSubclassOf<AWeaponProjectileDecal>> Decals;
+	TMap<TSubclassOf<AActor>, TSubclassOf<AWeaponProjectileDecal>> Decals;
+
+	/**
+	 * @brief Should the projectile be reused by the projectile pool instead of being destroyed?
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile|Pooling")
+	bool bEnablePooling = true;
+
+	/**
+	 * @brief The amount of projectiles created in advance when a weapon using the projectile is spawned
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile|Pooling",
+		meta=(EditCondition = "bEnablePooling", EditConditionHides))
+	int PoolSize = 10;
+
+	/**
+	 * @brief Should the projectile be simulated by the projectile simulation subsystem instead of spawning an actor?
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile|Lightweight")
+	bool bLightweight = false;
+
+	/**
+	 * @brief The mesh used to draw the projectile when it is simulated as a lightweight projectile
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile|Lightweight",
+		meta=(EditCondition = "bLightweight", EditConditionHides))
+	UStaticMesh* LightweightMesh;
+
+	/**
+	 * @brief The material override used to draw the projectile when it is simulated as a lightweight projectile
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile|Lightweight",
+		meta=(EditCondition = "bLightweight", EditConditionHides))
+	UMaterialInterface* LightweightMaterial;
 	
 	/**
 	 * @brief Create a new instance of the AWeaponProjectile actor
@@ -86,9 +122,79 @@ public:
 	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon Projectile")
 	UProjectileMovementComponent* GetProjectileMovementComponent() const;
 
+	/**
+	 * @brief Apply the impulse, hit reaction and decal of the projectile to the actor that was hit
+	 * @param OtherActor The actor that was hit
+	 * @param OtherComponent The component that was hit
+	 * @param Velocity The velocity of the projectile at the time of the hit
+	 * @param HitResult Result describing the hit
+	 */
+	void ApplyHit(AActor* OtherActor, UPrimitiveComponent* OtherComponent, const FVector& Velocity,
+		const FHitResult& HitResult) const;
+
+	/**
+	 * @brief Clear the cached hit reactions and decals. Call this after changing the hit reactions or decals at runtime
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon Projectile")
+	void InvalidateImpactCache();
+
+	/**
+	 * @brief Clear the impact caches of the class default objects, which apply the hits of hitscan and lightweight
+	 * projectiles and outlive the world
+	 */
+	static void InvalidateDefaultImpactCaches();
+
+	/**
+	 * @brief Destroy the projectile or return it to the projectile pool
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon Projectile")
+	void DestroyProjectile();
+
+	/**
+	 * @brief Activate the projectile after it was taken from the projectile pool
+	 * @param SpawnTransform The transform of the projectile
+	 */
+	void ActivateProjectile(const FTransform& SpawnTransform);
+
+	/**
+	 * @brief Deactivate the projectile before it is returned to the projectile pool
+	 */
+	void DeactivateProjectile();
+
+	/**
+	 * @brief Check if the projectile is owned by the projectile pool
+	 * @return A boolean value indicating if the projectile is owned by the projectile pool
+	 */
+	bool IsPooled() const;
+
+	/**
+	 * @brief Set whether the projectile is owned by the projectile pool
+	 * @param bPooled Is the projectile owned by the projectile pool?
+	 */
+	void SetPooled(bool bPooled);
+
+#if WITH_EDITOR
+	/**
+	 * @brief Called when a property on this object has been modified externally
+	 * @param PropertyChangedEvent The event containing information about the property that was changed
+	 */
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
 protected:
 	/**
-	 * @brief Called after the projectile hits something
+	 * @brief Called when the lifespan of the projectile expires
+	 */
+	virtual void LifeSpanExpired() override;
+
+	/**
+	 * @brief Called after the projectile was taken from the projectile pool and reset
+	 */
+	UFUNCTION(BlueprintNativeEvent, Category = "Ultimate Starter Kit|Weapon Projectile")
+	void OnProjectileReset();
+
+	/**
+	 * @brief Called after the projectile hits something. Not called for lightweight projectiles
 	 * @param HitComponent The component responsible for the hit
 	 * @param OtherActor The actor that was hit
 	 * @param OtherComponent The component that was hit
@@ -104,12 +210,36 @@ protected:
 	 * @param OtherActor The actor that was hit
 	 * @param HitResult The result describing the hit
 	 */
-	void ProcessHitReaction(AActor* OtherActor, const FHitResult& HitResult);
+	void ProcessHitReaction(AActor* OtherActor, const FHitResult& HitResult) const;
 
 	/**
 	 * @brief Spawn a decal at the hit location
 	 * @param OtherActor The actor that was hit
 	 * @param HitResult The result describing the hit
 	 */
-	void SpawnDecal(const AActor* OtherActor, const FHitResult& HitResult);
+	void SpawnDecal(const AActor* OtherActor, const FHitResult& HitResult) const;
+
+	/**
+	 * @brief Get the hit reaction and decal used for an actor, resolving them if they are not cached yet
+	 * @param OtherActor The actor that was hit
+	 * @return The hit reaction and decal used for the actor
+	 */
+	const FWeaponProjectileImpactCacheEntry& GetImpactCacheEntry(const AActor* OtherActor) const;
+
+private:
+	/**
+	 * @brief Is the projectile owned by the projectile pool?
+	 */
+	bool bIsPooled = false;
+
+	/**
+	 * @brief Does the projectile resolve its own hit reactions and decals instead of using the cache of its class?
+	 */
+	bool bOwnsImpactCache = false;
+
+	/**
+	 * @brief The hit reaction and decal resolved for each class of actor that was hit. Only the class default object
+	 * fills this cache unless the hit reactions or decals of the projectile were changed at runtime
+	 */
+	mutable TMap<const UClass*, FWeaponProjectileImpactCacheEntry> ImpactCache;
 };
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "WeaponProjectile.h"
+#include "Engine/EngineTypes.h"
 #include "WeaponProjectileData.generated.h"
 
 /**
@@ -24,4 +25,24 @@ struct USK_API FWeaponProjectileData
 	 */
 	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile")
 	FTransform SpawnTransform;
+
+	/**
+	 * @brief Should the projectile hit instantly using a line trace instead of spawning a projectile actor?
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile|Hitscan")
+	bool bHitscan = false;
+
+	/**
+	 * @brief The maximum distance of the line trace
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile|Hitscan",
+		meta=(EditCondition = "bHitscan", EditConditionHides))
+	float HitscanRange = 10000.0f;
+
+	/**
+	 * @brief The collision channel used by the line trace
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile|Hitscan",
+		meta=(EditCondition = "bHitscan", EditConditionHides))
+	TEnumAsByte<ECollisionChannel> HitscanTraceChannel = ECC_Visibility;
 };
\ No newline at end of file
@@ -2,15 +2,16 @@
 
 #include "WeaponProjectileDecal.h"
 
-#include "Kismet/KismetSystemLibrary.h"
+#include "WeaponProjectileDecalSubsystem.h"
+#include "Engine/World.h"
 #include "USK/Logger/Log.h"
 
 /**
- * @brief Create a new instance of the AWeaponProjectile actor
+ * @brief Create a new instance of the AWeaponProjectileDecal actor
  */
 AWeaponProjectileDecal::AWeaponProjectileDecal()
 {
-	PrimaryActorTick.bCanEverTick = true;
+	PrimaryActorTick.bCanEverTick = false;
 }
 
 /**
@@ -21,8 +22,12 @@ void AWeaponProjectileDecal::BeginPlay()
 	Super::BeginPlay();
 	if (bAutomaticallyDestroy && Lifetime > 0.0f)
 	{
-		USK_LOG_TRACE("Starting projectile decal destruction timer");
-		UKismetSystemLibrary::K2_SetTimer(this, "DestroyDecal", Lifetime, false);
+		UWeaponProjectileDecalSubsystem* DecalSubsystem = GetWorld()->GetSubsystem<UWeaponProjectileDecalSubsystem>();
+		if (IsValid(DecalSubsystem))
+		{
+			USK_LOG_TRACE("Registering projectile decal with the decal subsystem");
+			DecalSubsystem->RegisterDecalActor(this);
+		}
 	}
 }
 
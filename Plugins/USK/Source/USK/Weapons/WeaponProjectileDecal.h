@@ -28,19 +28,31 @@ public:
 	float Lifetime = 10.0f;
 
 	/**
-	 * @brief Create a new instance of the AWeaponProjectile actor
+	 * @brief The amount of time it takes to fade out the decal after it expired or was removed to stay within budget
 	 */
-	AWeaponProjectileDecal();
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile Decal")
+	float FadeDuration = 0.5f;
 
-protected:
 	/**
-	 * @brief Overridable native event for when play begins for this actor
+	 * @brief Should the decal component of this actor be drawn by the decal subsystem instead of spawning the actor?
 	 */
-	virtual void BeginPlay() override;
+	UPROPERTY(EditAnywhere, BlueprintReadWrite, Category = "Ultimate Starter Kit|Weapon Projectile Decal")
+	bool bUseDecalSubsystem = true;
+
+	/**
+	 * @brief Create a new instance of the AWeaponProjectileDecal actor
+	 */
+	AWeaponProjectileDecal();
 
 	/**
 	 * @brief Destroy the decal actor
 	 */
 	UFUNCTION(BlueprintCallable, BlueprintNativeEvent, Category = "Ultimate Starter Kit|Weapon Projectile Decal")
 	void DestroyDecal();
+
+protected:
+	/**
+	 * @brief Overridable native event for when play begins for this actor
+	 */
+	virtual void BeginPlay() override;
 };
\ No newline at end of file
@@ -0,0 +1,23 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponProjectileDecalEvictionPolicy.generated.h"
+
+/**
+ * @brief The policies used to decide which decal is removed when the decal budget is reached
+ */
+UENUM(BlueprintType)
+enum class EWeaponProjectileDecalEvictionPolicy : uint8
+{
+	/**
+	 * @brief Remove the decal that was spawned first
+	 */
+	OldestFirst,
+
+	/**
+	 * @brief Remove the decal that is the farthest away from the camera
+	 */
+	FarthestFirst,
+};
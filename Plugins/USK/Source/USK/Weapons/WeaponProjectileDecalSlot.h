@@ -0,0 +1,38 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponProjectileDecalSlot.generated.h"
+
+class UDecalComponent;
+
+/**
+ * @brief Structure describing a decal component owned by the decal subsystem
+ */
+USTRUCT()
+struct FWeaponProjectileDecalSlot
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The decal component drawn in the slot
+	 */
+	UPROPERTY()
+	UDecalComponent* Component = nullptr;
+
+	/**
+	 * @brief The world time at which the decal expires, or zero if the decal never expires
+	 */
+	float ExpireTime = 0.0f;
+
+	/**
+	 * @brief The amount of time it takes to fade out the decal
+	 */
+	float FadeDuration = 0.0f;
+
+	/**
+	 * @brief Is the slot currently drawing a decal?
+	 */
+	bool bIsActive = false;
+};
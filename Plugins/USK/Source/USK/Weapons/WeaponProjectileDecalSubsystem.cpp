@@ -0,0 +1,482 @@
+﻿// Created by Henry Jooste
+
+#include "WeaponProjectileDecalSubsystem.h"
+
+#include "Components/DecalComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/PlayerController.h"
+#include "Camera/PlayerCameraManager.h"
+#include "USK/Core/USKGameInstance.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Check if the subsystem should be created for the world
+ * @param Outer The world that owns the subsystem
+ * @return A boolean value indicating if the subsystem should be created
+ */
+bool UWeaponProjectileDecalSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return Super::ShouldCreateSubsystem(Outer) && IsValid(World) && World->IsGameWorld();
+}
+
+/**
+ * @brief Remove all the decals when the world is torn down
+ */
+void UWeaponProjectileDecalSubsystem::Deinitialize()
+{
+	if (IsValid(DecalOwner))
+	{
+		DecalOwner->Destroy();
+	}
+
+	DecalOwner = nullptr;
+	Slots.Empty();
+	FadingDecals.Empty();
+	FreeComponents.Empty();
+	DecalActors.Empty();
+	DecalActorExpireTimes.Empty();
+	Templates.Empty();
+	Super::Deinitialize();
+}
+
+/**
+ * @brief Expire and fade out the decals
+ * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+ */
+void UWeaponProjectileDecalSubsystem::Tick(float DeltaTime)
+{
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	for (int i = FadingDecals.Num() - 1; i >= 0; i--)
+	{
+		if (CurrentTime >= FadingDecals[i].ExpireTime)
+		{
+			ReleaseComponent(FadingDecals[i].Component);
+			FadingDecals.RemoveAtSwap(i);
+		}
+	}
+
+	if (ActiveDecalCount > 0 && CurrentTime >= NextExpireTime)
+	{
+		NextExpireTime = MAX_flt;
+		for (int i = 0; i < Slots.Num(); i++)
+		{
+			if (!Slots[i].bIsActive || Slots[i].ExpireTime <= 0.0f)
+			{
+				continue;
+			}
+
+			if (CurrentTime >= Slots[i].ExpireTime)
+			{
+				EvictSlot(i);
+				continue;
+			}
+
+			NextExpireTime = FMath::Min(NextExpireTime, Slots[i].ExpireTime);
+		}
+	}
+
+	ExpireDecalActors(CurrentTime);
+}
+
+/**
+ * @brief Check if the subsystem should be ticked
+ * @return A boolean value indicating if the subsystem should be ticked
+ */
+bool UWeaponProjectileDecalSubsystem::IsTickable() const
+{
+	return ActiveDecalCount > 0 || FadingDecals.Num() > 0 || DecalActors.Num() > 0;
+}
+
+/**
+ * @brief Get the tick type of the subsystem
+ * @return The tick type of the subsystem
+ */
+ETickableTickType UWeaponProjectileDecalSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+/**
+ * @brief Get the world the subsystem is ticked in
+ * @return The world the subsystem is ticked in
+ */
+UWorld* UWeaponProjectileDecalSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/**
+ * @brief Get the stat ID used to profile the subsystem
+ * @return The stat ID used to profile the subsystem
+ */
+TStatId UWeaponProjectileDecalSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWeaponProjectileDecalSubsystem, STATGROUP_Tickables);
+}
+
+/**
+ * @brief Spawn a projectile decal
+ * @param DecalClass The class of the decal
+ * @param DecalTransform The transform of the decal
+ */
+void UWeaponProjectileDecalSubsystem::SpawnDecal(const TSubclassOf<AWeaponProjectileDecal> DecalClass,
+	const FTransform& DecalTransform)
+{
+	if (!IsValid(DecalClass))
+	{
+		return;
+	}
+
+	if (!bIsConfigured)
+	{
+		Configure();
+	}
+
+	FVector ViewLocation;
+	if (CullDistance > 0.0f && GetViewLocation(ViewLocation) &&
+		FVector::DistSquared(ViewLocation, DecalTransform.GetLocation()) > FMath::Square(CullDistance))
+	{
+		USK_LOG_TRACE("Projectile decal culled");
+		return;
+	}
+
+	const FWeaponProjectileDecalTemplate& Template = GetTemplate(DecalClass);
+	if (!Template.bIsValid)
+	{
+		USK_LOG_TRACE("Spawning projectile decal actor");
+		GetWorld()->SpawnActor<AWeaponProjectileDecal>(DecalClass, DecalTransform);
+		return;
+	}
+
+	if (Slots.Num() == 0)
+	{
+		return;
+	}
+
+	const int SlotIndex = FindSlot();
+	if (Slots[SlotIndex].bIsActive)
+	{
+		EvictSlot(SlotIndex);
+	}
+
+	UDecalComponent* Component = GetFreeComponent();
+	if (!IsValid(Component))
+	{
+		USK_LOG_ERROR("Unable to spawn projectile decal. Failed to create decal component");
+		return;
+	}
+
+	Component->SetDecalMaterial(Template.DecalMaterial);
+	Component->DecalSize = Template.DecalSize;
+	Component->SortOrder = Template.SortOrder;
+	Component->FadeScreenSize = Template.FadeScreenSize;
+	Component->SetFadeOut(0.0f, 0.0f, false);
+	Component->SetWorldTransform(Template.RelativeTransform * DecalTransform);
+	Component->SetVisibility(true);
+	Component->MarkRenderStateDirty();
+
+	const float CurrentTime = GetWorld()->GetTimeSeconds();
+	FWeaponProjectileDecalSlot& Slot = Slots[SlotIndex];
+	Slot.Component = Component;
+	Slot.ExpireTime = Template.Lifetime > 0.0f ? CurrentTime + Template.Lifetime : 0.0f;
+	Slot.FadeDuration = Template.FadeDuration;
+	Slot.bIsActive = true;
+
+	if (Slot.ExpireTime > 0.0f)
+	{
+		NextExpireTime = ActiveDecalCount > 0 ? FMath::Min(NextExpireTime, Slot.ExpireTime) : Slot.ExpireTime;
+	}
+
+	ActiveDecalCount++;
+	NextSlot = (SlotIndex + 1) % Slots.Num();
+}
+
+/**
+ * @brief Remove all the decals that are currently drawn
+ */
+void UWeaponProjectileDecalSubsystem::ClearDecals()
+{
+	for (FWeaponProjectileDecalSlot& Slot : Slots)
+	{
+		if (Slot.bIsActive)
+		{
+			ReleaseComponent(Slot.Component);
+		}
+
+		Slot = FWeaponProjectileDecalSlot();
+	}
+
+	for (const FWeaponProjectileDecalSlot& FadingDecal : FadingDecals)
+	{
+		ReleaseComponent(FadingDecal.Component);
+	}
+
+	FadingDecals.Empty();
+	ActiveDecalCount = 0;
+	NextSlot = 0;
+}
+
+/**
+ * @brief Get the amount of decals that are currently drawn
+ * @return The amount of decals that are currently drawn
+ */
+int UWeaponProjectileDecalSubsystem::GetActiveDecalCount() const
+{
+	return ActiveDecalCount + FadingDecals.Num() + DecalActors.Num();
+}
+
+/**
+ * @brief Register a decal actor that should be destroyed after its lifetime expires
+ * @param DecalActor The decal actor
+ */
+void UWeaponProjectileDecalSubsystem::RegisterDecalActor(AWeaponProjectileDecal* DecalActor)
+{
+	if (!IsValid(DecalActor))
+	{
+		return;
+	}
+
+	DecalActors.Add(DecalActor);
+	DecalActorExpireTimes.Add(GetWorld()->GetTimeSeconds() + DecalActor->Lifetime);
+}
+
+/**
+ * @brief Read the decal budget from the game instance and create the decal slots
+ */
+void UWeaponProjectileDecalSubsystem::Configure()
+{
+	const UUSKGameInstance* GameInstance = Cast<UUSKGameInstance>(GetWorld()->GetGameInstance());
+	if (IsValid(GameInstance))
+	{
+		MaxDecals = GameInstance->MaxWeaponProjectileDecals;
+		EvictionPolicy = GameInstance->WeaponProjectileDecalEvictionPolicy;
+		CullDistance = GameInstance->WeaponProjectileDecalCullDistance;
+	}
+	else
+	{
+		USK_LOG_WARNING("GameInstance is not UUSKGameInstance. Using the default projectile decal budget");
+	}
+
+	Slots.SetNum(FMath::Max(MaxDecals, 0));
+	FreeComponents.Reserve(Slots.Num());
+	bIsConfigured = true;
+}
+
+/**
+ * @brief Get the appearance of a decal class
+ * @param DecalClass The class of the decal
+ * @return The appearance of the decal class
+ */
+const FWeaponProjectileDecalTemplate& UWeaponProjectileDecalSubsystem::GetTemplate(
+	const TSubclassOf<AWeaponProjectileDecal> DecalClass)
+{
+	if (const FWeaponProjectileDecalTemplate* ExistingTemplate = Templates.Find(DecalClass))
+	{
+		return *ExistingTemplate;
+	}
+
+	FWeaponProjectileDecalTemplate Template;
+	const AWeaponProjectileDecal* DefaultDecal = DecalClass->GetDefaultObject<AWeaponProjectileDecal>();
+	Template.Lifetime = DefaultDecal->bAutomaticallyDestroy ? DefaultDecal->Lifetime : 0.0f;
+	Template.FadeDuration = DefaultDecal->FadeDuration;
+
+	if (DefaultDecal->bUseDecalSubsystem)
+	{
+		// Components added in Blueprints only exist on spawned instances, so the appearance is copied from one
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		AWeaponProjectileDecal* TemplateActor = GetWorld()->SpawnActor<AWeaponProjectileDecal>(DecalClass,
+			FTransform::Identity, SpawnParams);
+
+		const UDecalComponent* DecalComponent = IsValid(TemplateActor)
+			? TemplateActor->FindComponentByClass<UDecalComponent>()
+			: nullptr;
+
+		if (IsValid(DecalComponent))
+		{
+			Template.DecalMaterial = DecalComponent->GetDecalMaterial();
+			Template.DecalSize = DecalComponent->DecalSize;
+			Template.SortOrder = DecalComponent->SortOrder;
+			Template.FadeScreenSize = DecalComponent->FadeScreenSize;
+			Template.RelativeTransform = DecalComponent->GetComponentTransform().GetRelativeTransform(
+				TemplateActor->GetActorTransform());
+			Template.bIsValid = true;
+		}
+		else
+		{
+			USK_LOG_WARNING(*FString::Format(TEXT("{0} has no decal component. Spawning decal actors instead"),
+				{ DecalClass->GetName() }));
+		}
+
+		if (IsValid(TemplateActor))
+		{
+			TemplateActor->Destroy();
+		}
+	}
+
+	return Templates.Add(DecalClass, Template);
+}
+
+/**
+ * @brief Get the location of the camera used for culling and eviction
+ * @param ViewLocation The location of the camera
+ * @return A boolean value indicating if a camera was found
+ */
+bool UWeaponProjectileDecalSubsystem::GetViewLocation(FVector& ViewLocation) const
+{
+	const APlayerController* PlayerController = GetWorld()->GetFirstPlayerController();
+	if (!IsValid(PlayerController) || !IsValid(PlayerController->PlayerCameraManager))
+	{
+		return false;
+	}
+
+	ViewLocation = PlayerController->PlayerCameraManager->GetCameraLocation();
+	return true;
+}
+
+/**
+ * @brief Find the slot that should be used for a new decal
+ * @return The index of the slot
+ */
+int UWeaponProjectileDecalSubsystem::FindSlot() const
+{
+	if (ActiveDecalCount < Slots.Num())
+	{
+		for (int i = 0; i < Slots.Num(); i++)
+		{
+			const int SlotIndex = (NextSlot + i) % Slots.Num();
+			if (!Slots[SlotIndex].bIsActive)
+			{
+				return SlotIndex;
+			}
+		}
+	}
+
+	FVector ViewLocation;
+	if (EvictionPolicy != EWeaponProjectileDecalEvictionPolicy::FarthestFirst || !GetViewLocation(ViewLocation))
+	{
+		return NextSlot;
+	}
+
+	int FarthestSlot = NextSlot;
+	float FarthestDistance = -1.0f;
+	for (int i = 0; i < Slots.Num(); i++)
+	{
+		if (!IsValid(Slots[i].Component))
+		{
+			continue;
+		}
+
+		const float Distance = FVector::DistSquared(ViewLocation, Slots[i].Component->GetComponentLocation());
+		if (Distance > FarthestDistance)
+		{
+			FarthestSlot = i;
+			FarthestDistance = Distance;
+		}
+	}
+
+	return FarthestSlot;
+}
+
+/**
+ * @brief Stop drawing the decal in a slot and start fading it out
+ * @param SlotIndex The index of the slot
+ */
+void UWeaponProjectileDecalSubsystem::EvictSlot(const int SlotIndex)
+{
+	FWeaponProjectileDecalSlot& Slot = Slots[SlotIndex];
+	if (!Slot.bIsActive)
+	{
+		return;
+	}
+
+	if (Slot.FadeDuration > 0.0f && IsValid(Slot.Component))
+	{
+		// The decal component destroys itself after fading by default, but we want to keep it for reuse
+		Slot.Component->SetFadeOut(0.0f, Slot.FadeDuration, false);
+		Slot.Component->SetLifeSpan(0.0f);
+
+		FWeaponProjectileDecalSlot& FadingDecal = FadingDecals.AddDefaulted_GetRef();
+		FadingDecal.Component = Slot.Component;
+		FadingDecal.ExpireTime = GetWorld()->GetTimeSeconds() + Slot.FadeDuration;
+	}
+	else
+	{
+		ReleaseComponent(Slot.Component);
+	}
+
+	Slot = FWeaponProjectileDecalSlot();
+	ActiveDecalCount--;
+}
+
+/**
+ * @brief Get a decal component that is not used
+ * @return The decal component
+ */
+UDecalComponent* UWeaponProjectileDecalSubsystem::GetFreeComponent()
+{
+	while (FreeComponents.Num() > 0)
+	{
+		UDecalComponent* Component = FreeComponents.Pop(false);
+		if (IsValid(Component))
+		{
+			return Component;
+		}
+	}
+
+	if (!IsValid(DecalOwner))
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		DecalOwner = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!IsValid(DecalOwner))
+		{
+			return nullptr;
+		}
+	}
+
+	UDecalComponent* Component = NewObject<UDecalComponent>(DecalOwner);
+	Component->SetVisibility(false);
+	Component->RegisterComponent();
+	return Component;
+}
+
+/**
+ * @brief Hide a decal component and make it available for reuse
+ * @param Component The decal component
+ */
+void UWeaponProjectileDecalSubsystem::ReleaseComponent(UDecalComponent* Component)
+{
+	if (!IsValid(Component))
+	{
+		return;
+	}
+
+	Component->SetVisibility(false);
+	FreeComponents.Add(Component);
+}
+
+/**
+ * @brief Destroy the decal actors whose lifetime expired
+ * @param CurrentTime The current world time
+ */
+void UWeaponProjectileDecalSubsystem::ExpireDecalActors(const float CurrentTime)
+{
+	for (int i = DecalActors.Num() - 1; i >= 0; i--)
+	{
+		const bool bIsDecalValid = IsValid(DecalActors[i]);
+		if (bIsDecalValid && CurrentTime < DecalActorExpireTimes[i])
+		{
+			continue;
+		}
+
+		if (bIsDecalValid)
+		{
+			DecalActors[i]->DestroyDecal();
+		}
+
+		DecalActors.RemoveAtSwap(i);
+		DecalActorExpireTimes.RemoveAtSwap(i);
+	}
+}
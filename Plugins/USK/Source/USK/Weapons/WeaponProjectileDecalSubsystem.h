@@ -0,0 +1,217 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "WeaponProjectileDecal.h"
+#include "WeaponProjectileDecalEvictionPolicy.h"
+#include "WeaponProjectileDecalSlot.h"
+#include "WeaponProjectileDecalTemplate.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WeaponProjectileDecalSubsystem.generated.h"
+
+/**
+ * @brief World subsystem that draws projectile decals using a fixed budget of recycled decal components
+ */
+UCLASS()
+class USK_API UWeaponProjectileDecalSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Check if the subsystem should be created for the world
+	 * @param Outer The world that owns the subsystem
+	 * @return A boolean value indicating if the subsystem should be created
+	 */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/**
+	 * @brief Remove all the decals when the world is torn down
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Expire and fade out the decals
+	 * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * @brief Check if the subsystem should be ticked
+	 * @return A boolean value indicating if the subsystem should be ticked
+	 */
+	virtual bool IsTickable() const override;
+
+	/**
+	 * @brief Get the tick type of the subsystem
+	 * @return The tick type of the subsystem
+	 */
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	/**
+	 * @brief Get the world the subsystem is ticked in
+	 * @return The world the subsystem is ticked in
+	 */
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/**
+	 * @brief Get the stat ID used to profile the subsystem
+	 * @return The stat ID used to profile the subsystem
+	 */
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Spawn a projectile decal
+	 * @param DecalClass The class of the decal
+	 * @param DecalTransform The transform of the decal
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon Projectile Decal")
+	void SpawnDecal(TSubclassOf<AWeaponProjectileDecal> DecalClass, const FTransform& DecalTransform);
+
+	/**
+	 * @brief Remove all the decals that are currently drawn
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon Projectile Decal")
+	void ClearDecals();
+
+	/**
+	 * @brief Get the amount of decals that are currently drawn
+	 * @return The amount of decals that are currently drawn
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon Projectile Decal")
+	int GetActiveDecalCount() const;
+
+	/**
+	 * @brief Register a decal actor that should be destroyed after its lifetime expires
+	 * @param DecalActor The decal actor
+	 */
+	void RegisterDecalActor(AWeaponProjectileDecal* DecalActor);
+
+private:
+	/**
+	 * @brief The actor that owns the decal components
+	 */
+	UPROPERTY()
+	AActor* DecalOwner;
+
+	/**
+	 * @brief The ring buffer of decal slots
+	 */
+	UPROPERTY()
+	TArray<FWeaponProjectileDecalSlot> Slots;
+
+	/**
+	 * @brief The decals that were evicted or expired and are currently fading out
+	 */
+	UPROPERTY()
+	TArray<FWeaponProjectileDecalSlot> FadingDecals;
+
+	/**
+	 * @brief The decal components that are not used
+	 */
+	UPROPERTY()
+	TArray<UDecalComponent*> FreeComponents;
+
+	/**
+	 * @brief The decal actors waiting for their lifetime to expire
+	 */
+	UPROPERTY()
+	TArray<AWeaponProjectileDecal*> DecalActors;
+
+	/**
+	 * @brief The world time at which each of the decal actors expires
+	 */
+	TArray<float> DecalActorExpireTimes;
+
+	/**
+	 * @brief The appearance of each decal class
+	 */
+	UPROPERTY()
+	TMap<TSubclassOf<AWeaponProjectileDecal>, FWeaponProjectileDecalTemplate> Templates;
+
+	/**
+	 * @brief The index of the next slot in the ring buffer
+	 */
+	int NextSlot;
+
+	/**
+	 * @brief The amount of slots that are currently drawing a decal
+	 */
+	int ActiveDecalCount;
+
+	/**
+	 * @brief The earliest world time at which a decal expires
+	 */
+	float NextExpireTime;
+
+	/**
+	 * @brief The maximum amount of decals drawn at the same time
+	 */
+	int MaxDecals = 100;
+
+	/**
+	 * @brief The policy used to decide which decal is removed when the budget is reached
+	 */
+	EWeaponProjectileDecalEvictionPolicy EvictionPolicy = EWeaponProjectileDecalEvictionPolicy::OldestFirst;
+
+	/**
+	 * @brief The maximum distance from the camera at which decals are spawned, or zero to disable culling
+	 */
+	float CullDistance = 5000.0f;
+
+	/**
+	 * @brief Has the budget been read from the game instance?
+	 */
+	bool bIsConfigured;
+
+	/**
+	 * @brief Read the decal budget from the game instance and create the decal slots
+	 */
+	void Configure();
+
+	/**
+	 * @brief Get the appearance of a decal class
+	 * @param DecalClass The class of the decal
+	 * @return The appearance of the decal class
+	 */
+	const FWeaponProjectileDecalTemplate& GetTemplate(TSubclassOf<AWeaponProjectileDecal> DecalClass);
+
+	/**
+	 * @brief Get the location of the camera used for culling and eviction
+	 * @param ViewLocation The location of the camera
+	 * @return A boolean value indicating if a camera was found
+	 */
+	bool GetViewLocation(FVector& ViewLocation) const;
+
+	/**
+	 * @brief Find the slot that should be used for a new decal
+	 * @return The index of the slot
+	 */
+	int FindSlot() const;
+
+	/**
+	 * @brief Stop drawing the decal in a slot and start fading it out
+	 * @param SlotIndex The index of the slot
+	 */
+	void EvictSlot(int SlotIndex);
+
+	/**
+	 * @brief Get a decal component that is not used
+	 * @return The decal component
+	 */
+	UDecalComponent* GetFreeComponent();
+
+	/**
+	 * @brief Hide a decal component and make it available for reuse
+	 * @param Component The decal component
+	 */
+	void ReleaseComponent(UDecalComponent* Component);
+
+	/**
+	 * @brief Destroy the decal actors whose lifetime expired
+	 * @param CurrentTime The current world time
+	 */
+	void ExpireDecalActors(float CurrentTime);
+};
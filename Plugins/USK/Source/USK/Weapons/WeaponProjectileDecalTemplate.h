@@ -0,0 +1,58 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponProjectileDecalTemplate.generated.h"
+
+class UMaterialInterface;
+
+/**
+ * @brief Structure describing the appearance of a decal class used by the decal subsystem
+ */
+USTRUCT()
+struct FWeaponProjectileDecalTemplate
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The material used by the decal
+	 */
+	UPROPERTY()
+	UMaterialInterface* DecalMaterial = nullptr;
+
+	/**
+	 * @brief The size of the decal
+	 */
+	FVector DecalSize = FVector::OneVector;
+
+	/**
+	 * @brief The transform of the decal relative to the impact point
+	 */
+	FTransform RelativeTransform;
+
+	/**
+	 * @brief The sort order of the decal
+	 */
+	int SortOrder = 0;
+
+	/**
+	 * @brief The screen size at which the decal starts fading out
+	 */
+	float FadeScreenSize = 0.01f;
+
+	/**
+	 * @brief The lifetime of the decal, or zero if the decal is never removed automatically
+	 */
+	float Lifetime = 0.0f;
+
+	/**
+	 * @brief The amount of time it takes to fade out the decal
+	 */
+	float FadeDuration = 0.0f;
+
+	/**
+	 * @brief Can the decal be drawn by the decal subsystem?
+	 */
+	bool bIsValid = false;
+};
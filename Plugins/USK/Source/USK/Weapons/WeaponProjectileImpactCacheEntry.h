@@ -0,0 +1,24 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponProjectileDecal.h"
+#include "WeaponProjectileHitData.h"
+
+/**
+ * @brief The hit reaction and decal resolved for a single class of actor hit by a projectile.
+ * Both are copied so the entry stays valid when the hit reaction or decal maps of the projectile are modified
+ */
+struct FWeaponProjectileImpactCacheEntry
+{
+	/**
+	 * @brief The hit reaction used for the actor class
+	 */
+	FWeaponProjectileHitData HitReaction;
+
+	/**
+	 * @brief The decal used for the actor class
+	 */
+	TSubclassOf<AWeaponProjectileDecal> Decal;
+};
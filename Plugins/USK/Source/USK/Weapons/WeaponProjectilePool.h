@@ -0,0 +1,30 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponProjectilePoolStats.h"
+#include "WeaponProjectilePool.generated.h"
+
+class AWeaponProjectile;
+
+/**
+ * @brief The projectiles pooled for a single projectile class
+ */
+USTRUCT()
+struct FWeaponProjectilePool
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The deactivated projectiles waiting to be reused
+	 */
+	UPROPERTY()
+	TArray<AWeaponProjectile*> Available;
+
+	/**
+	 * @brief The usage statistics of the pool
+	 */
+	UPROPERTY()
+	FWeaponProjectilePoolStats Stats;
+};
@@ -0,0 +1,39 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponProjectilePoolStats.generated.h"
+
+/**
+ * @brief Structure describing the usage of a weapon projectile pool
+ */
+USTRUCT(BlueprintType)
+struct USK_API FWeaponProjectilePoolStats
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The amount of projectiles that were reused from the pool
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Weapon Projectile Pool")
+	int Hits = 0;
+
+	/**
+	 * @brief The amount of projectiles that had to be spawned because the pool was empty
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Weapon Projectile Pool")
+	int Misses = 0;
+
+	/**
+	 * @brief The amount of projectiles currently in use
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Weapon Projectile Pool")
+	int Active = 0;
+
+	/**
+	 * @brief The amount of projectiles waiting in the pool
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Weapon Projectile Pool")
+	int Available = 0;
+};
@@ -0,0 +1,208 @@
+﻿// Created by Henry Jooste
+
+#include "WeaponProjectilePoolSubsystem.h"
+
+#include "Engine/World.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Check if the subsystem should be created for the world
+ * @param Outer The world that owns the subsystem
+ * @return A boolean value indicating if the subsystem should be created
+ */
+bool UWeaponProjectilePoolSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return Super::ShouldCreateSubsystem(Outer) && IsValid(World) && World->IsGameWorld();
+}
+
+/**
+ * @brief Destroy the pooled projectiles when the world is torn down
+ */
+void UWeaponProjectilePoolSubsystem::Deinitialize()
+{
+	for (TTuple<TSubclassOf<AWeaponProjectile>, FWeaponProjectilePool>& Pool : Pools)
+	{
+		for (AWeaponProjectile* Projectile : Pool.Value.Available)
+		{
+			if (IsValid(Projectile))
+			{
+				Projectile->Destroy();
+			}
+		}
+	}
+
+	Pools.Empty();
+	Super::Deinitialize();
+}
+
+/**
+ * @brief Make sure the pool contains a minimum amount of projectiles of a specific class
+ * @param ProjectileClass The class of the projectiles
+ * @param Amount The amount of projectiles that should be available
+ */
+void UWeaponProjectilePoolSubsystem::Prewarm(const TSubclassOf<AWeaponProjectile> ProjectileClass, const int Amount)
+{
+	if (!IsValid(ProjectileClass) || !ProjectileClass->GetDefaultObject<AWeaponProjectile>()->bEnablePooling)
+	{
+		return;
+	}
+
+	FWeaponProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass);
+	const int AmountToSpawn = Amount - Pool.Stats.Available - Pool.Stats.Active;
+	if (AmountToSpawn <= 0)
+	{
+		return;
+	}
+
+	USK_LOG_TRACE(*FString::Format(TEXT("Prewarming {0} projectiles of class {1}"),
+		{ AmountToSpawn, ProjectileClass->GetName() }));
+
+	Pool.Available.Reserve(Pool.Available.Num() + AmountToSpawn);
+	for (int i = 0; i < AmountToSpawn; i++)
+	{
+		AWeaponProjectile* Projectile = SpawnPooledProjectile(ProjectileClass, FTransform::Identity);
+		if (!IsValid(Projectile))
+		{
+			break;
+		}
+
+		Projectile->DeactivateProjectile();
+		Pool.Available.Add(Projectile);
+	}
+
+	Pool.Stats.Available = Pool.Available.Num();
+}
+
+/**
+ * @brief Get a projectile from the pool, spawning a new one if the pool is empty
+ * @param ProjectileClass The class of the projectile
+ * @param SpawnTransform The transform of the projectile
+ * @return The activated projectile
+ */
+AWeaponProjectile* UWeaponProjectilePoolSubsystem::Acquire(const TSubclassOf<AWeaponProjectile> ProjectileClass,
+	const FTransform& SpawnTransform)
+{
+	if (!IsValid(ProjectileClass))
+	{
+		USK_LOG_ERROR("Unable to acquire projectile. Projectile class is not valid");
+		return nullptr;
+	}
+
+	if (!ProjectileClass->GetDefaultObject<AWeaponProjectile>()->bEnablePooling)
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+		return GetWorld()->SpawnActor<AWeaponProjectile>(ProjectileClass, SpawnTransform, SpawnParams);
+	}
+
+	FWeaponProjectilePool& Pool = Pools.FindOrAdd(ProjectileClass);
+	AWeaponProjectile* Projectile = nullptr;
+	while (Pool.Available.Num() > 0 && !IsValid(Projectile))
+	{
+		Projectile = Pool.Available.Pop(false);
+	}
+
+	if (IsValid(Projectile))
+	{
+		Pool.Stats.Hits++;
+	}
+	else
+	{
+		USK_LOG_TRACE(*FString::Format(TEXT("Projectile pool for {0} is empty"), { ProjectileClass->GetName() }));
+		Pool.Stats.Misses++;
+		Projectile = SpawnPooledProjectile(ProjectileClass, SpawnTransform);
+		if (!IsValid(Projectile))
+		{
+			USK_LOG_ERROR("Unable to acquire projectile. Failed to spawn projectile");
+			return nullptr;
+		}
+	}
+
+	Pool.Stats.Active++;
+	Pool.Stats.Available = Pool.Available.Num();
+	Projectile->ActivateProjectile(SpawnTransform);
+	return Projectile;
+}
+
+/**
+ * @brief Return a projectile to the pool
+ * @param Projectile The projectile to return
+ */
+void UWeaponProjectilePoolSubsystem::Release(AWeaponProjectile* Projectile)
+{
+	if (!IsValid(Projectile))
+	{
+		return;
+	}
+
+	if (!Projectile->IsPooled())
+	{
+		Projectile->Destroy();
+		return;
+	}
+
+	FWeaponProjectilePool& Pool = Pools.FindOrAdd(Projectile->GetClass());
+	if (Pool.Available.Contains(Projectile))
+	{
+		USK_LOG_WARNING("Projectile was already returned to the pool");
+		return;
+	}
+
+	Projectile->DeactivateProjectile();
+	Pool.Available.Add(Projectile);
+	Pool.Stats.Active = FMath::Max(Pool.Stats.Active - 1, 0);
+	Pool.Stats.Available = Pool.Available.Num();
+}
+
+/**
+ * @brief Get the usage statistics for a specific projectile class
+ * @param ProjectileClass The class of the projectiles
+ * @return The usage statistics of the pool
+ */
+FWeaponProjectilePoolStats UWeaponProjectilePoolSubsystem::GetStats(
+	const TSubclassOf<AWeaponProjectile> ProjectileClass) const
+{
+	const FWeaponProjectilePool* Pool = Pools.Find(ProjectileClass);
+	return Pool != nullptr ? Pool->Stats : FWeaponProjectilePoolStats();
+}
+
+/**
+ * @brief Get the combined usage statistics of all the pools
+ * @return The combined usage statistics
+ */
+FWeaponProjectilePoolStats UWeaponProjectilePoolSubsystem::GetTotalStats() const
+{
+	FWeaponProjectilePoolStats TotalStats;
+	for (const TTuple<TSubclassOf<AWeaponProjectile>, FWeaponProjectilePool>& Pool : Pools)
+	{
+		TotalStats.Hits += Pool.Value.Stats.Hits;
+		TotalStats.Misses += Pool.Value.Stats.Misses;
+		TotalStats.Active += Pool.Value.Stats.Active;
+		TotalStats.Available += Pool.Value.Stats.Available;
+	}
+
+	return TotalStats;
+}
+
+/**
+ * @brief Spawn a new projectile that is owned by the pool
+ * @param ProjectileClass The class of the projectile
+ * @param SpawnTransform The transform of the projectile
+ * @return The spawned projectile
+ */
+AWeaponProjectile* UWeaponProjectilePoolSubsystem::SpawnPooledProjectile(
+	const TSubclassOf<AWeaponProjectile> ProjectileClass, const FTransform& SpawnTransform) const
+{
+	FActorSpawnParameters SpawnParams;
+	SpawnParams.SpawnCollisionHandlingOverride = ESpawnActorCollisionHandlingMethod::AlwaysSpawn;
+	AWeaponProjectile* Projectile = GetWorld()->SpawnActor<AWeaponProjectile>(ProjectileClass, SpawnTransform,
+		SpawnParams);
+
+	if (IsValid(Projectile))
+	{
+		Projectile->SetPooled(true);
+	}
+
+	return Projectile;
+}
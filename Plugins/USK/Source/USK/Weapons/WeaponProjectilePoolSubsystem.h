@@ -0,0 +1,86 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "WeaponProjectile.h"
+#include "WeaponProjectilePool.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WeaponProjectilePoolSubsystem.generated.h"
+
+/**
+ * @brief World subsystem used to reuse weapon projectiles instead of spawning and destroying them
+ */
+UCLASS()
+class USK_API UWeaponProjectilePoolSubsystem : public UWorldSubsystem
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Check if the subsystem should be created for the world
+	 * @param Outer The world that owns the subsystem
+	 * @return A boolean value indicating if the subsystem should be created
+	 */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/**
+	 * @brief Destroy the pooled projectiles when the world is torn down
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Make sure the pool contains a minimum amount of projectiles of a specific class
+	 * @param ProjectileClass The class of the projectiles
+	 * @param Amount The amount of projectiles that should be available
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon Projectile Pool")
+	void Prewarm(TSubclassOf<AWeaponProjectile> ProjectileClass, int Amount);
+
+	/**
+	 * @brief Get a projectile from the pool, spawning a new one if the pool is empty
+	 * @param ProjectileClass The class of the projectile
+	 * @param SpawnTransform The transform of the projectile
+	 * @return The activated projectile
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon Projectile Pool")
+	AWeaponProjectile* Acquire(TSubclassOf<AWeaponProjectile> ProjectileClass, const FTransform& SpawnTransform);
+
+	/**
+	 * @brief Return a projectile to the pool
+	 * @param Projectile The projectile to return
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon Projectile Pool")
+	void Release(AWeaponProjectile* Projectile);
+
+	/**
+	 * @brief Get the usage statistics for a specific projectile class
+	 * @param ProjectileClass The class of the projectiles
+	 * @return The usage statistics of the pool
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon Projectile Pool")
+	FWeaponProjectilePoolStats GetStats(TSubclassOf<AWeaponProjectile> ProjectileClass) const;
+
+	/**
+	 * @brief Get the combined usage statistics of all the pools
+	 * @return The combined usage statistics
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon Projectile Pool")
+	FWeaponProjectilePoolStats GetTotalStats() const;
+
+private:
+	/**
+	 * @brief The projectile pools for each projectile class
+	 */
+	UPROPERTY()
+	TMap<TSubclassOf<AWeaponProjectile>, FWeaponProjectilePool> Pools;
+
+	/**
+	 * @brief Spawn a new projectile that is owned by the pool
+	 * @param ProjectileClass The class of the projectile
+	 * @param SpawnTransform The transform of the projectile
+	 * @return The spawned projectile
+	 */
+	AWeaponProjectile* SpawnPooledProjectile(TSubclassOf<AWeaponProjectile> ProjectileClass,
+		const FTransform& SpawnTransform) const;
+};
@@ -0,0 +1,127 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Engine/EngineTypes.h"
+#include "WorldCollision.h"
+#include "WeaponProjectileSimulationBatch.generated.h"
+
+class AWeaponProjectile;
+class UInstancedStaticMeshComponent;
+
+/**
+ * @brief Structure holding all the lightweight projectiles of a single projectile class
+ */
+USTRUCT()
+struct FWeaponProjectileSimulationBatch
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The class of the projectiles
+	 */
+	UPROPERTY()
+	TSubclassOf<AWeaponProjectile> ProjectileClass;
+
+	/**
+	 * @brief The instanced mesh used to draw the projectiles
+	 */
+	UPROPERTY()
+	UInstancedStaticMeshComponent* Mesh = nullptr;
+
+	/**
+	 * @brief The location of each projectile
+	 */
+	TArray<FVector> Locations;
+
+	/**
+	 * @brief The velocity of each projectile
+	 */
+	TArray<FVector> Velocities;
+
+	/**
+	 * @brief The scale of each projectile
+	 */
+	TArray<FVector> Scales;
+
+	/**
+	 * @brief The remaining lifetime of each projectile
+	 */
+	TArray<float> Lifetimes;
+
+	/**
+	 * @brief The sweep started for each projectile during the last tick
+	 */
+	TArray<FTraceHandle> PendingSweeps;
+
+	/**
+	 * @brief The location each projectile moves to if its pending sweep does not hit anything
+	 */
+	TArray<FVector> SweepEnds;
+
+	/**
+	 * @brief The transforms written to the instanced mesh
+	 */
+	TArray<FTransform> Transforms;
+
+	/**
+	 * @brief The radius of the projectile collision
+	 */
+	float Radius = 5.0f;
+
+	/**
+	 * @brief The initial speed of the projectiles
+	 */
+	float InitialSpeed = 3000.0f;
+
+	/**
+	 * @brief The maximum speed of the projectiles (0 = unlimited)
+	 */
+	float MaxSpeed = 0.0f;
+
+	/**
+	 * @brief The gravity applied to the projectiles
+	 */
+	float GravityZ = 0.0f;
+
+	/**
+	 * @brief The lifetime of a new projectile (0 = unlimited)
+	 */
+	float Lifetime = 0.0f;
+
+	/**
+	 * @brief Should the projectiles bounce after hitting something?
+	 */
+	bool bShouldBounce = false;
+
+	/**
+	 * @brief The percentage of velocity maintained along the hit normal after bouncing
+	 */
+	float Bounciness = 0.6f;
+
+	/**
+	 * @brief The percentage of velocity lost along the surface after bouncing
+	 */
+	float Friction = 0.2f;
+
+	/**
+	 * @brief The speed below which a bouncing projectile stops moving
+	 */
+	float StopSpeed = 5.0f;
+
+	/**
+	 * @brief Should the projectiles be removed after hitting something?
+	 */
+	bool bDestroyOnHit = true;
+
+	/**
+	 * @brief The collision channel used to sweep the projectiles
+	 */
+	TEnumAsByte<ECollisionChannel> CollisionChannel = ECC_WorldDynamic;
+
+	/**
+	 * @brief The collision responses used to sweep the projectiles
+	 */
+	FCollisionResponseContainer CollisionResponses;
+};
@@ -0,0 +1,394 @@
+﻿// Created by Henry Jooste
+
+#include "WeaponProjectileSimulationSubsystem.h"
+
+#include "Components/InstancedStaticMeshComponent.h"
+#include "Components/SphereComponent.h"
+#include "Engine/World.h"
+#include "GameFramework/ProjectileMovementComponent.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Check if the subsystem should be created for the world
+ * @param Outer The world that owns the subsystem
+ * @return A boolean value indicating if the subsystem should be created
+ */
+bool UWeaponProjectileSimulationSubsystem::ShouldCreateSubsystem(UObject* Outer) const
+{
+	const UWorld* World = Cast<UWorld>(Outer);
+	return Super::ShouldCreateSubsystem(Outer) && IsValid(World) && World->IsGameWorld();
+}
+
+/**
+ * @brief Remove all the projectiles when the world is torn down
+ */
+void UWeaponProjectileSimulationSubsystem::Deinitialize()
+{
+	if (IsValid(MeshOwner))
+	{
+		MeshOwner->Destroy();
+	}
+
+	MeshOwner = nullptr;
+	Batches.Empty();
+	BatchIndices.Empty();
+	ProjectileCount = 0;
+	Super::Deinitialize();
+}
+
+/**
+ * @brief Move the projectiles and process their hits
+ * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+ */
+void UWeaponProjectileSimulationSubsystem::Tick(const float DeltaTime)
+{
+	for (FWeaponProjectileSimulationBatch& Batch : Batches)
+	{
+		if (Batch.Locations.Num() > 0)
+		{
+			SimulateBatch(Batch, DeltaTime);
+		}
+
+		UpdateBatchMesh(Batch);
+	}
+}
+
+/**
+ * @brief Check if the subsystem should be ticked
+ * @return A boolean value indicating if the subsystem should be ticked
+ */
+bool UWeaponProjectileSimulationSubsystem::IsTickable() const
+{
+	return ProjectileCount > 0;
+}
+
+/**
+ * @brief Get the tick type of the subsystem
+ * @return The tick type of the subsystem
+ */
+ETickableTickType UWeaponProjectileSimulationSubsystem::GetTickableTickType() const
+{
+	return IsTemplate() ? ETickableTickType::Never : ETickableTickType::Conditional;
+}
+
+/**
+ * @brief Get the world the subsystem is ticked in
+ * @return The world the subsystem is ticked in
+ */
+UWorld* UWeaponProjectileSimulationSubsystem::GetTickableGameObjectWorld() const
+{
+	return GetWorld();
+}
+
+/**
+ * @brief Get the stat ID used to profile the subsystem
+ * @return The stat ID used to profile the subsystem
+ */
+TStatId UWeaponProjectileSimulationSubsystem::GetStatId() const
+{
+	RETURN_QUICK_DECLARE_CYCLE_STAT(UWeaponProjectileSimulationSubsystem, STATGROUP_Tickables);
+}
+
+/**
+ * @brief Spawn a lightweight projectile
+ * @param ProjectileClass The class of the projectile
+ * @param SpawnTransform The transform of the projectile
+ */
+void UWeaponProjectileSimulationSubsystem::SpawnProjectile(const TSubclassOf<AWeaponProjectile> ProjectileClass,
+	const FTransform& SpawnTransform)
+{
+	if (!IsValid(ProjectileClass))
+	{
+		USK_LOG_ERROR("Unable to spawn lightweight projectile. Projectile class is not valid");
+		return;
+	}
+
+	const int BatchIndex = GetBatch(ProjectileClass);
+	if (BatchIndex == INDEX_NONE)
+	{
+		return;
+	}
+
+	FWeaponProjectileSimulationBatch& Batch = Batches[BatchIndex];
+	Batch.Locations.Add(SpawnTransform.GetLocation());
+	Batch.Velocities.Add(SpawnTransform.GetRotation().GetForwardVector() * Batch.InitialSpeed);
+	Batch.Scales.Add(SpawnTransform.GetScale3D());
+	Batch.Lifetimes.Add(Batch.Lifetime > 0.0f ? Batch.Lifetime : MAX_flt);
+	Batch.PendingSweeps.AddDefaulted();
+	Batch.SweepEnds.AddZeroed();
+	ProjectileCount++;
+}
+
+/**
+ * @brief Get the amount of lightweight projectiles currently simulated
+ * @return The amount of lightweight projectiles
+ */
+int UWeaponProjectileSimulationSubsystem::GetProjectileCount() const
+{
+	return ProjectileCount;
+}
+
+/**
+ * @brief Get the batch used by a projectile class, creating it if needed
+ * @param ProjectileClass The class of the projectile
+ * @return The index of the batch
+ */
+int UWeaponProjectileSimulationSubsystem::GetBatch(const TSubclassOf<AWeaponProjectile> ProjectileClass)
+{
+	if (const int* ExistingBatchIndex = BatchIndices.Find(ProjectileClass))
+	{
+		return *ExistingBatchIndex;
+	}
+
+	const AWeaponProjectile* DefaultProjectile = ProjectileClass->GetDefaultObject<AWeaponProjectile>();
+	if (!IsValid(DefaultProjectile->LightweightMesh))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Unable to spawn lightweight projectile. {0} has no lightweight mesh"),
+			{ ProjectileClass->GetName() }));
+		return INDEX_NONE;
+	}
+
+	if (ProjectileClass->IsFunctionImplementedInScript(GET_FUNCTION_NAME_CHECKED(AWeaponProjectile, OnHit)))
+	{
+		USK_LOG_WARNING(*FString::Format(TEXT("{0} implements OnHit, which is not called for lightweight projectiles"),
+			{ ProjectileClass->GetName() }));
+	}
+
+	if (!IsValid(MeshOwner))
+	{
+		FActorSpawnParameters SpawnParams;
+		SpawnParams.ObjectFlags |= RF_Transient;
+		MeshOwner = GetWorld()->SpawnActor<AActor>(AActor::StaticClass(), FTransform::Identity, SpawnParams);
+		if (!IsValid(MeshOwner))
+		{
+			return INDEX_NONE;
+		}
+	}
+
+	FWeaponProjectileSimulationBatch Batch;
+	Batch.ProjectileClass = ProjectileClass;
+	Batch.bDestroyOnHit = DefaultProjectile->bDestroyOnHit;
+	Batch.Lifetime = DefaultProjectile->InitialLifeSpan;
+
+	const USphereComponent* Collision = DefaultProjectile->GetCollisionComponent();
+	Batch.Radius = Collision->GetScaledSphereRadius();
+	Batch.CollisionChannel = Collision->GetCollisionObjectType();
+	Batch.CollisionResponses = Collision->GetCollisionResponseToChannels();
+
+	const UProjectileMovementComponent* Movement = DefaultProjectile->GetProjectileMovementComponent();
+	Batch.InitialSpeed = Movement->InitialSpeed;
+	Batch.MaxSpeed = Movement->MaxSpeed;
+	Batch.GravityZ = GetWorld()->GetGravityZ() * Movement->ProjectileGravityScale;
+	Batch.bShouldBounce = Movement->bShouldBounce;
+	Batch.Bounciness = Movement->Bounciness;
+	Batch.Friction = Movement->Friction;
+	Batch.StopSpeed = Movement->BounceVelocityStopSimulatingThreshold;
+
+	Batch.Mesh = NewObject<UInstancedStaticMeshComponent>(MeshOwner);
+	Batch.Mesh->SetStaticMesh(DefaultProjectile->LightweightMesh);
+	Batch.Mesh->SetCollisionEnabled(ECollisionEnabled::NoCollision);
+	Batch.Mesh->SetCastShadow(false);
+	Batch.Mesh->SetMobility(EComponentMobility::Movable);
+	if (IsValid(DefaultProjectile->LightweightMaterial))
+	{
+		Batch.Mesh->SetMaterial(0, DefaultProjectile->LightweightMaterial);
+	}
+
+	Batch.Mesh->RegisterComponent();
+
+	const int BatchIndex = Batches.Add(Batch);
+	BatchIndices.Add(ProjectileClass, BatchIndex);
+	USK_LOG_TRACE(*FString::Format(TEXT("Created lightweight projectile batch for {0}"),
+		{ ProjectileClass->GetName() }));
+
+	return BatchIndex;
+}
+
+/**
+ * @brief Move the projectiles of a batch and process their hits
+ * @param Batch The batch to simulate
+ * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+ */
+void UWeaponProjectileSimulationSubsystem::SimulateBatch(FWeaponProjectileSimulationBatch& Batch, const float DeltaTime)
+{
+	const FCollisionShape Shape = FCollisionShape::MakeSphere(Batch.Radius);
+	const FCollisionQueryParams QueryParams(SCENE_QUERY_STAT(WeaponProjectileSimulation), false);
+	const FCollisionResponseParams ResponseParams(Batch.CollisionResponses);
+	ResolveSweeps(Batch, Shape, QueryParams, ResponseParams);
+
+	const int Count = Batch.Locations.Num();
+	FVector* Velocities = Batch.Velocities.GetData();
+	float* Lifetimes = Batch.Lifetimes.GetData();
+
+	// Integrate all the projectiles in flat loops before doing any collision queries
+	const float GravityDelta = Batch.GravityZ * DeltaTime;
+	for (int i = 0; i < Count; i++)
+	{
+		Velocities[i].Z += GravityDelta;
+		Lifetimes[i] -= DeltaTime;
+	}
+
+	if (Batch.MaxSpeed > 0.0f)
+	{
+		const float MaxSpeedSquared = FMath::Square(Batch.MaxSpeed);
+		for (int i = 0; i < Count; i++)
+		{
+			if (Velocities[i].SizeSquared() > MaxSpeedSquared)
+			{
+				Velocities[i] = Velocities[i].GetSafeNormal() * Batch.MaxSpeed;
+			}
+		}
+	}
+
+	UWorld* World = GetWorld();
+	for (int i = Count - 1; i >= 0; i--)
+	{
+		if (Batch.Lifetimes[i] <= 0.0f)
+		{
+			RemoveProjectile(Batch, i);
+			continue;
+		}
+
+		const FVector Velocity = Batch.Velocities[i];
+		if (Velocity.IsNearlyZero())
+		{
+			continue;
+		}
+
+		// The sweeps of all the projectiles run together on worker threads and are resolved during the next tick
+		const FVector Start = Batch.Locations[i];
+		Batch.SweepEnds[i] = Start + Velocity * DeltaTime;
+		Batch.PendingSweeps[i] = World->AsyncSweepByChannel(EAsyncTraceType::Single, Start, Batch.SweepEnds[i],
+			FQuat::Identity, Batch.CollisionChannel, Shape, QueryParams, ResponseParams);
+	}
+}
+
+/**
+ * @brief Move the projectiles of a batch to the end of the sweeps started during the last tick or process their hits
+ * @param Batch The batch to resolve
+ * @param Shape The collision shape of the projectiles
+ * @param QueryParams The parameters used to sweep the projectiles
+ * @param ResponseParams The collision responses used to sweep the projectiles
+ */
+void UWeaponProjectileSimulationSubsystem::ResolveSweeps(FWeaponProjectileSimulationBatch& Batch,
+	const FCollisionShape& Shape, const FCollisionQueryParams& QueryParams,
+	const FCollisionResponseParams& ResponseParams)
+{
+	const AWeaponProjectile* DefaultProjectile = Batch.ProjectileClass->GetDefaultObject<AWeaponProjectile>();
+	UWorld* World = GetWorld();
+	FTraceDatum TraceDatum;
+	for (int i = Batch.Locations.Num() - 1; i >= 0; i--)
+	{
+		const FTraceHandle SweepHandle = Batch.PendingSweeps[i];
+		if (!SweepHandle.IsValid())
+		{
+			continue;
+		}
+
+		Batch.PendingSweeps[i] = FTraceHandle();
+		FHitResult HitResult;
+		bool bHit = false;
+		if (World->QueryTraceData(SweepHandle, TraceDatum))
+		{
+			for (const FHitResult& TraceHit : TraceDatum.OutHits)
+			{
+				if (TraceHit.bBlockingHit)
+				{
+					HitResult = TraceHit;
+					bHit = true;
+					break;
+				}
+			}
+		}
+		else
+		{
+			// The result is no longer available when the world was not ticked in between, so the sweep is repeated
+			bHit = World->SweepSingleByChannel(HitResult, Batch.Locations[i], Batch.SweepEnds[i], FQuat::Identity,
+				Batch.CollisionChannel, Shape, QueryParams, ResponseParams);
+		}
+
+		if (!bHit)
+		{
+			Batch.Locations[i] = Batch.SweepEnds[i];
+			continue;
+		}
+
+		const FVector Velocity = Batch.Velocities[i];
+		DefaultProjectile->ApplyHit(HitResult.GetActor(), HitResult.GetComponent(), Velocity, HitResult);
+		if (Batch.bDestroyOnHit)
+		{
+			RemoveProjectile(Batch, i);
+			continue;
+		}
+
+		Batch.Locations[i] = HitResult.Location + HitResult.Normal * KINDA_SMALL_NUMBER;
+		if (!Batch.bShouldBounce)
+		{
+			Batch.Velocities[i] = FVector::ZeroVector;
+			continue;
+		}
+
+		const FVector NormalVelocity = HitResult.Normal * (Velocity | HitResult.Normal);
+		const FVector TangentVelocity = Velocity - NormalVelocity;
+		const FVector BounceVelocity = TangentVelocity * (1.0f - Batch.Friction) - NormalVelocity * Batch.Bounciness;
+		Batch.Velocities[i] = BounceVelocity.Size() < Batch.StopSpeed ? FVector::ZeroVector : BounceVelocity;
+	}
+}
+
+/**
+ * @brief Write the projectile transforms of a batch to its instanced mesh
+ * @param Batch The batch to draw
+ */
+void UWeaponProjectileSimulationSubsystem::UpdateBatchMesh(FWeaponProjectileSimulationBatch& Batch)
+{
+	if (!IsValid(Batch.Mesh))
+	{
+		return;
+	}
+
+	const int Count = Batch.Locations.Num();
+	Batch.Transforms.SetNum(Count, false);
+	for (int i = 0; i < Count; i++)
+	{
+		const FRotator Rotation = Batch.Velocities[i].IsNearlyZero()
+			? Batch.Transforms[i].Rotator()
+			: Batch.Velocities[i].Rotation();
+		Batch.Transforms[i] = FTransform(Rotation, Batch.Locations[i], Batch.Scales[i]);
+	}
+
+	while (Batch.Mesh->GetInstanceCount() > Count)
+	{
+		Batch.Mesh->RemoveInstance(Batch.Mesh->GetInstanceCount() - 1);
+	}
+
+	for (int i = Batch.Mesh->GetInstanceCount(); i < Count; i++)
+	{
+		Batch.Mesh->AddInstance(Batch.Transforms[i]);
+	}
+
+	if (Count > 0)
+	{
+		Batch.Mesh->BatchUpdateInstancesTransforms(0, Batch.Transforms, true, true, true);
+	}
+}
+
+/**
+ * @brief Remove a projectile from a batch
+ * @param Batch The batch containing the projectile
+ * @param Index The index of the projectile
+ */
+void UWeaponProjectileSimulationSubsystem::RemoveProjectile(FWeaponProjectileSimulationBatch& Batch, const int Index)
+{
+	Batch.Locations.RemoveAtSwap(Index, 1, false);
+	Batch.Velocities.RemoveAtSwap(Index, 1, false);
+	Batch.Scales.RemoveAtSwap(Index, 1, false);
+	Batch.Lifetimes.RemoveAtSwap(Index, 1, false);
+	Batch.PendingSweeps.RemoveAtSwap(Index, 1, false);
+	Batch.SweepEnds.RemoveAtSwap(Index, 1, false);
+	if (Batch.Transforms.IsValidIndex(Index))
+	{
+		Batch.Transforms.RemoveAtSwap(Index, 1, false);
+	}
+
+	ProjectileCount--;
+}
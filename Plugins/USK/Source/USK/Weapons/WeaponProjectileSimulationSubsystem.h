@@ -0,0 +1,138 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Tickable.h"
+#include "WeaponProjectile.h"
+#include "WeaponProjectileSimulationBatch.h"
+#include "Subsystems/WorldSubsystem.h"
+#include "WeaponProjectileSimulationSubsystem.generated.h"
+
+/**
+ * @brief World subsystem that simulates lightweight projectiles without spawning an actor for each projectile
+ */
+UCLASS()
+class USK_API UWeaponProjectileSimulationSubsystem : public UWorldSubsystem, public FTickableGameObject
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Check if the subsystem should be created for the world
+	 * @param Outer The world that owns the subsystem
+	 * @return A boolean value indicating if the subsystem should be created
+	 */
+	virtual bool ShouldCreateSubsystem(UObject* Outer) const override;
+
+	/**
+	 * @brief Remove all the projectiles when the world is torn down
+	 */
+	virtual void Deinitialize() override;
+
+	/**
+	 * @brief Move the projectiles and process their hits
+	 * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+	 */
+	virtual void Tick(float DeltaTime) override;
+
+	/**
+	 * @brief Check if the subsystem should be ticked
+	 * @return A boolean value indicating if the subsystem should be ticked
+	 */
+	virtual bool IsTickable() const override;
+
+	/**
+	 * @brief Get the tick type of the subsystem
+	 * @return The tick type of the subsystem
+	 */
+	virtual ETickableTickType GetTickableTickType() const override;
+
+	/**
+	 * @brief Get the world the subsystem is ticked in
+	 * @return The world the subsystem is ticked in
+	 */
+	virtual UWorld* GetTickableGameObjectWorld() const override;
+
+	/**
+	 * @brief Get the stat ID used to profile the subsystem
+	 * @return The stat ID used to profile the subsystem
+	 */
+	virtual TStatId GetStatId() const override;
+
+	/**
+	 * @brief Spawn a lightweight projectile
+	 * @param ProjectileClass The class of the projectile
+	 * @param SpawnTransform The transform of the projectile
+	 */
+	UFUNCTION(BlueprintCallable, Category = "Ultimate Starter Kit|Weapon Projectile Simulation")
+	void SpawnProjectile(TSubclassOf<AWeaponProjectile> ProjectileClass, const FTransform& SpawnTransform);
+
+	/**
+	 * @brief Get the amount of lightweight projectiles currently simulated
+	 * @return The amount of lightweight projectiles
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon Projectile Simulation")
+	int GetProjectileCount() const;
+
+private:
+	/**
+	 * @brief The actor that owns the instanced meshes
+	 */
+	UPROPERTY()
+	AActor* MeshOwner;
+
+	/**
+	 * @brief The projectiles of each projectile class
+	 */
+	UPROPERTY()
+	TArray<FWeaponProjectileSimulationBatch> Batches;
+
+	/**
+	 * @brief The index of the batch used by each projectile class
+	 */
+	UPROPERTY()
+	TMap<TSubclassOf<AWeaponProjectile>, int> BatchIndices;
+
+	/**
+	 * @brief The amount of projectiles currently simulated
+	 */
+	int ProjectileCount;
+
+	/**
+	 * @brief Get the batch used by a projectile class, creating it if needed
+	 * @param ProjectileClass The class of the projectile
+	 * @return The index of the batch
+	 */
+	int GetBatch(TSubclassOf<AWeaponProjectile> ProjectileClass);
+
+	/**
+	 * @brief Move the projectiles of a batch and process their hits
+	 * @param Batch The batch to simulate
+	 * @param DeltaTime Game time elapsed during last frame modified by the time dilation
+	 */
+	void SimulateBatch(FWeaponProjectileSimulationBatch& Batch, float DeltaTime);
+
+	/**
+	 * @brief Move the projectiles of a batch to the end of the sweeps started during the last tick or process their hits
+	 * @param Batch The batch to resolve
+	 * @param Shape The collision shape of the projectiles
+	 * @param QueryParams The parameters used to sweep the projectiles
+	 * @param ResponseParams The collision responses used to sweep the projectiles
+	 */
+	void ResolveSweeps(FWeaponProjectileSimulationBatch& Batch, const FCollisionShape& Shape,
+		const FCollisionQueryParams& QueryParams, const FCollisionResponseParams& ResponseParams);
+
+	/**
+	 * @brief Write the projectile transforms of a batch to its instanced mesh
+	 * @param Batch The batch to draw
+	 */
+	static void UpdateBatchMesh(FWeaponProjectileSimulationBatch& Batch);
+
+	/**
+	 * @brief Remove a projectile from a batch
+	 * @param Batch The batch containing the projectile
+	 * @param Index The index of the projectile
+	 */
+	void RemoveProjectile(FWeaponProjectileSimulationBatch& Batch, int Index);
+};
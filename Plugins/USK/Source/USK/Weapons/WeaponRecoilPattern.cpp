@@ -0,0 +1,116 @@
+﻿// Created by Henry Jooste
+
+#include "WeaponRecoilPattern.h"
+
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Bake the recoil and recovery curves into the lookup tables
+ */
+void UWeaponRecoilPattern::Bake()
+{
+	RecoilTable.Reset();
+	RecoveryTable.Reset();
+	if (SampleRate <= 0.0f)
+	{
+		USK_LOG_ERROR("Unable to bake recoil pattern. Sample rate must be larger than zero");
+		return;
+	}
+
+	if (IsValid(RecoilCurve))
+	{
+		float MinTime;
+		float MaxTime;
+		RecoilCurve->GetTimeRange(MinTime, MaxTime);
+
+		const int SampleCount = FMath::CeilToInt(FMath::Max(MaxTime, 0.0f) * SampleRate) + 1;
+		RecoilTable.Reserve(SampleCount);
+		for (int i = 0; i < SampleCount; i++)
+		{
+			const FVector Recoil = RecoilCurve->GetVectorValue(i / SampleRate);
+			RecoilTable.Add(FVector2D(Recoil.Y, Recoil.Z));
+		}
+	}
+
+	const int RecoverySampleCount = FMath::CeilToInt(RecoveryTime * SampleRate) + 1;
+	RecoveryTable.Reserve(RecoverySampleCount);
+	for (int i = 0; i < RecoverySampleCount; i++)
+	{
+		const float Alpha = FMath::Min(i / (SampleRate * RecoveryTime), 1.0f);
+		RecoveryTable.Add(IsValid(RecoveryCurve)
+			? RecoveryCurve->GetFloatValue(Alpha)
+			: FMath::InterpEaseOut(1.0f, 0.0f, Alpha, 2.0f));
+	}
+
+	USK_LOG_INFO(*FString::Format(TEXT("Baked recoil pattern with {0} recoil samples and {1} recovery samples"),
+		{ RecoilTable.Num(), RecoveryTable.Num() }));
+}
+
+/**
+ * @brief Get the recoil offset at a specific time
+ * @param Time The amount of seconds since the recoil started
+ * @return The pitch (X) and yaw (Y) recoil offset
+ */
+FVector2D UWeaponRecoilPattern::GetRecoilOffset(const float Time) const
+{
+	return SampleTable(RecoilTable, Time, FVector2D::ZeroVector);
+}
+
+/**
+ * @brief Get the amount of recoil remaining at a specific time while recovering
+ * @param Time The amount of seconds since the recovery started
+ * @return The amount of recoil remaining (from 1 to 0)
+ */
+float UWeaponRecoilPattern::GetRecoveryAlpha(const float Time) const
+{
+	return SampleTable(RecoveryTable, Time, 0.0f);
+}
+
+#if WITH_EDITOR
+/**
+ * @brief Called when a property on this object has been modified externally
+ * @param PropertyChangedEvent The event containing information about the property that was changed
+ */
+void UWeaponRecoilPattern::PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent)
+{
+	Super::PostEditChangeProperty(PropertyChangedEvent);
+	if (PropertyChangedEvent.Property == nullptr)
+	{
+		return;
+	}
+
+	const FName PropertyName = PropertyChangedEvent.Property->GetFName();
+	if (PropertyName == GET_MEMBER_NAME_CHECKED(UWeaponRecoilPattern, RecoilCurve) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UWeaponRecoilPattern, RecoveryCurve) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UWeaponRecoilPattern, RecoveryTime) ||
+		PropertyName == GET_MEMBER_NAME_CHECKED(UWeaponRecoilPattern, SampleRate))
+	{
+		Bake();
+	}
+}
+#endif
+
+/**
+ * @brief Sample a lookup table at a specific time using linear interpolation
+ * @param Table The lookup table
+ * @param Time The time to sample
+ * @param Default The value returned when the table is empty
+ * @return The sampled value
+ */
+template <typename T>
+T UWeaponRecoilPattern::SampleTable(const TArray<T>& Table, const float Time, const T& Default) const
+{
+	if (Table.Num() == 0)
+	{
+		return Default;
+	}
+
+	const float Index = FMath::Max(Time, 0.0f) * SampleRate;
+	const int LowerIndex = FMath::FloorToInt(Index);
+	if (LowerIndex >= Table.Num() - 1)
+	{
+		return Table.Last();
+	}
+
+	return FMath::Lerp(Table[LowerIndex], Table[LowerIndex + 1], Index - LowerIndex);
+}
@@ -0,0 +1,98 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Curves/CurveFloat.h"
+#include "Curves/CurveVector.h"
+#include "Engine/DataAsset.h"
+#include "WeaponRecoilPattern.generated.h"
+
+/**
+ * @brief A recoil pattern baked into lookup tables that are sampled at a fixed rate
+ */
+UCLASS(BlueprintType)
+class USK_API UWeaponRecoilPattern : public UDataAsset
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief The curve the recoil pattern is baked from (Y is used for the pitch and Z for the yaw)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Weapon Recoil Pattern")
+	UCurveVector* RecoilCurve;
+
+	/**
+	 * @brief The curve describing the amount of recoil remaining while recovering (from 1 to 0 over a time of 1)
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Weapon Recoil Pattern")
+	UCurveFloat* RecoveryCurve;
+
+	/**
+	 * @brief The amount of seconds it takes to recover from recoil
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Weapon Recoil Pattern",
+		meta=(ClampMin = "0.01"))
+	float RecoveryTime = 1.0f;
+
+	/**
+	 * @brief The amount of samples baked for each second of the curves
+	 */
+	UPROPERTY(EditAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Weapon Recoil Pattern",
+		meta=(ClampMin = "1", ClampMax = "1000"))
+	float SampleRate = 60.0f;
+
+	/**
+	 * @brief The baked pitch (X) and yaw (Y) recoil offsets
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Weapon Recoil Pattern|Baked")
+	TArray<FVector2D> RecoilTable;
+
+	/**
+	 * @brief The baked amount of recoil remaining while recovering
+	 */
+	UPROPERTY(VisibleAnywhere, BlueprintReadOnly, Category = "Ultimate Starter Kit|Weapon Recoil Pattern|Baked")
+	TArray<float> RecoveryTable;
+
+	/**
+	 * @brief Bake the recoil and recovery curves into the lookup tables
+	 */
+	UFUNCTION(BlueprintCallable, CallInEditor, Category = "Ultimate Starter Kit|Weapon Recoil Pattern")
+	void Bake();
+
+	/**
+	 * @brief Get the recoil offset at a specific time
+	 * @param Time The amount of seconds since the recoil started
+	 * @return The pitch (X) and yaw (Y) recoil offset
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon Recoil Pattern")
+	FVector2D GetRecoilOffset(float Time) const;
+
+	/**
+	 * @brief Get the amount of recoil remaining at a specific time while recovering
+	 * @param Time The amount of seconds since the recovery started
+	 * @return The amount of recoil remaining (from 1 to 0)
+	 */
+	UFUNCTION(BlueprintCallable, BlueprintPure, Category = "Ultimate Starter Kit|Weapon Recoil Pattern")
+	float GetRecoveryAlpha(float Time) const;
+
+#if WITH_EDITOR
+	/**
+	 * @brief Called when a property on this object has been modified externally
+	 * @param PropertyChangedEvent The event containing information about the property that was changed
+	 */
+	virtual void PostEditChangeProperty(FPropertyChangedEvent& PropertyChangedEvent) override;
+#endif
+
+private:
+	/**
+	 * @brief Sample a lookup table at a specific time using linear interpolation
+	 * @param Table The lookup table
+	 * @param Time The time to sample
+	 * @param Default The value returned when the table is empty
+	 * @return The sampled value
+	 */
+	template <typename T>
+	T SampleTable(const TArray<T>& Table, float Time, const T& Default) const;
+};
@@ -2,6 +2,7 @@
 
 #include "WeaponUtils.h"
 
+#include "WeaponLoadoutComponent.h"
 #include "Engine/World.h"
 #include "USK/Character/USKCharacter.h"
 #include "USK/Logger/Log.h"
@@ -25,6 +26,13 @@ void UWeaponUtils::EquipWeapon(AUSKCharacter* Owner, const TSubclassOf<AWeapon>
 		return;
 	}
 	
+	UWeaponLoadoutComponent* WeaponLoadout = Owner->FindComponentByClass<UWeaponLoadoutComponent>();
+	if (IsValid(WeaponLoadout))
+	{
+		WeaponLoadout->EquipWeapon(WeaponClass);
+		return;
+	}
+
 	AWeapon* CurrentWeapon = Owner->GetWeapon();
 	if (IsValid(CurrentWeapon))
 	{
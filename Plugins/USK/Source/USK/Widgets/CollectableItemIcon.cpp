@@ -15,6 +15,15 @@ void UCollectableItemIcon::NativeConstruct()
 	UpdateState(false);
 }
 
+/**
+ * @brief Overridable native event for when the widget has been destructed
+ */
+void UCollectableItemIcon::NativeDestruct()
+{
+	StopMonitoring();
+	Super::NativeDestruct();
+}
+
 /**
  * @brief Update the collected state (and visibility) of the icon
  * @param IsCollected Is the item collected?
@@ -46,11 +55,28 @@ void UCollectableItemIcon::MonitorTrackableValue(UTrackableDataComponent* Tracka
 		return;
 	}
 
-	TrackableDataName = DataName;
-	TrackableDataComponent->OnValueUpdated.AddDynamic(this, &UCollectableItemIcon::OnTrackableValueChanged);
+	StopMonitoring();
+	FTrackableDataSubscriptionDelegate Callback;
+	Callback.BindDynamic(this, &UCollectableItemIcon::OnTrackableValueChanged);
+	SubscriptionId = TrackableDataComponent->Subscribe(DataName, Callback);
+	MonitoredComponent = TrackableDataComponent;
 	UpdateValue(TrackableDataComponent->GetValue(DataName));
 }
 
+/**
+ * @brief Stop monitoring the trackable data
+ */
+void UCollectableItemIcon::StopMonitoring()
+{
+	if (MonitoredComponent.IsValid())
+	{
+		MonitoredComponent->Unsubscribe(SubscriptionId);
+	}
+
+	MonitoredComponent.Reset();
+	SubscriptionId = INDEX_NONE;
+}
+
 /**
  * @brief Update the icon state after the trackable data is updated
  * @param Name The name of the data item
@@ -59,11 +85,6 @@ void UCollectableItemIcon::MonitorTrackableValue(UTrackableDataComponent* Tracka
  */
 void UCollectableItemIcon::OnTrackableValueChanged(const FName Name, const float Value, const float ValuePercentage)
 {
-	if (Name != TrackableDataName)
-	{
-		return;
-	}
-
 	USK_LOG_INFO("Trackable data updated. Updating icon state");
 	UpdateValue(Value);
 }
\ No newline at end of file
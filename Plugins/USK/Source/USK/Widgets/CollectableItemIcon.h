@@ -56,11 +56,26 @@ protected:
 	 */
 	virtual void NativeConstruct() override;
 
+	/**
+	 * @brief Overridable native event for when the widget has been destructed
+	 */
+	virtual void NativeDestruct() override;
+
 private:
 	/**
-	 * @brief The name of the data item to monitor
+	 * @brief The component containing the data item to monitor
+	 */
+	TWeakObjectPtr<UTrackableDataComponent> MonitoredComponent;
+
+	/**
+	 * @brief The ID of the subscription to the data item to monitor
+	 */
+	int SubscriptionId = INDEX_NONE;
+
+	/**
+	 * @brief Stop monitoring the trackable data
 	 */
-	FName TrackableDataName;
+	void StopMonitoring();
 
 	/**
 	 * @brief Update the icon state after the trackable data is updated
@@ -0,0 +1,126 @@
+﻿// Created by Henry Jooste
+
+#include "InputReplayBenchmarkCommandlet.h"
+
+#include "JsonObjectConverter.h"
+#include "HAL/PlatformProcess.h"
+#include "Misc/FileHelper.h"
+#include "Misc/Paths.h"
+#include "USK/Benchmark/InputReplayBenchmarkReport.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Create a new instance of the UInputReplayBenchmarkCommandlet commandlet
+ */
+UInputReplayBenchmarkCommandlet::UInputReplayBenchmarkCommandlet()
+{
+	IsClient = false;
+	IsEditor = true;
+	IsServer = false;
+	LogToConsole = true;
+}
+
+/**
+ * @brief Run the benchmark
+ * @param Params The parameters passed to the commandlet
+ * @return 0 if all the runs passed, otherwise 1
+ */
+int32 UInputReplayBenchmarkCommandlet::Main(const FString& Params)
+{
+	TArray<FString> Tokens;
+	TArray<FString> Switches;
+	TMap<FString, FString> ParamValues;
+	ParseCommandLine(*Params, Tokens, Switches, ParamValues);
+
+	const FString* Map = ParamValues.Find(TEXT("Map"));
+	const FString* Recording = ParamValues.Find(TEXT("Recording"));
+	if (Map == nullptr || Recording == nullptr)
+	{
+		USK_LOG_ERROR("Usage: -run=InputReplayBenchmark -Map=/Game/Maps/Level -Recording=Name [-Report=Name] "
+			"[-Baseline=File] [-Repeat=Count] [-Rendering]");
+		return 1;
+	}
+
+	const FString ReportName = ParamValues.FindRef(TEXT("Report")).IsEmpty()
+		? *Recording + TEXT("Replay")
+		: ParamValues.FindRef(TEXT("Report"));
+	const FString Baseline = ParamValues.FindRef(TEXT("Baseline"));
+	const int Repeat = FMath::Max(1, FCString::Atoi(*ParamValues.FindRef(TEXT("Repeat"))));
+	const bool bRendering = Switches.Contains(TEXT("Rendering"));
+
+	bool bPassed = true;
+	for (int Run = 0; Run < Repeat; Run++)
+	{
+		const FString RunReportName = Repeat > 1 ? FString::Printf(TEXT("%s_%d"), *ReportName, Run) : ReportName;
+		USK_LOG_INFO(*FString::Format(TEXT("Replaying {0} on {1} ({2}/{3})"), { *Recording, *Map, Run + 1, Repeat }));
+		const int32 ExitCode = RunGame(*Map, *Recording, RunReportName, Baseline, bRendering);
+		bPassed &= PrintReport(RunReportName) && ExitCode == 0;
+	}
+
+	return bPassed ? 0 : 1;
+}
+
+/**
+ * @brief Launch the game, replay the recording and wait for the game to exit
+ * @param Map The map containing the input replay benchmark actor
+ * @param Recording The name of the recording
+ * @param ReportName The name of the report written by the game
+ * @param Baseline The baseline report the results are compared against
+ * @param bRendering Should the game be launched with rendering enabled?
+ * @return The exit code of the game
+ */
+int32 UInputReplayBenchmarkCommandlet::RunGame(const FString& Map, const FString& Recording,
+	const FString& ReportName, const FString& Baseline, const bool bRendering)
+{
+	FString Arguments = FString::Printf(TEXT("\"%s\" %s -game -unattended -nosplash -nosound -USKInputReplay=%s ")
+		TEXT("-USKBenchmarkReport=%s"), *FPaths::ConvertRelativePathToFull(FPaths::GetProjectFilePath()), *Map,
+		*Recording, *ReportName);
+	if (!Baseline.IsEmpty())
+	{
+		Arguments += FString::Printf(TEXT(" -USKBenchmarkBaseline=\"%s\""), *Baseline);
+	}
+
+	if (!bRendering)
+	{
+		Arguments += TEXT(" -nullrhi");
+	}
+
+	FProcHandle Process = FPlatformProcess::CreateProc(FPlatformProcess::ExecutablePath(), *Arguments, false, true,
+		true, nullptr, 0, nullptr, nullptr);
+	if (!Process.IsValid())
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Failed to launch {0}"), { FPlatformProcess::ExecutablePath() }));
+		return 1;
+	}
+
+	FPlatformProcess::WaitForProc(Process);
+	int32 ExitCode = 1;
+	FPlatformProcess::GetProcReturnCode(Process, &ExitCode);
+	FPlatformProcess::CloseProc(Process);
+	return ExitCode;
+}
+
+/**
+ * @brief Read the report written by the game and log the frame time percentiles
+ * @param ReportName The name of the report
+ * @return A boolean value indicating if the report was read and passed
+ */
+bool UInputReplayBenchmarkCommandlet::PrintReport(const FString& ReportName)
+{
+	const FString ReportPath = FPaths::Combine(FPaths::ProjectSavedDir(), TEXT("Benchmarks"), ReportName + TEXT(".json"));
+	FString Json;
+	FInputReplayBenchmarkReport Report;
+	if (!FFileHelper::LoadFileToString(Json, *ReportPath) ||
+		!FJsonObjectConverter::JsonObjectStringToUStruct(Json, &Report, 0, 0))
+	{
+		USK_LOG_ERROR(*FString::Format(TEXT("Failed to read benchmark report {0}"), { ReportPath }));
+		return false;
+	}
+
+	USK_LOG_INFO(*FString::Printf(TEXT("%s: %d frames, average %.2fms, median %.2fms, p90 %.2fms, p99 %.2fms, ")
+		TEXT("max %.2fms, game thread average %.2fms, game thread p99 %.2fms, %s"), *ReportName, Report.FrameCount,
+		Report.AverageFrameTime, Report.MedianFrameTime, Report.P90FrameTime, Report.P99FrameTime,
+		Report.MaxFrameTime, Report.AverageGameThreadTime, Report.P99GameThreadTime,
+		Report.bPassed ? TEXT("passed") : TEXT("failed")));
+	return Report.bPassed;
+}
@@ -0,0 +1,52 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "Commandlets/Commandlet.h"
+#include "InputReplayBenchmarkCommandlet.generated.h"
+
+/**
+ * @brief Commandlet that replays an input recording in a headless game and reports the frame time percentiles
+ *
+ * Usage: -run=InputReplayBenchmark -Map=/Game/Maps/Level -Recording=Name [-Report=Name] [-Baseline=File]
+ * [-Repeat=Count] [-Rendering]
+ */
+UCLASS()
+class USKEDITOR_API UInputReplayBenchmarkCommandlet : public UCommandlet
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Create a new instance of the UInputReplayBenchmarkCommandlet commandlet
+	 */
+	UInputReplayBenchmarkCommandlet();
+
+	/**
+	 * @brief Run the benchmark
+	 * @param Params The parameters passed to the commandlet
+	 * @return 0 if all the runs passed, otherwise 1
+	 */
+	virtual int32 Main(const FString& Params) override;
+
+private:
+	/**
+	 * @brief Launch the game, replay the recording and wait for the game to exit
+	 * @param Map The map containing the input replay benchmark actor
+	 * @param Recording The name of the recording
+	 * @param ReportName The name of the report written by the game
+	 * @param Baseline The baseline report the results are compared against
+	 * @param bRendering Should the game be launched with rendering enabled?
+	 * @return The exit code of the game
+	 */
+	static int32 RunGame(const FString& Map, const FString& Recording, const FString& ReportName,
+		const FString& Baseline, bool bRendering);
+
+	/**
+	 * @brief Read the report written by the game and log the frame time percentiles
+	 * @param ReportName The name of the report
+	 * @return A boolean value indicating if the report was read and passed
+	 */
+	static bool PrintReport(const FString& ReportName);
+};
@@ -0,0 +1,28 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "USKDataAssetFactory.h"
+#include "Factories/Factory.h"
+#include "USK/Character/USKCharacterAnimationSet.h"
+#include "CharacterAnimationSetAssetFactory.generated.h"
+
+/**
+ * @brief Factory class used to create a character animation set
+ */
+UCLASS()
+class USKEDITOR_API UCharacterAnimationSetAssetFactory : public UUSKDataAssetFactory
+{
+	GENERATED_BODY()
+	
+public:
+	/**
+	 * @brief Create a new instance of the factory class
+	 */
+	UCharacterAnimationSetAssetFactory()
+	{
+		DataAssetClass = UUSKCharacterAnimationSet::StaticClass();
+		SupportedClass = UUSKCharacterAnimationSet::StaticClass();
+	}
+};
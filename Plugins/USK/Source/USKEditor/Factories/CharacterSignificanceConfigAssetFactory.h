@@ -0,0 +1,28 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "USKDataAssetFactory.h"
+#include "Factories/Factory.h"
+#include "USK/Character/CharacterSignificanceConfig.h"
+#include "CharacterSignificanceConfigAssetFactory.generated.h"
+
+/**
+ * @brief Factory class used to create a character significance config
+ */
+UCLASS()
+class USKEDITOR_API UCharacterSignificanceConfigAssetFactory : public UUSKDataAssetFactory
+{
+	GENERATED_BODY()
+	
+public:
+	/**
+	 * @brief Create a new instance of the factory class
+	 */
+	UCharacterSignificanceConfigAssetFactory()
+	{
+		DataAssetClass = UCharacterSignificanceConfig::StaticClass();
+		SupportedClass = UCharacterSignificanceConfig::StaticClass();
+	}
+};
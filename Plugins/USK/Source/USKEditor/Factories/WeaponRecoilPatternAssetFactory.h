@@ -0,0 +1,28 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "USKDataAssetFactory.h"
+#include "Factories/Factory.h"
+#include "USK/Weapons/WeaponRecoilPattern.h"
+#include "WeaponRecoilPatternAssetFactory.generated.h"
+
+/**
+ * @brief Factory class used to create a weapon recoil pattern
+ */
+UCLASS()
+class USKEDITOR_API UWeaponRecoilPatternAssetFactory : public UUSKDataAssetFactory
+{
+	GENERATED_BODY()
+	
+public:
+	/**
+	 * @brief Create a new instance of the factory class
+	 */
+	UWeaponRecoilPatternAssetFactory()
+	{
+		DataAssetClass = UWeaponRecoilPattern::StaticClass();
+		SupportedClass = UWeaponRecoilPattern::StaticClass();
+	}
+};
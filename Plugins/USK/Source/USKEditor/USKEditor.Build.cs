@@ -34,6 +34,8 @@ public class USKEditor : ModuleRules
 			"KismetWidgets",
 			"ApplicationCore",
 			"ToolMenus",
+			"Json",
+			"JsonUtilities",
 		});
 
 		DynamicallyLoadedModuleNames.AddRange(new string[] { });
@@ -3,12 +3,15 @@
 #include "USKEditor.h"
 
 #include "AssetToolsModule.h"
+#include "PropertyEditorModule.h"
 #include "Assets/DialogueAsset.h"
 #include "Assets/USKAsset.h"
 #include "Dialogue/AssetEditor/DialogueEditorStyle.h"
 #include "USK/Audio/MusicPlayer.h"
+#include "USK/Character/CharacterSignificanceConfig.h"
 #include "USK/Character/FpsCharacter.h"
 #include "USK/Character/PlatformerCharacter.h"
+#include "USK/Character/USKCharacterAnimationSet.h"
 #include "USK/Core/USKGameInstance.h"
 #include "USK/Dialogue/Dialogue.h"
 #include "USK/Dialogue/DialogueManager.h"
@@ -22,11 +25,13 @@
 #include "USK/Weapons/WeaponAmmoItem.h"
 #include "USK/Weapons/WeaponProjectile.h"
 #include "USK/Weapons/WeaponProjectileDecal.h"
+#include "USK/Weapons/WeaponRecoilPattern.h"
 #include "USK/Widgets/CollectableItemIcon.h"
 #include "USK/Widgets/CreditsWidget.h"
 #include "USK/Widgets/FpsCounter.h"
 #include "USK/Widgets/InputIndicator.h"
 #include "USK/Widgets/Menu.h"
+#include "Weapons/WeaponRecoilPatternDetails.h"
 
 #define LOCTEXT_NAMESPACE "FUSKEditorModule"
 
@@ -53,6 +58,10 @@ void FUSKEditorModule::StartupModule()
 		FColor(63, 126, 255), APlatformerCharacter::StaticClass());
 	RegisterBlueprint(AssetTools, UskCategory, "Gameplay", "Shadow Decal",
 		FColor(63, 126, 255), AShadowDecal::StaticClass());
+	RegisterBlueprint(AssetTools, UskCategory, "Gameplay", "Character Animation Set",
+		FColor(63, 126, 255), UUSKCharacterAnimationSet::StaticClass());
+	RegisterBlueprint(AssetTools, UskCategory, "Gameplay", "Character Significance Config",
+		FColor(63, 126, 255), UCharacterSignificanceConfig::StaticClass());
 	RegisterBlueprint(AssetTools, UskCategory, "Gameplay", "Collectable Item",
 		FColor(63, 126, 255), ACollectableItem::StaticClass());
 
@@ -66,6 +75,8 @@ void FUSKEditorModule::StartupModule()
 		FColor(52, 255, 180), AWeaponProjectile::StaticClass());
 	RegisterBlueprint(AssetTools, UskCategory, "Weapons", "Weapon Projectile Decal",
 		FColor(52, 255, 180), AWeaponProjectileDecal::StaticClass());
+	RegisterBlueprint(AssetTools, UskCategory, "Weapons", "Weapon Recoil Pattern",
+		FColor(52, 255, 180), UWeaponRecoilPattern::StaticClass());
 
 	RegisterDialogue(AssetTools, UskCategory, "Dialogue",
 		FColor(255, 201, 14), UDialogue::StaticClass());
@@ -103,6 +114,8 @@ void FUSKEditorModule::StartupModule()
 			FColor(44, 89, 180), UMenu::StaticClass());
 	RegisterBlueprint(AssetTools, UskCategory, "UI", "Menu Item",
 			FColor(44, 89, 180), UMenuItem::StaticClass());
+
+	RegisterDetailCustomizations();
 }
 
 void FUSKEditorModule::ShutdownModule()
@@ -122,6 +135,7 @@ void FUSKEditorModule::ShutdownModule()
 		GraphPanelNodeFactory_Dialogue.Reset();
 	}
 
+	UnregisterDetailCustomizations();
 	FDialogueEditorStyle::Shutdown();
 }
 
@@ -155,6 +169,26 @@ void FUSKEditorModule::RegisterDialogue(IAssetTools& AssetTools, const EAssetTyp
 	RegisterAssetTypeAction(AssetTools, MakeShareable(Asset));
 }
 
+void FUSKEditorModule::RegisterDetailCustomizations()
+{
+	FPropertyEditorModule& PropertyEditor = FModuleManager::LoadModuleChecked<FPropertyEditorModule>("PropertyEditor");
+	PropertyEditor.RegisterCustomClassLayout(UWeaponRecoilPattern::StaticClass()->GetFName(),
+		FOnGetDetailCustomizationInstance::CreateStatic(&FWeaponRecoilPatternDetails::MakeInstance));
+	PropertyEditor.NotifyCustomizationModuleChanged();
+}
+
+void FUSKEditorModule::UnregisterDetailCustomizations()
+{
+	if (!FModuleManager::Get().IsModuleLoaded("PropertyEditor"))
+	{
+		return;
+	}
+
+	FPropertyEditorModule& PropertyEditor = FModuleManager::GetModuleChecked<FPropertyEditorModule>("PropertyEditor");
+	PropertyEditor.UnregisterCustomClassLayout(UWeaponRecoilPattern::StaticClass()->GetFName());
+	PropertyEditor.NotifyCustomizationModuleChanged();
+}
+
 #undef LOCTEXT_NAMESPACE
 	
 IMPLEMENT_MODULE(FUSKEditorModule, USKEditor)
\ No newline at end of file
@@ -24,4 +24,6 @@ private:
 		const FString& AssetName, FColor AssetColor, UClass* AssetClass);
 	void RegisterDialogue(IAssetTools& AssetTools, EAssetTypeCategories::Type Category,
 		const FString& AssetName, FColor AssetColor, UClass* AssetClass);
+	void RegisterDetailCustomizations();
+	void UnregisterDetailCustomizations();
 };
@@ -0,0 +1,81 @@
+﻿// Created by Henry Jooste
+
+#include "SWeaponRecoilPatternPreview.h"
+
+#include "EditorStyleSet.h"
+#include "Rendering/DrawElements.h"
+
+/**
+ * @brief Construct the widget
+ * @param InArgs The arguments used to construct the widget
+ */
+void SWeaponRecoilPatternPreview::Construct(const FArguments& InArgs)
+{
+	RecoilPattern = InArgs._RecoilPattern;
+}
+
+/**
+ * @brief Draw the recoil table of the recoil pattern
+ * @param Args The arguments used to paint the widget
+ * @param AllottedGeometry The geometry of the widget
+ * @param MyCullingRect The culling rect of the widget
+ * @param OutDrawElements The list of elements to draw
+ * @param LayerId The layer of the widget
+ * @param InWidgetStyle The style of the widget
+ * @param bParentEnabled Is the parent of the widget enabled?
+ * @return The maximum layer used by the widget
+ */
+int32 SWeaponRecoilPatternPreview::OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry,
+	const FSlateRect& MyCullingRect, FSlateWindowElementList& OutDrawElements, const int32 LayerId,
+	const FWidgetStyle& InWidgetStyle, const bool bParentEnabled) const
+{
+	const FVector2D Size = AllottedGeometry.GetLocalSize();
+	FSlateDrawElement::MakeBox(OutDrawElements, LayerId, AllottedGeometry.ToPaintGeometry(),
+#if ENGINE_MAJOR_VERSION >= 5 && ENGINE_MINOR_VERSION >= 1
+		FAppStyle::GetBrush(TEXT("WhiteBrush")),
+#else
+		FEditorStyle::GetBrush(TEXT("WhiteBrush")),
+#endif
+		ESlateDrawEffect::None, FLinearColor(0.02f, 0.02f, 0.02f));
+
+	const TArray<FVector2D> Crosshair = { FVector2D(Size.X * 0.5f, 0.0f), FVector2D(Size.X * 0.5f, Size.Y) };
+	FSlateDrawElement::MakeLines(OutDrawElements, LayerId + 1, AllottedGeometry.ToPaintGeometry(), Crosshair,
+		ESlateDrawEffect::None, FLinearColor(0.2f, 0.2f, 0.2f));
+
+	const UWeaponRecoilPattern* Pattern = RecoilPattern.Get();
+	if (Pattern == nullptr || Pattern->RecoilTable.Num() < 2)
+	{
+		return LayerId + 1;
+	}
+
+	// Scale the pattern to fit the widget with the start of the recoil at the bottom center
+	float MaxOffset = KINDA_SMALL_NUMBER;
+	for (const FVector2D& Offset : Pattern->RecoilTable)
+	{
+		MaxOffset = FMath::Max3(MaxOffset, FMath::Abs(Offset.X), FMath::Abs(Offset.Y) * 2.0f);
+	}
+
+	const float Scale = (FMath::Min(Size.X, Size.Y) - 20.0f) / MaxOffset;
+	const FVector2D Origin(Size.X * 0.5f, Size.Y - 10.0f);
+	TArray<FVector2D> Points;
+	Points.Reserve(Pattern->RecoilTable.Num());
+	for (const FVector2D& Offset : Pattern->RecoilTable)
+	{
+		Points.Add(Origin + FVector2D(Offset.Y, -Offset.X) * Scale);
+	}
+
+	FSlateDrawElement::MakeLines(OutDrawElements, LayerId + 2, AllottedGeometry.ToPaintGeometry(), Points,
+		ESlateDrawEffect::None, FLinearColor(0.2f, 1.0f, 0.7f), true, 2.0f);
+
+	return LayerId + 2;
+}
+
+/**
+ * @brief Get the size the widget would like to be
+ * @param LayoutScaleMultiplier The scale applied to the layout
+ * @return The size the widget would like to be
+ */
+FVector2D SWeaponRecoilPatternPreview::ComputeDesiredSize(float LayoutScaleMultiplier) const
+{
+	return FVector2D(200.0f, 200.0f);
+}
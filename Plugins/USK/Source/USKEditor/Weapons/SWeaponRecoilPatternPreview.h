@@ -0,0 +1,53 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "USK/Weapons/WeaponRecoilPattern.h"
+#include "Widgets/SLeafWidget.h"
+
+/**
+ * @brief Widget used to preview the baked recoil table of a recoil pattern
+ */
+class USKEDITOR_API SWeaponRecoilPatternPreview : public SLeafWidget
+{
+public:
+	SLATE_BEGIN_ARGS(SWeaponRecoilPatternPreview) { }
+		SLATE_ARGUMENT(TWeakObjectPtr<UWeaponRecoilPattern>, RecoilPattern)
+	SLATE_END_ARGS()
+
+	/**
+	 * @brief Construct the widget
+	 * @param InArgs The arguments used to construct the widget
+	 */
+	void Construct(const FArguments& InArgs);
+
+	/**
+	 * @brief Draw the recoil table of the recoil pattern
+	 * @param Args The arguments used to paint the widget
+	 * @param AllottedGeometry The geometry of the widget
+	 * @param MyCullingRect The culling rect of the widget
+	 * @param OutDrawElements The list of elements to draw
+	 * @param LayerId The layer of the widget
+	 * @param InWidgetStyle The style of the widget
+	 * @param bParentEnabled Is the parent of the widget enabled?
+	 * @return The maximum layer used by the widget
+	 */
+	virtual int32 OnPaint(const FPaintArgs& Args, const FGeometry& AllottedGeometry, const FSlateRect& MyCullingRect,
+		FSlateWindowElementList& OutDrawElements, int32 LayerId, const FWidgetStyle& InWidgetStyle,
+		bool bParentEnabled) const override;
+
+protected:
+	/**
+	 * @brief Get the size the widget would like to be
+	 * @param LayoutScaleMultiplier The scale applied to the layout
+	 * @return The size the widget would like to be
+	 */
+	virtual FVector2D ComputeDesiredSize(float LayoutScaleMultiplier) const override;
+
+private:
+	/**
+	 * @brief The recoil pattern to preview
+	 */
+	TWeakObjectPtr<UWeaponRecoilPattern> RecoilPattern;
+};
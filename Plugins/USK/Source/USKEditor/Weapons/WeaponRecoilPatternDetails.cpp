@@ -0,0 +1,45 @@
+﻿// Created by Henry Jooste
+
+#include "WeaponRecoilPatternDetails.h"
+
+#include "DetailCategoryBuilder.h"
+#include "DetailLayoutBuilder.h"
+#include "DetailWidgetRow.h"
+#include "SWeaponRecoilPatternPreview.h"
+#include "Widgets/Layout/SBox.h"
+
+/**
+ * @brief Create a new instance of the details customization
+ * @return The details customization
+ */
+TSharedRef<IDetailCustomization> FWeaponRecoilPatternDetails::MakeInstance()
+{
+	return MakeShareable(new FWeaponRecoilPatternDetails());
+}
+
+/**
+ * @brief Add the preview to the details panel
+ * @param DetailBuilder The builder used to customize the details panel
+ */
+void FWeaponRecoilPatternDetails::CustomizeDetails(IDetailLayoutBuilder& DetailBuilder)
+{
+	TArray<TWeakObjectPtr<UObject>> Objects;
+	DetailBuilder.GetObjectsBeingCustomized(Objects);
+	if (Objects.Num() != 1)
+	{
+		return;
+	}
+
+	const TWeakObjectPtr<UWeaponRecoilPattern> RecoilPattern = Cast<UWeaponRecoilPattern>(Objects[0].Get());
+	IDetailCategoryBuilder& Category = DetailBuilder.EditCategory("Preview");
+	Category.AddCustomRow(FText::FromString("Recoil Preview"))
+		.WholeRowContent()
+		[
+			SNew(SBox)
+			.HeightOverride(250.0f)
+			[
+				SNew(SWeaponRecoilPatternPreview)
+				.RecoilPattern(RecoilPattern)
+			]
+		];
+}
@@ -0,0 +1,25 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IDetailCustomization.h"
+
+/**
+ * @brief Details customization that adds a preview of the baked recoil table to recoil patterns
+ */
+class USKEDITOR_API FWeaponRecoilPatternDetails : public IDetailCustomization
+{
+public:
+	/**
+	 * @brief Create a new instance of the details customization
+	 * @return The details customization
+	 */
+	static TSharedRef<IDetailCustomization> MakeInstance();
+
+	/**
+	 * @brief Add the preview to the details panel
+	 * @param DetailBuilder The builder used to customize the details panel
+	 */
+	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
+};
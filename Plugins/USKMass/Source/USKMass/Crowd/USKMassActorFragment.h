@@ -0,0 +1,32 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "USKMassActorFragment.generated.h"
+
+class AUSKCharacter;
+
+/**
+ * @brief The actor representing a crowd entity while it is close to a player
+ */
+USTRUCT()
+struct USKMASS_API FUSKMassActorFragment : public FMassFragment
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The spawned character or null while the entity is simulated in bulk
+	 */
+	TWeakObjectPtr<AUSKCharacter> Actor;
+};
+
+/**
+ * @brief Tag added to crowd entities that are currently represented by an actor
+ */
+USTRUCT()
+struct USKMASS_API FUSKMassActorTag : public FMassTag
+{
+	GENERATED_USTRUCT_BODY()
+};
@@ -0,0 +1,62 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "Math/RandomStream.h"
+#include "USKMassMovementFragment.generated.h"
+
+/**
+ * @brief The movement state of a crowd entity that is simulated without an actor
+ */
+USTRUCT()
+struct USKMASS_API FUSKMassMovementFragment : public FMassFragment
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The current velocity of the entity
+	 */
+	FVector Velocity = FVector::ZeroVector;
+
+	/**
+	 * @brief The location the entity wanders around
+	 */
+	FVector Origin = FVector::ZeroVector;
+
+	/**
+	 * @brief The location the entity is currently moving towards
+	 */
+	FVector Destination = FVector::ZeroVector;
+
+	/**
+	 * @brief The height of the entity when it is standing on the ground below it
+	 */
+	float GroundZ = 0.0f;
+
+	/**
+	 * @brief The world time at which the ground below the entity is traced again
+	 */
+	float NextGroundTraceTime = 0.0f;
+
+	/**
+	 * @brief The random stream used to pick destinations without sharing state between worker threads
+	 */
+	FRandomStream RandomStream;
+
+	/**
+	 * @brief Is the entity sprinting towards its destination?
+	 */
+	bool bSprinting = false;
+
+	/**
+	 * @brief Is the entity falling or jumping?
+	 */
+	bool bFalling = false;
+
+	/**
+	 * @brief Was the entity initialized from its spawn location?
+	 */
+	bool bInitialized = false;
+};
@@ -0,0 +1,102 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTypes.h"
+#include "Engine/EngineTypes.h"
+#include "USK/Character/USKCharacter.h"
+#include "USKMassMovementParameters.generated.h"
+
+/**
+ * @brief The movement values shared by all crowd entities created from the same USK character class
+ */
+USTRUCT()
+struct USKMASS_API FUSKMassMovementParameters : public FMassConstSharedFragment
+{
+	GENERATED_USTRUCT_BODY()
+
+	/**
+	 * @brief The character class spawned when an entity is upgraded to an actor
+	 */
+	UPROPERTY()
+	TSubclassOf<AUSKCharacter> CharacterClass;
+
+	/**
+	 * @brief The default movement speed of the character
+	 */
+	UPROPERTY()
+	float MovementSpeed = 600.0f;
+
+	/**
+	 * @brief The movement speed of the character while sprinting
+	 */
+	UPROPERTY()
+	float SprintSpeed = 950.0f;
+
+	/**
+	 * @brief The vertical velocity applied when the entity jumps onto higher ground
+	 */
+	UPROPERTY()
+	float JumpVelocity = 700.0f;
+
+	/**
+	 * @brief The vertical acceleration applied while falling
+	 */
+	UPROPERTY()
+	float GravityZ = -1960.0f;
+
+	/**
+	 * @brief The half height of the capsule of the character, used to place the entity above the ground
+	 */
+	UPROPERTY()
+	float HalfHeight = 88.0f;
+
+	/**
+	 * @brief The maximum height difference the entity can walk up without jumping
+	 */
+	UPROPERTY()
+	float StepHeight = 45.0f;
+
+	/**
+	 * @brief The maximum distance between the spawn location and the wander destinations of the entity
+	 */
+	UPROPERTY()
+	float WanderRadius = 1500.0f;
+
+	/**
+	 * @brief The chance (0 - 1) that the entity sprints towards a new destination
+	 */
+	UPROPERTY()
+	float SprintChance = 0.25f;
+
+	/**
+	 * @brief The amount of seconds between ground traces of an entity
+	 */
+	UPROPERTY()
+	float GroundTraceInterval = 0.25f;
+
+	/**
+	 * @brief The collision channel used to find the ground below the entity
+	 */
+	UPROPERTY()
+	TEnumAsByte<ECollisionChannel> GroundTraceChannel = ECC_Visibility;
+
+	/**
+	 * @brief The distance to the closest player at which the entity is upgraded to an actor
+	 */
+	UPROPERTY()
+	float UpgradeDistance = 3000.0f;
+
+	/**
+	 * @brief The distance to the closest player at which the actor is downgraded to an entity again
+	 */
+	UPROPERTY()
+	float DowngradeDistance = 3500.0f;
+
+	/**
+	 * @brief The maximum amount of actors spawned per frame for entities using these parameters
+	 */
+	UPROPERTY()
+	int MaxUpgradesPerFrame = 2;
+};
@@ -0,0 +1,125 @@
+﻿// Created by Henry Jooste
+
+#include "USKMassMovementProcessor.h"
+
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "USKMassActorFragment.h"
+#include "USKMassMovementFragment.h"
+#include "USKMassMovementParameters.h"
+
+/**
+ * @brief Create a new instance of the UUSKMassMovementProcessor processor
+ */
+UUSKMassMovementProcessor::UUSKMassMovementProcessor()
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+	ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Movement;
+	bRequiresGameThreadExecution = false;
+	EntityQuery.RegisterWithProcessor(*this);
+}
+
+/**
+ * @brief Get the horizontal velocity towards the destination of an entity and pick a new destination when reached
+ * @param Location The current location of the entity
+ * @param Movement The movement state of the entity
+ * @param Parameters The movement values of the entity
+ * @return The horizontal velocity of the entity
+ */
+FVector UUSKMassMovementProcessor::GetDesiredVelocity(const FVector& Location, FUSKMassMovementFragment& Movement,
+	const FUSKMassMovementParameters& Parameters)
+{
+	const float Speed = Movement.bSprinting ? Parameters.SprintSpeed : Parameters.MovementSpeed;
+	FVector Direction = Movement.Destination - Location;
+	Direction.Z = 0.0f;
+	if (Direction.SizeSquared() <= FMath::Square(Speed * 0.1f))
+	{
+		const FVector2D Offset = FVector2D(Movement.RandomStream.FRandRange(-1.0f, 1.0f),
+			Movement.RandomStream.FRandRange(-1.0f, 1.0f)).GetSafeNormal() *
+			Movement.RandomStream.FRandRange(0.0f, Parameters.WanderRadius);
+		Movement.Destination = Movement.Origin + FVector(Offset.X, Offset.Y, 0.0f);
+		Movement.bSprinting = Movement.RandomStream.FRand() < Parameters.SprintChance;
+		return FVector::ZeroVector;
+	}
+
+	return Direction.GetUnsafeNormal() * Speed;
+}
+
+/**
+ * @brief Configure the fragments required by the entity query
+ */
+void UUSKMassMovementProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FUSKMassMovementFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddConstSharedRequirement<FUSKMassMovementParameters>();
+	EntityQuery.AddTagRequirement<FUSKMassActorTag>(EMassFragmentPresence::None);
+}
+
+/**
+ * @brief Move the crowd entities
+ * @param EntityManager The entity manager that owns the entities
+ * @param Context The execution context of the processor
+ */
+void UUSKMassMovementProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [](FMassExecutionContext& ChunkContext)
+	{
+		const FUSKMassMovementParameters& Parameters =
+			ChunkContext.GetConstSharedFragment<FUSKMassMovementParameters>();
+		const TArrayView<FTransformFragment> Transforms = ChunkContext.GetMutableFragmentView<FTransformFragment>();
+		const TArrayView<FUSKMassMovementFragment> Movements =
+			ChunkContext.GetMutableFragmentView<FUSKMassMovementFragment>();
+		const float DeltaTime = ChunkContext.GetDeltaTimeSeconds();
+
+		for (int EntityIndex = 0; EntityIndex < ChunkContext.GetNumEntities(); EntityIndex++)
+		{
+			FTransform& Transform = Transforms[EntityIndex].GetMutableTransform();
+			FUSKMassMovementFragment& Movement = Movements[EntityIndex];
+			FVector Location = Transform.GetLocation();
+			if (!Movement.bInitialized)
+			{
+				Movement.Origin = Location;
+				Movement.Destination = Location;
+				Movement.GroundZ = Location.Z;
+				Movement.RandomStream.Initialize(ChunkContext.GetEntity(EntityIndex).Index);
+				Movement.bInitialized = true;
+			}
+
+			const FVector DesiredVelocity = GetDesiredVelocity(Location, Movement, Parameters);
+			Movement.Velocity.X = DesiredVelocity.X;
+			Movement.Velocity.Y = DesiredVelocity.Y;
+
+			// Jump onto ground that is too high to step onto, the same way a character would need to
+			if (!Movement.bFalling && Movement.GroundZ > Location.Z + Parameters.StepHeight)
+			{
+				Movement.Velocity.Z = Parameters.JumpVelocity;
+				Movement.bFalling = true;
+			}
+			else if (!Movement.bFalling && Location.Z > Movement.GroundZ + Parameters.StepHeight)
+			{
+				Movement.bFalling = true;
+			}
+
+			if (Movement.bFalling)
+			{
+				Movement.Velocity.Z += Parameters.GravityZ * DeltaTime;
+			}
+
+			Location += Movement.Velocity * DeltaTime;
+			if (!Movement.bFalling || (Location.Z <= Movement.GroundZ && Movement.Velocity.Z <= 0.0f))
+			{
+				Location.Z = Movement.GroundZ;
+				Movement.Velocity.Z = 0.0f;
+				Movement.bFalling = false;
+			}
+
+			Transform.SetLocation(Location);
+			if (!DesiredVelocity.IsNearlyZero())
+			{
+				Transform.SetRotation(DesiredVelocity.ToOrientationQuat());
+			}
+		}
+	});
+}
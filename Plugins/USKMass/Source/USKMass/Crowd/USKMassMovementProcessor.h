@@ -0,0 +1,54 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "USKMassMovementProcessor.generated.h"
+
+struct FUSKMassMovementFragment;
+struct FUSKMassMovementParameters;
+
+/**
+ * @brief Mass processor that moves all crowd entities without an actor in bulk using the USK movement values
+ */
+UCLASS()
+class USKMASS_API UUSKMassMovementProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Create a new instance of the UUSKMassMovementProcessor processor
+	 */
+	UUSKMassMovementProcessor();
+
+	/**
+	 * @brief Get the horizontal velocity towards the destination of an entity and pick a new destination when reached
+	 * @param Location The current location of the entity
+	 * @param Movement The movement state of the entity
+	 * @param Parameters The movement values of the entity
+	 * @return The horizontal velocity of the entity
+	 */
+	static FVector GetDesiredVelocity(const FVector& Location, FUSKMassMovementFragment& Movement,
+		const FUSKMassMovementParameters& Parameters);
+
+protected:
+	/**
+	 * @brief Configure the fragments required by the entity query
+	 */
+	virtual void ConfigureQueries() override;
+
+	/**
+	 * @brief Move the crowd entities
+	 * @param EntityManager The entity manager that owns the entities
+	 * @param Context The execution context of the processor
+	 */
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	/**
+	 * @brief The query used to find crowd entities that are not represented by an actor
+	 */
+	FMassEntityQuery EntityQuery;
+};
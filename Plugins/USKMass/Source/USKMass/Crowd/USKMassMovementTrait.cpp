@@ -0,0 +1,57 @@
+﻿// Created by Henry Jooste
+
+#include "USKMassMovementTrait.h"
+
+#include "MassCommonFragments.h"
+#include "MassEntityTemplateRegistry.h"
+#include "MassEntityUtils.h"
+#include "USKMassActorFragment.h"
+#include "USKMassMovementFragment.h"
+#include "USKMassMovementParameters.h"
+#include "Components/CapsuleComponent.h"
+#include "Engine/World.h"
+#include "USK/Character/USKCharacter.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Add the fragments used by the crowd processors to the entity template
+ * @param BuildContext The context used to build the entity template
+ * @param World The world the entities are spawned in
+ */
+void UUSKMassMovementTrait::BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const
+{
+	BuildContext.AddFragment<FTransformFragment>();
+	BuildContext.AddFragment<FUSKMassMovementFragment>();
+	BuildContext.AddFragment<FUSKMassActorFragment>();
+
+	FUSKMassMovementParameters Parameters;
+	Parameters.CharacterClass = CharacterClass;
+	Parameters.StepHeight = StepHeight;
+	Parameters.WanderRadius = WanderRadius;
+	Parameters.SprintChance = SprintChance;
+	Parameters.GroundTraceInterval = GroundTraceInterval;
+	Parameters.GroundTraceChannel = GroundTraceChannel;
+	Parameters.UpgradeDistance = UpgradeDistance;
+	Parameters.DowngradeDistance = FMath::Max(UpgradeDistance, DowngradeDistance);
+	Parameters.MaxUpgradesPerFrame = MaxUpgradesPerFrame;
+
+	// The tuning values are read from the class defaults so the crowd always matches the actor it upgrades to
+	const AUSKCharacter* Character = CharacterClass != nullptr
+		? CharacterClass->GetDefaultObject<AUSKCharacter>()
+		: nullptr;
+	if (IsValid(Character))
+	{
+		Parameters.MovementSpeed = Character->MovementSpeed;
+		Parameters.SprintSpeed = Character->SprintSpeed;
+		Parameters.JumpVelocity = Character->JumpVelocity;
+		Parameters.GravityZ = Character->Gravity * World.GetGravityZ();
+		Parameters.HalfHeight = Character->GetCapsuleComponent()->GetScaledCapsuleHalfHeight();
+	}
+	else
+	{
+		USK_LOG_WARNING("No character class specified for the crowd movement trait. Using default movement values");
+	}
+
+	FMassEntityManager& EntityManager = UE::Mass::Utils::GetEntityManagerChecked(World);
+	BuildContext.AddConstSharedFragment(EntityManager.GetOrCreateConstSharedFragment(Parameters));
+}
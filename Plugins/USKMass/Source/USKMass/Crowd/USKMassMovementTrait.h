@@ -0,0 +1,82 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassEntityTraitBase.h"
+#include "Engine/EngineTypes.h"
+#include "USKMassMovementTrait.generated.h"
+
+class AUSKCharacter;
+
+/**
+ * @brief Mass trait that simulates a crowd entity using the movement values of a USK character class
+ */
+UCLASS(meta = (DisplayName = "USK Crowd Movement"))
+class USKMASS_API UUSKMassMovementTrait : public UMassEntityTraitBase
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief The character class used for the movement values and spawned when the entity is close to a player
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ultimate Starter Kit|Crowd")
+	TSubclassOf<AUSKCharacter> CharacterClass;
+
+	/**
+	 * @brief The maximum height difference the entity can walk up without jumping
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ultimate Starter Kit|Crowd", meta = (ClampMin = 0))
+	float StepHeight = 45.0f;
+
+	/**
+	 * @brief The maximum distance between the spawn location and the wander destinations of the entity
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ultimate Starter Kit|Crowd", meta = (ClampMin = 0))
+	float WanderRadius = 1500.0f;
+
+	/**
+	 * @brief The chance (0 - 1) that the entity sprints towards a new destination
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ultimate Starter Kit|Crowd", meta = (ClampMin = 0, ClampMax = 1))
+	float SprintChance = 0.25f;
+
+	/**
+	 * @brief The amount of seconds between ground traces of an entity
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ultimate Starter Kit|Crowd", meta = (ClampMin = 0))
+	float GroundTraceInterval = 0.25f;
+
+	/**
+	 * @brief The collision channel used to find the ground below the entity
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ultimate Starter Kit|Crowd")
+	TEnumAsByte<ECollisionChannel> GroundTraceChannel = ECC_Visibility;
+
+	/**
+	 * @brief The distance to the closest player at which the entity is upgraded to an actor
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ultimate Starter Kit|Crowd", meta = (ClampMin = 0))
+	float UpgradeDistance = 3000.0f;
+
+	/**
+	 * @brief The distance to the closest player at which the actor is downgraded to an entity again
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ultimate Starter Kit|Crowd", meta = (ClampMin = 0))
+	float DowngradeDistance = 3500.0f;
+
+	/**
+	 * @brief The maximum amount of actors spawned per frame for entities using this trait
+	 */
+	UPROPERTY(EditAnywhere, Category = "Ultimate Starter Kit|Crowd", meta = (ClampMin = 1))
+	int MaxUpgradesPerFrame = 2;
+
+protected:
+	/**
+	 * @brief Add the fragments used by the crowd processors to the entity template
+	 * @param BuildContext The context used to build the entity template
+	 * @param World The world the entities are spawned in
+	 */
+	virtual void BuildTemplate(FMassEntityTemplateBuildContext& BuildContext, const UWorld& World) const override;
+};
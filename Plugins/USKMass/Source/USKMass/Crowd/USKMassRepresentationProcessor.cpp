@@ -0,0 +1,166 @@
+﻿// Created by Henry Jooste
+
+#include "USKMassRepresentationProcessor.h"
+
+#include "MassCommonFragments.h"
+#include "MassCommonTypes.h"
+#include "MassExecutionContext.h"
+#include "USKMassActorFragment.h"
+#include "USKMassMovementFragment.h"
+#include "USKMassMovementParameters.h"
+#include "USKMassMovementProcessor.h"
+#include "Engine/World.h"
+#include "GameFramework/CharacterMovementComponent.h"
+#include "GameFramework/PlayerController.h"
+#include "USK/Character/USKCharacter.h"
+#include "USK/Logger/Log.h"
+
+/**
+ * @brief Create a new instance of the UUSKMassRepresentationProcessor processor
+ */
+UUSKMassRepresentationProcessor::UUSKMassRepresentationProcessor()
+{
+	ExecutionFlags = static_cast<int32>(EProcessorExecutionFlags::All);
+	ExecutionOrder.ExecuteInGroup = UE::Mass::ProcessorGroupNames::Representation;
+	ExecutionOrder.ExecuteAfter.Add(UE::Mass::ProcessorGroupNames::Movement);
+	bRequiresGameThreadExecution = true;
+	EntityQuery.RegisterWithProcessor(*this);
+}
+
+/**
+ * @brief Configure the fragments required by the entity query
+ */
+void UUSKMassRepresentationProcessor::ConfigureQueries()
+{
+	EntityQuery.AddRequirement<FTransformFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FUSKMassMovementFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddRequirement<FUSKMassActorFragment>(EMassFragmentAccess::ReadWrite);
+	EntityQuery.AddConstSharedRequirement<FUSKMassMovementParameters>();
+}
+
+/**
+ * @brief Trace the ground below the crowd entities and swap between entities and actors based on player distance
+ * @param EntityManager The entity manager that owns the entities
+ * @param Context The execution context of the processor
+ */
+void UUSKMassRepresentationProcessor::Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context)
+{
+	UWorld* World = EntityManager.GetWorld();
+	if (!IsValid(World))
+	{
+		return;
+	}
+
+	PlayerLocations.Reset();
+	for (FConstPlayerControllerIterator Iterator = World->GetPlayerControllerIterator(); Iterator; ++Iterator)
+	{
+		const APlayerController* PlayerController = Iterator->Get();
+		if (IsValid(PlayerController) && IsValid(PlayerController->GetPawn()))
+		{
+			PlayerLocations.Add(PlayerController->GetPawn()->GetActorLocation());
+		}
+	}
+
+	// The characters are replicated, so only the server and standalone games swap entities and actors. Clients
+	// receive the characters from the server and only keep the ground of the bulk simulated entities up to date
+	const bool bCanSwapRepresentation = World->GetNetMode() != NM_Client;
+	const float CurrentTime = World->GetTimeSeconds();
+	int Upgrades = 0;
+	EntityQuery.ForEachEntityChunk(EntityManager, Context, [this, World, CurrentTime, bCanSwapRepresentation,
+		&Upgrades](FMassExecutionContext& ChunkContext)
+	{
+		const FUSKMassMovementParameters& Parameters =
+			ChunkContext.GetConstSharedFragment<FUSKMassMovementParameters>();
+		const TArrayView<FTransformFragment> Transforms = ChunkContext.GetMutableFragmentView<FTransformFragment>();
+		const TArrayView<FUSKMassMovementFragment> Movements =
+			ChunkContext.GetMutableFragmentView<FUSKMassMovementFragment>();
+		const TArrayView<FUSKMassActorFragment> Actors = ChunkContext.GetMutableFragmentView<FUSKMassActorFragment>();
+		const float UpgradeDistanceSquared = FMath::Square(Parameters.UpgradeDistance);
+		const float DowngradeDistanceSquared = FMath::Square(Parameters.DowngradeDistance);
+
+		for (int EntityIndex = 0; EntityIndex < ChunkContext.GetNumEntities(); EntityIndex++)
+		{
+			FTransform& Transform = Transforms[EntityIndex].GetMutableTransform();
+			FUSKMassMovementFragment& Movement = Movements[EntityIndex];
+			FUSKMassActorFragment& ActorFragment = Actors[EntityIndex];
+			const FMassEntityHandle Entity = ChunkContext.GetEntity(EntityIndex);
+			AUSKCharacter* Character = ActorFragment.Actor.Get();
+			if (ActorFragment.Actor.IsStale())
+			{
+				// The actor was destroyed by gameplay, so the entity continues to be simulated in bulk
+				ActorFragment.Actor.Reset();
+				ChunkContext.Defer().RemoveTag<FUSKMassActorTag>(Entity);
+			}
+
+			if (IsValid(Character))
+			{
+				Transform = Character->GetActorTransform();
+			}
+
+			float ClosestDistanceSquared = TNumericLimits<float>::Max();
+			for (const FVector& PlayerLocation : PlayerLocations)
+			{
+				ClosestDistanceSquared = FMath::Min(ClosestDistanceSquared,
+					FVector::DistSquared(PlayerLocation, Transform.GetLocation()));
+			}
+
+			if (IsValid(Character))
+			{
+				if (ClosestDistanceSquared <= DowngradeDistanceSquared)
+				{
+					const FVector Direction = UUSKMassMovementProcessor::GetDesiredVelocity(
+						Transform.GetLocation(), Movement, Parameters).GetSafeNormal();
+					Character->AddMovementInput(Direction);
+					continue;
+				}
+
+				Movement.Velocity = Character->GetVelocity();
+				Movement.bFalling = Character->GetCharacterMovement()->IsFalling();
+				Movement.GroundZ = Transform.GetLocation().Z;
+				Movement.NextGroundTraceTime = 0.0f;
+				Character->Destroy();
+				ActorFragment.Actor.Reset();
+				ChunkContext.Defer().RemoveTag<FUSKMassActorTag>(Entity);
+				continue;
+			}
+
+			if (bCanSwapRepresentation && ClosestDistanceSquared <= UpgradeDistanceSquared &&
+				Upgrades < Parameters.MaxUpgradesPerFrame && Parameters.CharacterClass != nullptr &&
+				Movement.bInitialized)
+			{
+				FActorSpawnParameters SpawnParameters;
+				SpawnParameters.SpawnCollisionHandlingOverride =
+					ESpawnActorCollisionHandlingMethod::AdjustIfPossibleButAlwaysSpawn;
+				Character = World->SpawnActor<AUSKCharacter>(Parameters.CharacterClass, Transform, SpawnParameters);
+				if (IsValid(Character))
+				{
+					Upgrades++;
+					Character->SpawnDefaultController();
+					Character->GetCharacterMovement()->Velocity = Movement.Velocity;
+					ActorFragment.Actor = Character;
+					ChunkContext.Defer().AddTag<FUSKMassActorTag>(Entity);
+					continue;
+				}
+
+				USK_LOG_ERROR("Failed to spawn the character of a crowd entity");
+			}
+
+			if (CurrentTime < Movement.NextGroundTraceTime)
+			{
+				continue;
+			}
+
+			// Spread the traces of entities spawned on the same frame over the interval
+			Movement.NextGroundTraceTime = CurrentTime + Parameters.GroundTraceInterval *
+				Movement.RandomStream.FRandRange(0.75f, 1.25f);
+			const FVector Location = Transform.GetLocation();
+			const FVector TraceStart = Location + FVector(0.0f, 0.0f, Parameters.StepHeight * 2.0f);
+			const FVector TraceEnd = Location - FVector(0.0f, 0.0f, Parameters.HalfHeight * 20.0f);
+			FHitResult HitResult;
+			if (World->LineTraceSingleByChannel(HitResult, TraceStart, TraceEnd, Parameters.GroundTraceChannel))
+			{
+				Movement.GroundZ = HitResult.Location.Z + Parameters.HalfHeight;
+			}
+		}
+	});
+}
@@ -0,0 +1,46 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "MassProcessor.h"
+#include "USKMassRepresentationProcessor.generated.h"
+
+/**
+ * @brief Mass processor that upgrades crowd entities to USK characters close to a player and downgrades them again
+ */
+UCLASS()
+class USKMASS_API UUSKMassRepresentationProcessor : public UMassProcessor
+{
+	GENERATED_BODY()
+
+public:
+	/**
+	 * @brief Create a new instance of the UUSKMassRepresentationProcessor processor
+	 */
+	UUSKMassRepresentationProcessor();
+
+protected:
+	/**
+	 * @brief Configure the fragments required by the entity query
+	 */
+	virtual void ConfigureQueries() override;
+
+	/**
+	 * @brief Trace the ground below the crowd entities and swap between entities and actors based on player distance
+	 * @param EntityManager The entity manager that owns the entities
+	 * @param Context The execution context of the processor
+	 */
+	virtual void Execute(FMassEntityManager& EntityManager, FMassExecutionContext& Context) override;
+
+private:
+	/**
+	 * @brief The query used to find all crowd entities
+	 */
+	FMassEntityQuery EntityQuery;
+
+	/**
+	 * @brief The locations of the player pawns, reused between frames
+	 */
+	TArray<FVector> PlayerLocations;
+};
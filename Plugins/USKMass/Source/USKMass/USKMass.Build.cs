@@ -0,0 +1,29 @@
+﻿// Created by Henry Jooste
+
+using UnrealBuildTool;
+
+public class USKMass : ModuleRules
+{
+	public USKMass(ReadOnlyTargetRules Target) : base(Target)
+	{
+		PCHUsage = PCHUsageMode.UseExplicitOrSharedPCHs;
+		
+		PublicIncludePaths.AddRange(new string[] { });
+		PrivateIncludePaths.AddRange(new string[] { });
+		PublicDependencyModuleNames.AddRange(new[]
+		{
+			"Core",
+			"CoreUObject",
+			"Engine",
+			"MassEntity",
+			"MassCommon",
+			"MassSpawner",
+			"StructUtils",
+			"USK"
+		});
+
+		PrivateDependencyModuleNames.AddRange(new string[] { });
+
+		DynamicallyLoadedModuleNames.AddRange(new string[] { });
+	}
+}
@@ -0,0 +1,13 @@
+﻿// Created by Henry Jooste
+
+#include "USKMass.h"
+
+#define LOCTEXT_NAMESPACE "FUSKMassModule"
+
+void FUSKMassModule::StartupModule() { }
+
+void FUSKMassModule::ShutdownModule() { }
+
+#undef LOCTEXT_NAMESPACE
+
+IMPLEMENT_MODULE(FUSKMassModule, USKMass)
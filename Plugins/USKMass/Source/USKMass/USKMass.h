@@ -0,0 +1,12 @@
+﻿// Created by Henry Jooste
+
+#pragma once
+
+#include "Modules/ModuleManager.h"
+
+class FUSKMassModule : public IModuleInterface
+{
+public:
+	virtual void StartupModule() override;
+	virtual void ShutdownModule() override;
+};
@@ -9,6 +9,7 @@ class Args:
     input_file = None
     output_file = None
     widget = None
+    plugin = None
 
     def __init__(self):
         self.parser = argparse.ArgumentParser()
@@ -18,12 +19,15 @@ class Args:
                                  help="Specify the name of the output file", required=True)
         self.parser.add_argument("-w", "--widget", metavar="\b",
                                  help="Specify the name of the widget implementation", required=False)
+        self.parser.add_argument("-p", "--plugin", metavar="\b", default="USK",
+                                 help="Specify the name of the plugin containing the file", required=False)
         self.parse()
 
     def parse(self):
         args = self.parser.parse_args()
+        self.plugin = args.plugin
         self.input_file = args.input.replace(".h", "").replace(".cpp", "") + ".h"
-        self.input_file = os.path.abspath(os.path.join(os.path.dirname(__file__), "..\\..\\..\\Plugins\\USK\\Source\\USK", self.input_file))
+        self.input_file = os.path.abspath(os.path.join(os.path.dirname(__file__), f"..\\..\\..\\Plugins\\{self.plugin}\\Source\\{self.plugin}", self.input_file))
         self.output_file = args.output.replace(".md", "") + ".md"
         self.output_file = os.path.abspath(os.path.join(os.path.dirname(__file__), "..\\..\\..\\docs", self.output_file))
         self.widget = args.widget
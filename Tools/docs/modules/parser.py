@@ -211,6 +211,23 @@ class Parser:
             self.output += html
 
 
+    def extract_declaration(self, section):
+        declaration = section.split("*/")[-1]
+        for macro in ["UFUNCTION", "UPROPERTY"]:
+            if macro not in declaration:
+                continue
+            depth = 0
+            for index in range(declaration.index(macro), len(declaration)):
+                if declaration[index] == "(":
+                    depth += 1
+                elif declaration[index] == ")":
+                    depth -= 1
+                    if depth == 0:
+                        declaration = declaration[index + 1:]
+                        break
+        return " ".join(line.strip() for line in declaration.splitlines() if line.strip() != "")
+
+
     def extract_uproperties(self, only_events):
         properties = []        
         for section in self.sections:
@@ -220,17 +237,17 @@ class Parser:
                 continue
             if only_events and not "BlueprintAssignable" in section:
                 continue
-            lines = section.split("\n")
+            declaration = self.extract_declaration(section)
             description = section.split("@brief")[1].split("*")[0].strip()
             type_index = 0
             while True:
-                type = lines[len(lines) - 1].replace(", ", ",").strip().split(" ")[type_index].strip()
+                type = declaration.replace(", ", ",").strip().split(" ")[type_index].strip()
                 if type in ["static", "virtual", "class"]:
                     type_index += 1
                     continue
                 break
             type = type.replace(",", ", ")
-            name = lines[len(lines) - 1].split(f"{type} ")[1].split("(")[0].strip()[:-1]
+            name = declaration.split(f"{type} ")[1].split("(")[0].strip()[:-1]
             default = ""
             if "=" in name:
                 default = name.split("=")[1].strip()
@@ -347,16 +364,17 @@ class Parser:
             if "UFUNCTION" not in section:
                 continue
             lines = section.split("\n")
+            declaration = self.extract_declaration(section)
             description = section.split("@brief")[1].split("*")[0].strip()
             category = section.split("Category")[1].strip()[1:].strip()[1:].split("\"")[0].strip()
             return_type_index = 0
             while True:
-                return_type = lines[len(lines) - 1].split(" ")[return_type_index].strip()
+                return_type = declaration.split(" ")[return_type_index].strip()
                 if return_type == "static" or return_type == "virtual":
                     return_type_index += 1
                     continue
                 break
-            name = lines[len(lines) - 1].split(return_type)[1].split("(")[0].strip()
+            name = declaration.split(return_type)[1].split("(")[0].strip()
             display_name = re.sub("([a-z])([A-Z])","\g<1> \g<2>", name)
             if "DisplayName" in section:
                 display_name = section.split("DisplayName")[1].split("=")[1].split("\"")[1]
@@ -367,7 +385,7 @@ class Parser:
             for line in lines:
                 if "@param" in line:
                     param_name = line.strip().split("@param ")[1].split(" ")[0].strip()
-                    param_type = lines[len(lines) - 1].split(f" {param_name}")[0].replace("const", "").strip()
+                    param_type = declaration.split(f" {param_name}")[0].replace("const", "").strip()
                     if " " in param_type:
                         param_type = param_type.split(" ")[-1].strip()
                     if "," in param_type:
@@ -386,7 +404,7 @@ class Parser:
                 "category": category.replace("|", " > "),
                 "params": params,
                 "void": "void " in section,
-                "static": "static " in lines[len(lines) - 1],
+                "static": "static " in declaration,
                 "return_type": return_type,
                 "return_description": return_description
             })
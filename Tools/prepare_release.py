@@ -5,18 +5,37 @@ print(f"Documentation script path: {docs}\n")
 
 os.system(f"python \"{docs}\" --input \"Audio\\AudioUtils\" --output audioutils")
 os.system(f"python \"{docs}\" --input \"Audio\\MusicPlayer\" --output music")
+os.system(f"python \"{docs}\" --input \"Effects\\ParticleFxSubsystem\" --output particlefxsubsystem")
+os.system(f"python \"{docs}\" --input \"Effects\\ParticleFxUtils\" --output particlefxutils")
 
 os.system(f"python \"{docs}\" --input \"Character\\USKCharacterAnimationInstance\" --output characteranimationinstance")
+os.system(f"python \"{docs}\" --input \"Character\\USKCharacterAnimationSnapshot\" --output characteranimationsnapshot")
+os.system(f"python \"{docs}\" --input \"Character\\USKCharacterAnimationSet\" --output characteranimationset")
+os.system(f"python \"{docs}\" --input \"Character\\USKCharacterAnimationSetEntry\" --output characteranimationsetentry")
+os.system(f"python \"{docs}\" --input \"Character\\USKCharacterAnimations\" --output characteranimations")
 os.system(f"python \"{docs}\" --input \"Character\\PlatformerCharacter\" --output platformercharacter")
 os.system(f"python \"{docs}\" --input \"Character\\ShadowDecal\" --output platformershadow")
+os.system(f"python \"{docs}\" --input \"Character\\CharacterSignificanceSubsystem\" --output charactersignificancesubsystem")
+os.system(f"python \"{docs}\" --input \"Character\\CharacterSignificanceConfig\" --output charactersignificanceconfig")
+os.system(f"python \"{docs}\" --input \"Character\\CharacterSignificanceBucket\" --output charactersignificancebucket")
 os.system(f"python \"{docs}\" --input \"Character\\USKCharacter\" --output uskcharacter")
+os.system(f"python \"{docs}\" --input \"Character\\USKCharacterState\" --output uskcharacterstate")
+os.system(f"python \"{docs}\" --input \"Character\\USKCharacterMovementComponent\" --output uskcharactermovementcomponent")
+os.system(f"python \"{docs}\" --input \"Character\\USKMovementLaunch\" --output uskmovementlaunch")
 os.system(f"python \"{docs}\" --input \"Character\\FpsCharacter\" --output fpscharacter")
 
+os.system(f"python \"{docs}\" --plugin USKMass --input \"Crowd\\USKMassMovementTrait\" --output uskmassmovementtrait")
+os.system(f"python \"{docs}\" --plugin USKMass --input \"Crowd\\USKMassMovementParameters\" --output uskmassmovementparameters")
+
 os.system(f"python \"{docs}\" --input \"Core\\InputDevice\" --output inputdevice")
 os.system(f"python \"{docs}\" --input \"Core\\USKGameInstance\" --output gameinstance")
 
 os.system(f"python \"{docs}\" --input \"Data\\TrackableData\" --output trackabledata")
 os.system(f"python \"{docs}\" --input \"Data\\TrackableDataComponent\" --output trackabledatacomponent")
+os.system(f"python \"{docs}\" --input \"Data\\TrackableDataSubsystem\" --output trackabledatasubsystem")
+os.system(f"python \"{docs}\" --input \"Data\\TrackableDataModifier\" --output trackabledatamodifier")
+os.system(f"python \"{docs}\" --input \"Data\\TrackableDataModifierTarget\" --output trackabledatamodifiertarget")
+os.system(f"python \"{docs}\" --input \"Data\\TrackableDataModifierType\" --output trackabledatamodifiertype")
 
 os.system(f"python \"{docs}\" --input \"Dialogue\\Dialogue\" --output dialogue")
 os.system(f"python \"{docs}\" --input \"Dialogue\\DialogueParticipant\" --output dialogueparticipant")
@@ -46,6 +65,7 @@ os.system(f"python \"{docs}\" --input \"Settings\\SettingsItem\" --output settin
 os.system(f"python \"{docs}\" --input \"Settings\\SettingsUtils\" --output settingsutils")
 
 os.system(f"python \"{docs}\" --input \"Utils\\ConfigUtils\" --output configutils")
+os.system(f"python \"{docs}\" --input \"Utils\\GroundProbeSubsystem\" --output groundprobesubsystem")
 os.system(f"python \"{docs}\" --input \"Utils\\Platform\" --output platformtype")
 os.system(f"python \"{docs}\" --input \"Utils\\PlatformUtils\" --output platformutils")
 os.system(f"python \"{docs}\" --input \"Utils\\ProjectUtils\" --output projectutils")
@@ -54,12 +74,28 @@ os.system(f"python \"{docs}\" --input \"Weapons\\Weapon\" --output weapon")
 os.system(f"python \"{docs}\" --input \"Weapons\\WeaponType\" --output weapontype")
 os.system(f"python \"{docs}\" --input \"Weapons\\WeaponFireMode\" --output weaponfiremode")
 os.system(f"python \"{docs}\" --input \"Weapons\\WeaponItem\" --output weaponitem")
+os.system(f"python \"{docs}\" --input \"Weapons\\WeaponLoadoutComponent\" --output weaponloadoutcomponent")
 os.system(f"python \"{docs}\" --input \"Weapons\\WeaponAmmoItem\" --output weaponammoitem")
 os.system(f"python \"{docs}\" --input \"Weapons\\WeaponProjectile\" --output weaponprojectile")
 os.system(f"python \"{docs}\" --input \"Weapons\\WeaponProjectileData\" --output weaponprojectiledata")
 os.system(f"python \"{docs}\" --input \"Weapons\\WeaponProjectileHitData\" --output weaponprojectilehitdata")
 os.system(f"python \"{docs}\" --input \"Weapons\\WeaponProjectileDecal\" --output weaponprojectiledecal")
+os.system(f"python \"{docs}\" --input \"Weapons\\WeaponProjectilePoolSubsystem\" --output weaponprojectilepoolsubsystem")
+os.system(f"python \"{docs}\" --input \"Weapons\\WeaponProjectilePoolStats\" --output weaponprojectilepoolstats")
+os.system(f"python \"{docs}\" --input \"Weapons\\WeaponProjectileSimulationSubsystem\" --output weaponprojectilesimulationsubsystem")
+os.system(f"python \"{docs}\" --input \"Weapons\\WeaponRecoilPattern\" --output weaponrecoilpattern")
+os.system(f"python \"{docs}\" --input \"Weapons\\WeaponProjectileDecalSubsystem\" --output weaponprojectiledecalsubsystem")
+os.system(f"python \"{docs}\" --input \"Weapons\\WeaponProjectileDecalEvictionPolicy\" --output weaponprojectiledecalevictionpolicy")
 os.system(f"python \"{docs}\" --input \"Weapons\\WeaponUtils\" --output weaponutils")
+os.system(f"python \"{docs}\" --input \"Benchmark\\WeaponBenchmark\" --output weaponbenchmark")
+os.system(f"python \"{docs}\" --input \"Benchmark\\WeaponBenchmarkReport\" --output weaponbenchmarkreport")
+os.system(f"python \"{docs}\" --input \"Benchmark\\WeaponBenchmarkSample\" --output weaponbenchmarksample")
+os.system(f"python \"{docs}\" --input \"Benchmark\\InputRecorderComponent\" --output inputrecordercomponent")
+os.system(f"python \"{docs}\" --input \"Benchmark\\InputRecording\" --output inputrecording")
+os.system(f"python \"{docs}\" --input \"Benchmark\\InputRecordingFrame\" --output inputrecordingframe")
+os.system(f"python \"{docs}\" --input \"Benchmark\\InputRecordingButton\" --output inputrecordingbutton")
+os.system(f"python \"{docs}\" --input \"Benchmark\\InputReplayBenchmark\" --output inputreplaybenchmark")
+os.system(f"python \"{docs}\" --input \"Benchmark\\InputReplayBenchmarkReport\" --output inputreplaybenchmarkreport")
 
 os.system(f"python \"{docs}\" --input \"Widgets\\CollectableItemIcon\" --output collectableitemicon")
 os.system(f"python \"{docs}\" --input \"Widgets\\CreditsEntry\" --output creditsentry")